@@ -91,6 +91,8 @@ static void display_test_reload_config(DisplayTest* instance) {
         instance->config_contrast,
         instance->config_regulation_ratio,
         instance->config_bias);
+    // Display was reinitialized bypassing canvas, next commit must send whole frame
+    canvas_invalidate(instance->gui->canvas);
 }
 
 static void display_config_set_bias(VariableItem* item) {
@@ -0,0 +1,157 @@
+#include <furi.h>
+#include <toolbox/compress.h>
+#include "../minunit.h"
+
+#define COMPRESS_TEST_DATA_SIZE (3000U)
+#define COMPRESS_TEST_ENCODED_SIZE (COMPRESS_TEST_DATA_SIZE * 2U)
+/* compress_encode output starts with 4 byte header, heatshrink stream follows */
+#define COMPRESS_TEST_HEADER_SIZE (4U)
+/* Must match compress_encode parameters */
+#define COMPRESS_TEST_WINDOW_LOG (8U)
+#define COMPRESS_TEST_LOOKAHEAD_LOG (4U)
+/* Small chunks to split heatshrink records across callback calls */
+#define COMPRESS_TEST_CHUNK_SIZE (7U)
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    size_t calls;
+} CompressTestSource;
+
+static int32_t compress_test_read_cb(void* context, uint8_t* buffer, size_t size) {
+    CompressTestSource* source = context;
+    source->calls++;
+    size_t left = source->size - source->position;
+    size_t chunk = MIN(MIN(size, left), COMPRESS_TEST_CHUNK_SIZE);
+    memcpy(buffer, &source->data[source->position], chunk);
+    source->position += chunk;
+    return chunk;
+}
+
+/* Text-like data: repeating words with varying numbers, compresses but not trivially */
+static void compress_test_fill(uint8_t* data, size_t size) {
+    FuriString* text = furi_string_alloc();
+    for(uint32_t i = 0; furi_string_size(text) < size; i++) {
+        furi_string_cat_printf(text, "entry %lu value %lu;", i, (i * 2654435761UL) % 1000);
+    }
+    memcpy(data, furi_string_get_cstr(text), size);
+    furi_string_free(text);
+}
+
+typedef struct {
+    uint8_t* data;
+    uint8_t* encoded;
+    size_t encoded_size;
+    uint8_t* decoded;
+    CompressTestSource source;
+    CompressStreamDecoder* decoder;
+} CompressTest;
+
+static CompressTest* compress_test_alloc(void) {
+    CompressTest* test = malloc(sizeof(CompressTest));
+    test->data = malloc(COMPRESS_TEST_DATA_SIZE);
+    test->encoded = malloc(COMPRESS_TEST_ENCODED_SIZE);
+    test->decoded = malloc(COMPRESS_TEST_DATA_SIZE);
+    compress_test_fill(test->data, COMPRESS_TEST_DATA_SIZE);
+
+    Compress* compress = compress_alloc(512);
+    furi_check(compress_encode(
+        compress,
+        test->data,
+        COMPRESS_TEST_DATA_SIZE,
+        test->encoded,
+        COMPRESS_TEST_ENCODED_SIZE,
+        &test->encoded_size));
+    compress_free(compress);
+    /* Compressed data is marked in header, otherwise the stream is not heatshrink */
+    furi_check(test->encoded[0] == 0x01);
+
+    test->source.data = &test->encoded[COMPRESS_TEST_HEADER_SIZE];
+    test->source.size = test->encoded_size - COMPRESS_TEST_HEADER_SIZE;
+    test->source.position = 0;
+    test->source.calls = 0;
+    test->decoder = compress_stream_decoder_alloc(
+        COMPRESS_TEST_WINDOW_LOG,
+        COMPRESS_TEST_LOOKAHEAD_LOG,
+        64,
+        compress_test_read_cb,
+        &test->source);
+    return test;
+}
+
+static void compress_test_free(CompressTest* test) {
+    compress_stream_decoder_free(test->decoder);
+    free(test->data);
+    free(test->encoded);
+    free(test->decoded);
+    free(test);
+}
+
+MU_TEST(compress_stream_decoder_read_test) {
+    CompressTest* test = compress_test_alloc();
+
+    /* Odd read sizes, crossing input and window buffer boundaries */
+    const size_t read_sizes[] = {1, 13, 255, 256, 257, 511, 3};
+    size_t position = 0;
+    for(size_t i = 0; position < COMPRESS_TEST_DATA_SIZE; i++) {
+        size_t size =
+            MIN(read_sizes[i % COUNT_OF(read_sizes)], COMPRESS_TEST_DATA_SIZE - position);
+        mu_assert(
+            compress_stream_decoder_read(test->decoder, &test->decoded[position], size),
+            "read failed");
+        position += size;
+        mu_assert_int_eq(position, compress_stream_decoder_tell(test->decoder));
+    }
+
+    mu_assert_mem_eq(test->data, test->decoded, COMPRESS_TEST_DATA_SIZE);
+    mu_assert(test->source.calls > 1, "source is expected to be read in chunks");
+
+    uint8_t byte = 0;
+    mu_assert(!compress_stream_decoder_read(test->decoder, &byte, 1), "read past end");
+
+    compress_test_free(test);
+}
+
+MU_TEST(compress_stream_decoder_seek_test) {
+    CompressTest* test = compress_test_alloc();
+    uint8_t buffer[100];
+
+    /* Forward seek skips decoded data */
+    mu_assert(compress_stream_decoder_seek(test->decoder, 1000), "seek forward failed");
+    mu_assert_int_eq(1000, compress_stream_decoder_tell(test->decoder));
+    mu_assert(compress_stream_decoder_read(test->decoder, buffer, sizeof(buffer)), "read failed");
+    mu_assert_mem_eq(&test->data[1000], buffer, sizeof(buffer));
+
+    /* Seek to current position is a no-op */
+    mu_assert(compress_stream_decoder_seek(test->decoder, 1100), "seek to current failed");
+    mu_assert(compress_stream_decoder_read(test->decoder, buffer, sizeof(buffer)), "read failed");
+    mu_assert_mem_eq(&test->data[1100], buffer, sizeof(buffer));
+
+    /* Backward seek is only possible after rewind */
+    mu_assert(!compress_stream_decoder_seek(test->decoder, 10), "seek backward succeeded");
+
+    test->source.position = 0;
+    compress_stream_decoder_rewind(test->decoder);
+    mu_assert_int_eq(0, compress_stream_decoder_tell(test->decoder));
+    mu_assert(compress_stream_decoder_seek(test->decoder, 10), "seek after rewind failed");
+    mu_assert(compress_stream_decoder_read(test->decoder, buffer, sizeof(buffer)), "read failed");
+    mu_assert_mem_eq(&test->data[10], buffer, sizeof(buffer));
+
+    /* Seek past end of data fails */
+    mu_assert(
+        !compress_stream_decoder_seek(test->decoder, COMPRESS_TEST_DATA_SIZE + 1),
+        "seek past end succeeded");
+
+    compress_test_free(test);
+}
+
+MU_TEST_SUITE(compress_suite) {
+    MU_RUN_TEST(compress_stream_decoder_read_test);
+    MU_RUN_TEST(compress_stream_decoder_seek_test);
+}
+
+int run_minunit_test_compress() {
+    MU_RUN_SUITE(compress_suite);
+    return MU_EXIT_CODE;
+}
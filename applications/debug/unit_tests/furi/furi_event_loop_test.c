@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <furi.h>
+#include "../minunit.h"
+
+#define EVENT_LOOP_TEST_MESSAGE_COUNT 256
+#define EVENT_LOOP_TEST_FLAG_DONE (1 << 0)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* queue;
+    FuriThreadId consumer_id;
+    uint32_t received;
+    uint32_t sum;
+    uint32_t timer_fired;
+    uint32_t flags;
+} EventLoopTestContext;
+
+static int32_t test_furi_event_loop_producer(void* context) {
+    EventLoopTestContext* test = context;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_TEST_MESSAGE_COUNT; i++) {
+        furi_check(furi_message_queue_put(test->queue, &i, FuriWaitForever) == FuriStatusOk);
+        if(i % 32 == 0) furi_delay_tick(1);
+    }
+    furi_thread_flags_set(test->consumer_id, EVENT_LOOP_TEST_FLAG_DONE);
+
+    return 0;
+}
+
+static void test_furi_event_loop_queue_callback(void* object, void* context) {
+    EventLoopTestContext* test = context;
+    uint32_t value;
+
+    // Take one message per call: event is level triggered
+    furi_check(furi_message_queue_get(object, &value, 0) == FuriStatusOk);
+    test->received++;
+    test->sum += value;
+}
+
+static void test_furi_event_loop_flags_callback(uint32_t flags, void* context) {
+    EventLoopTestContext* test = context;
+    test->flags |= flags;
+}
+
+static void test_furi_event_loop_timer_callback(void* context) {
+    EventLoopTestContext* test = context;
+    test->timer_fired++;
+
+    if((test->flags & EVENT_LOOP_TEST_FLAG_DONE) &&
+       test->received == EVENT_LOOP_TEST_MESSAGE_COUNT) {
+        furi_event_loop_stop(test->event_loop);
+    }
+}
+
+void test_furi_event_loop() {
+    EventLoopTestContext test = {0};
+
+    test.event_loop = furi_event_loop_alloc();
+    test.queue = furi_message_queue_alloc(8, sizeof(uint32_t));
+    test.consumer_id = furi_thread_get_current_id();
+
+    furi_event_loop_subscribe_message_queue(
+        test.event_loop, test.queue, test_furi_event_loop_queue_callback, &test);
+    furi_event_loop_subscribe_thread_flags(
+        test.event_loop, test_furi_event_loop_flags_callback, &test);
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        test.event_loop, test_furi_event_loop_timer_callback, FuriEventLoopTimerTypePeriodic, &test);
+    furi_event_loop_timer_start(timer, 5);
+    mu_assert(furi_event_loop_timer_is_running(timer), "timer is not running");
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("EventLoopProducer", 1024, test_furi_event_loop_producer, &test);
+    furi_thread_start(producer);
+
+    furi_event_loop_run(test.event_loop);
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    mu_assert_int_eq(EVENT_LOOP_TEST_MESSAGE_COUNT, test.received);
+    mu_assert_int_eq(
+        EVENT_LOOP_TEST_MESSAGE_COUNT * (EVENT_LOOP_TEST_MESSAGE_COUNT - 1) / 2, test.sum);
+    mu_assert(test.timer_fired > 0, "timer did not fire");
+
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_unsubscribe(test.event_loop, test.queue);
+    furi_event_loop_unsubscribe_thread_flags(test.event_loop);
+    furi_event_loop_free(test.event_loop);
+    furi_message_queue_free(test.queue);
+}
+
+#define EVENT_LOOP_TEST_WATCHDOG_MS 1000
+#define EVENT_LOOP_TEST_FLAG_WATCHDOG_CANCEL (1 << 0)
+
+/* Stops a stuck event loop, so that failing test doesn't block forever.
+ * Loop is stopped from other thread: it doesn't set a deadline that could hide the failure. */
+static int32_t test_furi_event_loop_watchdog(void* context) {
+    FuriEventLoop* event_loop = context;
+    if(furi_thread_flags_wait(
+           EVENT_LOOP_TEST_FLAG_WATCHDOG_CANCEL, FuriFlagWaitAny, EVENT_LOOP_TEST_WATCHDOG_MS) ==
+       (uint32_t)FuriFlagErrorTimeout) {
+        furi_event_loop_stop(event_loop);
+    }
+    return 0;
+}
+
+static void test_furi_event_loop_run_guarded(FuriEventLoop* event_loop) {
+    FuriThread* watchdog =
+        furi_thread_alloc_ex("EventLoopWatchdog", 512, test_furi_event_loop_watchdog, event_loop);
+    furi_thread_start(watchdog);
+
+    furi_event_loop_run(event_loop);
+
+    furi_thread_flags_set(furi_thread_get_id(watchdog), EVENT_LOOP_TEST_FLAG_WATCHDOG_CANCEL);
+    furi_thread_join(watchdog);
+    furi_thread_free(watchdog);
+}
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* first;
+    FuriEventLoopTimer* second;
+    bool first_fired;
+} EventLoopTestTimerRestart;
+
+static void test_furi_event_loop_first_timer_callback(void* context) {
+    EventLoopTestTimerRestart* test = context;
+    test->first_fired = true;
+    furi_event_loop_stop(test->event_loop);
+}
+
+static void test_furi_event_loop_second_timer_callback(void* context) {
+    EventLoopTestTimerRestart* test = context;
+    // Timer processed before this one in the same pass
+    furi_event_loop_timer_start(test->first, 1);
+}
+
+void test_furi_event_loop_timer_restart() {
+    EventLoopTestTimerRestart test = {0};
+
+    test.event_loop = furi_event_loop_alloc();
+    test.first = furi_event_loop_timer_alloc(
+        test.event_loop,
+        test_furi_event_loop_first_timer_callback,
+        FuriEventLoopTimerTypeOnce,
+        &test);
+    test.second = furi_event_loop_timer_alloc(
+        test.event_loop,
+        test_furi_event_loop_second_timer_callback,
+        FuriEventLoopTimerTypeOnce,
+        &test);
+    furi_event_loop_timer_start(test.second, 1);
+
+    test_furi_event_loop_run_guarded(test.event_loop);
+
+    mu_assert(test.first_fired, "timer started from other timer callback did not fire");
+
+    furi_event_loop_timer_free(test.first);
+    furi_event_loop_timer_free(test.second);
+    furi_event_loop_free(test.event_loop);
+}
+
+typedef struct {
+    FuriEventLoop* outer;
+    FuriEventLoop* inner;
+    FuriMessageQueue* queue;
+    bool inner_fired;
+    uint32_t received;
+} EventLoopTestNested;
+
+static void test_furi_event_loop_nested_queue_callback(void* object, void* context) {
+    EventLoopTestNested* test = context;
+    uint32_t value;
+    furi_check(furi_message_queue_get(object, &value, 0) == FuriStatusOk);
+    test->received++;
+    furi_event_loop_stop(test->outer);
+}
+
+static void test_furi_event_loop_inner_timer_callback(void* context) {
+    EventLoopTestNested* test = context;
+    test->inner_fired = true;
+
+    // Wakes the thread while inner loop runs: outer must still see it later
+    uint32_t value = 0;
+    furi_check(furi_message_queue_put(test->queue, &value, 0) == FuriStatusOk);
+    furi_event_loop_stop(test->inner);
+}
+
+static void test_furi_event_loop_outer_timer_callback(void* context) {
+    EventLoopTestNested* test = context;
+
+    test->inner = furi_event_loop_alloc();
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        test->inner, test_furi_event_loop_inner_timer_callback, FuriEventLoopTimerTypeOnce, test);
+    furi_event_loop_timer_start(timer, 1);
+    furi_event_loop_run(test->inner);
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_free(test->inner);
+    test->inner = NULL;
+}
+
+void test_furi_event_loop_nested() {
+    EventLoopTestNested test = {0};
+
+    test.outer = furi_event_loop_alloc();
+    test.queue = furi_message_queue_alloc(1, sizeof(uint32_t));
+    furi_event_loop_subscribe_message_queue(
+        test.outer, test.queue, test_furi_event_loop_nested_queue_callback, &test);
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        test.outer, test_furi_event_loop_outer_timer_callback, FuriEventLoopTimerTypeOnce, &test);
+    furi_event_loop_timer_start(timer, 1);
+
+    test_furi_event_loop_run_guarded(test.outer);
+
+    mu_assert(test.inner_fired, "nested event loop did not run");
+    mu_assert_int_eq(1, test.received);
+
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_unsubscribe(test.outer, test.queue);
+    furi_event_loop_free(test.outer);
+    furi_message_queue_free(test.queue);
+}
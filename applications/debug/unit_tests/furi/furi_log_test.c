@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <furi.h>
+#include "../minunit.h"
+
+#define LOG_TEST_TAG "LogRingTest"
+#define LOG_TEST_PREFIX "[" LOG_TEST_TAG "] " _FURI_LOG_CLR_RESET
+#define LOG_TEST_TIMEOUT_MS 1000
+#define LOG_TEST_LONG_FORMAT_SIZE 300
+
+/* Each format is printed with the same arguments both through log and snprintf */
+#define LOG_TEST_FORMAT "int %d %5u %-4x|%lld %.2f %c %s|%*s|%-*.*s|%.*s|%.3s|%.4s %%"
+#define LOG_TEST_ARGS(nonterminated)                                                  \
+    -42, 7U, 0xabU, (long long)-1234567890123LL, 3.14159, 'z', "string", 6, "wd", 8, \
+        3, "precision", 2, "star", "literal", nonterminated
+
+typedef struct {
+    FuriMutex* mutex;
+    FuriString* output;
+} LogTestCollector;
+
+static void log_test_handler(const uint8_t* data, size_t size, void* context) {
+    LogTestCollector* collector = context;
+    furi_check(furi_mutex_acquire(collector->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < size; i++) {
+        furi_string_push_back(collector->output, data[i]);
+    }
+    furi_mutex_release(collector->mutex);
+}
+
+static bool log_test_contains(LogTestCollector* collector, const char* body) {
+    FuriString* expected = furi_string_alloc_printf(LOG_TEST_PREFIX "%s\r\n", body);
+    furi_check(furi_mutex_acquire(collector->mutex, FuriWaitForever) == FuriStatusOk);
+    bool found = furi_string_search(collector->output, expected) != FURI_STRING_FAILURE;
+    furi_mutex_release(collector->mutex);
+    furi_string_free(expected);
+    return found;
+}
+
+static bool log_test_wait(LogTestCollector* collector, const char* body) {
+    for(uint32_t i = 0; i < LOG_TEST_TIMEOUT_MS; i++) {
+        if(log_test_contains(collector, body)) return true;
+        furi_delay_ms(1);
+    }
+    return false;
+}
+
+static void log_test_roundtrip(LogTestCollector* collector) {
+    /* Precision allows string without terminator */
+    const char nonterminated[4] = {'a', 'b', 'c', 'd'};
+    char expected[256];
+
+    /* Format in firmware flash, stored by pointer */
+    snprintf(expected, sizeof(expected), LOG_TEST_FORMAT, LOG_TEST_ARGS(nonterminated));
+    FURI_LOG_E(LOG_TEST_TAG, LOG_TEST_FORMAT, LOG_TEST_ARGS(nonterminated));
+
+    /* Format in RAM, copied into record */
+    char* format = strdup(LOG_TEST_FORMAT " inline");
+    FURI_LOG_E(LOG_TEST_TAG, format, LOG_TEST_ARGS(nonterminated));
+    free(format);
+
+    /* String arguments are truncated */
+    char long_string[100];
+    memset(long_string, 's', sizeof(long_string) - 1);
+    long_string[sizeof(long_string) - 1] = '\0';
+    FURI_LOG_E(LOG_TEST_TAG, "long %s", long_string);
+
+    /* Format in RAM longer than inline limit: printed synchronously, not truncated */
+    char* long_format = malloc(LOG_TEST_LONG_FORMAT_SIZE + 1);
+    memset(long_format, 'f', LOG_TEST_LONG_FORMAT_SIZE);
+    strcpy(&long_format[LOG_TEST_LONG_FORMAT_SIZE - 6], " %d %s");
+    FURI_LOG_E(LOG_TEST_TAG, long_format, 1234, "tail");
+
+    FURI_LOG_E(LOG_TEST_TAG, "done");
+    mu_assert(log_test_wait(collector, "done"), "log ring was not drained");
+
+    mu_assert(log_test_contains(collector, expected), "flash format mismatch");
+
+    strcat(expected, " inline");
+    mu_assert(log_test_contains(collector, expected), "inline format mismatch");
+
+    snprintf(expected, sizeof(expected), "long %.64s", long_string);
+    mu_assert(log_test_contains(collector, expected), "string argument not truncated");
+
+    char* long_expected = malloc(LOG_TEST_LONG_FORMAT_SIZE + 16);
+    snprintf(long_expected, LOG_TEST_LONG_FORMAT_SIZE + 16, long_format, 1234, "tail");
+    bool long_found = log_test_contains(collector, long_expected);
+    free(long_expected);
+    free(long_format);
+    mu_assert(long_found, "long inline format mismatch");
+}
+
+void test_furi_log_ring() {
+    LogTestCollector collector = {
+        .mutex = furi_mutex_alloc(FuriMutexTypeNormal),
+        .output = furi_string_alloc(),
+    };
+    FuriLogHandler handler = {.callback = log_test_handler, .context = &collector};
+
+    const bool async = furi_log_get_async();
+    const FuriLogLevel level = furi_log_get_level();
+    if(level < FuriLogLevelError) furi_log_set_level(FuriLogLevelError);
+    furi_log_set_async(true);
+    furi_check(furi_log_add_handler(handler));
+
+    log_test_roundtrip(&collector);
+
+    furi_log_remove_handler(handler);
+    furi_log_set_async(async);
+    furi_log_set_level(level);
+    furi_string_free(collector.output);
+    furi_mutex_free(collector.mutex);
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 
 const uint32_t context_value = 0xdeadbeef;
@@ -43,3 +44,211 @@ void test_furi_pubsub() {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+typedef struct TestPubSubReentrancy TestPubSubReentrancy;
+
+struct TestPubSubReentrancy {
+    FuriPubSub* pubsub;
+    FuriPubSubSubscription* self;
+    TestPubSubReentrancy* to_add;
+    uint32_t calls;
+    uint32_t last_value;
+};
+
+static void test_pubsub_counter_handler(const void* arg, void* ctx) {
+    TestPubSubReentrancy* context = ctx;
+    context->calls++;
+    context->last_value = *(uint32_t*)arg;
+}
+
+static void test_pubsub_reentrant_handler(const void* arg, void* ctx) {
+    TestPubSubReentrancy* context = ctx;
+    context->calls++;
+    context->last_value = *(uint32_t*)arg;
+
+    // Unsubscribe itself, subscribe new one and publish from callback
+    furi_pubsub_unsubscribe(context->pubsub, context->self);
+    context->to_add->self =
+        furi_pubsub_subscribe(context->pubsub, test_pubsub_counter_handler, context->to_add);
+    uint32_t nested_value = 2;
+    furi_pubsub_publish(context->pubsub, &nested_value);
+}
+
+void test_furi_pubsub_reentrancy() {
+    FuriPubSub* pubsub = furi_pubsub_alloc();
+    TestPubSubReentrancy old_context = {.pubsub = pubsub};
+    TestPubSubReentrancy new_context = {.pubsub = pubsub};
+    TestPubSubReentrancy reentrant_context = {.pubsub = pubsub};
+
+    old_context.self = furi_pubsub_subscribe(pubsub, test_pubsub_counter_handler, &old_context);
+    // Reentrant one is newer, so it is called first
+    reentrant_context.to_add = &new_context;
+    reentrant_context.self =
+        furi_pubsub_subscribe(pubsub, test_pubsub_reentrant_handler, &reentrant_context);
+
+    uint32_t value = 1;
+    furi_pubsub_publish(pubsub, &value);
+
+    // Reentrant subscriber is gone after first message
+    mu_assert_int_eq(1, reentrant_context.calls);
+    mu_assert_int_eq(1, reentrant_context.last_value);
+    // Subscriber added from callback gets only nested message
+    mu_assert_int_eq(1, new_context.calls);
+    mu_assert_int_eq(2, new_context.last_value);
+    // Old subscriber gets both, nested one first
+    mu_assert_int_eq(2, old_context.calls);
+    mu_assert_int_eq(1, old_context.last_value);
+
+    value = 3;
+    furi_pubsub_publish(pubsub, &value);
+    mu_assert_int_eq(1, reentrant_context.calls);
+    mu_assert_int_eq(3, new_context.last_value);
+    mu_assert_int_eq(3, old_context.last_value);
+
+    furi_pubsub_unsubscribe(pubsub, old_context.self);
+    furi_pubsub_unsubscribe(pubsub, new_context.self);
+    furi_pubsub_free(pubsub);
+}
+
+#define TEST_PUBSUB_SLOW_CALLBACK_MS (100)
+
+typedef struct {
+    FuriPubSub* pubsub;
+    FuriSemaphore* started;
+    volatile bool finished;
+} TestPubSubConcurrent;
+
+static void test_pubsub_slow_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    TestPubSubConcurrent* context = ctx;
+    furi_semaphore_release(context->started);
+    furi_delay_ms(TEST_PUBSUB_SLOW_CALLBACK_MS);
+    context->finished = true;
+}
+
+static int32_t test_pubsub_publisher_thread(void* ctx) {
+    TestPubSubConcurrent* context = ctx;
+    uint32_t value = 1;
+    furi_pubsub_publish(context->pubsub, &value);
+    return 0;
+}
+
+void test_furi_pubsub_concurrent_unsubscribe() {
+    TestPubSubConcurrent context = {
+        .pubsub = furi_pubsub_alloc(),
+        .started = furi_semaphore_alloc(1, 0),
+    };
+    TestPubSubReentrancy other_context = {};
+
+    FuriPubSubSubscription* slow =
+        furi_pubsub_subscribe(context.pubsub, test_pubsub_slow_handler, &context);
+
+    FuriThread* publisher =
+        furi_thread_alloc_ex("PubSubPublisher", 1024, test_pubsub_publisher_thread, &context);
+    furi_thread_start(publisher);
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(context.started, 1000));
+
+    // Slow callback doesn't block subscribe from other threads
+    uint32_t tick = furi_get_tick();
+    FuriPubSubSubscription* other =
+        furi_pubsub_subscribe(context.pubsub, test_pubsub_counter_handler, &other_context);
+    mu_check(furi_get_tick() - tick < TEST_PUBSUB_SLOW_CALLBACK_MS / 2);
+    mu_check(!context.finished);
+
+    // Unsubscribe waits for callback running in other thread
+    furi_pubsub_unsubscribe(context.pubsub, slow);
+    mu_check(context.finished);
+
+    furi_thread_join(publisher);
+    furi_thread_free(publisher);
+
+    // Subscription made during publish is not called for that message
+    mu_assert_int_eq(0, other_context.calls);
+    uint32_t value = 2;
+    furi_pubsub_publish(context.pubsub, &value);
+    mu_assert_int_eq(1, other_context.calls);
+    mu_assert_int_eq(2, other_context.last_value);
+
+    furi_pubsub_unsubscribe(context.pubsub, other);
+    furi_pubsub_free(context.pubsub);
+    furi_semaphore_free(context.started);
+}
+
+#define TEST_PUBSUB_DEFERRED_QUEUE_SIZE (16)
+
+typedef struct {
+    uint32_t values[TEST_PUBSUB_DEFERRED_QUEUE_SIZE * 2];
+    volatile uint32_t count;
+} TestPubSubDeferred;
+
+static void test_pubsub_deferred_handler(const void* arg, void* ctx) {
+    TestPubSubDeferred* context = ctx;
+    furi_delay_us(500);
+    if(context->count < COUNT_OF(context->values)) {
+        context->values[context->count] = *(uint32_t*)arg;
+    }
+    context->count++;
+}
+
+static uint32_t test_pubsub_publish_worst_us(FuriPubSub* pubsub, uint32_t count) {
+    uint32_t worst = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t start = DWT->CYCCNT;
+        furi_pubsub_publish(pubsub, &i);
+        worst = MAX(worst, DWT->CYCCNT - start);
+    }
+    return worst / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static bool test_pubsub_wait_count(TestPubSubDeferred* context, uint32_t count) {
+    for(size_t i = 0; i < 100 && context->count < count; i++) {
+        furi_delay_ms(10);
+    }
+    return context->count == count;
+}
+
+void test_furi_pubsub_latency() {
+    TestPubSubDeferred context = {};
+
+    // Regular pubsub: publisher pays for every subscriber
+    FuriPubSub* pubsub = furi_pubsub_alloc();
+    FuriPubSubSubscription* subscription =
+        furi_pubsub_subscribe(pubsub, test_pubsub_deferred_handler, &context);
+    uint32_t direct_worst_us = test_pubsub_publish_worst_us(pubsub, 4);
+    furi_pubsub_unsubscribe(pubsub, subscription);
+    furi_pubsub_free(pubsub);
+    mu_assert_int_eq(4, context.count);
+    mu_check(direct_worst_us >= 500);
+
+    // Deferred pubsub: constant publish cost, delivered in order
+    context.count = 0;
+    pubsub = furi_pubsub_alloc_deferred(sizeof(uint32_t), TEST_PUBSUB_DEFERRED_QUEUE_SIZE);
+    subscription = furi_pubsub_subscribe(pubsub, test_pubsub_deferred_handler, &context);
+    uint32_t deferred_worst_us =
+        test_pubsub_publish_worst_us(pubsub, TEST_PUBSUB_DEFERRED_QUEUE_SIZE);
+    mu_check(deferred_worst_us < 100);
+    mu_check(test_pubsub_wait_count(&context, TEST_PUBSUB_DEFERRED_QUEUE_SIZE));
+    for(uint32_t i = 0; i < TEST_PUBSUB_DEFERRED_QUEUE_SIZE; i++) {
+        mu_assert_int_eq(i, context.values[i]);
+    }
+    mu_assert_int_eq(0, furi_pubsub_get_dropped_count(pubsub));
+
+    // Publish with interrupts masked takes ISR path, queue overflow is dropped
+    context.count = 0;
+    __disable_irq();
+    for(uint32_t i = 0; i < TEST_PUBSUB_DEFERRED_QUEUE_SIZE + 4; i++) {
+        furi_pubsub_publish(pubsub, &i);
+    }
+    __enable_irq();
+    mu_check(test_pubsub_wait_count(&context, TEST_PUBSUB_DEFERRED_QUEUE_SIZE));
+    mu_assert_int_eq(4, furi_pubsub_get_dropped_count(pubsub));
+
+    FURI_LOG_I(
+        "PubSubTest",
+        "Worst publish: %luus direct, %luus deferred",
+        direct_worst_us,
+        deferred_worst_us);
+
+    furi_pubsub_unsubscribe(pubsub, subscription);
+    furi_pubsub_free(pubsub);
+}
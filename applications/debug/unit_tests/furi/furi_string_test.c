@@ -1,6 +1,11 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 
+#define TAG "FuriStringTest"
+
+#define BENCH_STRING_COUNT (64U)
+
 static void test_setup(void) {
 }
 
@@ -445,6 +450,132 @@ MU_TEST(mu_test_furi_string_utf8) {
     furi_string_free(utf8_string);
 }
 
+typedef enum {
+    BenchWorkloadKeyValue,
+    BenchWorkloadPath,
+    BenchWorkloadProtocolName,
+    BenchWorkloadGrow,
+} BenchWorkload;
+
+typedef struct {
+    BenchWorkload workload;
+    size_t allocations;
+    uint32_t cycles;
+} BenchContext;
+
+static const char* const bench_keys[] = {"Frequency", "Preset", "Protocol", "Bit", "Key", "TE"};
+static const char* const bench_protocols[] = {"Princeton", "CAME", "Nice FLO", "KeeLoq"};
+
+static FuriString* mu_test_furi_string_bench_make(BenchWorkload workload, size_t index) {
+    FuriString* string = NULL;
+
+    switch(workload) {
+    case BenchWorkloadKeyValue:
+        // FlipperFormat keys: alloc, then filled by reader
+        string = furi_string_alloc();
+        furi_string_set(string, bench_keys[index % COUNT_OF(bench_keys)]);
+        break;
+    case BenchWorkloadPath:
+        // File browser entries: full path known at allocation
+        string = furi_string_alloc_printf("/ext/subghz/Gate_remote_%03zu.sub", index);
+        break;
+    case BenchWorkloadProtocolName:
+        // Decoders: protocol name and bit count per packet
+        string = furi_string_alloc_set_str(bench_protocols[index % COUNT_OF(bench_protocols)]);
+        furi_string_cat_printf(string, " %zubit", 12 + index % 52);
+        break;
+    case BenchWorkloadGrow:
+        // Long values grown in place
+        string = furi_string_alloc();
+        for(size_t i = 0; i < 8; i++) {
+            furi_string_cat_printf(string, "%02zX %02zX ", i, index & 0xFF);
+        }
+        break;
+    }
+
+    return string;
+}
+
+static int32_t mu_test_furi_string_bench_thread(void* context) {
+    BenchContext* bench = context;
+    FuriString* strings[BENCH_STRING_COUNT];
+    FuriThreadId thread_id = furi_thread_get_current_id();
+
+    size_t allocations_before = memmgr_heap_get_thread_allocations(thread_id);
+    uint32_t cycles = DWT->CYCCNT;
+    for(size_t i = 0; i < BENCH_STRING_COUNT; i++) {
+        strings[i] = mu_test_furi_string_bench_make(bench->workload, i);
+    }
+    bench->cycles = DWT->CYCCNT - cycles;
+    bench->allocations = memmgr_heap_get_thread_allocations(thread_id) - allocations_before;
+
+    for(size_t i = 0; i < BENCH_STRING_COUNT; i++) {
+        furi_string_free(strings[i]);
+    }
+
+    return 0;
+}
+
+static void mu_test_furi_string_bench_run(BenchContext* bench, BenchWorkload workload) {
+    bench->workload = workload;
+    FuriThread* thread =
+        furi_thread_alloc_ex("StrBench", 1024, mu_test_furi_string_bench_thread, bench);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    FURI_LOG_I(
+        TAG,
+        "Workload %d: %zu allocations, %lu us per %u strings",
+        workload,
+        bench->allocations,
+        bench->cycles / furi_hal_cortex_instructions_per_microsecond(),
+        BENCH_STRING_COUNT);
+}
+
+MU_TEST(mu_test_furi_string_bench) {
+    BenchContext bench = {};
+
+    // Short content lives inside of FuriString allocation
+    mu_test_furi_string_bench_run(&bench, BenchWorkloadKeyValue);
+    mu_assert_int_eq(BENCH_STRING_COUNT, bench.allocations);
+    mu_test_furi_string_bench_run(&bench, BenchWorkloadProtocolName);
+    mu_assert_int_eq(BENCH_STRING_COUNT, bench.allocations);
+
+    // Long content known at allocation time goes to the same allocation
+    mu_test_furi_string_bench_run(&bench, BenchWorkloadPath);
+    mu_assert_int_eq(BENCH_STRING_COUNT, bench.allocations);
+
+    // Growing past inline storage needs one more block
+    mu_test_furi_string_bench_run(&bench, BenchWorkloadGrow);
+    mu_assert_int_eq(BENCH_STRING_COUNT * 2, bench.allocations);
+}
+
+MU_TEST(mu_test_furi_string_inline) {
+    FuriString* string = furi_string_alloc_set("short");
+    FuriString* long_string =
+        furi_string_alloc_set("this is definitely longer than inline storage");
+
+    // Grow, swap and move across inline and heap storage
+    furi_string_swap(string, long_string);
+    mu_assert_string_eq(
+        "this is definitely longer than inline storage", furi_string_get_cstr(string));
+    mu_assert_string_eq("short", furi_string_get_cstr(long_string));
+    furi_string_cat(string, string);
+    mu_assert_int_eq(90, furi_string_size(string));
+    furi_string_set_n(string, string, 85, 10);
+    mu_assert_string_eq("orage", furi_string_get_cstr(string));
+    furi_string_reserve(string, 256);
+    mu_assert_string_eq("orage", furi_string_get_cstr(string));
+    furi_string_reserve(string, 0);
+    mu_assert_string_eq("orage", furi_string_get_cstr(string));
+    furi_string_move(long_string, string);
+    mu_assert_string_eq("orage", furi_string_get_cstr(long_string));
+
+    furi_string_free(long_string);
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -460,6 +591,8 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_string_start_end);
     MU_RUN_TEST(mu_test_furi_string_trim);
     MU_RUN_TEST(mu_test_furi_string_utf8);
+    MU_RUN_TEST(mu_test_furi_string_inline);
+    MU_RUN_TEST(mu_test_furi_string_bench);
 }
 
 int run_minunit_test_furi_string() {
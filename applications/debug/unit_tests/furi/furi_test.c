@@ -7,6 +7,13 @@
 void test_furi_create_open();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_pubsub_reentrancy();
+void test_furi_pubsub_concurrent_unsubscribe();
+void test_furi_pubsub_latency();
+void test_furi_event_loop();
+void test_furi_event_loop_timer_restart();
+void test_furi_event_loop_nested();
+void test_furi_log_ring();
 
 void test_furi_memmgr();
 
@@ -33,6 +40,34 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_reentrancy) {
+    test_furi_pubsub_reentrancy();
+}
+
+MU_TEST(mu_test_furi_pubsub_concurrent_unsubscribe) {
+    test_furi_pubsub_concurrent_unsubscribe();
+}
+
+MU_TEST(mu_test_furi_pubsub_latency) {
+    test_furi_pubsub_latency();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
+MU_TEST(mu_test_furi_event_loop_timer_restart) {
+    test_furi_event_loop_timer_restart();
+}
+
+MU_TEST(mu_test_furi_event_loop_nested) {
+    test_furi_event_loop_nested();
+}
+
+MU_TEST(mu_test_furi_log_ring) {
+    test_furi_log_ring();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
@@ -47,6 +82,13 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_reentrancy);
+    MU_RUN_TEST(mu_test_furi_pubsub_concurrent_unsubscribe);
+    MU_RUN_TEST(mu_test_furi_pubsub_latency);
+    MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer_restart);
+    MU_RUN_TEST(mu_test_furi_event_loop_nested);
+    MU_RUN_TEST(mu_test_furi_log_ring);
     MU_RUN_TEST(mu_test_furi_memmgr);
 }
 
@@ -1,6 +1,7 @@
 #include <furi.h>
 #include <flipper_format.h>
 #include <infrared.h>
+#include <infrared_raw_compact.h>
 #include <common/infrared_common_i.h>
 #include "../minunit.h"
 
@@ -323,6 +324,84 @@ static void infrared_test_run_encoder_decoder(InfraredProtocol protocol, uint32_
     free(timings);
 }
 
+/* Replays encoded signal from its compact form, decoder must see the same messages */
+static void infrared_test_run_raw_compact(InfraredProtocol protocol, uint32_t test_index) {
+    uint32_t timings_count = 200;
+    uint32_t* timings = malloc(sizeof(uint32_t) * timings_count);
+    uint32_t* replay = malloc(sizeof(uint32_t) * timings_count);
+    InfraredMessage* input_messages;
+    uint32_t input_messages_count;
+    uint32_t compacted = 0;
+    bool level = false;
+
+    FuriString* buf;
+    buf = furi_string_alloc();
+
+    const char* protocol_name = infrared_get_protocol_name(protocol);
+    mu_assert(infrared_test_prepare_file(protocol_name), "Failed to prepare test file");
+
+    furi_string_printf(buf, "encoder_decoder_input%ld", test_index);
+    mu_assert(
+        infrared_test_load_messages(
+            test->ff, furi_string_get_cstr(buf), &input_messages, &input_messages_count),
+        "Failed to load messages from file");
+
+    flipper_format_buffered_file_close(test->ff);
+    furi_string_free(buf);
+
+    for(uint32_t message_counter = 0; message_counter < input_messages_count; ++message_counter) {
+        const InfraredMessage* message_encoded = &input_messages[message_counter];
+        if(!message_encoded->repeat) {
+            infrared_reset_encoder(test->encoder_handler, message_encoded);
+        }
+
+        timings_count = 200;
+        infrared_test_run_encoder_fill_array(
+            test->encoder_handler, timings, &timings_count, &level);
+        furi_check(timings_count <= 200);
+
+        InfraredRawCompact* compact = infrared_raw_compact_alloc(timings, timings_count);
+        /* Short frames (e.g. repeats) may not get smaller */
+        if(!compact) continue;
+        ++compacted;
+
+        mu_assert_int_eq(timings_count, infrared_raw_compact_get_timings_size(compact));
+        infrared_raw_compact_expand(compact, replay);
+
+        InfraredRawCompactIterator it;
+        infrared_raw_compact_it_init(compact, &it);
+        for(size_t i = 0; i < timings_count; ++i) {
+            uint32_t duration = 0;
+            mu_check(infrared_raw_compact_it_next(compact, &it, &duration));
+            mu_assert_int_eq(replay[i], duration);
+            mu_check(MATCH_TIMING(
+                duration, timings[i], timings[i] * INFRARED_RAW_COMPACT_TOLERANCE + 1));
+        }
+        uint32_t extra;
+        mu_check(!infrared_raw_compact_it_next(compact, &it, &extra));
+        infrared_raw_compact_free(compact);
+
+        const InfraredMessage* message_decoded = 0;
+        for(size_t i = 0; i < timings_count && !message_decoded; ++i) {
+            message_decoded = infrared_decode(test->decoder_handler, level, replay[i]);
+            level = !level;
+        }
+        if(!message_decoded) {
+            message_decoded = infrared_check_decoder_ready(test->decoder_handler);
+        }
+        mu_check(message_decoded);
+        if(message_decoded) {
+            infrared_test_compare_message_results(message_decoded, message_encoded);
+        }
+    }
+
+    mu_check(compacted);
+
+    free(input_messages);
+    free(replay);
+    free(timings);
+}
+
 static void infrared_test_run_decoder(InfraredProtocol protocol, uint32_t test_index) {
     uint32_t* timings;
     uint32_t timings_count;
@@ -522,6 +601,13 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolRCA, 1);
 }
 
+MU_TEST(infrared_test_raw_compact) {
+    infrared_test_run_raw_compact(InfraredProtocolNEC, 1);
+    infrared_test_run_raw_compact(InfraredProtocolSamsung32, 1);
+    infrared_test_run_raw_compact(InfraredProtocolRC6, 1);
+    infrared_test_run_raw_compact(InfraredProtocolSIRC, 1);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -541,6 +627,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_rca);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_raw_compact);
 }
 
 int run_minunit_test_infrared() {
@@ -0,0 +1,127 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/crc32_calc.h>
+#include <mjs_core.h>
+#include <mjs_core_public.h>
+#include <mjs_exec_public.h>
+#include <mjs_primitive_public.h>
+
+#include "../minunit.h"
+
+#define JS_TEST_SCRIPT_PATH EXT_PATH("unit_tests/js_cache_test.js")
+#define JS_TEST_CACHE_DIR EXT_PATH(".tmp/js_cache")
+
+static const char* js_test_script_v1 = "let a = 20; function f(x) { return x * 2 + 2; } f(a);";
+static const char* js_test_script_v2 = "let a = 100; function f(x) { return x * 3; } f(a);";
+
+/* Literal property names are interned, computed ones are not */
+static const char* js_test_script_strings =
+    "let o = {}; o.longPropertyName = 1;"
+    "let k = 'longProperty' + 'Name'; o[k] = o[k] + 1;"
+    "let d = {}; d[k] = 5;"
+    "let r = o.longPropertyName + d.longPropertyName * 10;"
+    "if (k === 'longPropertyName') r = r + 100;"
+    "if (k !== 'longPropertyNamf') r = r + 1000;"
+    "gc(true);"
+    "r + o[k] * 10000;";
+
+static Storage* storage;
+static FuriString* cache_path;
+
+static void js_test_setup(void) {
+    storage = furi_record_open(RECORD_STORAGE);
+    cache_path = furi_string_alloc_printf(
+        "%s/%08lX.jsc",
+        JS_TEST_CACHE_DIR,
+        crc32_calc_buffer(0, JS_TEST_SCRIPT_PATH, strlen(JS_TEST_SCRIPT_PATH)));
+    storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+}
+
+static void js_test_teardown(void) {
+    storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+    storage_simply_remove(storage, JS_TEST_SCRIPT_PATH);
+    furi_string_free(cache_path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static bool js_test_write_file(const char* path, const void* data, size_t size) {
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, data, size) == size;
+    storage_file_free(file);
+    return success;
+}
+
+static size_t js_test_parse_cnt;
+
+static int js_test_run(bool use_cache) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_set_generate_jsc(mjs, use_cache);
+
+    mjs_val_t result = MJS_UNDEFINED;
+    mjs_err_t err = mjs_exec_file(mjs, JS_TEST_SCRIPT_PATH, &result);
+    int value = (err == MJS_OK && mjs_is_number(result)) ? mjs_get_int(mjs, result) : -1;
+    js_test_parse_cnt = mjs_get_parse_cnt(mjs);
+
+    mjs_destroy(mjs);
+    return value;
+}
+
+MU_TEST(js_bcode_cache_test) {
+    mu_assert(
+        js_test_write_file(JS_TEST_SCRIPT_PATH, js_test_script_v1, strlen(js_test_script_v1)),
+        "failed to write script");
+
+    // Cache is not touched when disabled
+    mu_assert_int_eq(42, js_test_run(false));
+    mu_assert_int_eq(1, js_test_parse_cnt);
+    mu_assert(!storage_file_exists(storage, furi_string_get_cstr(cache_path)), "unexpected cache");
+
+    // First run compiles and stores, second one loads compiled bytecode
+    mu_assert_int_eq(42, js_test_run(true));
+    mu_assert_int_eq(1, js_test_parse_cnt);
+    mu_assert(storage_file_exists(storage, furi_string_get_cstr(cache_path)), "cache not stored");
+    mu_assert_int_eq(42, js_test_run(true));
+    mu_assert_int_eq(0, js_test_parse_cnt);
+
+    // Changed source invalidates cache entry
+    mu_assert(
+        js_test_write_file(JS_TEST_SCRIPT_PATH, js_test_script_v2, strlen(js_test_script_v2)),
+        "failed to write script");
+    mu_assert_int_eq(300, js_test_run(true));
+    mu_assert_int_eq(1, js_test_parse_cnt);
+    mu_assert_int_eq(300, js_test_run(true));
+    mu_assert_int_eq(0, js_test_parse_cnt);
+
+    // Corrupted cache entry is ignored and rewritten
+    const uint8_t garbage[] = {0xDE, 0xAD, 0xBE, 0xEF};
+    mu_assert(
+        js_test_write_file(furi_string_get_cstr(cache_path), garbage, sizeof(garbage)),
+        "failed to corrupt cache");
+    mu_assert_int_eq(300, js_test_run(true));
+    mu_assert_int_eq(1, js_test_parse_cnt);
+    mu_assert_int_eq(300, js_test_run(true));
+    mu_assert_int_eq(0, js_test_parse_cnt);
+}
+
+MU_TEST(js_string_interning_test) {
+    struct mjs* mjs = mjs_create(NULL);
+
+    mjs_val_t result = MJS_UNDEFINED;
+    mu_assert_int_eq(MJS_OK, mjs_exec(mjs, js_test_script_strings, &result));
+    mu_assert(mjs_is_number(result), "result is not a number");
+    mu_assert_int_eq(21152, mjs_get_int(mjs, result));
+
+    mjs_destroy(mjs);
+}
+
+MU_TEST_SUITE(js_suite) {
+    MU_SUITE_CONFIGURE(&js_test_setup, &js_test_teardown);
+    MU_RUN_TEST(js_bcode_cache_test);
+    MU_RUN_TEST(js_string_interning_test);
+}
+
+int run_minunit_test_js() {
+    MU_RUN_SUITE(js_suite);
+    return MU_EXIT_CODE;
+}
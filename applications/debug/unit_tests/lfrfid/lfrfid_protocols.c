@@ -3,9 +3,18 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/tools/raw_block.h>
+#include <lfrfid/tools/varint_pair.h>
+#include <storage/storage.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
+#define LF_RFID_RAW_TEST_PAIRS_PATH EXT_PATH("unit_tests/lfrfid_raw_pairs.raw")
+#define LF_RFID_RAW_TEST_BLOCKS_PATH EXT_PATH("unit_tests/lfrfid_raw_blocks.raw")
+#define LF_RFID_RAW_TEST_PAIRS_COUNT 1000
+#define LF_RFID_RAW_TEST_BUFFER_SIZE 2048
+
 #define EM_TEST_DATA \
     { 0x58, 0x00, 0x85, 0x64, 0x02 }
 #define EM_TEST_DATA_SIZE 5
@@ -531,6 +540,193 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+static void lfrfid_test_raw_generate(uint32_t* pulses, uint32_t* durations, size_t count) {
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0, pair = 0; pair < count; i++) {
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT] >= 0,
+            abs(em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT]) *
+                LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            pulse_glue_pop(pulse_glue, &durations[pair], &pulses[pair]);
+            // capture jitter
+            pulses[pair] += pair % 5;
+            pair++;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+}
+
+static bool lfrfid_test_raw_write_pairs(
+    LFRFIDRawFile* file,
+    const uint32_t* pulses,
+    const uint32_t* durations,
+    size_t count) {
+    if(!lfrfid_raw_file_write_header(file, 125000, 0.5f, LF_RFID_RAW_TEST_BUFFER_SIZE)) {
+        return false;
+    }
+
+    uint8_t* buffer = malloc(LF_RFID_RAW_TEST_BUFFER_SIZE);
+    VarintPair* pair = varint_pair_alloc();
+    size_t size = 0;
+    bool success = true;
+
+    for(size_t i = 0; i < count && success; i++) {
+        varint_pair_pack(pair, true, pulses[i]);
+        varint_pair_pack(pair, false, durations[i]);
+        if(size + varint_pair_get_size(pair) > LF_RFID_RAW_TEST_BUFFER_SIZE) {
+            success = lfrfid_raw_file_write_buffer(file, buffer, size);
+            size = 0;
+        }
+        memcpy(&buffer[size], varint_pair_get_data(pair), varint_pair_get_size(pair));
+        size += varint_pair_get_size(pair);
+        varint_pair_reset(pair);
+    }
+    if(success && size) {
+        success = lfrfid_raw_file_write_buffer(file, buffer, size);
+    }
+
+    varint_pair_free(pair);
+    free(buffer);
+    return success;
+}
+
+static bool lfrfid_test_raw_write_blocks(
+    LFRFIDRawFile* file,
+    const uint32_t* pulses,
+    const uint32_t* durations,
+    size_t count) {
+    if(!lfrfid_raw_file_write_blocks_header(file, 125000, 0.5f)) return false;
+
+    const size_t capacity = sizeof(RawBlockHeader) + RAW_BLOCK_PAYLOAD_MAX_SIZE;
+    uint8_t* buffer = malloc(capacity);
+    RawBlockEncoder encoder;
+    raw_block_encoder_start(&encoder, buffer, capacity, 1, 0);
+    bool success = true;
+
+    for(size_t i = 0; i < count && success; i++) {
+        if(!raw_block_encoder_push(&encoder, pulses[i], durations[i])) {
+            success = lfrfid_raw_file_write_blocks(
+                file, buffer, raw_block_encoder_finish(&encoder));
+            raw_block_encoder_start(&encoder, buffer, capacity, 1, 0);
+            furi_check(raw_block_encoder_push(&encoder, pulses[i], durations[i]));
+        }
+    }
+    if(success) {
+        success =
+            lfrfid_raw_file_write_blocks(file, buffer, raw_block_encoder_finish(&encoder));
+    }
+
+    free(buffer);
+    return success;
+}
+
+static ProtocolId lfrfid_test_raw_decode(
+    const uint32_t* pulses,
+    const uint32_t* durations,
+    size_t count,
+    uint8_t* data,
+    size_t data_size) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    protocol_dict_decoders_start(dict);
+
+    ProtocolId protocol = PROTOCOL_NO;
+    for(size_t i = 0; i < count && protocol == PROTOCOL_NO; i++) {
+        protocol = protocol_dict_decoders_feed(dict, true, pulses[i]);
+        if(protocol == PROTOCOL_NO) {
+            protocol = protocol_dict_decoders_feed(dict, false, durations[i] - pulses[i]);
+        }
+    }
+
+    if(protocol != PROTOCOL_NO) {
+        protocol_dict_get_data(dict, protocol, data, data_size);
+    }
+
+    protocol_dict_free(dict);
+    return protocol;
+}
+
+MU_TEST(test_lfrfid_raw_file_formats) {
+    const size_t count = LF_RFID_RAW_TEST_PAIRS_COUNT;
+    uint32_t* pulses = malloc(count * sizeof(uint32_t));
+    uint32_t* durations = malloc(count * sizeof(uint32_t));
+    uint32_t* read_pulses = malloc(count * sizeof(uint32_t));
+    uint32_t* read_durations = malloc(count * sizeof(uint32_t));
+    const uint8_t data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    uint8_t received_data[EM_TEST_DATA_SIZE] = {0};
+
+    lfrfid_test_raw_generate(pulses, durations, count);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+
+    mu_check(lfrfid_raw_file_open_write(file, LF_RFID_RAW_TEST_PAIRS_PATH));
+    mu_check(lfrfid_test_raw_write_pairs(file, pulses, durations, count));
+    lfrfid_raw_file_free(file);
+
+    file = lfrfid_raw_file_alloc(storage);
+    mu_check(lfrfid_raw_file_open_write(file, LF_RFID_RAW_TEST_BLOCKS_PATH));
+    mu_check(lfrfid_test_raw_write_blocks(file, pulses, durations, count));
+    lfrfid_raw_file_free(file);
+
+    const char* paths[] = {LF_RFID_RAW_TEST_PAIRS_PATH, LF_RFID_RAW_TEST_BLOCKS_PATH};
+    for(size_t format = 0; format < COUNT_OF(paths); format++) {
+        float frequency, duty_cycle;
+        bool pass_end = false;
+
+        file = lfrfid_raw_file_alloc(storage);
+        mu_check(lfrfid_raw_file_open_read(file, paths[format]));
+        mu_check(lfrfid_raw_file_read_header(file, &frequency, &duty_cycle));
+        mu_check(frequency == 125000);
+
+        // odd chunk size to cross buffer and block boundaries
+        for(size_t index = 0; index < count;) {
+            size_t chunk = MIN(count - index, 77U);
+            mu_assert_int_eq(
+                chunk,
+                lfrfid_raw_file_read_pairs(
+                    file, &read_durations[index], &read_pulses[index], chunk, &pass_end));
+            index += chunk;
+        }
+        mu_check(!pass_end);
+
+        for(size_t i = 0; i < count; i++) {
+            // blocks are quantized to 2us
+            uint32_t tolerance = format ? 1 : 0;
+            mu_check(MAX(read_pulses[i], pulses[i]) - MIN(read_pulses[i], pulses[i]) <= tolerance);
+            mu_check(
+                MAX(read_durations[i], durations[i]) - MIN(read_durations[i], durations[i]) <=
+                tolerance);
+        }
+
+        // capture is replayed from the start when the end is reached
+        uint32_t pulse, duration;
+        mu_check(lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end));
+        mu_check(pass_end);
+        mu_assert_int_eq(read_pulses[0], pulse);
+        lfrfid_raw_file_free(file);
+
+        mu_assert_int_eq(
+            LFRFIDProtocolEM4100,
+            lfrfid_test_raw_decode(
+                read_pulses, read_durations, count, received_data, EM_TEST_DATA_SIZE));
+        mu_assert_mem_eq(data, received_data, EM_TEST_DATA_SIZE);
+    }
+
+    storage_simply_remove(storage, LF_RFID_RAW_TEST_PAIRS_PATH);
+    storage_simply_remove(storage, LF_RFID_RAW_TEST_BLOCKS_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    free(read_durations);
+    free(read_pulses);
+    free(durations);
+    free(pulses);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -545,6 +741,8 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_raw_file_formats);
 }
 
 int run_minunit_test_lfrfid_protocols() {
@@ -6,22 +6,37 @@
 #include <nfc/helpers/nfc_data_generator.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
+#include <nfc/nfc_scanner.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_listener_i.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/protocols/mf_desfire/mf_desfire.h>
+#include <nfc/protocols/mf_desfire/mf_desfire_poller.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <nfc/protocols/mf_classic/mf_classic_listener.h>
 
 #include <toolbox/keys_dict.h>
 #include <nfc/nfc.h>
 
 #include "../minunit.h"
+#include "nfc_transport.h"
 
 #define TAG "NfcTest"
 
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
 
+#define NFC_TEST_DICT_ATTACK_DONE_EVENT (1UL << 0)
+#define NFC_TEST_DICT_ATTACK_KEYS_NUM (120)
+#define NFC_TEST_SCANNER_DONE_EVENT (1UL << 1)
+#define NFC_TEST_DESFIRE_DONE_EVENT (1UL << 2)
+#define NFC_TEST_DESFIRE_FAILED_EVENT (1UL << 3)
+
 typedef struct {
     Storage* storage;
 } NfcTest;
@@ -221,9 +236,24 @@ static void mf_ultralight_reader_test(const char* path) {
     nfc_listener_start(mfu_listener, NULL, NULL);
 
     MfUltralightData* mfu_data = mf_ultralight_alloc();
+    nfc_transport_stats_reset();
     MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data);
     mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
 
+    uint32_t frames = nfc_transport_stats_get_frames();
+    FURI_LOG_I(
+        TAG,
+        "%u pages read: %lu frames, %lu us airtime",
+        mfu_data->pages_total,
+        frames,
+        nfc_transport_stats_get_airtime_us());
+    if(mf_ultralight_support_feature(features, MfUltralightFeatureSupportFastRead)) {
+        // READ alone would need a frame per 4 pages, FAST_READ reads 63 pages per frame
+        mu_assert(
+            frames * 4 < mfu_data->pages_total || mfu_data->pages_total < 64,
+            "FAST_READ is not used");
+    }
+
     nfc_listener_stop(mfu_listener);
     nfc_listener_free(mfu_listener);
 
@@ -435,6 +465,588 @@ static void mf_classic_value_block() {
     nfc_free(poller);
 }
 
+typedef struct {
+    FuriThreadId thread_id;
+    const MfClassicData* data;
+    const MfClassicKey* keys;
+    size_t keys_num;
+    size_t key_idx;
+    uint32_t auth_attempts;
+} NfcTestDictAttack;
+
+static NfcCommand mf_classic_dict_attack_listener_callback(NfcGenericEvent event, void* context) {
+    NfcTestDictAttack* dict_attack = context;
+    MfClassicListenerEvent* mfc_event = event.event_data;
+
+    if(mfc_event->type == MfClassicListenerEventTypeAuthContextPartCollected) {
+        dict_attack->auth_attempts++;
+    }
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand mf_classic_dict_attack_poller_callback(NfcGenericEvent event, void* context) {
+    NfcTestDictAttack* dict_attack = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcCommand command = NfcCommandContinue;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttack;
+        mfc_event->data->poller_mode.data = dict_attack->data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        if(dict_attack->key_idx < dict_attack->keys_num) {
+            mfc_event->data->key_request_data.key = dict_attack->keys[dict_attack->key_idx++];
+            mfc_event->data->key_request_data.key_provided = true;
+        } else {
+            mfc_event->data->key_request_data.key_provided = false;
+        }
+    } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
+        dict_attack->key_idx = 0;
+    } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
+        furi_thread_flags_set(dict_attack->thread_id, NFC_TEST_DICT_ATTACK_DONE_EVENT);
+        command = NfcCommandStop;
+    }
+
+    return command;
+}
+
+static void mf_classic_dict_attack_set_sector(
+    MfClassicData* data,
+    uint8_t sector,
+    const MfClassicKey* key_a,
+    const MfClassicKey* key_b,
+    bool key_b_readable) {
+    // Key B readable with key A, or key B only known to the issuer
+    const MfClassicAccessBits access_bits_transport = {.data = {0xff, 0x07, 0x80, 0x69}};
+    const MfClassicAccessBits access_bits_issuer = {.data = {0x78, 0x77, 0x88, 0x69}};
+
+    MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, sector);
+    sec_tr->key_a = *key_a;
+    sec_tr->key_b = *key_b;
+    sec_tr->access_bits = key_b_readable ? access_bits_transport : access_bits_issuer;
+}
+
+static uint32_t mf_classic_dict_attack_run(
+    Nfc* poller,
+    Nfc* listener,
+    const MfClassicData* card,
+    NfcTestDictAttack* dict_attack,
+    MfClassicData* result) {
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, card);
+    nfc_listener_start(mfc_listener, mf_classic_dict_attack_listener_callback, dict_attack);
+
+    dict_attack->thread_id = furi_thread_get_current_id();
+    dict_attack->key_idx = 0;
+    dict_attack->auth_attempts = 0;
+    nfc_transport_stats_reset();
+    uint32_t start = furi_get_tick();
+
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+    nfc_poller_start(mfc_poller, mf_classic_dict_attack_poller_callback, dict_attack);
+    furi_thread_flags_wait(NFC_TEST_DICT_ATTACK_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_DICT_ATTACK_DONE_EVENT);
+    nfc_poller_stop(mfc_poller);
+
+    uint32_t duration = furi_get_tick() - start;
+    mf_classic_copy(result, nfc_poller_get_data(mfc_poller));
+    nfc_poller_free(mfc_poller);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    FURI_LOG_I(
+        TAG,
+        "Dict attack: %lu auths, %lu frames, %lu us airtime, %lu ms",
+        dict_attack->auth_attempts,
+        nfc_transport_stats_get_frames(),
+        nfc_transport_stats_get_airtime_us(),
+        duration);
+
+    return dict_attack->auth_attempts;
+}
+
+MU_TEST(mf_classic_dict_attack) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic4k_7b, nfc_device);
+    MfClassicData* card = mf_classic_alloc();
+    mf_classic_copy(card, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+
+    // Transit card layout: few issuer keys shared by most sectors, transport sectors
+    // and two sectors with keys out of dictionary
+    MfClassicKey keys[NFC_TEST_DICT_ATTACK_KEYS_NUM] = {};
+    for(size_t i = 0; i < COUNT_OF(keys); i++) {
+        furi_hal_random_fill_buf(keys[i].data, sizeof(MfClassicKey));
+    }
+    const MfClassicKey key_transport = {.data = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff}};
+    const MfClassicKey key_mad = {.data = {0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5}};
+    keys[0] = key_transport;
+    keys[1] = key_mad;
+    const MfClassicKey* key_issuer_a1 = &keys[40];
+    const MfClassicKey* key_issuer_b1 = &keys[70];
+    const MfClassicKey* key_issuer_a2 = &keys[95];
+    const MfClassicKey* key_issuer_b2 = &keys[110];
+
+    MfClassicKey key_unknown_a = {};
+    MfClassicKey key_unknown_b = {};
+    furi_hal_random_fill_buf(key_unknown_a.data, sizeof(MfClassicKey));
+    furi_hal_random_fill_buf(key_unknown_b.data, sizeof(MfClassicKey));
+
+    uint8_t sectors_total = mf_classic_get_total_sectors_num(card->type);
+    for(uint8_t i = 0; i < sectors_total; i++) {
+        if(i < 4) {
+            mf_classic_dict_attack_set_sector(card, i, &key_mad, key_issuer_b1, false);
+        } else if(i < 16) {
+            mf_classic_dict_attack_set_sector(card, i, key_issuer_a1, key_issuer_b1, false);
+        } else if(i < 32) {
+            mf_classic_dict_attack_set_sector(card, i, &key_transport, &key_transport, true);
+        } else if(i < 38) {
+            mf_classic_dict_attack_set_sector(card, i, key_issuer_a2, key_issuer_b2, false);
+        } else {
+            mf_classic_dict_attack_set_sector(card, i, &key_unknown_a, &key_unknown_b, false);
+        }
+    }
+
+    // Attack from scratch
+    MfClassicData* start = mf_classic_alloc();
+    mf_classic_copy(start, card);
+    start->key_a_mask = 0;
+    start->key_b_mask = 0;
+    memset(start->block_read_mask, 0, sizeof(start->block_read_mask));
+    memset(start->block, 0, sizeof(start->block));
+
+    NfcTestDictAttack dict_attack = {
+        .data = start,
+        .keys = keys,
+        .keys_num = COUNT_OF(keys),
+    };
+    MfClassicData* result = mf_classic_alloc();
+    uint32_t auths_full = mf_classic_dict_attack_run(poller, listener, card, &dict_attack, result);
+
+    const uint64_t keys_mask = (1ULL << 38) - 1;
+    mu_assert(result->key_a_mask == keys_mask, "Key A not found");
+    mu_assert(result->key_b_mask == keys_mask, "Key B not found");
+    for(uint8_t i = 0; i < 38; i++) {
+        mu_assert(mf_classic_is_sector_read(result, i), "Sector not read");
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(result, i);
+        MfClassicSectorTrailer* sec_tr_ref = mf_classic_get_sector_trailer_by_sector(card, i);
+        mu_assert(
+            memcmp(&sec_tr->key_a, &sec_tr_ref->key_a, sizeof(MfClassicKey)) == 0,
+            "Key A mismatch");
+        mu_assert(
+            memcmp(&sec_tr->key_b, &sec_tr_ref->key_b, sizeof(MfClassicKey)) == 0,
+            "Key B mismatch");
+    }
+    // Out of dictionary sectors take ~460 attempts and the rest of the card ~580 when every
+    // found key is reused across sectors. Rewinding dictionary after each reuse took ~1170.
+    mu_assert(auths_full < 1100, "Too many auth attempts");
+
+    // Attack with keys of two sectors known from cache, they are tried on all sectors first
+    mf_classic_copy(start, result);
+    start->key_a_mask = (1ULL << 4) | (1ULL << 32);
+    start->key_b_mask = 0;
+    memset(start->block_read_mask, 0, sizeof(start->block_read_mask));
+    uint32_t auths_cached =
+        mf_classic_dict_attack_run(poller, listener, card, &dict_attack, result);
+
+    mu_assert(result->key_a_mask == keys_mask, "Key A not found");
+    mu_assert(result->key_b_mask == keys_mask, "Key B not found");
+    mu_assert(auths_cached < auths_full, "Cached keys are not reused");
+
+    mf_classic_free(result);
+    mf_classic_free(start);
+    mf_classic_free(card);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+typedef struct {
+    FuriThreadId thread_id;
+    size_t protocols_num;
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcTestScanner;
+
+static void nfc_scanner_test_callback(NfcScannerEvent event, void* context) {
+    NfcTestScanner* scanner = context;
+
+    // Scanner keeps reporting the same result until stopped
+    if(event.type == NfcScannerEventTypeDetected && scanner->protocols_num == 0) {
+        memcpy(
+            scanner->protocols,
+            event.data.protocols,
+            event.data.protocol_num * sizeof(NfcProtocol));
+        scanner->protocols_num = event.data.protocol_num;
+        furi_thread_flags_set(scanner->thread_id, NFC_TEST_SCANNER_DONE_EVENT);
+    }
+}
+
+static void nfc_scanner_test(NfcProtocol protocol, const NfcDeviceData* data) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* nfc_listener = nfc_listener_alloc(listener, protocol, data);
+    nfc_listener_start(nfc_listener, NULL, NULL);
+
+    NfcTestScanner scanner_ctx = {.thread_id = furi_thread_get_current_id()};
+    nfc_transport_stats_reset();
+    uint32_t start = furi_get_tick();
+
+    NfcScanner* scanner = nfc_scanner_alloc(poller);
+    nfc_scanner_start(scanner, nfc_scanner_test_callback, &scanner_ctx);
+    furi_thread_flags_wait(NFC_TEST_SCANNER_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_SCANNER_DONE_EVENT);
+
+    uint32_t duration = furi_get_tick() - start;
+    uint32_t field_resets = nfc_transport_stats_get_field_resets();
+    FURI_LOG_I(
+        TAG,
+        "Scanner %s: %lu field resets, %lu frames, %lu us airtime, %lu ms",
+        nfc_device_get_protocol_name(protocol),
+        field_resets,
+        nfc_transport_stats_get_frames(),
+        nfc_transport_stats_get_airtime_us(),
+        duration);
+
+    nfc_scanner_stop(scanner);
+    nfc_scanner_free(scanner);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(scanner_ctx.protocols_num == 1, "Wrong number of detected protocols");
+    mu_assert(scanner_ctx.protocols[0] == protocol, "Wrong protocol detected");
+
+    // One field cycle per base protocol, ISO14443-3A children are classified by SAK
+    // and the remaining candidates share one more. Detecting every child separately
+    // took five field cycles for them.
+    size_t base_protocols_num = 0;
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        if(nfc_protocol_get_parent(i) == NfcProtocolInvalid) base_protocols_num++;
+    }
+    mu_assert(field_resets == base_protocols_num + 1, "Wrong number of field resets");
+}
+
+MU_TEST(nfc_scanner_mf_ultralight) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG215, nfc_device);
+    nfc_scanner_test(
+        NfcProtocolMfUltralight, nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_device_free(nfc_device);
+}
+
+MU_TEST(nfc_scanner_mf_classic) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+    nfc_scanner_test(NfcProtocolMfClassic, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    nfc_device_free(nfc_device);
+}
+
+MU_TEST(nfc_scanner_iso14443_4a) {
+    const uint8_t uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+    const uint8_t atqa[] = {0x44, 0x03};
+
+    Iso14443_4aData* data = iso14443_4a_alloc();
+    Iso14443_3aData* iso14443_3a_data = iso14443_4a_get_base_data(data);
+    iso14443_3a_set_uid(iso14443_3a_data, uid, sizeof(uid));
+    iso14443_3a_set_atqa(iso14443_3a_data, atqa);
+    iso14443_3a_set_sak(iso14443_3a_data, 0x20);
+    data->ats_data.tl = 5;
+    data->ats_data.t0 = 0x75;
+    data->ats_data.ta_1 = 0x77;
+    data->ats_data.tb_1 = 0x81;
+    data->ats_data.tc_1 = 0x02;
+
+    // Listener does not answer DESFire and EMV probes
+    nfc_scanner_test(NfcProtocolIso14443_4a, data);
+    iso14443_4a_free(data);
+}
+
+#define NFC_TEST_DESFIRE_STATUS_OK (0x00)
+#define NFC_TEST_DESFIRE_STATUS_BOUNDARY_ERROR (0xBE)
+#define NFC_TEST_DESFIRE_FILE_NUM (3)
+#define NFC_TEST_DESFIRE_RECORD_SIZE (32U)
+
+typedef struct {
+    MfDesfireFileId id;
+    MfDesfireFileType type;
+    uint32_t size; // Bytes of data files, records of record files
+    uint8_t* data;
+} NfcTestDesfireFile;
+
+// Card with one plaintext application, responses are chained in frames of FSC size
+typedef struct {
+    FuriThreadId thread_id;
+    MfDesfireApplicationId app_id;
+    NfcTestDesfireFile files[NFC_TEST_DESFIRE_FILE_NUM];
+    BitBuffer* response;
+    size_t response_offset;
+    size_t frame_data_size;
+    BitBuffer* tx_buffer;
+    size_t heap_free_start;
+    size_t heap_free_min;
+} NfcTestDesfireCard;
+
+static size_t nfc_test_desfire_file_bytes(const NfcTestDesfireFile* file) {
+    const bool is_record = file->type == MfDesfireFileTypeLinearRecord ||
+                           file->type == MfDesfireFileTypeCyclicRecord;
+    return is_record ? file->size * NFC_TEST_DESFIRE_RECORD_SIZE : file->size;
+}
+
+static uint32_t nfc_test_desfire_get_u24(const BitBuffer* buf, size_t index) {
+    return bit_buffer_get_byte(buf, index) | (bit_buffer_get_byte(buf, index + 1) << 8) |
+           (bit_buffer_get_byte(buf, index + 2) << 16);
+}
+
+static void nfc_test_desfire_append_u24(BitBuffer* buf, uint32_t value) {
+    bit_buffer_append_bytes(buf, (const uint8_t*)&value, 3);
+}
+
+static const NfcTestDesfireFile*
+    nfc_test_desfire_find_file(const NfcTestDesfireCard* card, MfDesfireFileId id) {
+    for(size_t i = 0; i < NFC_TEST_DESFIRE_FILE_NUM; i++) {
+        if(card->files[i].id == id) return &card->files[i];
+    }
+    return NULL;
+}
+
+// Fills response with command result, returns status
+static uint8_t nfc_test_desfire_process(NfcTestDesfireCard* card, const BitBuffer* rx) {
+    const uint8_t cmd = bit_buffer_get_byte(rx, 1);
+    BitBuffer* response = card->response;
+    uint8_t status = NFC_TEST_DESFIRE_STATUS_OK;
+
+    if(cmd == MF_DESFIRE_CMD_GET_VERSION) {
+        const uint8_t version[sizeof(MfDesfireVersion)] = {
+            0x04, 0x01, 0x01, 0x01, 0x00, 0x1A, 0x05, 0x04, 0x01, 0x01,
+            0x01, 0x04, 0x1A, 0x05, 0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73,
+            0x81, 0xBA, 0x44, 0x95, 0x50, 0x70, 0x12, 0x20};
+        bit_buffer_append_bytes(response, version, sizeof(version));
+    } else if(cmd == MF_DESFIRE_CMD_GET_FREE_MEMORY) {
+        nfc_test_desfire_append_u24(response, 0x400);
+    } else if(cmd == MF_DESFIRE_CMD_GET_KEY_SETTINGS) {
+        // Everything changeable and free, one key
+        bit_buffer_append_byte(response, 0x0F);
+        bit_buffer_append_byte(response, 0x01);
+    } else if(cmd == MF_DESFIRE_CMD_GET_KEY_VERSION) {
+        bit_buffer_append_byte(response, 0x00);
+    } else if(cmd == MF_DESFIRE_CMD_GET_APPLICATION_IDS) {
+        bit_buffer_append_bytes(response, card->app_id.data, sizeof(MfDesfireApplicationId));
+    } else if(cmd == MF_DESFIRE_CMD_GET_FILE_IDS) {
+        for(size_t i = 0; i < NFC_TEST_DESFIRE_FILE_NUM; i++) {
+            bit_buffer_append_byte(response, card->files[i].id);
+        }
+    } else if(cmd == MF_DESFIRE_CMD_GET_FILE_SETTINGS) {
+        const NfcTestDesfireFile* file =
+            nfc_test_desfire_find_file(card, bit_buffer_get_byte(rx, 2));
+        furi_check(file);
+        // Plaintext, free access
+        bit_buffer_append_byte(response, file->type);
+        bit_buffer_append_byte(response, MfDesfireFileCommunicationSettingsPlaintext);
+        bit_buffer_append_byte(response, 0xEE);
+        bit_buffer_append_byte(response, 0xEE);
+        if(file->type == MfDesfireFileTypeLinearRecord) {
+            nfc_test_desfire_append_u24(response, NFC_TEST_DESFIRE_RECORD_SIZE);
+            nfc_test_desfire_append_u24(response, file->size);
+        }
+        nfc_test_desfire_append_u24(response, file->size);
+    } else if(cmd == MF_DESFIRE_CMD_READ_DATA || cmd == MF_DESFIRE_CMD_READ_RECORDS) {
+        const NfcTestDesfireFile* file =
+            nfc_test_desfire_find_file(card, bit_buffer_get_byte(rx, 2));
+        furi_check(file);
+        const size_t unit_size =
+            cmd == MF_DESFIRE_CMD_READ_RECORDS ? NFC_TEST_DESFIRE_RECORD_SIZE : 1;
+        const uint32_t offset = nfc_test_desfire_get_u24(rx, 3);
+        uint32_t length = nfc_test_desfire_get_u24(rx, 6);
+        if(length == 0 && offset < file->size) length = file->size - offset;
+
+        if(offset + length > file->size) {
+            status = NFC_TEST_DESFIRE_STATUS_BOUNDARY_ERROR;
+        } else {
+            // Records are stored oldest first, offset counts back from the newest one
+            const uint32_t start = cmd == MF_DESFIRE_CMD_READ_RECORDS ?
+                                       file->size - offset - length :
+                                       offset;
+            bit_buffer_append_bytes(response, &file->data[start * unit_size], length * unit_size);
+        }
+    }
+    // Application selection succeeds without data
+
+    return status;
+}
+
+static NfcCommand nfc_test_desfire_card_callback(NfcGenericEvent event, void* context) {
+    NfcTestDesfireCard* card = context;
+    Iso14443_4aListener* iso14443_4a_listener = event.instance;
+    Iso14443_4aListenerEvent* iso14443_4a_event = event.event_data;
+
+    do {
+        if(iso14443_4a_event->type != Iso14443_4aListenerEventTypeReceivedData) break;
+
+        const BitBuffer* rx = iso14443_4a_event->data->buffer;
+        if(bit_buffer_get_size_bytes(rx) < 2) break;
+
+        // Data allocated by the poller while reading, sampled on every command
+        const size_t heap_free = memmgr_get_free_heap();
+        if(card->heap_free_start == 0) {
+            card->heap_free_start = heap_free;
+            card->heap_free_min = heap_free;
+        }
+        card->heap_free_min = MIN(card->heap_free_min, heap_free);
+
+        uint8_t status = NFC_TEST_DESFIRE_STATUS_OK;
+        if(bit_buffer_get_byte(rx, 1) != MF_DESFIRE_FLAG_HAS_NEXT) {
+            bit_buffer_reset(card->response);
+            card->response_offset = 0;
+            status = nfc_test_desfire_process(card, rx);
+        }
+
+        const size_t remaining = bit_buffer_get_size_bytes(card->response) - card->response_offset;
+        const size_t frame_data_size = MIN(remaining, card->frame_data_size);
+        if(frame_data_size < remaining) status = MF_DESFIRE_FLAG_HAS_NEXT;
+
+        // I-block with the block number of the request
+        bit_buffer_reset(card->tx_buffer);
+        bit_buffer_append_byte(card->tx_buffer, bit_buffer_get_byte(rx, 0));
+        bit_buffer_append_byte(card->tx_buffer, status);
+        for(size_t i = 0; i < frame_data_size; i++) {
+            bit_buffer_append_byte(
+                card->tx_buffer, bit_buffer_get_byte(card->response, card->response_offset++));
+        }
+
+        iso14443_3a_listener_send_standard_frame(
+            iso14443_4a_listener->iso14443_3a_listener, card->tx_buffer);
+    } while(false);
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand nfc_test_desfire_poller_callback(NfcGenericEvent event, void* context) {
+    NfcTestDesfireCard* card = context;
+    const MfDesfirePollerEvent* mf_desfire_event = event.event_data;
+
+    if(mf_desfire_event->type == MfDesfirePollerEventTypeReadSuccess) {
+        furi_thread_flags_set(card->thread_id, NFC_TEST_DESFIRE_DONE_EVENT);
+    } else {
+        furi_thread_flags_set(card->thread_id, NFC_TEST_DESFIRE_FAILED_EVENT);
+    }
+
+    return NfcCommandStop;
+}
+
+MU_TEST(mf_desfire_reader) {
+    const uint8_t uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+    const uint8_t atqa[] = {0x44, 0x03};
+
+    Iso14443_4aData* iso14443_4a_data = iso14443_4a_alloc();
+    Iso14443_3aData* iso14443_3a_data = iso14443_4a_get_base_data(iso14443_4a_data);
+    iso14443_3a_set_uid(iso14443_3a_data, uid, sizeof(uid));
+    iso14443_3a_set_atqa(iso14443_3a_data, atqa);
+    iso14443_3a_set_sak(iso14443_3a_data, 0x20);
+    iso14443_4a_data->ats_data.tl = 5;
+    iso14443_4a_data->ats_data.t0 = 0x75;
+    iso14443_4a_data->ats_data.ta_1 = 0x77;
+    iso14443_4a_data->ats_data.tb_1 = 0x81;
+    iso14443_4a_data->ats_data.tc_1 = 0x02;
+
+    // Files larger than the poller result buffer, sizes not aligned to frames
+    NfcTestDesfireCard card = {
+        .thread_id = furi_thread_get_current_id(),
+        .app_id = {.data = {0x12, 0x34, 0x56}},
+        .files =
+            {
+                {.id = 0x01, .type = MfDesfireFileTypeStandard, .size = 4096},
+                {.id = 0x02, .type = MfDesfireFileTypeBackup, .size = 2501},
+                {.id = 0x03, .type = MfDesfireFileTypeLinearRecord, .size = 97},
+            },
+        .frame_data_size = iso14443_4a_get_frame_size_max(iso14443_4a_data) - 4,
+    };
+
+    size_t file_bytes_max = 0;
+    size_t file_bytes_total = 0;
+    for(size_t i = 0; i < NFC_TEST_DESFIRE_FILE_NUM; i++) {
+        const size_t file_bytes = nfc_test_desfire_file_bytes(&card.files[i]);
+        card.files[i].data = malloc(file_bytes);
+        for(size_t j = 0; j < file_bytes; j++) {
+            card.files[i].data[j] = (j * 7 + i) & 0xFF;
+        }
+        file_bytes_max = MAX(file_bytes_max, file_bytes);
+        file_bytes_total += file_bytes;
+    }
+    card.response = bit_buffer_alloc(file_bytes_max);
+    card.tx_buffer = bit_buffer_alloc(card.frame_data_size + 2);
+
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* iso14443_4a_listener =
+        nfc_listener_alloc(listener, NfcProtocolIso14443_4a, iso14443_4a_data);
+    nfc_listener_start(iso14443_4a_listener, nfc_test_desfire_card_callback, &card);
+
+    nfc_transport_stats_reset();
+    uint32_t start = furi_get_tick();
+
+    NfcPoller* mf_desfire_poller = nfc_poller_alloc(poller, NfcProtocolMfDesfire);
+    nfc_poller_start(mf_desfire_poller, nfc_test_desfire_poller_callback, &card);
+    uint32_t flags = furi_thread_flags_wait(
+        NFC_TEST_DESFIRE_DONE_EVENT | NFC_TEST_DESFIRE_FAILED_EVENT,
+        FuriFlagWaitAny,
+        FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_DESFIRE_DONE_EVENT | NFC_TEST_DESFIRE_FAILED_EVENT);
+    nfc_poller_stop(mf_desfire_poller);
+
+    uint32_t duration = furi_get_tick() - start;
+    uint32_t frames = nfc_transport_stats_get_frames();
+    size_t heap_peak = card.heap_free_start - card.heap_free_min;
+    FURI_LOG_I(
+        TAG,
+        "DESFire %zu file bytes: %lu frames, %lu us airtime, %zu bytes heap peak, %lu ms",
+        file_bytes_total,
+        frames,
+        nfc_transport_stats_get_airtime_us(),
+        heap_peak,
+        duration);
+
+    MfDesfireData* mf_desfire_data = mf_desfire_alloc();
+    mf_desfire_copy(mf_desfire_data, nfc_poller_get_data(mf_desfire_poller));
+    nfc_poller_free(mf_desfire_poller);
+
+    nfc_listener_stop(iso14443_4a_listener);
+    nfc_listener_free(iso14443_4a_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(flags & NFC_TEST_DESFIRE_DONE_EVENT, "DESFire read failed");
+
+    const MfDesfireApplication* app = mf_desfire_get_application(mf_desfire_data, &card.app_id);
+    mu_assert(app, "Application not read");
+    for(size_t i = 0; i < NFC_TEST_DESFIRE_FILE_NUM; i++) {
+        const MfDesfireFileData* file_data = mf_desfire_get_file_data(app, &card.files[i].id);
+        const size_t file_bytes = nfc_test_desfire_file_bytes(&card.files[i]);
+        mu_assert(file_data, "File not read");
+        mu_assert_int_eq(file_bytes, simple_array_get_count(file_data->data));
+        mu_assert_mem_eq(
+            card.files[i].data, simple_array_cget_data(file_data->data), file_bytes);
+    }
+
+    // Read data lands in its place, no staging buffer of the file size
+    mu_assert(heap_peak < file_bytes_total * 2, "File data is buffered");
+    // Command and response frame per FSC worth of data, and a few to set up
+    mu_assert(frames < file_bytes_total / card.frame_data_size * 3, "Too many frames");
+
+    mf_desfire_free(mf_desfire_data);
+    for(size_t i = 0; i < NFC_TEST_DESFIRE_FILE_NUM; i++) {
+        free(card.files[i].data);
+    }
+    bit_buffer_free(card.response);
+    bit_buffer_free(card.tx_buffer);
+    iso14443_4a_free(iso14443_4a_data);
+}
+
 MU_TEST(mf_classic_dict_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
@@ -542,6 +1154,13 @@ MU_TEST_SUITE(nfc) {
 
     MU_RUN_TEST(mf_classic_write);
     MU_RUN_TEST(mf_classic_value_block);
+    MU_RUN_TEST(mf_classic_dict_attack);
+
+    MU_RUN_TEST(nfc_scanner_mf_ultralight);
+    MU_RUN_TEST(nfc_scanner_mf_classic);
+    MU_RUN_TEST(nfc_scanner_iso14443_4a);
+
+    MU_RUN_TEST(mf_desfire_reader);
 
     MU_RUN_TEST(mf_classic_dict_test);
 
@@ -6,8 +6,16 @@
 
 #include <furi/furi.h>
 
+#include "nfc_transport.h"
+
 #define NFC_MAX_BUFFER_SIZE (256)
 
+// ISO14443-3A 106 kbit/s timings, used for airtime estimation
+#define NFC_TRANSPORT_FC_PER_BIT (128U)
+#define NFC_TRANSPORT_FC_PER_US_X100 (1356U)
+#define NFC_TRANSPORT_FDT_LISTEN_FC (1172U)
+#define NFC_TRANSPORT_SOF_EOF_BITS (2U)
+
 typedef enum {
     NfcTransportLogLevelWarning,
     NfcTransportLogLevelInfo,
@@ -16,6 +24,14 @@ typedef enum {
 FuriMessageQueue* poller_queue = NULL;
 FuriMessageQueue* listener_queue = NULL;
 
+typedef struct {
+    uint32_t field_resets;
+    uint32_t frames;
+    uint64_t airtime_fc;
+} NfcTransportStats;
+
+static NfcTransportStats nfc_transport_stats = {};
+
 typedef enum {
     NfcMessageTypeTx,
     NfcMessageTypeTimeout,
@@ -60,6 +76,7 @@ struct Nfc {
     void* context;
 
     NfcMode mode;
+    uint32_t fdt_poll_poll_us;
 
     FuriThread* worker_thread;
 };
@@ -150,8 +167,7 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
 }
 
 void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us) {
-    UNUSED(instance);
-    UNUSED(fdt_poll_poll_us);
+    instance->fdt_poll_poll_us = fdt_poll_poll_us;
 }
 
 void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us) {
@@ -174,6 +190,28 @@ NfcError nfc_iso14443a_listener_set_col_res_data(
     return NfcErrorNone;
 }
 
+static uint32_t nfc_transport_frame_fc(uint16_t data_bits) {
+    // Every full byte is followed by parity bit
+    uint32_t bits = data_bits + data_bits / 8 + NFC_TRANSPORT_SOF_EOF_BITS;
+    return bits * NFC_TRANSPORT_FC_PER_BIT;
+}
+
+void nfc_transport_stats_reset(void) {
+    memset(&nfc_transport_stats, 0, sizeof(nfc_transport_stats));
+}
+
+uint32_t nfc_transport_stats_get_field_resets(void) {
+    return nfc_transport_stats.field_resets;
+}
+
+uint32_t nfc_transport_stats_get_frames(void) {
+    return nfc_transport_stats.frames;
+}
+
+uint32_t nfc_transport_stats_get_airtime_us(void) {
+    return nfc_transport_stats.airtime_fc * 100 / NFC_TRANSPORT_FC_PER_US_X100;
+}
+
 static int32_t nfc_worker_poller(void* context) {
     Nfc* instance = context;
     furi_check(instance->callback);
@@ -187,6 +225,8 @@ static int32_t nfc_worker_poller(void* context) {
         command = instance->callback(event, instance->context);
         if(command == NfcCommandStop) {
             break;
+        } else if(command == NfcCommandReset) {
+            nfc_transport_stats.field_resets++;
         }
     }
 
@@ -315,6 +355,8 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
         listener_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
     } else {
         poller_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
+        // Every poller start turns the field on
+        nfc_transport_stats.field_resets++;
     }
 
     instance->worker_thread = furi_thread_alloc();
@@ -387,7 +429,6 @@ NfcError
     furi_check(rx_buffer);
     furi_check(poller_queue);
     furi_check(listener_queue);
-    UNUSED(fwt);
 
     NfcError error = NfcErrorNone;
 
@@ -395,6 +436,11 @@ NfcError
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
+
+    nfc_transport_stats.frames++;
+    nfc_transport_stats.airtime_fc += nfc_transport_frame_fc(message.data.data_bits) +
+                                      instance->fdt_poll_poll_us *
+                                          NFC_TRANSPORT_FC_PER_US_X100 / 100;
     // Tx
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
     // Rx
@@ -403,6 +449,8 @@ NfcError
     if(status == FuriStatusErrorTimeout) {
         error = NfcErrorTimeout;
     } else if(message.type == NfcMessageTypeTx) {
+        nfc_transport_stats.airtime_fc +=
+            NFC_TRANSPORT_FDT_LISTEN_FC + nfc_transport_frame_fc(message.data.data_bits);
         bit_buffer_copy_bits(rx_buffer, message.data.data, message.data.data_bits);
         nfc_test_print(
             NfcTransportLogLevelWarning, "TAG", message.data.data, message.data.data_bits);
@@ -410,6 +458,10 @@ NfcError
         error = NfcErrorTimeout;
     }
 
+    if(error == NfcErrorTimeout) {
+        nfc_transport_stats.airtime_fc += fwt;
+    }
+
     return error;
 }
 
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Frame statistics of the unit test NFC transport */
+
+/** Clear all counters */
+void nfc_transport_stats_reset(void);
+
+/** Number of times field was turned on: poller starts and resets */
+uint32_t nfc_transport_stats_get_field_resets(void);
+
+/** Number of frames exchanged between poller and listener */
+uint32_t nfc_transport_stats_get_frames(void);
+
+/** Estimated ISO14443-3A 106 kbit/s air time of exchanged frames, microseconds */
+uint32_t nfc_transport_stats_get_airtime_us(void);
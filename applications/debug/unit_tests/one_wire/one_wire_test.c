@@ -0,0 +1,573 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#include <one_wire/one_wire_host.h>
+#include <one_wire/maxim_crc.h>
+
+/*
+ * Virtual 1-Wire bus with virtual slaves, plugged into OneWireHost as a bus backend.
+ * Slaves follow the ROM and memory command state machine of a DS1996 class device and
+ * check every reset pulse and time slot against the datasheet limits of their speed.
+ */
+
+#define ONE_WIRE_TEST_SLAVES_MAX (4U)
+#define ONE_WIRE_TEST_ROM_SIZE (8U)
+#define ONE_WIRE_TEST_MEMORY_SIZE (32U)
+
+#define ONE_WIRE_TEST_CMD_READ_ROM 0x33U
+#define ONE_WIRE_TEST_CMD_SKIP_ROM 0xCCU
+#define ONE_WIRE_TEST_CMD_SEARCH_ROM 0xF0U
+#define ONE_WIRE_TEST_CMD_OVERDRIVE_SKIP_ROM 0x3CU
+#define ONE_WIRE_TEST_CMD_READ_MEM 0xF0U
+
+typedef struct {
+    uint16_t low_1_max; /* write 1 and read slot low time */
+    uint16_t low_0_min; /* write 0 slot low time */
+    uint16_t low_0_max;
+    uint16_t sample_max; /* read data valid time */
+    uint16_t slot_min; /* slot and recovery time */
+    uint16_t reset_min; /* reset low time */
+    uint16_t reset_max;
+    uint16_t presence_min; /* presence guaranteed low after release */
+    uint16_t presence_max;
+} OneWireTestLimits;
+
+static const OneWireTestLimits one_wire_test_limits_standard = {
+    .low_1_max = 15,
+    .low_0_min = 60,
+    .low_0_max = 120,
+    .sample_max = 30, /* 15 guaranteed, real devices hold the line twice as long */
+    .slot_min = 61,
+    .reset_min = 480,
+    .reset_max = 960,
+    .presence_min = 60,
+    .presence_max = 75,
+};
+
+static const OneWireTestLimits one_wire_test_limits_overdrive = {
+    .low_1_max = 2,
+    .low_0_min = 6,
+    .low_0_max = 16,
+    .sample_max = 2,
+    .slot_min = 7,
+    .reset_min = 48,
+    .reset_max = 80,
+    .presence_min = 6,
+    .presence_max = 10,
+};
+
+typedef enum {
+    OneWireTestSlaveStateIdle, /* waits for a reset pulse */
+    OneWireTestSlaveStateRomCommand,
+    OneWireTestSlaveStateSearchBit,
+    OneWireTestSlaveStateSearchComplement,
+    OneWireTestSlaveStateSearchDirection,
+    OneWireTestSlaveStateFunctionCommand,
+    OneWireTestSlaveStateReadMemAddress,
+    OneWireTestSlaveStateSend,
+} OneWireTestSlaveState;
+
+typedef struct {
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    bool overdrive_capable;
+    uint8_t memory[ONE_WIRE_TEST_MEMORY_SIZE];
+
+    bool overdrive;
+    OneWireTestSlaveState state;
+    uint8_t rx_byte;
+    size_t rx_bit;
+    size_t address;
+    size_t address_bytes;
+    size_t search_bit;
+    const uint8_t* tx_data;
+    size_t tx_bit_count;
+    size_t tx_bit;
+    OneWireTestSlaveState tx_next_state;
+} OneWireTestSlave;
+
+typedef struct {
+    OneWireTestSlave slaves[ONE_WIRE_TEST_SLAVES_MAX];
+    size_t slave_count;
+    bool started;
+    size_t resets;
+    size_t exchanges;
+    size_t slots;
+    size_t timing_errors;
+} OneWireTestBus;
+
+static inline const OneWireTestLimits* one_wire_test_slave_limits(const OneWireTestSlave* slave) {
+    return slave->overdrive ? &one_wire_test_limits_overdrive : &one_wire_test_limits_standard;
+}
+
+static inline bool one_wire_test_bit(const uint8_t* data, size_t bit) {
+    return data[bit / 8] & (1U << (bit % 8));
+}
+
+static void one_wire_test_slave_send(
+    OneWireTestSlave* slave,
+    const uint8_t* data,
+    size_t size,
+    OneWireTestSlaveState next_state) {
+    slave->state = OneWireTestSlaveStateSend;
+    slave->tx_data = data;
+    slave->tx_bit_count = size * 8;
+    slave->tx_bit = 0;
+    slave->tx_next_state = next_state;
+}
+
+static void one_wire_test_slave_rom_command(OneWireTestSlave* slave, uint8_t command) {
+    switch(command) {
+    case ONE_WIRE_TEST_CMD_READ_ROM:
+        one_wire_test_slave_send(
+            slave, slave->rom, ONE_WIRE_TEST_ROM_SIZE, OneWireTestSlaveStateFunctionCommand);
+        break;
+    case ONE_WIRE_TEST_CMD_SEARCH_ROM:
+        slave->state = OneWireTestSlaveStateSearchBit;
+        slave->search_bit = 0;
+        break;
+    case ONE_WIRE_TEST_CMD_SKIP_ROM:
+        slave->state = OneWireTestSlaveStateFunctionCommand;
+        break;
+    case ONE_WIRE_TEST_CMD_OVERDRIVE_SKIP_ROM:
+        // Devices without overdrive do not know the command
+        slave->overdrive = slave->overdrive_capable;
+        slave->state = slave->overdrive_capable ? OneWireTestSlaveStateFunctionCommand :
+                                                  OneWireTestSlaveStateIdle;
+        break;
+    default:
+        slave->state = OneWireTestSlaveStateIdle;
+        break;
+    }
+}
+
+static void one_wire_test_slave_byte(OneWireTestSlave* slave, uint8_t value) {
+    if(slave->state == OneWireTestSlaveStateRomCommand) {
+        one_wire_test_slave_rom_command(slave, value);
+    } else if(slave->state == OneWireTestSlaveStateFunctionCommand) {
+        if(value == ONE_WIRE_TEST_CMD_READ_MEM) {
+            slave->state = OneWireTestSlaveStateReadMemAddress;
+            slave->address = 0;
+            slave->address_bytes = 0;
+        } else {
+            slave->state = OneWireTestSlaveStateIdle;
+        }
+    } else if(slave->state == OneWireTestSlaveStateReadMemAddress) {
+        slave->address |= value << (8 * slave->address_bytes++);
+        if(slave->address_bytes == 2) {
+            if(slave->address < ONE_WIRE_TEST_MEMORY_SIZE) {
+                one_wire_test_slave_send(
+                    slave,
+                    &slave->memory[slave->address],
+                    ONE_WIRE_TEST_MEMORY_SIZE - slave->address,
+                    OneWireTestSlaveStateIdle);
+            } else {
+                slave->state = OneWireTestSlaveStateIdle;
+            }
+        }
+    }
+}
+
+/* Level the slave leaves on the line in a read slot */
+static bool one_wire_test_slave_output(const OneWireTestSlave* slave) {
+    switch(slave->state) {
+    case OneWireTestSlaveStateSearchBit:
+        return one_wire_test_bit(slave->rom, slave->search_bit);
+    case OneWireTestSlaveStateSearchComplement:
+        return !one_wire_test_bit(slave->rom, slave->search_bit);
+    case OneWireTestSlaveStateSend:
+        return one_wire_test_bit(slave->tx_data, slave->tx_bit);
+    default:
+        return true;
+    }
+}
+
+/* Bit the slave sees in a slot once it is over */
+static void one_wire_test_slave_slot(OneWireTestSlave* slave, bool value) {
+    switch(slave->state) {
+    case OneWireTestSlaveStateSearchBit:
+        slave->state = OneWireTestSlaveStateSearchComplement;
+        break;
+    case OneWireTestSlaveStateSearchComplement:
+        slave->state = OneWireTestSlaveStateSearchDirection;
+        break;
+    case OneWireTestSlaveStateSearchDirection:
+        if(value != one_wire_test_bit(slave->rom, slave->search_bit)) {
+            slave->state = OneWireTestSlaveStateIdle;
+        } else if(++slave->search_bit == ONE_WIRE_TEST_ROM_SIZE * 8) {
+            slave->state = OneWireTestSlaveStateFunctionCommand;
+        } else {
+            slave->state = OneWireTestSlaveStateSearchBit;
+        }
+        break;
+    case OneWireTestSlaveStateSend:
+        if(++slave->tx_bit == slave->tx_bit_count) slave->state = slave->tx_next_state;
+        break;
+    case OneWireTestSlaveStateRomCommand:
+    case OneWireTestSlaveStateFunctionCommand:
+    case OneWireTestSlaveStateReadMemAddress:
+        if(value) slave->rx_byte |= 1U << slave->rx_bit;
+        if(++slave->rx_bit == 8) {
+            const uint8_t rx_byte = slave->rx_byte;
+            slave->rx_byte = 0;
+            slave->rx_bit = 0;
+            one_wire_test_slave_byte(slave, rx_byte);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static bool one_wire_test_slot_is_valid(
+    const OneWireTestLimits* limits,
+    const OneWireHostTimings* timings,
+    bool value) {
+    if(value) {
+        return timings->a >= 1 && timings->a <= limits->low_1_max &&
+               timings->a + timings->e <= limits->sample_max &&
+               timings->a + timings->e + timings->f >= limits->slot_min &&
+               timings->a + timings->b >= limits->slot_min;
+    } else {
+        return timings->c >= limits->low_0_min && timings->c <= limits->low_0_max &&
+               timings->c + timings->d >= limits->slot_min;
+    }
+}
+
+static void one_wire_test_bus_start(void* context) {
+    OneWireTestBus* bus = context;
+    bus->started = true;
+}
+
+static void one_wire_test_bus_stop(void* context) {
+    OneWireTestBus* bus = context;
+    bus->started = false;
+}
+
+static bool one_wire_test_bus_reset(void* context, const OneWireHostTimings* timings) {
+    OneWireTestBus* bus = context;
+    bool presence = false;
+
+    if(!bus->started) return false;
+    bus->resets++;
+
+    for(size_t i = 0; i < bus->slave_count; i++) {
+        OneWireTestSlave* slave = &bus->slaves[i];
+        const OneWireTestLimits* limits = NULL;
+
+        // A standard speed reset brings every device back to standard speed
+        if(timings->h >= one_wire_test_limits_standard.reset_min &&
+           timings->h <= one_wire_test_limits_standard.reset_max) {
+            slave->overdrive = false;
+            limits = &one_wire_test_limits_standard;
+        } else if(
+            slave->overdrive && timings->h >= one_wire_test_limits_overdrive.reset_min &&
+            timings->h <= one_wire_test_limits_overdrive.reset_max) {
+            limits = &one_wire_test_limits_overdrive;
+        }
+
+        slave->rx_byte = 0;
+        slave->rx_bit = 0;
+
+        if(!limits) {
+            slave->state = OneWireTestSlaveStateIdle;
+            continue;
+        }
+
+        slave->state = OneWireTestSlaveStateRomCommand;
+        if(timings->i >= limits->presence_min && timings->i <= limits->presence_max) {
+            presence = true;
+        } else {
+            bus->timing_errors++;
+        }
+    }
+
+    return presence;
+}
+
+static void one_wire_test_bus_exchange(
+    void* context,
+    const OneWireHostTimings* timings,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    OneWireTestBus* bus = context;
+
+    furi_check(bus->started);
+    bus->exchanges++;
+
+    for(size_t bit = 0; bit < bit_count; bit++) {
+        const bool value = tx ? one_wire_test_bit(tx, bit) : true;
+        bool line = value;
+
+        bus->slots++;
+
+        for(size_t i = 0; i < bus->slave_count; i++) {
+            OneWireTestSlave* slave = &bus->slaves[i];
+            if(slave->state == OneWireTestSlaveStateIdle) continue;
+
+            if(!one_wire_test_slot_is_valid(one_wire_test_slave_limits(slave), timings, value)) {
+                // Slave loses track of the slot and waits for the next reset
+                bus->timing_errors++;
+                slave->state = OneWireTestSlaveStateIdle;
+                continue;
+            }
+
+            // Wired AND, any slave may pull the line low in a read slot
+            if(value && !one_wire_test_slave_output(slave)) line = false;
+        }
+
+        for(size_t i = 0; i < bus->slave_count; i++) {
+            OneWireTestSlave* slave = &bus->slaves[i];
+            if(slave->state != OneWireTestSlaveStateIdle) one_wire_test_slave_slot(slave, line);
+        }
+
+        if(!rx) continue;
+        if(bit % 8 == 0) rx[bit / 8] = 0;
+        if(line) rx[bit / 8] |= 1U << (bit % 8);
+    }
+}
+
+static const OneWireHostBus one_wire_test_bus = {
+    .start = one_wire_test_bus_start,
+    .stop = one_wire_test_bus_stop,
+    .reset = one_wire_test_bus_reset,
+    .exchange = one_wire_test_bus_exchange,
+};
+
+static OneWireTestSlave* one_wire_test_bus_add_slave(
+    OneWireTestBus* bus,
+    uint8_t family_code,
+    uint32_t serial,
+    bool overdrive_capable) {
+    furi_check(bus->slave_count < ONE_WIRE_TEST_SLAVES_MAX);
+    OneWireTestSlave* slave = &bus->slaves[bus->slave_count++];
+
+    slave->rom[0] = family_code;
+    for(size_t i = 1; i < ONE_WIRE_TEST_ROM_SIZE - 1; i++) {
+        slave->rom[i] = i < 5 ? (serial >> (8 * (i - 1))) & 0xFF : 0;
+    }
+    slave->rom[ONE_WIRE_TEST_ROM_SIZE - 1] =
+        maxim_crc8(slave->rom, ONE_WIRE_TEST_ROM_SIZE - 1, MAXIM_CRC8_INIT);
+    slave->overdrive_capable = overdrive_capable;
+
+    for(size_t i = 0; i < ONE_WIRE_TEST_MEMORY_SIZE; i++) {
+        slave->memory[i] = family_code ^ (i * 7);
+    }
+
+    return slave;
+}
+
+/* Search the bus to the end, return the number of devices found, ROMs must hold them all */
+static size_t one_wire_test_search_all(
+    OneWireHost* host,
+    uint8_t (*roms)[ONE_WIRE_TEST_ROM_SIZE],
+    size_t roms_max) {
+    size_t found = 0;
+
+    onewire_host_reset_search(host);
+    while(found < roms_max) {
+        if(!onewire_host_search(host, roms[found], OneWireHostSearchModeNormal)) break;
+        found++;
+    }
+
+    return found;
+}
+
+static bool one_wire_test_rom_found(
+    const OneWireTestSlave* slave,
+    uint8_t (*roms)[ONE_WIRE_TEST_ROM_SIZE],
+    size_t found) {
+    for(size_t i = 0; i < found; i++) {
+        if(memcmp(slave->rom, roms[i], ONE_WIRE_TEST_ROM_SIZE) == 0) return true;
+    }
+    return false;
+}
+
+MU_TEST(one_wire_test_search_multiple) {
+    OneWireTestBus bus = {0};
+    // Serials share prefixes, so that the search has to backtrack
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00001234, false);
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00001235, false);
+    one_wire_test_bus_add_slave(&bus, 0x0C, 0x00001234, true);
+    one_wire_test_bus_add_slave(&bus, 0x81, 0x80000000, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    uint8_t roms[ONE_WIRE_TEST_SLAVES_MAX + 1][ONE_WIRE_TEST_ROM_SIZE];
+    const size_t found = one_wire_test_search_all(host, roms, COUNT_OF(roms));
+
+    mu_assert_int_eq(bus.slave_count, found);
+    for(size_t i = 0; i < bus.slave_count; i++) {
+        mu_assert(one_wire_test_rom_found(&bus.slaves[i], roms, found), "device not found");
+    }
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    // Search starts over once all devices were found
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    mu_assert(onewire_host_search(host, rom, OneWireHostSearchModeNormal), "no restart");
+    mu_assert_mem_eq(roms[0], rom, ONE_WIRE_TEST_ROM_SIZE);
+
+    onewire_host_free(host);
+    mu_assert(!bus.started, "bus not stopped");
+}
+
+MU_TEST(one_wire_test_search_batching) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0xDEADBEEF, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    mu_assert(onewire_host_search(host, rom, OneWireHostSearchModeNormal), "device not found");
+    mu_assert_mem_eq(bus.slaves[0].rom, rom, ONE_WIRE_TEST_ROM_SIZE);
+
+    // Command byte, first bit pair, then each direction bit together with the next pair
+    mu_assert_int_eq(1, bus.resets);
+    mu_assert_int_eq(1 + 1 + 64, bus.exchanges);
+    mu_assert_int_eq(8 + 64 * 3, bus.slots);
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_search_target) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00000001, false);
+    one_wire_test_bus_add_slave(&bus, 0x0C, 0x00000002, true);
+    one_wire_test_bus_add_slave(&bus, 0x33, 0x00000003, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    onewire_host_target_search(host, 0x0C);
+    mu_assert(onewire_host_search(host, rom, OneWireHostSearchModeNormal), "device not found");
+    mu_assert_mem_eq(bus.slaves[1].rom, rom, ONE_WIRE_TEST_ROM_SIZE);
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_read_rom) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x12345678, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    mu_assert(onewire_host_reset(host), "no presence");
+    onewire_host_write(host, ONE_WIRE_TEST_CMD_READ_ROM);
+    onewire_host_read_bytes(host, rom, sizeof(rom));
+
+    mu_assert_mem_eq(bus.slaves[0].rom, rom, ONE_WIRE_TEST_ROM_SIZE);
+    mu_assert_int_eq(0, maxim_crc8(rom, ONE_WIRE_TEST_ROM_SIZE, MAXIM_CRC8_INIT));
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_overdrive_search) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00000001, false);
+    one_wire_test_bus_add_slave(&bus, 0x0C, 0x00000002, true);
+    one_wire_test_bus_add_slave(&bus, 0x0C, 0x00000003, true);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    uint8_t roms[ONE_WIRE_TEST_SLAVES_MAX][ONE_WIRE_TEST_ROM_SIZE];
+
+    // Only overdrive devices answer at overdrive speed
+    mu_assert(onewire_host_overdrive_skip_rom(host), "no presence");
+    mu_assert(!bus.slaves[0].overdrive, "standard device switched to overdrive");
+    mu_assert(bus.slaves[1].overdrive && bus.slaves[2].overdrive, "overdrive not enabled");
+
+    size_t found = one_wire_test_search_all(host, roms, COUNT_OF(roms));
+    mu_assert_int_eq(2, found);
+    mu_assert(one_wire_test_rom_found(&bus.slaves[1], roms, found), "device not found");
+    mu_assert(one_wire_test_rom_found(&bus.slaves[2], roms, found), "device not found");
+
+    // Standard speed reset brings everyone back
+    onewire_host_set_overdrive(host, false);
+    found = one_wire_test_search_all(host, roms, COUNT_OF(roms));
+    mu_assert_int_eq(3, found);
+    mu_assert(!bus.slaves[1].overdrive && !bus.slaves[2].overdrive, "overdrive not reset");
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_overdrive_read_mem) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x0C, 0x00000002, true);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    const uint8_t command[] = {ONE_WIRE_TEST_CMD_READ_MEM, 0x04, 0x00};
+    uint8_t data[ONE_WIRE_TEST_MEMORY_SIZE - 4];
+
+    mu_assert(onewire_host_overdrive_skip_rom(host), "no presence");
+    onewire_host_write_bytes(host, command, sizeof(command));
+    onewire_host_read_bytes(host, data, sizeof(data));
+
+    mu_assert_mem_eq(&bus.slaves[0].memory[4], data, sizeof(data));
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_overdrive_unsupported) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00000001, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    // Presence at standard speed, silence at overdrive
+    mu_assert(onewire_host_overdrive_skip_rom(host), "no presence");
+    mu_assert(!onewire_host_reset(host), "presence at overdrive");
+
+    uint8_t rom[ONE_WIRE_TEST_ROM_SIZE];
+    mu_assert(!onewire_host_search(host, rom, OneWireHostSearchModeNormal), "device found");
+    mu_assert_int_eq(0, bus.timing_errors);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(one_wire_test_timing_mismatch) {
+    OneWireTestBus bus = {0};
+    one_wire_test_bus_add_slave(&bus, 0x01, 0x00000001, false);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_test_bus, &bus);
+    onewire_host_start(host);
+
+    // Overdrive slots confuse a selected standard speed device
+    mu_assert(onewire_host_reset(host), "no presence");
+    onewire_host_set_overdrive(host, true);
+    onewire_host_write(host, ONE_WIRE_TEST_CMD_READ_ROM);
+
+    mu_assert_int_not_eq(0, bus.timing_errors);
+    mu_assert_int_eq(OneWireTestSlaveStateIdle, bus.slaves[0].state);
+
+    onewire_host_free(host);
+}
+
+MU_TEST_SUITE(one_wire_test_host) {
+    MU_RUN_TEST(one_wire_test_search_multiple);
+    MU_RUN_TEST(one_wire_test_search_batching);
+    MU_RUN_TEST(one_wire_test_search_target);
+    MU_RUN_TEST(one_wire_test_read_rom);
+    MU_RUN_TEST(one_wire_test_overdrive_search);
+    MU_RUN_TEST(one_wire_test_overdrive_read_mem);
+    MU_RUN_TEST(one_wire_test_overdrive_unsupported);
+    MU_RUN_TEST(one_wire_test_timing_mismatch);
+}
+
+int run_minunit_test_one_wire() {
+    MU_RUN_SUITE(one_wire_test_host);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,251 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/compress.h>
+#include <toolbox/tar/tar_archive.h>
+#include <update_util/resources/resource_install.h>
+#include "../minunit.h"
+
+#define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
+#define TEST_DEST_DIR TEST_DIR_NAME "/resources"
+#define TEST_BUNDLE TEST_DIR_NAME "/resources.tar"
+#define TEST_BUNDLE_HEATSHRINK TEST_DIR_NAME "/resources" RESOURCE_INSTALL_HEATSHRINK_EXT
+#define TEST_NEW_MANIFEST TEST_DIR_NAME "/Manifest.new"
+#define TEST_DEST(path) TEST_DEST_DIR "/" path
+
+#define TEST_OLD_CONTENT "OLD!"
+#define TEST_NEW_CONTENT "NEW!"
+/* Manifests only hold hashes, they don't have to be real MD5 of content */
+#define TEST_HASH_SAME "00112233445566778899aabbccddeeff"
+#define TEST_HASH_OLD "11111111111111111111111111111111"
+#define TEST_HASH_NEW "22222222222222222222222222222222"
+#define TEST_HASH_REMOVED "33333333333333333333333333333333"
+#define TEST_HASH_COLLISION "44444444444444444444444444444444"
+#define TEST_COLLISION_A RESOURCE_INSTALL_TEST_COLLISION_PREFIX "a.txt"
+#define TEST_COLLISION_B RESOURCE_INSTALL_TEST_COLLISION_PREFIX "b.txt"
+
+/* Must match compress_encode parameters */
+#define TEST_HEATSHRINK_WINDOW_LOG (8U)
+#define TEST_HEATSHRINK_LOOKAHEAD_LOG (4U)
+/* compress_encode output starts with 4 byte header, heatshrink stream follows */
+#define TEST_COMPRESS_HEADER_SIZE (4U)
+
+/* Installed resources: same.txt matches new manifest but differs from bundle content,
+ * so it is only overwritten when installation is not differential */
+static const char* old_manifest = "V:0\n"
+                                  "T:0\n"
+                                  "D:old_dir\n"
+                                  "F:" TEST_HASH_SAME ":4:same.txt\n"
+                                  "F:" TEST_HASH_OLD ":4:changed.txt\n"
+                                  "F:" TEST_HASH_REMOVED ":4:removed.txt\n"
+                                  "F:" TEST_HASH_COLLISION ":4:" TEST_COLLISION_A "\n"
+                                  "F:" TEST_HASH_COLLISION ":4:" TEST_COLLISION_B "\n";
+
+static const char* new_manifest = "V:0\n"
+                                  "T:0\n"
+                                  "D:dir\n"
+                                  "F:" TEST_HASH_SAME ":4:same.txt\n"
+                                  "F:" TEST_HASH_NEW ":4:changed.txt\n"
+                                  "F:" TEST_HASH_COLLISION ":4:" TEST_COLLISION_A "\n"
+                                  "F:" TEST_HASH_COLLISION ":4:" TEST_COLLISION_B "\n"
+                                  "F:" TEST_HASH_NEW ":4:dir/new.txt\n";
+
+static const char* bundle_files[] = {
+    "same.txt",
+    "changed.txt",
+    TEST_COLLISION_A,
+    TEST_COLLISION_B,
+    "dir/new.txt",
+};
+
+static bool resource_install_test_write(Storage* storage, const char* path, const char* data) {
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, data, strlen(data)) == strlen(data);
+    storage_file_free(file);
+    return success;
+}
+
+static bool
+    resource_install_test_content_eq(Storage* storage, const char* path, const char* data) {
+    char buffer[256];
+    File* file = storage_file_alloc(storage);
+    size_t size = 0;
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size = storage_file_read(file, buffer, sizeof(buffer));
+    }
+    storage_file_free(file);
+    return size == strlen(data) && memcmp(buffer, data, size) == 0;
+}
+
+static bool resource_install_test_make_bundle(Storage* storage, bool with_manifest) {
+    TarArchive* archive = tar_archive_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!tar_archive_open(archive, TEST_BUNDLE, TAR_OPEN_MODE_WRITE)) break;
+        /* Manifest goes first, as in bundles made by update.py */
+        if(with_manifest && !tar_archive_store_data(
+                                archive,
+                                RESOURCE_INSTALL_MANIFEST_NAME,
+                                (const uint8_t*)new_manifest,
+                                strlen(new_manifest)))
+            break;
+        if(!tar_archive_dir_add_element(archive, "dir")) break;
+
+        size_t i = 0;
+        for(; i < COUNT_OF(bundle_files); i++) {
+            if(!tar_archive_store_data(
+                   archive,
+                   bundle_files[i],
+                   (const uint8_t*)TEST_NEW_CONTENT,
+                   strlen(TEST_NEW_CONTENT)))
+                break;
+        }
+        success = (i == COUNT_OF(bundle_files)) && tar_archive_finalize(archive);
+    } while(false);
+
+    tar_archive_free(archive);
+    return success;
+}
+
+/* Compress plain bundle into TarHeatshrinkHeader + heatshrink stream */
+static bool resource_install_test_compress_bundle(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    Compress* compress = compress_alloc(512);
+    uint8_t* data = NULL;
+    uint8_t* encoded = NULL;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, TEST_BUNDLE, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        size_t size = storage_file_size(file);
+        data = malloc(size);
+        encoded = malloc(size * 2);
+        if(storage_file_read(file, data, size) != size) break;
+        storage_file_close(file);
+
+        size_t encoded_size = 0;
+        if(!compress_encode(compress, data, size, encoded, size * 2, &encoded_size)) break;
+        if(encoded[0] != 0x01) break;
+
+        TarHeatshrinkHeader header = {
+            .magic = {TAR_HEATSHRINK_MAGIC[0], TAR_HEATSHRINK_MAGIC[1]},
+            .window_log = TEST_HEATSHRINK_WINDOW_LOG,
+            .lookahead_log = TEST_HEATSHRINK_LOOKAHEAD_LOG,
+        };
+        size_t stream_size = encoded_size - TEST_COMPRESS_HEADER_SIZE;
+        if(!storage_file_open(file, TEST_BUNDLE_HEATSHRINK, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(file, &encoded[TEST_COMPRESS_HEADER_SIZE], stream_size) !=
+           stream_size)
+            break;
+        success = true;
+    } while(false);
+
+    free(data);
+    free(encoded);
+    compress_free(compress);
+    storage_file_free(file);
+    return success;
+}
+
+/* Fresh test directory with resources of old manifest installed */
+static bool resource_install_test_prepare(Storage* storage) {
+    storage_simply_remove_recursive(storage, TEST_DIR_NAME);
+    return storage_simply_mkdir(storage, TEST_DIR_NAME) &&
+           storage_simply_mkdir(storage, TEST_DEST_DIR) &&
+           storage_simply_mkdir(storage, TEST_DEST("old_dir")) &&
+           resource_install_test_write(storage, TEST_DEST("Manifest"), old_manifest) &&
+           resource_install_test_write(storage, TEST_DEST("same.txt"), TEST_OLD_CONTENT) &&
+           resource_install_test_write(storage, TEST_DEST("changed.txt"), TEST_OLD_CONTENT) &&
+           resource_install_test_write(storage, TEST_DEST("removed.txt"), TEST_OLD_CONTENT) &&
+           resource_install_test_write(storage, TEST_DEST(TEST_COLLISION_A), TEST_OLD_CONTENT) &&
+           resource_install_test_write(storage, TEST_DEST(TEST_COLLISION_B), TEST_OLD_CONTENT);
+}
+
+static void resource_install_test_run(bool with_manifest, bool compressed) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mu_assert(resource_install_test_prepare(storage), "Cannot prepare resources");
+    mu_assert(resource_install_test_make_bundle(storage, with_manifest), "Cannot make bundle");
+    if(compressed) {
+        mu_assert(resource_install_test_compress_bundle(storage), "Cannot compress bundle");
+    }
+
+    ResourceInstallStats stats;
+    mu_assert(
+        resource_install(
+            storage,
+            compressed ? TEST_BUNDLE_HEATSHRINK : TEST_BUNDLE,
+            TEST_DEST_DIR,
+            TEST_NEW_MANIFEST,
+            NULL,
+            NULL,
+            &stats),
+        "Install failed");
+
+    mu_assert(stats.differential == with_manifest, "Wrong install mode");
+    mu_assert(!storage_file_exists(storage, TEST_NEW_MANIFEST), "Temporary manifest left");
+
+    if(with_manifest) {
+        mu_assert_int_eq(1, stats.skipped_files);
+        mu_assert(
+            resource_install_test_content_eq(storage, TEST_DEST("same.txt"), TEST_OLD_CONTENT),
+            "Unchanged file was extracted");
+        mu_assert(
+            resource_install_test_content_eq(storage, TEST_DEST("Manifest"), new_manifest),
+            "Manifest not updated");
+    } else {
+        mu_assert_int_eq(0, stats.skipped_files);
+        mu_assert(
+            resource_install_test_content_eq(storage, TEST_DEST("same.txt"), TEST_NEW_CONTENT),
+            "File not extracted");
+    }
+
+    mu_assert(
+        resource_install_test_content_eq(storage, TEST_DEST("changed.txt"), TEST_NEW_CONTENT),
+        "Changed file not extracted");
+    mu_assert(
+        resource_install_test_content_eq(storage, TEST_DEST(TEST_COLLISION_A), TEST_NEW_CONTENT),
+        "Colliding file not extracted");
+    mu_assert(
+        resource_install_test_content_eq(storage, TEST_DEST(TEST_COLLISION_B), TEST_NEW_CONTENT),
+        "Colliding file not extracted");
+    mu_assert(
+        resource_install_test_content_eq(storage, TEST_DEST("dir/new.txt"), TEST_NEW_CONTENT),
+        "New file not extracted");
+    mu_assert(!storage_file_exists(storage, TEST_DEST("removed.txt")), "Removed file left");
+    mu_assert(!storage_dir_exists(storage, TEST_DEST("old_dir")), "Removed directory left");
+
+    mu_assert(storage_simply_remove_recursive(storage, TEST_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(resource_install_differential_test) {
+    resource_install_test_run(true, false);
+}
+
+MU_TEST(resource_install_differential_heatshrink_test) {
+    resource_install_test_run(true, true);
+}
+
+MU_TEST(resource_install_no_manifest_test) {
+    resource_install_test_run(false, false);
+}
+
+MU_TEST(resource_install_no_manifest_heatshrink_test) {
+    resource_install_test_run(false, true);
+}
+
+MU_TEST_SUITE(resource_install_suite) {
+    MU_RUN_TEST(resource_install_differential_test);
+    MU_RUN_TEST(resource_install_differential_heatshrink_test);
+    MU_RUN_TEST(resource_install_no_manifest_test);
+    MU_RUN_TEST(resource_install_no_manifest_heatshrink_test);
+}
+
+int run_minunit_test_resource_install() {
+    MU_RUN_SUITE(resource_install_suite);
+    return MU_EXIT_CODE;
+}
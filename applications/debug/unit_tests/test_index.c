@@ -30,6 +30,11 @@ int run_minunit_test_datetime();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
 int run_minunit_test_dialogs_file_browser_options();
+int run_minunit_test_js();
+int run_minunit_test_one_wire();
+int run_minunit_test_trace();
+int run_minunit_test_compress();
+int run_minunit_test_resource_install();
 
 typedef int (*UnitTestEntry)();
 
@@ -62,6 +67,11 @@ const UnitTest unit_tests[] = {
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
+    {.name = "js", .entry = run_minunit_test_js},
+    {.name = "one_wire", .entry = run_minunit_test_one_wire},
+    {.name = "trace", .entry = run_minunit_test_trace},
+    {.name = "compress", .entry = run_minunit_test_compress},
+    {.name = "resource_install", .entry = run_minunit_test_resource_install},
 };
 
 void minunit_print_progress() {
@@ -0,0 +1,192 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#include <toolbox/trace.h>
+
+#include <stdio.h>
+
+#define TRACE_TEST_OUTPUT_SIZE (8192U)
+#define TRACE_TEST_THREAD_RECORDS (1000U)
+
+typedef struct {
+    char data[TRACE_TEST_OUTPUT_SIZE];
+    size_t size;
+    bool overflow;
+    size_t unit_test_records;
+} TraceTestOutput;
+
+static TraceTestOutput trace_test_output;
+
+/* Other firmware trace points may fire while a test runs, only own records are counted */
+static bool trace_test_is_unit_test(const char* data, size_t size) {
+    const char* name = "\"name\":\"unit_test\"";
+    size_t name_size = strlen(name);
+    for(size_t i = 0; i + name_size <= size; i++) {
+        if(memcmp(&data[i], name, name_size) == 0) return true;
+    }
+    return false;
+}
+
+static void trace_test_output_callback(const char* data, size_t size, void* context) {
+    TraceTestOutput* output = context;
+    // Export calls back once per record
+    if(trace_test_is_unit_test(data, size)) output->unit_test_records++;
+    if(output->size + size >= sizeof(output->data)) {
+        output->overflow = true;
+        return;
+    }
+    memcpy(&output->data[output->size], data, size);
+    output->size += size;
+    output->data[output->size] = '\0';
+}
+
+static size_t trace_test_export(void) {
+    trace_test_output.size = 0;
+    trace_test_output.overflow = false;
+    trace_test_output.unit_test_records = 0;
+    trace_test_output.data[0] = '\0';
+    return trace_export_chrome(trace_test_output_callback, &trace_test_output);
+}
+
+static void trace_test_teardown(void) {
+    trace_stop();
+    trace_free();
+}
+
+/* Check that exported timestamps never go backwards */
+static bool trace_test_timestamps_ordered(const char* output) {
+    unsigned long previous_us = 0;
+    unsigned long previous_ns = 0;
+    for(const char* ts = strstr(output, "\"ts\":"); ts; ts = strstr(ts + 1, "\"ts\":")) {
+        unsigned long us = 0;
+        unsigned long ns = 0;
+        if(sscanf(ts, "\"ts\":%lu.%lu", &us, &ns) != 2) return false;
+        if(us < previous_us || (us == previous_us && ns < previous_ns)) return false;
+        previous_us = us;
+        previous_ns = ns;
+    }
+    return true;
+}
+
+MU_TEST(trace_test_record_export) {
+    mu_assert(trace_start(16), "start failed");
+    mu_assert(trace_is_started(), "not started");
+
+    TRACE_BEGIN(UnitTest);
+    TRACE_INSTANT(UnitTest, 42);
+    TRACE_COUNTER(UnitTest, 7);
+    TRACE_END(UnitTest);
+
+    trace_stop();
+    mu_assert(!trace_is_started(), "still started");
+    mu_assert(trace_get_count() >= 4, "records lost");
+
+    mu_assert_int_eq(trace_get_count(), trace_test_export());
+    mu_assert_int_eq(4, trace_test_output.unit_test_records);
+    const char* output = trace_test_output.data;
+    mu_assert(!trace_test_output.overflow, "output overflow");
+    mu_assert(strncmp(output, "{\"traceEvents\":[", 16) == 0, "bad header");
+    mu_assert(output[trace_test_output.size - 2] == '}', "bad footer");
+
+    const char* begin = strstr(output, "\"ph\":\"B\"");
+    const char* end = strstr(output, "\"ph\":\"E\"");
+    mu_assert(begin && end && begin < end, "duration not exported in order");
+    mu_assert(strstr(output, "\"name\":\"unit_test\",\"cat\":\"unit_tests\""), "no event name");
+    mu_assert(strstr(output, "\"args\":{\"arg\":42}"), "no instant argument");
+    mu_assert(strstr(output, "\"args\":{\"value\":7}"), "no counter value");
+    mu_assert(trace_test_timestamps_ordered(output), "timestamps out of order");
+
+    trace_test_teardown();
+}
+
+MU_TEST(trace_test_overwrite) {
+    // Rounded up to 8 records
+    mu_assert(trace_start(5), "start failed");
+    for(uint32_t i = 0; i < 20; i++) {
+        TRACE_INSTANT(UnitTest, i);
+    }
+    trace_stop();
+
+    mu_assert_int_eq(8, trace_get_count());
+    mu_assert(trace_get_dropped() >= 12, "records not overwritten");
+    mu_assert_int_eq(8, trace_test_export());
+    mu_assert(trace_test_output.unit_test_records <= 8, "overwritten record exported");
+
+    const char* output = trace_test_output.data;
+    mu_assert(!strstr(output, "\"arg\":11}"), "overwritten record exported");
+    const char* newest = strstr(output, "\"arg\":19}");
+    mu_assert(newest, "newest record not exported");
+    const char* oldest = strstr(output, "\"arg\":12}");
+    mu_assert(!oldest || oldest < newest, "records not exported oldest first");
+
+    trace_test_teardown();
+}
+
+MU_TEST(trace_test_stopped) {
+    mu_assert(!trace_start(0), "started without capacity");
+
+    TRACE_INSTANT(UnitTest, 1);
+    mu_assert_int_eq(0, trace_get_count());
+
+    mu_assert(trace_start(4), "start failed");
+    mu_assert(!trace_start(4), "started twice");
+    TRACE_INSTANT(UnitTest, 1);
+    trace_stop();
+    TRACE_INSTANT(UnitTest, 2);
+    trace_test_export();
+    mu_assert_int_eq(1, trace_test_output.unit_test_records);
+    mu_assert(strstr(trace_test_output.data, "\"arg\":1}"), "record lost");
+
+    // Restart discards previous trace
+    mu_assert(trace_start(4), "restart failed");
+    trace_stop();
+    trace_test_export();
+    mu_assert_int_eq(0, trace_test_output.unit_test_records);
+
+    trace_free();
+    mu_assert_int_eq(0, trace_test_export());
+    mu_assert_string_eq(
+        "{\"traceEvents\":[\n\n],\"displayTimeUnit\":\"ns\"}\n", trace_test_output.data);
+}
+
+static int32_t trace_test_thread(void* context) {
+    UNUSED(context);
+    for(uint32_t i = 0; i < TRACE_TEST_THREAD_RECORDS; i++) {
+        TRACE_COUNTER(UnitTest, i);
+    }
+    return 0;
+}
+
+MU_TEST(trace_test_threads) {
+    mu_assert(trace_start(4 * TRACE_TEST_THREAD_RECORDS), "start failed");
+
+    FuriThread* threads[2];
+    for(size_t i = 0; i < COUNT_OF(threads); i++) {
+        threads[i] = furi_thread_alloc_ex("TraceTest", 1024, trace_test_thread, NULL);
+        furi_thread_start(threads[i]);
+    }
+    for(size_t i = 0; i < COUNT_OF(threads); i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+    }
+    trace_stop();
+
+    // Every record complete, none lost to a concurrent writer
+    mu_assert_int_eq(0, trace_get_dropped());
+    mu_assert_int_eq(trace_get_count(), trace_test_export());
+    mu_assert_int_eq(2 * TRACE_TEST_THREAD_RECORDS, trace_test_output.unit_test_records);
+
+    trace_test_teardown();
+}
+
+MU_TEST_SUITE(trace_test) {
+    MU_RUN_TEST(trace_test_record_export);
+    MU_RUN_TEST(trace_test_overwrite);
+    MU_RUN_TEST(trace_test_stopped);
+    MU_RUN_TEST(trace_test_threads);
+}
+
+int run_minunit_test_trace() {
+    MU_RUN_SUITE(trace_test);
+    return MU_EXIT_CODE;
+}
@@ -472,17 +472,10 @@ bool subghz_device_cc1101_ext_tx() {
 
 float subghz_device_cc1101_ext_get_rssi() {
     furi_hal_spi_acquire(subghz_device_cc1101_ext->spi_bus_handle);
-    int32_t rssi_dec = cc1101_get_rssi(subghz_device_cc1101_ext->spi_bus_handle);
+    uint8_t rssi = cc1101_get_rssi(subghz_device_cc1101_ext->spi_bus_handle);
     furi_hal_spi_release(subghz_device_cc1101_ext->spi_bus_handle);
 
-    float rssi = rssi_dec;
-    if(rssi_dec >= 128) {
-        rssi = ((rssi - 256.0f) / 2.0f) - 74.0f;
-    } else {
-        rssi = (rssi / 2.0f) - 74.0f;
-    }
-
-    return rssi;
+    return cc1101_rssi_to_dbm(rssi);
 }
 
 uint8_t subghz_device_cc1101_ext_get_lqi() {
@@ -162,10 +162,9 @@ static void loclass_rk(const uint8_t* key, uint8_t n, uint8_t* outp_key) {
     return;
 }
 
-static mbedtls_des_context loclass_ctx_enc;
-static mbedtls_des_context loclass_ctx_dec;
-
+// Contexts live on the stack, so keys can be diversified in more than one thread
 static void loclass_desdecrypt_iclass(uint8_t* iclass_key, uint8_t* input, uint8_t* output) {
+    mbedtls_des_context loclass_ctx_dec;
     uint8_t key_std_format[8] = {0};
     loclass_permutekey_rev(iclass_key, key_std_format);
     mbedtls_des_setkey_dec(&loclass_ctx_dec, key_std_format);
@@ -173,6 +172,7 @@ static void loclass_desdecrypt_iclass(uint8_t* iclass_key, uint8_t* input, uint8
 }
 
 static void loclass_desencrypt_iclass(const uint8_t* iclass_key, uint8_t* input, uint8_t* output) {
+    mbedtls_des_context loclass_ctx_enc;
     uint8_t key_std_format[8] = {0};
     loclass_permutekey_rev(iclass_key, key_std_format);
     mbedtls_des_setkey_enc(&loclass_ctx_enc, key_std_format);
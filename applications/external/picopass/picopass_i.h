@@ -67,6 +67,7 @@ typedef struct {
     const char* name;
     uint16_t total_keys;
     uint16_t current_key;
+    uint16_t requested_keys;
     bool card_detected;
 } PicopassDictAttackContext;
 
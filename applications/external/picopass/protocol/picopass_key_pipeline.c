@@ -0,0 +1,124 @@
+#include "picopass_key_pipeline.h"
+
+#include "../loclass/optimized_cipher.h"
+
+#include <furi/furi.h>
+
+#define TAG "PicopassKeyPipeline"
+
+#define PICOPASS_KEY_PIPELINE_STACK_SIZE (2 * 1024)
+
+typedef struct {
+    bool stop;
+    PicopassKeyCandidate candidate;
+} PicopassKeyPipelineMessage;
+
+struct PicopassKeyPipeline {
+    FuriThread* thread;
+    FuriMessageQueue* input;
+    FuriMessageQueue* output;
+    size_t pending;
+};
+
+void picopass_key_pipeline_compute(PicopassKeyCandidate* candidate) {
+    furi_assert(candidate);
+
+    uint8_t ccnr[12] = {}; // last 4 bytes left 0
+    memcpy(ccnr, candidate->cc, sizeof(candidate->cc));
+
+    loclass_iclass_calc_div_key(
+        candidate->csn, candidate->key, candidate->div_key, candidate->is_elite_key);
+    loclass_opt_doReaderMAC(ccnr, candidate->div_key, candidate->mac.data);
+}
+
+static int32_t picopass_key_pipeline_worker(void* context) {
+    PicopassKeyPipeline* instance = context;
+    PicopassKeyPipelineMessage message;
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(instance->input, &message, FuriWaitForever) == FuriStatusOk);
+        if(message.stop) break;
+
+        picopass_key_pipeline_compute(&message.candidate);
+        furi_check(
+            furi_message_queue_put(instance->output, &message.candidate, FuriWaitForever) ==
+            FuriStatusOk);
+    }
+
+    return 0;
+}
+
+PicopassKeyPipeline* picopass_key_pipeline_alloc(void) {
+    PicopassKeyPipeline* instance = malloc(sizeof(PicopassKeyPipeline));
+
+    // One extra slot for the stop message
+    instance->input = furi_message_queue_alloc(
+        PICOPASS_KEY_PIPELINE_DEPTH + 1, sizeof(PicopassKeyPipelineMessage));
+    instance->output =
+        furi_message_queue_alloc(PICOPASS_KEY_PIPELINE_DEPTH, sizeof(PicopassKeyCandidate));
+
+    instance->thread = furi_thread_alloc_ex(
+        TAG, PICOPASS_KEY_PIPELINE_STACK_SIZE, picopass_key_pipeline_worker, instance);
+    // Below the NFC worker, computation must never delay card exchange
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+
+    return instance;
+}
+
+void picopass_key_pipeline_free(PicopassKeyPipeline* instance) {
+    furi_assert(instance);
+
+    picopass_key_pipeline_reset(instance);
+
+    PicopassKeyPipelineMessage message = {.stop = true};
+    furi_check(
+        furi_message_queue_put(instance->input, &message, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+
+    furi_message_queue_free(instance->input);
+    furi_message_queue_free(instance->output);
+    free(instance);
+}
+
+size_t picopass_key_pipeline_get_pending(const PicopassKeyPipeline* instance) {
+    furi_assert(instance);
+
+    return instance->pending;
+}
+
+void picopass_key_pipeline_push(
+    PicopassKeyPipeline* instance,
+    const PicopassKeyCandidate* candidate) {
+    furi_assert(instance);
+    furi_assert(candidate);
+    furi_check(instance->pending < PICOPASS_KEY_PIPELINE_DEPTH);
+
+    PicopassKeyPipelineMessage message = {.stop = false, .candidate = *candidate};
+    furi_check(
+        furi_message_queue_put(instance->input, &message, FuriWaitForever) == FuriStatusOk);
+    instance->pending++;
+}
+
+bool picopass_key_pipeline_pop(PicopassKeyPipeline* instance, PicopassKeyCandidate* candidate) {
+    furi_assert(instance);
+    furi_assert(candidate);
+
+    if(!instance->pending) return false;
+
+    furi_check(
+        furi_message_queue_get(instance->output, candidate, FuriWaitForever) == FuriStatusOk);
+    instance->pending--;
+
+    return true;
+}
+
+void picopass_key_pipeline_reset(PicopassKeyPipeline* instance) {
+    furi_assert(instance);
+
+    PicopassKeyCandidate candidate;
+    while(picopass_key_pipeline_pop(instance, &candidate)) {
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "picopass_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Precomputes diversified keys and reader MACs of dictionary attack candidates
+ * in a low priority thread, so the poller only has to wait for the card.
+ * Candidates are returned in the order they were pushed.
+ */
+
+#define PICOPASS_KEY_PIPELINE_DEPTH (4)
+
+typedef struct {
+    uint8_t key[PICOPASS_KEY_LEN];
+    bool is_elite_key;
+    uint8_t csn[RFAL_PICOPASS_UID_LEN];
+    uint8_t cc[PICOPASS_READ_CHECK_RESP_LEN];
+    uint8_t div_key[PICOPASS_KEY_LEN];
+    PicopassMac mac;
+} PicopassKeyCandidate;
+
+typedef struct PicopassKeyPipeline PicopassKeyPipeline;
+
+PicopassKeyPipeline* picopass_key_pipeline_alloc(void);
+
+void picopass_key_pipeline_free(PicopassKeyPipeline* instance);
+
+/** Number of pushed candidates not yet popped */
+size_t picopass_key_pipeline_get_pending(const PicopassKeyPipeline* instance);
+
+/** Queue candidate, key, is_elite_key, csn and cc must be set */
+void picopass_key_pipeline_push(
+    PicopassKeyPipeline* instance,
+    const PicopassKeyCandidate* candidate);
+
+/** Wait for the oldest candidate with div_key and mac computed, false if none pending */
+bool picopass_key_pipeline_pop(PicopassKeyPipeline* instance, PicopassKeyCandidate* candidate);
+
+/** Drop all pending candidates */
+void picopass_key_pipeline_reset(PicopassKeyPipeline* instance);
+
+/** Compute div_key and mac of candidate in the calling thread */
+void picopass_key_pipeline_compute(PicopassKeyCandidate* candidate);
+
+#ifdef __cplusplus
+}
+#endif
@@ -319,16 +319,87 @@ NfcCommand picopass_poller_nr_mac_auth(PicopassPoller* instance) {
     return command;
 }
 
+static NfcCommand picopass_poller_request_key(
+    PicopassPoller* instance,
+    PicopassKeyCandidate* candidate,
+    size_t keys_pending) {
+    instance->event.type = PicopassPollerEventTypeRequestKey;
+    instance->event_data.req_key.keys_pending = keys_pending;
+    NfcCommand command = instance->callback(instance->event, instance->context);
+
+    if(command == NfcCommandContinue && instance->event_data.req_key.is_key_provided) {
+        memcpy(candidate->key, instance->event_data.req_key.key, PICOPASS_KEY_LEN);
+        candidate->is_elite_key = instance->event_data.req_key.is_elite_key;
+        memcpy(candidate->csn, instance->serial_num.data, sizeof(candidate->csn));
+        // Read check returns the e-purse read during pre-auth, unless the card changed
+        memcpy(
+            candidate->cc,
+            instance->data->card_data[PICOPASS_SECURE_EPURSE_BLOCK_INDEX].data,
+            sizeof(candidate->cc));
+    }
+
+    return command;
+}
+
+static NfcCommand picopass_poller_next_candidate(
+    PicopassPoller* instance,
+    PicopassKeyCandidate* candidate,
+    bool* is_key_provided) {
+    NfcCommand command = NfcCommandContinue;
+
+    if(instance->mode == PicopassPollerModeRead) {
+        // Keys are requested ahead, so their div keys and MACs are computed during card exchange
+        if(!instance->key_pipeline) {
+            instance->key_pipeline = picopass_key_pipeline_alloc();
+        }
+        // Set from GUI thread, test and clear must not lose a request made in between
+        FURI_CRITICAL_ENTER();
+        bool discard_keys = instance->discard_keys;
+        instance->discard_keys = false;
+        FURI_CRITICAL_EXIT();
+        if(discard_keys) {
+            picopass_key_pipeline_reset(instance->key_pipeline);
+        }
+        while(!instance->keys_exhausted) {
+            size_t pending = picopass_key_pipeline_get_pending(instance->key_pipeline);
+            if(pending >= PICOPASS_KEY_PIPELINE_DEPTH) break;
+
+            command = picopass_poller_request_key(instance, candidate, pending);
+            if(command != NfcCommandContinue) break;
+
+            if(instance->event_data.req_key.is_key_provided) {
+                picopass_key_pipeline_push(instance->key_pipeline, candidate);
+            } else {
+                // Pending keys are tried first, then the key is requested again
+                if(!pending) instance->keys_exhausted = true;
+                break;
+            }
+        }
+        if(command == NfcCommandContinue) {
+            *is_key_provided = picopass_key_pipeline_pop(instance->key_pipeline, candidate);
+        }
+    } else {
+        command = picopass_poller_request_key(instance, candidate, 0);
+        *is_key_provided = instance->event_data.req_key.is_key_provided;
+        if(command == NfcCommandContinue && *is_key_provided) {
+            picopass_key_pipeline_compute(candidate);
+        }
+    }
+
+    return command;
+}
+
 NfcCommand picopass_poller_auth_handler(PicopassPoller* instance) {
     NfcCommand command = NfcCommandContinue;
 
     do {
-        // Request key
-        instance->event.type = PicopassPollerEventTypeRequestKey;
-        command = instance->callback(instance->event, instance->context);
+        PicopassKeyCandidate candidate = {};
+        bool is_key_provided = false;
+
+        command = picopass_poller_next_candidate(instance, &candidate, &is_key_provided);
         if(command != NfcCommandContinue) break;
 
-        if(!instance->event_data.req_key.is_key_provided) {
+        if(!is_key_provided) {
             instance->state = PicopassPollerStateAuthFail;
             break;
         }
@@ -336,15 +407,15 @@ NfcCommand picopass_poller_auth_handler(PicopassPoller* instance) {
         FURI_LOG_D(
             TAG,
             "Try to %s auth with key %02x%02x%02x%02x%02x%02x%02x%02x",
-            instance->event_data.req_key.is_elite_key ? "elite" : "standard",
-            instance->event_data.req_key.key[0],
-            instance->event_data.req_key.key[1],
-            instance->event_data.req_key.key[2],
-            instance->event_data.req_key.key[3],
-            instance->event_data.req_key.key[4],
-            instance->event_data.req_key.key[5],
-            instance->event_data.req_key.key[6],
-            instance->event_data.req_key.key[7]);
+            candidate.is_elite_key ? "elite" : "standard",
+            candidate.key[0],
+            candidate.key[1],
+            candidate.key[2],
+            candidate.key[3],
+            candidate.key[4],
+            candidate.key[5],
+            candidate.key[6],
+            candidate.key[7]);
 
         PicopassReadCheckResp read_check_resp = {};
         uint8_t* csn = instance->serial_num.data;
@@ -357,9 +428,6 @@ NfcCommand picopass_poller_auth_handler(PicopassPoller* instance) {
             div_key = instance->div_key;
         }
 
-        uint8_t ccnr[12] = {};
-        PicopassMac mac = {};
-
         PicopassError error = picopass_poller_read_check(instance, &read_check_resp);
         if(error == PicopassErrorTimeout) {
             instance->event.type = PicopassPollerEventTypeCardLost;
@@ -370,25 +438,25 @@ NfcCommand picopass_poller_auth_handler(PicopassPoller* instance) {
             FURI_LOG_E(TAG, "Read check failed: %d", error);
             break;
         }
-        memcpy(ccnr, read_check_resp.data, sizeof(PicopassReadCheckResp)); // last 4 bytes left 0
 
-        loclass_iclass_calc_div_key(
-            csn,
-            instance->event_data.req_key.key,
-            div_key,
-            instance->event_data.req_key.is_elite_key);
-        loclass_opt_doReaderMAC(ccnr, div_key, mac.data);
+        // Candidate was computed for another card or e-purse value
+        if(memcmp(candidate.csn, csn, sizeof(candidate.csn)) ||
+           memcmp(candidate.cc, read_check_resp.data, sizeof(candidate.cc))) {
+            memcpy(candidate.csn, csn, sizeof(candidate.csn));
+            memcpy(candidate.cc, read_check_resp.data, sizeof(candidate.cc));
+            picopass_key_pipeline_compute(&candidate);
+        }
+        memcpy(div_key, candidate.div_key, PICOPASS_KEY_LEN);
 
         PicopassCheckResp check_resp = {};
-        error = picopass_poller_check(instance, NULL, &mac, &check_resp);
+        error = picopass_poller_check(instance, NULL, &candidate.mac, &check_resp);
         if(error == PicopassErrorNone) {
             FURI_LOG_I(TAG, "Found key");
-            memcpy(instance->mac.data, mac.data, sizeof(PicopassMac));
+            memcpy(instance->mac.data, candidate.mac.data, sizeof(PicopassMac));
             if(instance->mode == PicopassPollerModeRead) {
-                memcpy(
-                    instance->data->pacs.key, instance->event_data.req_key.key, PICOPASS_KEY_LEN);
+                memcpy(instance->data->pacs.key, candidate.key, PICOPASS_KEY_LEN);
                 instance->data->card_data[PICOPASS_SECURE_KD_BLOCK_INDEX].valid = true;
-                instance->data->pacs.elite_kdf = instance->event_data.req_key.is_elite_key;
+                instance->data->pacs.elite_kdf = candidate.is_elite_key;
                 picopass_poller_prepare_read(instance);
                 instance->state = PicopassPollerStateReadBlock;
             } else if(instance->mode == PicopassPollerModeWrite) {
@@ -611,6 +679,8 @@ NfcCommand picopass_poller_auth_fail_handler(PicopassPoller* instance) {
     instance->event.type = PicopassPollerEventTypeAuthFail;
     command = instance->callback(instance->event, instance->context);
     picopass_poller_reset(instance);
+    // Keys are requested again if the poller keeps running
+    instance->keys_exhausted = false;
     instance->state = PicopassPollerStateDetect;
 
     return command;
@@ -661,6 +731,12 @@ void picopass_poller_start(
     instance->callback = callback;
     instance->context = context;
 
+    if(instance->key_pipeline) {
+        picopass_key_pipeline_reset(instance->key_pipeline);
+    }
+    instance->keys_exhausted = false;
+    instance->discard_keys = false;
+
     instance->session_state = PicopassPollerSessionStateActive;
     nfc_start(instance->nfc, picopass_poller_callback, instance);
 }
@@ -696,6 +772,9 @@ PicopassPoller* picopass_poller_alloc(Nfc* nfc) {
 void picopass_poller_free(PicopassPoller* instance) {
     furi_assert(instance);
 
+    if(instance->key_pipeline) {
+        picopass_key_pipeline_free(instance->key_pipeline);
+    }
     free(instance->data);
     bit_buffer_free(instance->tx_buffer);
     bit_buffer_free(instance->rx_buffer);
@@ -703,6 +782,14 @@ void picopass_poller_free(PicopassPoller* instance) {
     free(instance);
 }
 
+void picopass_poller_discard_keys(PicopassPoller* instance) {
+    furi_assert(instance);
+
+    FURI_CRITICAL_ENTER();
+    instance->discard_keys = true;
+    FURI_CRITICAL_EXIT();
+}
+
 const PicopassDeviceData* picopass_poller_get_data(PicopassPoller* instance) {
     furi_assert(instance);
 
@@ -33,6 +33,10 @@ typedef struct {
     uint8_t key[PICOPASS_KEY_LEN];
     bool is_key_provided;
     bool is_elite_key;
+    /* Read mode requests keys ahead: number of provided keys not tried yet.
+     * Not providing a key while some are pending is not the end of the dictionary,
+     * key is requested again once all pending keys are tried. */
+    uint8_t keys_pending;
 } PicopassPollerEventDataRequestKey;
 
 typedef struct {
@@ -76,6 +80,9 @@ void picopass_poller_stop(PicopassPoller* instance);
 
 const PicopassDeviceData* picopass_poller_get_data(PicopassPoller* instance);
 
+/** Drop keys requested ahead and not tried yet, e.g. when dictionary is skipped */
+void picopass_poller_discard_keys(PicopassPoller* instance);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,6 +2,7 @@
 
 #include "picopass_poller.h"
 #include "picopass_protocol.h"
+#include "picopass_key_pipeline.h"
 
 #include <nfc/helpers/iso13239_crc.h>
 
@@ -50,6 +51,11 @@ struct PicopassPoller {
 
     PicopassDeviceData* data;
 
+    // Dictionary attack in read mode
+    PicopassKeyPipeline* key_pipeline;
+    bool keys_exhausted;
+    bool discard_keys;
+
     BitBuffer* tx_buffer;
     BitBuffer* rx_buffer;
     BitBuffer* tmp_buffer;
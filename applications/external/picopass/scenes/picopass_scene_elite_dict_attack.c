@@ -42,6 +42,7 @@ static bool picopass_elite_dict_attack_change_dict(Picopass* picopass) {
         }
         picopass->dict_attack_ctx.total_keys = keys_dict_get_total_keys(picopass->dict);
         picopass->dict_attack_ctx.current_key = 0;
+        picopass->dict_attack_ctx.requested_keys = 0;
         picopass->dict_attack_ctx.name = picopass_dict_name[scene_state];
         scene_manager_set_scene_state(
             picopass->scene_manager, PicopassSceneEliteDictAttack, scene_state);
@@ -62,8 +63,24 @@ NfcCommand picopass_elite_dict_attack_worker_callback(PicopassPollerEvent event,
     } else if(event.type == PicopassPollerEventTypeRequestKey) {
         uint8_t key[PICOPASS_KEY_LEN] = {};
         bool is_key_provided = true;
+        uint8_t keys_pending = event.data->req_key.keys_pending;
+        PicopassDictAttackContext* ctx = &picopass->dict_attack_ctx;
+
+        // Keys are requested ahead of the card exchange, count only the ones already tried
+        uint16_t current_key = ctx->requested_keys - MIN(keys_pending, ctx->requested_keys);
+        if(current_key != ctx->current_key) {
+            ctx->current_key = current_key;
+            if(current_key % PICOPASS_SCENE_DICT_ATTACK_KEYS_BATCH_UPDATE == 0) {
+                view_dispatcher_send_custom_event(
+                    picopass->view_dispatcher, PicopassCustomEventDictAttackUpdateView);
+            }
+        }
+
         if(!keys_dict_get_next_key(picopass->dict, key, PICOPASS_KEY_LEN)) {
-            if(picopass_elite_dict_attack_change_dict(picopass)) {
+            if(keys_pending) {
+                // Switch dictionary only after all of its keys were tried
+                is_key_provided = false;
+            } else if(picopass_elite_dict_attack_change_dict(picopass)) {
                 is_key_provided = keys_dict_get_next_key(picopass->dict, key, PICOPASS_KEY_LEN);
                 view_dispatcher_send_custom_event(
                     picopass->view_dispatcher, PicopassCustomEventDictAttackUpdateView);
@@ -78,13 +95,7 @@ NfcCommand picopass_elite_dict_attack_worker_callback(PicopassPollerEvent event,
             (scene_state != PicopassSceneEliteDictAttackDictStandard);
         event.data->req_key.is_key_provided = is_key_provided;
         if(is_key_provided) {
-            picopass->dict_attack_ctx.current_key++;
-            if(picopass->dict_attack_ctx.current_key %
-                   PICOPASS_SCENE_DICT_ATTACK_KEYS_BATCH_UPDATE ==
-               0) {
-                view_dispatcher_send_custom_event(
-                    picopass->view_dispatcher, PicopassCustomEventDictAttackUpdateView);
-            }
+            ctx->requested_keys++;
         }
     } else if(
         event.type == PicopassPollerEventTypeSuccess ||
@@ -156,6 +167,7 @@ void picopass_scene_elite_dict_attack_on_enter(void* context) {
     picopass->dict_attack_ctx.card_detected = false;
     picopass->dict_attack_ctx.total_keys = keys_dict_get_total_keys(picopass->dict);
     picopass->dict_attack_ctx.current_key = 0;
+    picopass->dict_attack_ctx.requested_keys = 0;
     picopass->dict_attack_ctx.name = picopass_dict_name[state];
     scene_manager_set_scene_state(picopass->scene_manager, PicopassSceneEliteDictAttack, state);
 
@@ -194,6 +206,8 @@ bool picopass_scene_elite_dict_attack_on_event(void* context, SceneManagerEvent
             uint32_t scene_state = scene_manager_get_scene_state(
                 picopass->scene_manager, PicopassSceneEliteDictAttack);
             if(scene_state != PicopassSceneEliteDictAttackDictElite) {
+                // Keys of skipped dictionary requested ahead must not be tried
+                picopass_poller_discard_keys(picopass->poller);
                 picopass_elite_dict_attack_change_dict(picopass);
                 picopass_scene_elite_dict_attack_update_view(picopass);
             } else {
@@ -222,6 +236,7 @@ void picopass_scene_elite_dict_attack_on_exit(void* context) {
         picopass->dict = NULL;
     }
     picopass->dict_attack_ctx.current_key = 0;
+    picopass->dict_attack_ctx.requested_keys = 0;
     picopass->dict_attack_ctx.total_keys = 0;
 
     picopass_poller_stop(picopass->poller);
@@ -40,7 +40,10 @@ NfcCommand picopass_read_card_worker_callback(PicopassPollerEvent event, void* c
         uint8_t key[PICOPASS_KEY_LEN] = {};
         bool is_key_provided = true;
         if(!keys_dict_get_next_key(picopass->dict, key, PICOPASS_KEY_LEN)) {
-            if(picopass_read_card_change_dict(picopass)) {
+            if(event.data->req_key.keys_pending) {
+                // Switch dictionary only after all of its keys were tried
+                is_key_provided = false;
+            } else if(picopass_read_card_change_dict(picopass)) {
                 is_key_provided = keys_dict_get_next_key(picopass->dict, key, PICOPASS_KEY_LEN);
             } else {
                 is_key_provided = false;
@@ -25,6 +25,7 @@
 #define PROTOVIEW_RAW_VIEW_DEFAULT_SCALE 100 // 100us is 1 pixel by default
 #define BITMAP_SEEK_NOT_FOUND UINT32_MAX // Returned by function as sentinel
 #define PROTOVIEW_VIEW_PRIVDATA_LEN 64 // View specific private data len
+#define BITMAP_PATTERN_MAX_BITS 64 // Max len of a compiled bitmap pattern
 
 #define DEBUG_MSG 0
 
@@ -185,6 +186,15 @@ typedef struct ProtoViewMsgInfo {
                                    integer. */
 } ProtoViewMsgInfo;
 
+/* A bit pattern like "1010...", compiled by bitmap_pattern_compile() so
+ * that the bitmap functions can match it with a single comparison. */
+typedef struct {
+    uint64_t bits; /* Pattern bits, the last pattern bit is the LSB. */
+    uint32_t len; /* Pattern length in bits. */
+    const char* str; /* Original pattern, used if len exceeds the
+                        BITMAP_PATTERN_MAX_BITS limit. */
+} BitmapPattern;
+
 /* This structures describe a set of protocol fields. It is used by decoders
  * supporting message building to receive and return information about the
  * protocol. */
@@ -259,6 +269,8 @@ void reset_current_signal(ProtoViewApp* app);
 void scan_for_signal(ProtoViewApp* app, RawSamplesBuffer* source, uint32_t min_duration);
 bool bitmap_get(uint8_t* b, uint32_t blen, uint32_t bitpos);
 void bitmap_set(uint8_t* b, uint32_t blen, uint32_t bitpos, bool val);
+uint64_t bitmap_get_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, uint32_t count);
+void bitmap_set_run(uint8_t* b, uint32_t blen, uint32_t bitpos, uint32_t count, bool val);
 void bitmap_copy(
     uint8_t* d,
     uint32_t dlen,
@@ -269,7 +281,15 @@ void bitmap_copy(
     uint32_t count);
 void bitmap_set_pattern(uint8_t* b, uint32_t blen, uint32_t off, const char* pat);
 void bitmap_reverse_bytes_bits(uint8_t* p, uint32_t len);
+void bitmap_pattern_compile(BitmapPattern* p, const char* bits);
+bool bitmap_match_pattern(uint8_t* b, uint32_t blen, uint32_t bitpos, const BitmapPattern* p);
 bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits);
+uint32_t bitmap_seek_pattern(
+    uint8_t* b,
+    uint32_t blen,
+    uint32_t startpos,
+    uint32_t maxbits,
+    const BitmapPattern* p);
 uint32_t bitmap_seek_bits(
     uint8_t* b,
     uint32_t blen,
@@ -293,6 +313,14 @@ uint32_t convert_from_line_code(
     uint32_t offset,
     const char* zero_pattern,
     const char* one_pattern);
+uint32_t convert_from_line_code_patterns(
+    uint8_t* buf,
+    uint64_t buflen,
+    uint8_t* bits,
+    uint32_t len,
+    uint32_t off,
+    const BitmapPattern* zero,
+    const BitmapPattern* one);
 uint32_t convert_from_diff_manchester(
     uint8_t* buf,
     uint64_t buflen,
@@ -152,8 +152,9 @@ static uint32_t find_alternating_bits(
         uint32_t start_off = odd;
         uint32_t j = odd;
         while(j < numbits - 1) {
-            bool bit1 = bitmap_get(bits, numbytes, j);
-            bool bit2 = bitmap_get(bits, numbytes, j + 1);
+            uint64_t pair = bitmap_get_bits(bits, numbytes, j, 2);
+            bool bit1 = pair >> 1;
+            bool bit2 = pair & 1;
             if((!only_raising && bit1 != bit2) || (only_raising && !bit1 && bit2)) {
                 count++;
                 if(count > best_count) {
@@ -286,6 +286,59 @@ bool bitmap_get(uint8_t* b, uint32_t blen, uint32_t bitpos) {
     return (b[byte] & (1 << bit)) != 0;
 }
 
+/* Return 'count' bits (up to 64) of the bitmap 'b' of 'blen' bytes,
+ * starting at 'bitpos', as an integer: the first bit of the bitmap is the
+ * most significant bit of the returned value. Like bitmap_get(), out of range
+ * bits are read as zero.
+ *
+ * This is the building block of the word-level functions below: instead
+ * of testing bits one after the other, we load at most 9 bytes and shift
+ * them in place, so that comparing a whole pattern costs a single
+ * integer comparison. */
+uint64_t bitmap_get_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, uint32_t count) {
+    furi_assert(count <= 64);
+    if(count == 0) return 0;
+
+    uint32_t byte = bitpos / 8;
+    uint32_t skew = bitpos & 7;
+    uint32_t nbytes = (skew + count + 7) / 8; /* At most 9 bytes. */
+
+    uint64_t word = 0;
+    for(uint32_t j = 0; j < nbytes && j < 8; j++) {
+        if(byte + j >= blen) break;
+        word |= (uint64_t)b[byte + j] << (56 - j * 8);
+    }
+    word <<= skew;
+    if(nbytes == 9 && byte + 8 < blen) word |= b[byte + 8] >> (8 - skew);
+    return word >> (64 - count);
+}
+
+/* Set 'count' bits of the bitmap 'b' of 'blen' bytes to the value 'val',
+ * starting at 'bitpos'. Out of range bits are silently discarded, like
+ * in bitmap_set(), but whole bytes are filled at once when possible. */
+void bitmap_set_run(uint8_t* b, uint32_t blen, uint32_t bitpos, uint32_t count, bool val) {
+    /* Reach a byte boundary. */
+    while(count && (bitpos & 7) != 0) {
+        bitmap_set(b, blen, bitpos++, val);
+        count--;
+    }
+
+    /* Fill full bytes. */
+    uint32_t byte = bitpos / 8;
+    uint8_t fill = val ? 0xff : 0;
+    while(count >= 8 && byte < blen) {
+        b[byte++] = fill;
+        bitpos += 8;
+        count -= 8;
+    }
+
+    /* Trailing bits, if any. */
+    while(count && bitpos / 8 < blen) {
+        bitmap_set(b, blen, bitpos++, val);
+        count--;
+    }
+}
+
 /* Copy 'count' bits from the bitmap 's' of 'slen' total bytes, to the
  * bitmap 'd' of 'dlen' total bytes. The bits are copied starting from
  * offset 'soff' of the source bitmap to the offset 'doff' of the
@@ -399,10 +452,25 @@ void bitmap_reverse_bytes_bits(uint8_t* p, uint32_t len) {
     }
 }
 
-/* Return true if the specified sequence of bits, provided as a string in the
- * form "11010110..." is found in the 'b' bitmap of 'blen' bits at 'bitpos'
- * position. */
-bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits) {
+/* Compile the pattern 'bits', provided as a string in the form "11010110...",
+ * into 'p', so that it can be matched against a bitmap with a single
+ * integer comparison instead of bit by bit. Like in bitmap_match_bits(),
+ * every character that is not '1' is considered a zero.
+ *
+ * Patterns longer than BITMAP_PATTERN_MAX_BITS are still accepted: in that
+ * case the matching functions fall back to the bit by bit comparison
+ * using the original string, that must stay valid while 'p' is in use. */
+void bitmap_pattern_compile(BitmapPattern* p, const char* bits) {
+    p->str = bits;
+    p->bits = 0;
+    p->len = strlen(bits);
+    if(p->len > BITMAP_PATTERN_MAX_BITS) return;
+    for(uint32_t j = 0; j < p->len; j++) p->bits = (p->bits << 1) | (bits[j] == '1');
+}
+
+/* Bit by bit implementation of bitmap_match_bits(), used for patterns
+ * that don't fit into a compiled BitmapPattern. */
+static bool bitmap_match_bits_slow(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits) {
     for(size_t j = 0; bits[j]; j++) {
         bool expected = (bits[j] == '1') ? true : false;
         if(bitmap_get(b, blen, bitpos + j) != expected) return false;
@@ -410,26 +478,72 @@ bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* b
     return true;
 }
 
+/* Return true if the compiled pattern 'p' is found in the 'b' bitmap
+ * of 'blen' bytes at 'bitpos' position. */
+bool bitmap_match_pattern(uint8_t* b, uint32_t blen, uint32_t bitpos, const BitmapPattern* p) {
+    if(p->len > BITMAP_PATTERN_MAX_BITS) return bitmap_match_bits_slow(b, blen, bitpos, p->str);
+    return bitmap_get_bits(b, blen, bitpos, p->len) == p->bits;
+}
+
+/* Return true if the specified sequence of bits, provided as a string in the
+ * form "11010110..." is found in the 'b' bitmap of 'blen' bits at 'bitpos'
+ * position. */
+bool bitmap_match_bits(uint8_t* b, uint32_t blen, uint32_t bitpos, const char* bits) {
+    BitmapPattern p;
+    bitmap_pattern_compile(&p, bits);
+    return bitmap_match_pattern(b, blen, bitpos, &p);
+}
+
+/* Search for the compiled pattern 'p' in the bitmap 'b' of 'blen' bytes,
+ * looking forward at most 'maxbits' ahead. Returns the offset (in bits) of
+ * the match, or BITMAP_SEEK_NOT_FOUND if not found.
+ *
+ * Instead of re-testing the whole pattern at every offset, we keep a
+ * window with the last p->len bits of the bitmap: sliding by one bit
+ * is just a shift plus the next bit, and each offset is tested with a
+ * single comparison. */
+uint32_t bitmap_seek_pattern(
+    uint8_t* b,
+    uint32_t blen,
+    uint32_t startpos,
+    uint32_t maxbits,
+    const BitmapPattern* p) {
+    uint32_t endpos = startpos + blen * 8;
+    uint32_t end2 = startpos + maxbits;
+    if(end2 < endpos) endpos = end2;
+
+    if(p->len > BITMAP_PATTERN_MAX_BITS) {
+        for(uint32_t j = startpos; j < endpos; j++)
+            if(bitmap_match_bits_slow(b, blen, j, p->str)) return j;
+        return BITMAP_SEEK_NOT_FOUND;
+    }
+
+    uint64_t mask = p->len == 64 ? UINT64_MAX : ((uint64_t)1 << p->len) - 1;
+    uint64_t window = bitmap_get_bits(b, blen, startpos, p->len);
+    for(uint32_t j = startpos; j < endpos; j++) {
+        if(window == p->bits) return j;
+        window = ((window << 1) | bitmap_get(b, blen, j + p->len)) & mask;
+    }
+    return BITMAP_SEEK_NOT_FOUND;
+}
+
 /* Search for the specified bit sequence (see bitmap_match_bits() for details)
  * in the bitmap 'b' of 'blen' bytes, looking forward at most 'maxbits' ahead.
  * Returns the offset (in bits) of the match, or BITMAP_SEEK_NOT_FOUND if not
  * found.
  *
- * Note: there are better algorithms, such as Boyer-Moore. Here we hope that
- * for the kind of patterns we search we'll have a lot of early stops so
- * we use a vanilla approach. */
+ * The pattern is compiled once and searched with bitmap_seek_pattern().
+ * Decoders calling this function many times with the same pattern may
+ * want to compile it themselves. */
 uint32_t bitmap_seek_bits(
     uint8_t* b,
     uint32_t blen,
     uint32_t startpos,
     uint32_t maxbits,
     const char* bits) {
-    uint32_t endpos = startpos + blen * 8;
-    uint32_t end2 = startpos + maxbits;
-    if(end2 < endpos) endpos = end2;
-    for(uint32_t j = startpos; j < endpos; j++)
-        if(bitmap_match_bits(b, blen, j, bits)) return j;
-    return BITMAP_SEEK_NOT_FOUND;
+    BitmapPattern p;
+    bitmap_pattern_compile(&p, bits);
+    return bitmap_seek_pattern(b, blen, startpos, maxbits, &p);
 }
 
 /* Compare bitmaps b1 and b2 (possibly overlapping or the same bitmap),
@@ -443,10 +557,26 @@ bool bitmap_match_bitmap(
     uint32_t b2len,
     uint32_t b2off,
     uint32_t cmplen) {
-    for(uint32_t j = 0; j < cmplen; j++) {
-        bool bit1 = bitmap_get(b1, b1len, b1off + j);
-        bool bit2 = bitmap_get(b2, b2len, b2off + j);
-        if(bit1 != bit2) return false;
+    /* Callers may pass UINT32_MAX as a "not yet known" offset: in that
+     * case the offsets wrap around, so stick to the bit by bit
+     * comparison to return exactly the same result as always. */
+    if(b1off + cmplen < b1off || b2off + cmplen < b2off) {
+        for(uint32_t j = 0; j < cmplen; j++) {
+            bool bit1 = bitmap_get(b1, b1len, b1off + j);
+            bool bit2 = bitmap_get(b2, b2len, b2off + j);
+            if(bit1 != bit2) return false;
+        }
+        return true;
+    }
+
+    /* Compare up to 64 bits at a time. */
+    while(cmplen) {
+        uint32_t chunk = cmplen > 64 ? 64 : cmplen;
+        if(bitmap_get_bits(b1, b1len, b1off, chunk) != bitmap_get_bits(b2, b2len, b2off, chunk))
+            return false;
+        b1off += chunk;
+        b2off += chunk;
+        cmplen -= chunk;
     }
     return true;
 }
@@ -530,15 +660,16 @@ uint32_t convert_signal_to_bits(
          * and ignore it completely. */
         if(numbits == 0) continue;
 
-        while(numbits--) bitmap_set(b, blen, bitpos++, level);
+        bitmap_set_run(b, blen, bitpos, numbits, level);
+        bitpos += numbits;
     }
     return bitpos;
 }
 
 /* This function converts the line code used to the final data representation.
  * The representation is put inside 'buf', for up to 'buflen' bytes of total
- * data. For instance in order to convert manchester you can use "10" and "01"
- * as zero and one patterns. However this function does not handle differential
+ * data. The zero and one symbols are given as compiled patterns, see
+ * bitmap_pattern_compile(). This function does not handle differential
  * encodings. See below for convert_from_diff_manchester().
  *
  * The function returns the number of bits converted. It will stop as soon
@@ -546,34 +677,94 @@ uint32_t convert_signal_to_bits(
  * the end of the bitmap pointed by 'bits' is reached (the length is
  * specified in bytes by the caller, via the 'len' parameters).
  *
- * The decoding starts at the specified offset (in bits) 'off'. */
-uint32_t convert_from_line_code(
+ * The decoding starts at the specified offset (in bits) 'off'.
+ *
+ * Both symbols are tested against a single window of bits extracted from
+ * the bitmap, and the decoded bits are accumulated and stored in 'buf' a
+ * byte at a time. */
+uint32_t convert_from_line_code_patterns(
     uint8_t* buf,
     uint64_t buflen,
     uint8_t* bits,
     uint32_t len,
     uint32_t off,
-    const char* zero_pattern,
-    const char* one_pattern) {
+    const BitmapPattern* zero,
+    const BitmapPattern* one) {
     uint32_t decoded = 0; /* Number of bits extracted. */
-    len *= 8; /* Convert bytes to bits. */
-    while(off < len) {
+
+    /* Patterns that don't fit a word (or empty ones) use the bit by bit
+     * path, that can handle everything. */
+    if(zero->len == 0 || zero->len > BITMAP_PATTERN_MAX_BITS || one->len == 0 ||
+       one->len > BITMAP_PATTERN_MAX_BITS) {
+        uint32_t numbits = len * 8; /* Convert bytes to bits. */
+        while(off < numbits) {
+            bool bitval;
+            if(bitmap_match_pattern(bits, len, off, zero)) {
+                bitval = false;
+                off += zero->len;
+            } else if(bitmap_match_pattern(bits, len, off, one)) {
+                bitval = true;
+                off += one->len;
+            } else {
+                break;
+            }
+            bitmap_set(buf, buflen, decoded++, bitval);
+            if(decoded / 8 == buflen) break; /* No space left on target buffer. */
+        }
+        return decoded;
+    }
+
+    uint32_t numbits = len * 8; /* Convert bytes to bits. */
+    uint32_t winlen = zero->len > one->len ? zero->len : one->len;
+    uint8_t acc = 0; /* Decoded bits not yet stored in 'buf'. */
+    while(off < numbits) {
+        uint64_t window = bitmap_get_bits(bits, len, off, winlen);
         bool bitval;
-        if(bitmap_match_bits(bits, len, off, zero_pattern)) {
+        if((window >> (winlen - zero->len)) == zero->bits) {
             bitval = false;
-            off += strlen(zero_pattern);
-        } else if(bitmap_match_bits(bits, len, off, one_pattern)) {
+            off += zero->len;
+        } else if((window >> (winlen - one->len)) == one->bits) {
             bitval = true;
-            off += strlen(one_pattern);
+            off += one->len;
         } else {
             break;
         }
-        bitmap_set(buf, buflen, decoded++, bitval);
+        acc = (acc << 1) | bitval;
+        decoded++;
+        if((decoded & 7) == 0) {
+            buf[decoded / 8 - 1] = acc;
+            acc = 0;
+        }
         if(decoded / 8 == buflen) break; /* No space left on target buffer. */
     }
+
+    /* Store the last partial byte, leaving the bits after the decoded
+     * ones untouched, like bitmap_set() would do. */
+    uint32_t partial = decoded & 7;
+    if(partial && decoded / 8 < buflen) {
+        uint8_t mask = 0xff << (8 - partial);
+        buf[decoded / 8] = (buf[decoded / 8] & ~mask) | (acc << (8 - partial));
+    }
     return decoded;
 }
 
+/* Like convert_from_line_code_patterns(), but the zero and one symbols are
+ * provided as strings in the form "1010...". For instance in order to
+ * convert manchester you can use "10" and "01" as zero and one patterns. */
+uint32_t convert_from_line_code(
+    uint8_t* buf,
+    uint64_t buflen,
+    uint8_t* bits,
+    uint32_t len,
+    uint32_t off,
+    const char* zero_pattern,
+    const char* one_pattern) {
+    BitmapPattern zero, one;
+    bitmap_pattern_compile(&zero, zero_pattern);
+    bitmap_pattern_compile(&one, one_pattern);
+    return convert_from_line_code_patterns(buf, buflen, bits, len, off, &zero, &one);
+}
+
 /* Convert the differential Manchester code to bits. This is similar to
  * convert_from_line_code() but specific for diff-Manchester. The user must
  * supply the value of the previous symbol before this stream, since
@@ -588,10 +779,11 @@ uint32_t convert_from_diff_manchester(
     uint32_t off,
     bool previous) {
     uint32_t decoded = 0;
-    len *= 8; /* Conver to bits. */
-    for(uint32_t j = off; j < len; j += 2) {
-        bool b0 = bitmap_get(bits, len, j);
-        bool b1 = bitmap_get(bits, len, j + 1);
+    uint32_t numbits = len * 8; /* Conver to bits. */
+    for(uint32_t j = off; j < numbits; j += 2) {
+        uint64_t pair = bitmap_get_bits(bits, len, j, 2);
+        bool b0 = pair >> 1;
+        bool b1 = pair & 1;
         if(b0 == previous) break; /* Each new bit must switch value. */
         bitmap_set(buf, buflen, decoded++, b0 == b1);
         previous = b1;
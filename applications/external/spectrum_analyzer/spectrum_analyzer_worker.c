@@ -6,7 +6,13 @@
 
 #include "helpers/radio_device_loader.h"
 
-#include <lib/drivers/cc1101_regs.h>
+#include <cfw/cfw.h>
+
+#include <lib/drivers/cc1101.h>
+#include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
+
+// Synthesizer calibration drifts with temperature
+#define SPECTRUM_ANALYZER_CALIBRATION_PERIOD_MS 30000
 
 struct SpectrumAnalyzerWorker {
     FuriThread* thread;
@@ -16,6 +22,7 @@ struct SpectrumAnalyzerWorker {
     void* callback_context;
 
     const SubGhzDevice* radio_device;
+    FuriHalSpiBusHandle* spi_bus;
 
     uint32_t channel0_frequency;
     uint32_t spacing;
@@ -26,6 +33,15 @@ struct SpectrumAnalyzerWorker {
     uint8_t max_rssi_channel;
 
     uint8_t channel_ss[NUM_CHANNELS];
+
+    // Calibrated channels in visiting order
+    CC1101Channel channels[NUM_CHANNELS];
+    uint8_t channel_index[NUM_CHANNELS];
+    uint8_t channel_rssi[NUM_CHANNELS];
+    size_t channel_count;
+    uint32_t calibrated_channel0_frequency;
+    uint32_t calibrated_spacing;
+    uint32_t calibration_tick;
 };
 
 /* set the channel bandwidth */
@@ -54,6 +70,37 @@ void spectrum_analyzer_worker_set_filter(SpectrumAnalyzerWorker* instance) {
     // furi_hal_subghz_load_registers((uint8_t*)filter_config);
 }
 
+static void spectrum_analyzer_worker_calibrate(
+    SpectrumAnalyzerWorker* instance,
+    uint32_t channel0_frequency,
+    uint32_t spacing) {
+    instance->channel_count = 0;
+    instance->calibrated_channel0_frequency = channel0_frequency;
+    instance->calibrated_spacing = spacing;
+    instance->calibration_tick = furi_get_tick();
+
+    furi_hal_spi_acquire(instance->spi_bus);
+
+    // Visit each channel non-consecutively
+    for(uint8_t ch_offset = 0, chunk = 0; ch_offset < CHUNK_SIZE;
+        ++chunk >= NUM_CHUNKS && ++ch_offset && (chunk = 0)) {
+        uint8_t ch = chunk * CHUNK_SIZE + ch_offset;
+        uint32_t frequency = channel0_frequency + (ch * spacing);
+
+        if(!subghz_devices_is_frequency_valid(instance->radio_device, frequency)) continue;
+
+        if(!cc1101_calibrate_channel(
+               instance->spi_bus, frequency, &instance->channels[instance->channel_count])) {
+            FURI_LOG_E("SpectrumWorker", "Calibration failed at %lu", frequency);
+            instance->channel_count = 0;
+            break;
+        }
+        instance->channel_index[instance->channel_count++] = ch;
+    }
+
+    furi_hal_spi_release(instance->spi_bus);
+}
+
 static int32_t spectrum_analyzer_worker_thread(void* context) {
     furi_assert(context);
     SpectrumAnalyzerWorker* instance = context;
@@ -205,37 +252,47 @@ static int32_t spectrum_analyzer_worker_thread(void* context) {
         // TODO: Check filter!
         // spectrum_analyzer_worker_set_filter(instance);
 
-        instance->max_rssi_dec = 0;
+        uint32_t channel0_frequency = instance->channel0_frequency;
+        uint32_t spacing = instance->spacing;
+        if(!instance->channel_count ||
+           channel0_frequency != instance->calibrated_channel0_frequency ||
+           spacing != instance->calibrated_spacing ||
+           furi_get_tick() - instance->calibration_tick >
+               furi_ms_to_ticks(SPECTRUM_ANALYZER_CALIBRATION_PERIOD_MS)) {
+            spectrum_analyzer_worker_calibrate(instance, channel0_frequency, spacing);
+        }
 
-        // Visit each channel non-consecutively
-        for(uint8_t ch_offset = 0, chunk = 0; ch_offset < CHUNK_SIZE;
-            ++chunk >= NUM_CHUNKS && ++ch_offset && (chunk = 0)) {
-            uint8_t ch = chunk * CHUNK_SIZE + ch_offset;
+        furi_hal_spi_acquire(instance->spi_bus);
+        bool swept = cc1101_sweep(
+            instance->spi_bus,
+            instance->channels,
+            instance->channel_count,
+            instance->channel_rssi);
+        furi_hal_spi_release(instance->spi_bus);
+        if(!swept) {
+            FURI_LOG_E("SpectrumWorker", "Sweep failed");
+            instance->channel_count = 0;
+            continue;
+        }
 
-            if(subghz_devices_is_frequency_valid(
-                   instance->radio_device,
-                   instance->channel0_frequency + (ch * instance->spacing)))
-                subghz_devices_set_frequency(
-                    instance->radio_device,
-                    instance->channel0_frequency + (ch * instance->spacing));
+        instance->max_rssi_dec = 0;
+        memset(instance->channel_ss, 0, sizeof(instance->channel_ss));
 
-            subghz_devices_set_rx(instance->radio_device);
-            furi_delay_ms(3);
+        for(size_t i = 0; i < instance->channel_count; i++) {
+            uint8_t ch = instance->channel_index[i];
 
             //         dec      dBm
             //max_ss = 127 ->  -10.5
             //max_ss = 0   ->  -74.0
             //max_ss = 255 ->  -74.5
             //max_ss = 128 -> -138.0
-            instance->channel_ss[ch] = (subghz_devices_get_rssi(instance->radio_device) + 138) * 2;
+            instance->channel_ss[ch] = (cc1101_rssi_to_dbm(instance->channel_rssi[i]) + 138) * 2;
 
             if(instance->channel_ss[ch] > instance->max_rssi_dec) {
                 instance->max_rssi_dec = instance->channel_ss[ch];
                 instance->max_rssi = (instance->channel_ss[ch] / 2) - 138;
                 instance->max_rssi_channel = ch;
             }
-
-            subghz_devices_idle(instance->radio_device);
         }
 
         // FURI_LOG_T("SpectrumWorker", "channel_ss[0]: %u", instance->channel_ss[0]);
@@ -269,6 +326,14 @@ SpectrumAnalyzerWorker* spectrum_analyzer_worker_alloc() {
 
     instance->radio_device =
         radio_device_loader_set(instance->radio_device, SubGhzRadioDeviceTypeExternalCC1101);
+    if(instance->radio_device == subghz_devices_get_by_name(SUBGHZ_DEVICE_CC1101_INT_NAME)) {
+        instance->spi_bus = &furi_hal_spi_bus_handle_subghz;
+    } else {
+        // Same bus selection as the cc1101_ext driver
+        instance->spi_bus =
+            (cfw_settings.spi_cc1101_handle == SpiDefault ? &furi_hal_spi_bus_handle_external :
+                                                            &furi_hal_spi_bus_handle_external_extra);
+    }
 
     FURI_LOG_D("Spectrum", "spectrum_analyzer_worker_alloc: End");
 
@@ -346,8 +346,20 @@ void infrared_tx_start(InfraredApp* infrared) {
 
     if(infrared_signal_is_raw(infrared->current_signal)) {
         const InfraredRawSignal* raw = infrared_signal_get_raw_signal(infrared->current_signal);
-        infrared_worker_set_raw_signal(
-            infrared->worker, raw->timings, raw->timings_size, raw->frequency, raw->duty_cycle);
+        const InfraredRawCompact* compact =
+            infrared_signal_get_raw_compact(infrared->current_signal);
+        if(compact) {
+            // Current signal is not changed while it is being transmitted
+            infrared_worker_set_raw_compact_signal(
+                infrared->worker, compact, raw->frequency, raw->duty_cycle);
+        } else {
+            infrared_worker_set_raw_signal(
+                infrared->worker,
+                raw->timings,
+                raw->timings_size,
+                raw->frequency,
+                raw->duty_cycle);
+        }
     } else {
         const InfraredMessage* message = infrared_signal_get_message(infrared->current_signal);
         infrared_worker_set_decoded_signal(infrared->worker, message);
@@ -254,6 +254,8 @@ static bool infrared_cli_decode_file(FlipperFormat* input_file, FlipperFormat* o
     bool ret = false;
 
     InfraredSignal* signal = infrared_signal_alloc();
+    // Decode and save exactly the recorded timings
+    infrared_signal_set_compact_read(signal, false);
     InfraredDecoderHandler* decoder = infrared_alloc_decoder();
 
     FuriString* tmp;
@@ -179,6 +179,9 @@ static bool infrared_remote_batch_start(
         status = storage_common_stat(storage, path_out, NULL);
     } while(status == FSE_OK || status == FSE_EXIST);
 
+    // Signals are written back, keep their timings exact
+    infrared_signal_set_compact_read(batch_context.signal, false);
+
     bool success = false;
 
     do {
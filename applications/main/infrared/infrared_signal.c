@@ -32,6 +32,10 @@ struct InfraredSignal {
         InfraredMessage message;
         InfraredRawSignal raw;
     } payload;
+    /* Raw signal in compact form, timings are expanded only on request */
+    InfraredRawCompact* compact;
+    /* Raw signals read from file are held in compact form when possible */
+    bool compact_read;
 };
 
 static void infrared_signal_clear_timings(InfraredSignal* signal) {
@@ -40,6 +44,43 @@ static void infrared_signal_clear_timings(InfraredSignal* signal) {
         signal->payload.raw.timings_size = 0;
         signal->payload.raw.timings = NULL;
     }
+    if(signal->compact) {
+        infrared_raw_compact_free(signal->compact);
+        signal->compact = NULL;
+    }
+}
+
+static uint32_t infrared_signal_clamp_frequency(uint32_t frequency) {
+    if(frequency > INFRARED_MAX_FREQUENCY) {
+        return INFRARED_MAX_FREQUENCY;
+    } else if(frequency < INFRARED_MIN_FREQUENCY) {
+        return INFRARED_MIN_FREQUENCY;
+    }
+    return frequency;
+}
+
+static float infrared_signal_clamp_duty_cycle(float duty_cycle) {
+    if((duty_cycle <= (float)0) || (duty_cycle > (float)1)) {
+        return (float)0.33;
+    }
+    return duty_cycle;
+}
+
+/* Takes ownership of compact */
+static void infrared_signal_set_raw_compact(
+    InfraredSignal* signal,
+    InfraredRawCompact* compact,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_signal_clear_timings(signal);
+
+    signal->is_raw = true;
+    signal->compact = compact;
+
+    signal->payload.raw.timings_size = infrared_raw_compact_get_timings_size(compact);
+    signal->payload.raw.timings = NULL;
+    signal->payload.raw.frequency = infrared_signal_clamp_frequency(frequency);
+    signal->payload.raw.duty_cycle = infrared_signal_clamp_duty_cycle(duty_cycle);
 }
 
 static bool infrared_signal_is_message_valid(const InfraredMessage* message) {
@@ -113,14 +154,25 @@ static inline bool
                ff, INFRARED_SIGNAL_COMMAND_KEY, (uint8_t*)&message->command, 4);
 }
 
-static inline bool infrared_signal_save_raw(const InfraredRawSignal* raw, FlipperFormat* ff) {
+static inline bool infrared_signal_save_raw(const InfraredSignal* signal, FlipperFormat* ff) {
+    const InfraredRawSignal* raw = &signal->payload.raw;
     furi_assert(raw->timings_size <= MAX_TIMINGS_AMOUNT);
-    return flipper_format_write_string_cstr(
-               ff, INFRARED_SIGNAL_TYPE_KEY, INFRARED_SIGNAL_TYPE_RAW) &&
-           flipper_format_write_uint32(ff, INFRARED_SIGNAL_FREQUENCY_KEY, &raw->frequency, 1) &&
-           flipper_format_write_float(ff, INFRARED_SIGNAL_DUTY_CYCLE_KEY, &raw->duty_cycle, 1) &&
-           flipper_format_write_uint32(
-               ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, raw->timings_size);
+
+    // Compact form only exists in memory, files always hold plain timings
+    uint32_t* timings = raw->timings;
+    if(signal->compact) {
+        timings = malloc(raw->timings_size * sizeof(uint32_t));
+        infrared_raw_compact_expand(signal->compact, timings);
+    }
+
+    const bool success =
+        flipper_format_write_string_cstr(ff, INFRARED_SIGNAL_TYPE_KEY, INFRARED_SIGNAL_TYPE_RAW) &&
+        flipper_format_write_uint32(ff, INFRARED_SIGNAL_FREQUENCY_KEY, &raw->frequency, 1) &&
+        flipper_format_write_float(ff, INFRARED_SIGNAL_DUTY_CYCLE_KEY, &raw->duty_cycle, 1) &&
+        flipper_format_write_uint32(ff, INFRARED_SIGNAL_DATA_KEY, timings, raw->timings_size);
+
+    if(signal->compact) free(timings);
+    return success;
 }
 
 static inline bool infrared_signal_read_message(InfraredSignal* signal, FlipperFormat* ff) {
@@ -168,7 +220,14 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
             free(timings);
             break;
         }
-        infrared_signal_set_raw_signal(signal, timings, timings_size, frequency, duty_cycle);
+
+        InfraredRawCompact* compact =
+            signal->compact_read ? infrared_raw_compact_alloc(timings, timings_size) : NULL;
+        if(compact) {
+            infrared_signal_set_raw_compact(signal, compact, frequency, duty_cycle);
+        } else {
+            infrared_signal_set_raw_signal(signal, timings, timings_size, frequency, duty_cycle);
+        }
         free(timings);
 
         success = true;
@@ -206,6 +265,8 @@ InfraredSignal* infrared_signal_alloc() {
 
     signal->is_raw = false;
     signal->payload.message.protocol = InfraredProtocolUnknown;
+    signal->compact = NULL;
+    signal->compact_read = true;
 
     return signal;
 }
@@ -225,7 +286,14 @@ bool infrared_signal_is_valid(const InfraredSignal* signal) {
 }
 
 void infrared_signal_set_signal(InfraredSignal* signal, const InfraredSignal* other) {
-    if(other->is_raw) {
+    if(other->compact) {
+        const InfraredRawSignal* raw = &other->payload.raw;
+        infrared_signal_set_raw_compact(
+            signal,
+            infrared_raw_compact_alloc_copy(other->compact),
+            raw->frequency,
+            raw->duty_cycle);
+    } else if(other->is_raw) {
         const InfraredRawSignal* raw = &other->payload.raw;
         infrared_signal_set_raw_signal(
             signal, raw->timings, raw->timings_size, raw->frequency, raw->duty_cycle);
@@ -245,14 +313,8 @@ void infrared_signal_set_raw_signal(
 
     // If the frequency is out of bounds, set it to the closest bound same for duty cycle
     // TODO: Should we return error instead? Also infrared_signal_is_valid is used only in CLI for some reason?!
-    if(frequency > INFRARED_MAX_FREQUENCY) {
-        frequency = INFRARED_MAX_FREQUENCY;
-    } else if(frequency < INFRARED_MIN_FREQUENCY) {
-        frequency = INFRARED_MIN_FREQUENCY;
-    }
-    if((duty_cycle <= (float)0) || (duty_cycle > (float)1)) {
-        duty_cycle = (float)0.33;
-    }
+    frequency = infrared_signal_clamp_frequency(frequency);
+    duty_cycle = infrared_signal_clamp_duty_cycle(duty_cycle);
     // In case of timings out of bounds we just call return
     if((timings_size <= 0) || (timings_size > MAX_TIMINGS_AMOUNT)) {
         return;
@@ -273,6 +335,15 @@ const InfraredRawSignal* infrared_signal_get_raw_signal(const InfraredSignal* si
     return &signal->payload.raw;
 }
 
+const InfraredRawCompact* infrared_signal_get_raw_compact(const InfraredSignal* signal) {
+    furi_assert(signal->is_raw);
+    return signal->compact;
+}
+
+void infrared_signal_set_compact_read(InfraredSignal* signal, bool enable) {
+    signal->compact_read = enable;
+}
+
 void infrared_signal_set_message(InfraredSignal* signal, const InfraredMessage* message) {
     infrared_signal_clear_timings(signal);
 
@@ -290,7 +361,7 @@ bool infrared_signal_save(const InfraredSignal* signal, FlipperFormat* ff, const
        !flipper_format_write_string_cstr(ff, INFRARED_SIGNAL_NAME_KEY, name)) {
         return false;
     } else if(signal->is_raw) {
-        return infrared_signal_save_raw(&signal->payload.raw, ff);
+        return infrared_signal_save_raw(signal, ff);
     } else {
         return infrared_signal_save_message(&signal->payload.message, ff);
     }
@@ -350,7 +421,11 @@ bool infrared_signal_search_by_index_and_read(
 }
 
 void infrared_signal_transmit(const InfraredSignal* signal) {
-    if(signal->is_raw) {
+    if(signal->compact) {
+        const InfraredRawSignal* raw_signal = &signal->payload.raw;
+        infrared_send_raw_compact(
+            signal->compact, raw_signal->frequency, raw_signal->duty_cycle);
+    } else if(signal->is_raw) {
         const InfraredRawSignal* raw_signal = &signal->payload.raw;
         infrared_send_raw_ext(
             raw_signal->timings,
@@ -5,11 +5,16 @@
  * Infrared signals may be of two types:
  * - known to the infrared signal decoder, or *parsed* signals
  * - the rest, or *raw* signals, which are treated merely as a set of timings.
+ *
+ * Raw signals are always saved as plain timings, which every .ir reader understands.
+ * When read from a file, they are held in compact form (see infrared_raw_compact.h)
+ * if their timings fit it, and transmitted without expanding the timings.
  */
 #pragma once
 
 #include <flipper_format/flipper_format.h>
 #include <infrared/encoder_decoder/infrared.h>
+#include <infrared/worker/infrared_raw_compact.h>
 
 /**
  * @brief InfraredSignal opaque type declaration.
@@ -26,7 +31,7 @@ typedef struct InfraredSignal InfraredSignal;
  */
 typedef struct {
     size_t timings_size; /**< Number of elements in the timings array. */
-    uint32_t* timings; /**< Pointer to an array of timings describing the signal. */
+    uint32_t* timings; /**< Pointer to an array of timings describing the signal, NULL for compact signals. */
     uint32_t frequency; /**< Carrier frequency of the signal. */
     float duty_cycle; /**< Duty cycle of the signal. */
 } InfraredRawSignal;
@@ -96,6 +101,8 @@ void infrared_signal_set_raw_signal(
 /**
  * @brief Get the raw signal held by an InfraredSignal instance.
  *
+ * Timings are NULL if the signal is held in compact form, see infrared_signal_get_raw_compact().
+ *
  * @warning the instance MUST hold a *raw* signal, otherwise undefined behaviour will occur.
  *
  * @param[in] signal pointer to the instance to be queried.
@@ -103,6 +110,28 @@ void infrared_signal_set_raw_signal(
  */
 const InfraredRawSignal* infrared_signal_get_raw_signal(const InfraredSignal* signal);
 
+/**
+ * @brief Get the compact form of a raw signal held by an InfraredSignal instance.
+ *
+ * @warning the instance MUST hold a *raw* signal, otherwise undefined behaviour will occur.
+ *
+ * @param[in] signal pointer to the instance to be queried.
+ * @returns pointer to the compact signal or NULL if the signal is held as plain timings.
+ */
+const InfraredRawCompact* infrared_signal_get_raw_compact(const InfraredSignal* signal);
+
+/**
+ * @brief Choose whether raw signals read into an InfraredSignal instance are held in compact form.
+ *
+ * Enabled by default. Compact form replays every timing within INFRARED_RAW_COMPACT_TOLERANCE
+ * of the original one, so disable it where exact timings matter, e.g. when signals are decoded
+ * or written back to a file.
+ *
+ * @param[in,out] signal pointer to the instance to be configured.
+ * @param[in] enable true to hold raw signals read from files in compact form, false otherwise.
+ */
+void infrared_signal_set_compact_read(InfraredSignal* signal, bool enable);
+
 /**
  * @brief Set an InfraredInstance to hold a parsed signal.
  *
@@ -80,9 +80,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        // Dictionary continues from the same key, keys before it already failed on sector
         instance->nfc_dict_context.is_key_attack = false;
-        instance->nfc_dict_context.dict_keys_current = 0;
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
@@ -177,6 +176,15 @@ void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
 
 static void nfc_scene_mf_classic_dict_attack_notify_read(NfcApp* instance) {
     const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+
+    // Found keys include cached ones, so next read of this card needs no dictionary
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    mf_classic_get_read_sectors_and_keys(mfc_data, &sectors_read, &keys_found);
+    if(keys_found && !mf_classic_key_cache_save(instance->mfc_key_cache, mfc_data)) {
+        FURI_LOG_W(TAG, "Failed to save key cache");
+    }
+
     bool is_card_fully_read = mf_classic_is_card_read(mfc_data);
     if(is_card_fully_read) {
         notification_message(instance->notifications, &sequence_success);
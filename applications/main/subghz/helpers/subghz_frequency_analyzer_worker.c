@@ -8,6 +8,13 @@
 
 #define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD -97.0f
 
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN 300000
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP 20000
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_COUNT \
+    (2 * SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN / SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP)
+// Synthesizer calibration drifts with temperature
+#define SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_PERIOD_MS 30000
+
 static const uint8_t subghz_preset_ook_58khz[][2] = {
     {CC1101_MDMCFG4, 0b11110111}, // Rx BW filter is 58.035714kHz
     /* End  */
@@ -51,6 +58,66 @@ static void subghz_frequency_analyzer_worker_load_registers(
     furi_hal_spi_release(spi_bus);
 }
 
+static bool subghz_frequency_analyzer_worker_is_coarse_frequency(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint32_t frequency) {
+    return subghz_devices_is_frequency_valid(instance->radio_device, frequency) &&
+           (frequency != 467750000) && (frequency != 464000000) &&
+           !((instance->ext_radio) &&
+             ((frequency == 390000000) || (frequency == 312000000) ||
+              (frequency == 312100000) || (frequency == 312200000) ||
+              (frequency == 440175000)));
+}
+
+static void subghz_frequency_analyzer_worker_calibrate(
+    FuriHalSpiBusHandle* spi_bus,
+    uint32_t frequency,
+    CC1101Channel* channel) {
+    furi_hal_spi_acquire(spi_bus);
+    furi_check(cc1101_calibrate_channel(spi_bus, frequency, channel));
+    furi_hal_spi_release(spi_bus);
+}
+
+static size_t subghz_frequency_analyzer_worker_calibrate_coarse(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    CC1101Channel* channels) {
+    size_t count = 0;
+    for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
+        uint32_t frequency = subghz_setting_get_frequency(instance->setting, i);
+        if(subghz_frequency_analyzer_worker_is_coarse_frequency(instance, frequency)) {
+            subghz_frequency_analyzer_worker_calibrate(
+                instance->spi_bus, frequency, &channels[count++]);
+        }
+    }
+    return count;
+}
+
+static size_t subghz_frequency_analyzer_worker_calibrate_fine(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint32_t frequency_coarse,
+    CC1101Channel* channels) {
+    size_t count = 0;
+    //for example -0.3 ... 433.92 ... +0.3 step 20KHz
+    for(uint32_t i = frequency_coarse - SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+        i < frequency_coarse + SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+        i += SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP) {
+        if(subghz_devices_is_frequency_valid(instance->radio_device, i)) {
+            subghz_frequency_analyzer_worker_calibrate(instance->spi_bus, i, &channels[count++]);
+        }
+    }
+    return count;
+}
+
+static void subghz_frequency_analyzer_worker_sweep(
+    FuriHalSpiBusHandle* spi_bus,
+    const CC1101Channel* channels,
+    size_t count,
+    uint8_t* rssi) {
+    furi_hal_spi_acquire(spi_bus);
+    furi_check(cc1101_sweep(spi_bus, channels, count, rssi));
+    furi_hal_spi_release(spi_bus);
+}
+
 // running average with adaptive coefficient
 static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     SubGhzFrequencyAnalyzerWorker* instance,
@@ -85,6 +152,17 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     FuriHalSpiBusHandle* spi_bus = instance->spi_bus;
     const SubGhzDevice* radio_device = instance->radio_device;
 
+    // Channels are calibrated once and swept without recalibration
+    size_t coarse_max = subghz_setting_get_frequency_count(instance->setting);
+    CC1101Channel* coarse_channels = malloc(sizeof(CC1101Channel) * coarse_max);
+    size_t coarse_count = 0;
+    CC1101Channel* fine_channels =
+        malloc(sizeof(CC1101Channel) * SUBGHZ_FREQUENCY_ANALYZER_FINE_COUNT);
+    size_t fine_count = 0;
+    uint32_t fine_frequency = 0;
+    uint8_t* rssi_raw = malloc(MAX(coarse_max, (size_t)SUBGHZ_FREQUENCY_ANALYZER_FINE_COUNT));
+    uint32_t calibration_tick = 0;
+
     //Start CC1101
     // furi_hal_subghz_reset();
     subghz_devices_reset(radio_device);
@@ -117,6 +195,14 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     while(instance->worker_running) {
         furi_delay_ms(10);
 
+        if(!coarse_count || (furi_get_tick() - calibration_tick >
+                             furi_ms_to_ticks(SUBGHZ_FREQUENCY_ANALYZER_CALIBRATION_PERIOD_MS))) {
+            coarse_count =
+                subghz_frequency_analyzer_worker_calibrate_coarse(instance, coarse_channels);
+            fine_frequency = 0;
+            calibration_tick = furi_get_tick();
+        }
+
         float rssi_min = 26.0f;
         float rssi_avg = 0;
         size_t rssi_avg_samples = 0;
@@ -128,40 +214,19 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
         subghz_frequency_analyzer_worker_load_registers(spi_bus, subghz_preset_ook_650khz);
 
         // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            uint32_t current_frequency = subghz_setting_get_frequency(instance->setting, i);
-            // if(furi_hal_subghz_is_frequency_valid(current_frequency) &&
-            if(subghz_devices_is_frequency_valid(radio_device, current_frequency) &&
-               (current_frequency != 467750000) && (current_frequency != 464000000) &&
-               !((instance->ext_radio) &&
-                 ((current_frequency == 390000000) || (current_frequency == 312000000) ||
-                  (current_frequency == 312100000) || (current_frequency == 312200000) ||
-                  (current_frequency == 440175000)))) {
-                furi_hal_spi_acquire(spi_bus);
-                cc1101_switch_to_idle(spi_bus);
-                frequency = cc1101_set_frequency(spi_bus, current_frequency);
-
-                cc1101_calibrate(spi_bus);
-
-                furi_check(cc1101_wait_status_state(spi_bus, CC1101StateIDLE, 10000));
-
-                cc1101_switch_to_rx(spi_bus);
-                furi_hal_spi_release(spi_bus);
-
-                furi_delay_ms(2);
-
-                // rssi = furi_hal_subghz_get_rssi();
-                rssi = subghz_devices_get_rssi(radio_device);
+        subghz_frequency_analyzer_worker_sweep(spi_bus, coarse_channels, coarse_count, rssi_raw);
+        for(size_t i = 0; i < coarse_count; i++) {
+            frequency = coarse_channels[i].frequency;
+            rssi = cc1101_rssi_to_dbm(rssi_raw[i]);
 
-                rssi_avg += rssi;
-                rssi_avg_samples++;
+            rssi_avg += rssi;
+            rssi_avg_samples++;
 
-                if(rssi < rssi_min) rssi_min = rssi;
+            if(rssi < rssi_min) rssi_min = rssi;
 
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
+            if(frequency_rssi.rssi_coarse < rssi) {
+                frequency_rssi.rssi_coarse = rssi;
+                frequency_rssi.frequency_coarse = frequency;
             }
         }
 
@@ -175,37 +240,26 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
         // Second stage: fine scan
         if(frequency_rssi.rssi_coarse > instance->trigger_level) {
+            // Calibration is kept while the signal stays on the same coarse frequency
+            if(fine_frequency != frequency_rssi.frequency_coarse) {
+                fine_count = subghz_frequency_analyzer_worker_calibrate_fine(
+                    instance, frequency_rssi.frequency_coarse, fine_channels);
+                fine_frequency = frequency_rssi.frequency_coarse;
+            }
+
             // furi_hal_subghz_idle();
             subghz_devices_idle(radio_device);
             subghz_frequency_analyzer_worker_load_registers(spi_bus, subghz_preset_ook_58khz);
-            //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
-                // if(furi_hal_subghz_is_frequency_valid(i)) {
-                if(subghz_devices_is_frequency_valid(radio_device, i)) {
-                    furi_hal_spi_acquire(spi_bus);
-                    cc1101_switch_to_idle(spi_bus);
-                    frequency = cc1101_set_frequency(spi_bus, i);
-
-                    cc1101_calibrate(spi_bus);
-
-                    furi_check(cc1101_wait_status_state(spi_bus, CC1101StateIDLE, 10000));
+            subghz_frequency_analyzer_worker_sweep(spi_bus, fine_channels, fine_count, rssi_raw);
+            for(size_t i = 0; i < fine_count; i++) {
+                frequency = fine_channels[i].frequency;
+                rssi = cc1101_rssi_to_dbm(rssi_raw[i]);
 
-                    cc1101_switch_to_rx(spi_bus);
-                    furi_hal_spi_release(spi_bus);
+                FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
 
-                    furi_delay_ms(2);
-
-                    // rssi = furi_hal_subghz_get_rssi();
-                    rssi = subghz_devices_get_rssi(radio_device);
-
-                    FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
-
-                    if(frequency_rssi.rssi_fine < rssi) {
-                        frequency_rssi.rssi_fine = rssi;
-                        frequency_rssi.frequency_fine = frequency;
-                    }
+                if(frequency_rssi.rssi_fine < rssi) {
+                    frequency_rssi.rssi_fine = rssi;
+                    frequency_rssi.frequency_fine = frequency;
                 }
             }
         }
@@ -280,6 +334,10 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     subghz_devices_idle(radio_device);
     subghz_devices_sleep(radio_device);
 
+    free(rssi_raw);
+    free(fine_channels);
+    free(coarse_channels);
+
     return 0;
 }
 
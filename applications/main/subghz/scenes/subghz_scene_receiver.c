@@ -220,10 +220,10 @@ static void subghz_scene_add_to_history_callback(
                     furi_record_close(RECORD_STORAGE);
                     free(dir);
                     // Save
-                    subghz_save_protocol_to_file(
-                        subghz,
-                        subghz_history_get_raw_data(history, idx),
-                        furi_string_get_cstr(path));
+                    FlipperFormat* raw_data = subghz_history_get_raw_data(history, idx);
+                    if(raw_data) {
+                        subghz_save_protocol_to_file(subghz, raw_data, furi_string_get_cstr(path));
+                    }
                     furi_string_free(path);
                 }
 
@@ -420,13 +420,16 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
                 subghz->history, subghz_history_get_last_index(subghz->history) - 1);
 
             uint32_t tmpTe = 300;
-            if(!flipper_format_rewind(key_repeat_data)) {
+            if(!key_repeat_data) {
+                FURI_LOG_E(TAG, "Missing signal data");
+            } else if(!flipper_format_rewind(key_repeat_data)) {
                 FURI_LOG_E(TAG, "Rewind error");
             } else if(!flipper_format_read_uint32(key_repeat_data, "TE", (uint32_t*)&tmpTe, 1)) {
                 FURI_LOG_E(TAG, "Missing TE");
             }
 
-            if(subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
+            if(!key_repeat_data ||
+               subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewRepeaterStop);
             } else {
@@ -455,12 +458,10 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         case SubGhzCustomEventViewReceiverOKLong:
             subghz_txrx_stop(subghz->txrx);
             subghz_txrx_hopper_pause(subghz->txrx);
-            if(subghz_txrx_tx_start(
-                   subghz->txrx,
-                   subghz_history_get_raw_data(
-                       subghz->history,
-                       subghz_view_receiver_get_idx_menu(subghz->subghz_receiver))) !=
-               SubGhzTxRxStartTxStateOk) {
+            FlipperFormat* tx_data = subghz_history_get_raw_data(
+                subghz->history, subghz_view_receiver_get_idx_menu(subghz->subghz_receiver));
+            if(!tx_data ||
+               subghz_txrx_tx_start(subghz->txrx, tx_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewReceiverOKRelease);
             } else {
@@ -1,32 +1,60 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <lib/toolbox/stream/stream.h>
 #include <rpc/rpc.h>
+#include <storage/storage.h>
+#include <m-dict.h>
 
 #include <furi.h>
 
 #define SUBGHZ_HISTORY_MAX 65535 // uint16_t index max, ram limit below
 #define SUBGHZ_HISTORY_FREE_HEAP (10240 * (3 - MIN(rpc_get_sessions_count(instance->rpc), 2U)))
+#define SUBGHZ_HISTORY_ITEM_STR_SIZE 32
+#define SUBGHZ_HISTORY_SPILL_PATH EXT_PATH("subghz/.history.tmp")
+#define SUBGHZ_HISTORY_SPILL_MAX_SIZE (4 * 1024 * 1024)
 #define TAG "SubGhzHistory"
 
+/* Fixed size record kept in RAM for every received signal.
+ * The serialized signal lives in the spill file on SD card (data_offset),
+ * or in a heap buffer (data) if SD card is not available. */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-    DateTime datetime;
-    uint32_t hash_data;
     const SubGhzProtocol* protocol;
-    uint16_t repeats;
+    uint64_t key;
+    uint32_t hash_data;
+    uint32_t frequency;
+    uint32_t timestamp;
     float latitude;
     float longitude;
+    uint8_t* data;
+    uint32_t data_offset;
+    uint16_t data_size;
+    uint16_t repeats;
+    uint8_t preset_index;
+    uint8_t type;
+    char item_str[SUBGHZ_HISTORY_ITEM_STR_SIZE];
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
+
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
+
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
+// (protocol, hash) -> repeat count of the last record with this key
+DICT_DEF2(SubGhzHistoryRepeatDict, uint64_t, M_DEFAULT_OPLIST, uint16_t, M_DEFAULT_OPLIST)
+
 typedef struct {
     SubGhzHistoryItemArray_t data;
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzHistoryRepeatDict_t repeats;
 } SubGhzHistoryStruct;
 
 struct SubGhzHistory {
@@ -36,14 +64,98 @@ struct SubGhzHistory {
     FuriString* tmp_string;
     SubGhzHistoryStruct* history;
     Rpc* rpc;
+
+    Storage* storage;
+    File* spill_file;
+    uint32_t spill_size;
+    uint8_t* spill_buffer;
+    size_t spill_buffer_size;
+
+    FlipperFormat* serialize_data;
+    FlipperFormat* raw_data;
+    SubGhzRadioPreset raw_preset;
 };
 
+static inline uint64_t subghz_history_key(const SubGhzProtocol* protocol, uint32_t hash_data) {
+    return ((uint64_t)(uintptr_t)protocol << 32) | hash_data;
+}
+
+static inline SubGhzHistoryItem* subghz_history_get(SubGhzHistory* instance, uint16_t idx) {
+    return SubGhzHistoryItemArray_get(instance->history->data, idx);
+}
+
+static void subghz_history_spill_open(SubGhzHistory* instance) {
+    instance->spill_size = 0;
+    if(storage_sd_status(instance->storage) != FSE_OK ||
+       !storage_file_open(
+           instance->spill_file, SUBGHZ_HISTORY_SPILL_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Spill file unavailable, keeping history in RAM");
+        storage_file_close(instance->spill_file);
+    }
+}
+
+static void subghz_history_spill_rewind(SubGhzHistory* instance) {
+    if(!storage_file_is_open(instance->spill_file)) return;
+    if(!storage_file_seek(instance->spill_file, 0, true) ||
+       !storage_file_truncate(instance->spill_file)) {
+        FURI_LOG_E(TAG, "Spill file rewind error");
+    }
+    instance->spill_size = 0;
+}
+
+static void subghz_history_reserve_buffer(SubGhzHistory* instance, size_t size) {
+    if(instance->spill_buffer_size < size) {
+        instance->spill_buffer = realloc(instance->spill_buffer, size); //-V701
+        instance->spill_buffer_size = size;
+    }
+}
+
+static void subghz_history_item_free(SubGhzHistoryItem* item) {
+    free(item->data);
+    item->data = NULL;
+    item->type = 0;
+}
+
+static uint8_t subghz_history_get_preset_index(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    size_t count = SubGhzHistoryPresetArray_size(instance->history->presets);
+    for(size_t i = 0; i < count; i++) {
+        SubGhzHistoryPreset* entry = SubGhzHistoryPresetArray_get(instance->history->presets, i);
+        if(entry->data == preset->data && furi_string_equal(entry->name, preset->name)) {
+            return i;
+        }
+    }
+    furi_check(count <= UINT8_MAX);
+    SubGhzHistoryPreset* entry = SubGhzHistoryPresetArray_push_raw(instance->history->presets);
+    entry->name = furi_string_alloc_set(preset->name);
+    entry->data = preset->data;
+    entry->data_size = preset->data_size;
+    return count;
+}
+
+static void subghz_history_presets_reset(SubGhzHistory* instance) {
+    for
+        M_EACH(entry, instance->history->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(entry->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->history->presets);
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     instance->tmp_string = furi_string_alloc();
     instance->history = malloc(sizeof(SubGhzHistoryStruct));
     SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryPresetArray_init(instance->history->presets);
+    SubGhzHistoryRepeatDict_init(instance->history->repeats);
     instance->rpc = furi_record_open(RECORD_RPC);
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->spill_file = storage_file_alloc(instance->storage);
+    subghz_history_spill_open(instance);
+
+    instance->serialize_data = flipper_format_string_alloc();
+    instance->raw_data = flipper_format_string_alloc();
+    instance->raw_preset.name = furi_string_alloc();
     return instance;
 }
 
@@ -52,63 +164,85 @@ void subghz_history_free(SubGhzHistory* instance) {
     furi_string_free(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(item);
         }
     SubGhzHistoryItemArray_clear(instance->history->data);
+    subghz_history_presets_reset(instance);
+    SubGhzHistoryPresetArray_clear(instance->history->presets);
+    SubGhzHistoryRepeatDict_clear(instance->history->repeats);
     free(instance->history);
     furi_record_close(RECORD_RPC);
+
+    if(storage_file_is_open(instance->spill_file)) {
+        storage_file_close(instance->spill_file);
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_SPILL_PATH);
+    }
+    storage_file_free(instance->spill_file);
+    furi_record_close(RECORD_STORAGE);
+    free(instance->spill_buffer);
+
+    flipper_format_free(instance->serialize_data);
+    flipper_format_free(instance->raw_data);
+    furi_string_free(instance->raw_preset.name);
     free(instance);
 }
 
 uint32_t subghz_history_get_hash_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->hash_data;
 }
 
 const SubGhzProtocol* subghz_history_get_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->protocol;
 }
 
 uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->repeats;
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    return item->frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    SubGhzHistoryPreset* entry =
+        SubGhzHistoryPresetArray_get(instance->history->presets, item->preset_index);
+    SubGhzRadioPreset* preset = &instance->raw_preset;
+    furi_string_set(preset->name, entry->name);
+    preset->frequency = item->frequency;
+    preset->data = entry->data;
+    preset->data_size = entry->data_size;
+    preset->latitude = item->latitude;
+    preset->longitude = item->longitude;
+    return preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    SubGhzHistoryPreset* entry =
+        SubGhzHistoryPresetArray_get(instance->history->presets, item->preset_index);
+    return furi_string_get_cstr(entry->name);
 }
 
 float subghz_history_get_latitude(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->latitude;
 }
 
 float subghz_history_get_longitude(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->longitude;
 }
 
@@ -117,29 +251,49 @@ void subghz_history_reset(SubGhzHistory* instance) {
     furi_string_reset(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(item);
         }
     SubGhzHistoryItemArray_reset(instance->history->data);
+    subghz_history_presets_reset(instance);
+    SubGhzHistoryRepeatDict_reset(instance->history->repeats);
+    subghz_history_spill_rewind(instance);
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
 }
 
+static void subghz_history_remove_item(SubGhzHistory* instance, uint16_t idx) {
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    subghz_history_item_free(item);
+    SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
+    instance->last_index_write--;
+    // Spill file is append only: reclaim it once nothing refers to it
+    if(instance->last_index_write == 0) {
+        subghz_history_spill_rewind(instance);
+    }
+}
+
+// Point the repeat counter of key back at the latest remaining record, or drop it
+static void subghz_history_repeats_update(SubGhzHistory* instance, uint64_t key) {
+    size_t idx = SubGhzHistoryItemArray_size(instance->history->data);
+    while(idx > 0) {
+        idx--;
+        SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+        if(subghz_history_key(item->protocol, item->hash_data) == key) {
+            SubGhzHistoryRepeatDict_set_at(instance->history->repeats, key, item->repeats);
+            return;
+        }
+    }
+    SubGhzHistoryRepeatDict_erase(instance->history->repeats, key);
+}
+
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
 
     if(idx < SubGhzHistoryItemArray_size(instance->history->data)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-        furi_string_free(item->item_str);
-        furi_string_free(item->preset->name);
-        free(item->preset);
-        flipper_format_free(item->flipper_string);
-        item->type = 0;
-        SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
-        instance->last_index_write--;
+        SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+        uint64_t key = subghz_history_key(item->protocol, item->hash_data);
+        subghz_history_remove_item(instance, idx);
+        subghz_history_repeats_update(instance, key);
     }
 }
 
@@ -150,45 +304,53 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     return item->type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    if(!item || !item->protocol) {
         FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
+        return "";
     }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    return item->protocol->name;
 }
 
 DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    DateTime datetime = {};
     if(item) {
-        return item->datetime;
-    } else {
-        return (DateTime){};
+        datetime_timestamp_to_datetime(item->timestamp, &datetime);
     }
+    return datetime;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+    Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+    stream_clean(stream);
+
+    if(item->data) {
+        stream_write(stream, item->data, item->data_size);
     } else {
-        return NULL;
+        subghz_history_reserve_buffer(instance, item->data_size);
+        if(!storage_file_seek(instance->spill_file, item->data_offset, true) ||
+           storage_file_read(instance->spill_file, instance->spill_buffer, item->data_size) !=
+               item->data_size) {
+            FURI_LOG_E(TAG, "Spill file read error");
+            return NULL;
+        }
+        stream_write(stream, instance->spill_buffer, item->data_size);
     }
+
+    flipper_format_rewind(instance->raw_data);
+    return instance->raw_data;
 }
+
 bool subghz_history_get_text_space_left(
     SubGhzHistory* instance,
     FuriString* output,
@@ -200,7 +362,8 @@ bool subghz_history_get_text_space_left(
             if(output != NULL) furi_string_printf(output, "    Memory is FULL");
             return true;
         }
-        if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+        if(instance->last_index_write == SUBGHZ_HISTORY_MAX ||
+           instance->spill_size >= SUBGHZ_HISTORY_SPILL_MAX_SIZE) {
             if(output != NULL) furi_string_printf(output, "     History is FULL");
             return true;
         }
@@ -223,155 +386,191 @@ uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
+    SubGhzHistoryItem* item = subghz_history_get(instance, idx);
     furi_string_set(output, item->item_str);
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    DateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    DateTime t = subghz_history_get_datetime(instance, idx);
+    furi_string_printf(output, "%.2d:%.2d:%.2d ", t.hour, t.minute, t.second);
 }
 
-bool subghz_history_add_to_history(
+static void subghz_history_item_make_text(
     SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
-    furi_assert(instance);
-    furi_assert(context);
-
-    if(subghz_history_full(instance)) return false;
-
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
-    if((instance->code_last_hash_data == hash_data) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
-    }
-
-    uint16_t repeats = 0;
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* search = SubGhzHistoryItemArray_ref(it);
-        if(search->hash_data == hash_data && search->protocol == decoder_base->protocol) {
-            repeats = search->repeats + 1;
-            break;
-        }
-        SubGhzHistoryItemArray_previous(it);
-    }
-
-    instance->code_last_hash_data = hash_data;
-    instance->last_update_timestamp = furi_get_tick();
-
+    SubGhzHistoryItem* item,
+    FlipperFormat* flipper_format) {
     FuriString* text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
-    item->hash_data = hash_data;
-    item->protocol = decoder_base->protocol;
-    item->repeats = repeats;
-    item->latitude = preset->latitude;
-    item->longitude = preset->longitude;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    furi_string_set(instance->tmp_string, item->protocol->name);
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
+        if(!strcmp(item->protocol->name, "KeeLoq")) {
             furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
+        } else if(!strcmp(item->protocol->name, "Star Line")) {
             furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_format, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
         }
-        uint64_t data = 0;
         for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
+            item->key = (item->key << 8) | key_data[i];
         }
-        if(data != 0) {
-            if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data >> 32),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            }
+    } while(false);
+
+    uint64_t data = item->key;
+    if(data != 0) {
+        if(!(uint32_t)(data >> 32)) {
+            snprintf(
+                item->item_str,
+                sizeof(item->item_str),
+                "%s %lX",
+                furi_string_get_cstr(instance->tmp_string),
+                (uint32_t)(data & 0xFFFFFFFF));
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            snprintf(
+                item->item_str,
+                sizeof(item->item_str),
+                "%s %lX%08lX",
+                furi_string_get_cstr(instance->tmp_string),
+                (uint32_t)(data >> 32),
+                (uint32_t)(data & 0xFFFFFFFF));
         }
-
-    } while(false);
+    } else {
+        strlcpy(item->item_str, furi_string_get_cstr(instance->tmp_string), sizeof(item->item_str));
+    }
 
     furi_string_free(text);
-    instance->last_index_write++;
+}
+
+static bool subghz_history_item_store_data(
+    SubGhzHistory* instance,
+    SubGhzHistoryItem* item,
+    FlipperFormat* flipper_format) {
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    size_t size = stream_size(stream);
+    if(size > UINT16_MAX) {
+        FURI_LOG_E(TAG, "Serialized signal too big");
+        return false;
+    }
+    item->data_size = size;
+    item->data_offset = 0;
+    item->data = NULL;
+
+    subghz_history_reserve_buffer(instance, size);
+    stream_rewind(stream);
+    stream_read(stream, instance->spill_buffer, size);
+
+    if(storage_file_is_open(instance->spill_file)) {
+        if(storage_file_seek(instance->spill_file, instance->spill_size, true) &&
+           storage_file_write(instance->spill_file, instance->spill_buffer, size) == size) {
+            item->data_offset = instance->spill_size;
+            instance->spill_size += size;
+            return true;
+        }
+        FURI_LOG_E(TAG, "Spill file write error, keeping history in RAM");
+        storage_file_close(instance->spill_file);
+    }
+
+    item->data = malloc(size);
+    memcpy(item->data, instance->spill_buffer, size);
     return true;
 }
 
-void subghz_history_remove_duplicates(SubGhzHistory* instance) {
+bool subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset) {
     furi_assert(instance);
+    furi_assert(context);
 
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* i = SubGhzHistoryItemArray_ref(it);
+    if(subghz_history_full(instance)) return false;
 
-        SubGhzHistoryItemArray_it_t jt;
-        SubGhzHistoryItemArray_it_set(jt, it);
-        SubGhzHistoryItemArray_previous(jt);
-        while(!SubGhzHistoryItemArray_end_p(jt)) {
-            SubGhzHistoryItem* j = SubGhzHistoryItemArray_ref(jt);
+    SubGhzProtocolDecoderBase* decoder_base = context;
+    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
+    if((instance->code_last_hash_data == hash_data) &&
+       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
+        instance->last_update_timestamp = furi_get_tick();
+        return false;
+    }
 
-            if(j->hash_data == i->hash_data && j->protocol == i->protocol) {
-                subghz_history_delete_item(instance, jt->index);
-            }
-            SubGhzHistoryItemArray_previous(jt);
+    uint16_t repeats = 0;
+    uint64_t key = subghz_history_key(decoder_base->protocol, hash_data);
+    uint16_t* last_repeats = SubGhzHistoryRepeatDict_get(instance->history->repeats, key);
+    if(last_repeats) {
+        repeats = *last_repeats + 1;
+    }
+
+    instance->code_last_hash_data = hash_data;
+    instance->last_update_timestamp = furi_get_tick();
+
+    // Serialize into a scratch buffer, only the raw bytes are kept
+    FlipperFormat* flipper_format = instance->serialize_data;
+    stream_clean(flipper_format_get_raw_stream(flipper_format));
+    subghz_protocol_decoder_base_serialize(decoder_base, flipper_format, preset);
+
+    SubGhzHistoryItem item = {
+        .protocol = decoder_base->protocol,
+        .hash_data = hash_data,
+        .frequency = preset->frequency,
+        .timestamp = furi_hal_rtc_get_timestamp(),
+        .latitude = preset->latitude,
+        .longitude = preset->longitude,
+        .repeats = repeats,
+        .preset_index = subghz_history_get_preset_index(instance, preset),
+        .type = decoder_base->protocol->type,
+    };
+
+    if(!subghz_history_item_store_data(instance, &item, flipper_format)) return false;
+
+    if(!flipper_format_rewind(flipper_format)) {
+        FURI_LOG_E(TAG, "Rewind error");
+    }
+    subghz_history_item_make_text(instance, &item, flipper_format);
+
+    SubGhzHistoryItemArray_push_back(instance->history->data, item);
+    SubGhzHistoryRepeatDict_set_at(instance->history->repeats, key, repeats);
+    instance->last_index_write++;
+    return true;
+}
+
+void subghz_history_remove_duplicates(SubGhzHistory* instance) {
+    furi_assert(instance);
+
+    // Keep the most recent record of every (protocol, hash) pair
+    SubGhzHistoryRepeatDict_t seen;
+    SubGhzHistoryRepeatDict_init(seen);
+    size_t idx = SubGhzHistoryItemArray_size(instance->history->data);
+    while(idx > 0) {
+        idx--;
+        SubGhzHistoryItem* item = subghz_history_get(instance, idx);
+        uint64_t key = subghz_history_key(item->protocol, item->hash_data);
+        if(SubGhzHistoryRepeatDict_get(seen, key)) {
+            // The latest record of the key stays, so its repeat counter is still valid
+            subghz_history_remove_item(instance, idx);
+        } else {
+            SubGhzHistoryRepeatDict_set_at(seen, key, 0);
         }
-        SubGhzHistoryItemArray_previous(it);
     }
+    SubGhzHistoryRepeatDict_clear(seen);
 }
 
 bool subghz_history_full(SubGhzHistory* instance) {
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return true;
     if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return true;
+    if(instance->spill_size >= SUBGHZ_HISTORY_SPILL_MAX_SIZE) return true;
     return false;
 }
@@ -61,6 +61,12 @@ uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx);
  */
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx);
 
+/** Get radio preset of history[idx]
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @return preset   - SubGhzRadioPreset owned by history, valid until next call
+ */
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx);
 
 /** Get preset to history[idx]
@@ -152,10 +158,13 @@ bool subghz_history_add_to_history(
     SubGhzRadioPreset* preset);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * 
+ * Serialized signal is loaded from SD card spill file into a buffer owned by
+ * history, it stays valid until next call.
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return SubGhzProtocolCommonLoad*, NULL on read error
  */
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
 
@@ -9,6 +9,8 @@
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/trace.h>
+#include <storage/storage.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -282,6 +284,20 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     }
 }
 
+void cli_command_sysctl_log_async(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    if(!furi_string_cmp(args, "0")) {
+        furi_log_set_async(false);
+        printf("Asynchronous logging disabled");
+    } else if(!furi_string_cmp(args, "1")) {
+        furi_log_set_async(true);
+        printf("Asynchronous logging enabled");
+    } else {
+        cli_print_usage("sysctl log_async", "<1|0>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_sysctl_print_usage() {
     printf("Usage:\r\n");
     printf("sysctl <cmd> <args>\r\n");
@@ -293,6 +309,7 @@ void cli_command_sysctl_print_usage() {
 #else
     printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
 #endif
+    printf("\tlog_async <0|1>\t - Defer log formatting to background thread\r\n");
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -315,12 +332,128 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "log_async") == 0) {
+            cli_command_sysctl_log_async(cli, args, context);
+            break;
+        }
+
         cli_command_sysctl_print_usage();
     } while(false);
 
     furi_string_free(cmd);
 }
 
+#define CLI_TRACE_RECORDS_DEFAULT (1024)
+
+void cli_command_trace_print_usage() {
+    printf("Usage:\r\n");
+    printf("trace <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+
+    printf(
+        "\tstart [records]\t - Start recording into a new ring buffer, default %d records\r\n",
+        CLI_TRACE_RECORDS_DEFAULT);
+    printf("\tstop\t - Stop recording\r\n");
+    printf("\tdump [path]\t - Print Chrome trace JSON or save it to file\r\n");
+    printf("\tfree\t - Free recorded trace\r\n");
+}
+
+static void cli_command_trace_print_callback(const char* data, size_t size, void* context) {
+    UNUSED(context);
+    printf("%.*s", (int)size, data);
+}
+
+static void cli_command_trace_file_callback(const char* data, size_t size, void* context) {
+    File* file = context;
+    if(storage_file_get_error(file) != FSE_OK) return;
+    storage_file_write(file, data, size);
+}
+
+static void cli_command_trace_dump(FuriString* args) {
+    if(trace_is_started()) {
+        printf("Stop trace first");
+        return;
+    }
+
+    if(furi_string_empty(args)) {
+        trace_export_chrome(cli_command_trace_print_callback, NULL);
+        return;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    if(storage_file_open(file, furi_string_get_cstr(args), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        size_t count = trace_export_chrome(cli_command_trace_file_callback, file);
+        if(storage_file_get_error(file) == FSE_OK) {
+            printf("%zu records saved to %s", count, furi_string_get_cstr(args));
+        } else {
+            printf("Write failed: %s", storage_file_get_error_desc(file));
+        }
+    } else {
+        printf(
+            "Cannot open %s: %s",
+            furi_string_get_cstr(args),
+            storage_file_get_error_desc(file));
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+void cli_command_trace(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_trace_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            int records = CLI_TRACE_RECORDS_DEFAULT;
+            if(!furi_string_empty(args) &&
+               (!args_read_int_and_trim(args, &records) || records <= 0)) {
+                cli_print_usage("trace start", "[records]", furi_string_get_cstr(args));
+                break;
+            }
+            if(trace_start(records)) {
+                printf("Trace started");
+            } else {
+                printf("Trace already started or out of memory");
+            }
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stop") == 0) {
+            trace_stop();
+            printf(
+                "Trace stopped, %zu records, %zu dropped",
+                trace_get_count(),
+                trace_get_dropped());
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "dump") == 0) {
+            cli_command_trace_dump(args);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "free") == 0) {
+            trace_stop();
+            trace_free();
+            break;
+        }
+
+        cli_command_trace_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_vibro(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(context);
@@ -485,6 +618,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "l", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "sysctl", CliCommandFlagDefault, cli_command_sysctl, NULL);
+    cli_add_command(cli, "trace", CliCommandFlagParallelSafe, cli_command_trace, NULL);
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
@@ -6,8 +6,11 @@
 #define TAG "CliVcp"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
-#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
+// Big enough to keep endpoints busy while the other side handles a block
+#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 16)
+#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 16)
+// Tx stream is filled in halves: one is sent while the other one is filled
+#define VCP_TX_BATCH_SIZE (VCP_TX_BUF_SIZE / 2)
 
 #define VCP_IF_NUM 0
 
@@ -42,7 +45,8 @@ typedef struct {
 
     FuriHalUsbInterface* usb_if_prev;
 
-    uint8_t data_buffer[USB_CDC_PKT_LEN];
+    uint8_t rx_buffer[USB_CDC_PKT_LEN];
+    uint8_t tx_buffer[USB_CDC_PKT_LEN];
 } CliVcp;
 
 static int32_t vcp_worker(void* context);
@@ -64,6 +68,12 @@ static CliVcp* vcp = NULL;
 static const uint8_t ascii_soh = 0x01;
 static const uint8_t ascii_eot = 0x04;
 
+// Drop pending output, unblocks writer waiting for space
+static void vcp_tx_stream_drain() {
+    while(furi_stream_buffer_receive(vcp->tx_stream, vcp->tx_buffer, USB_CDC_PKT_LEN, 0) > 0)
+        ;
+}
+
 static void cli_vcp_init() {
     if(vcp == NULL) {
         vcp = malloc(sizeof(CliVcp));
@@ -124,7 +134,7 @@ static int32_t vcp_worker(void* context) {
 
             if(vcp->connected == true) {
                 vcp->connected = false;
-                furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+                vcp_tx_stream_drain();
                 furi_stream_buffer_send(vcp->rx_stream, &ascii_eot, 1, FuriWaitForever);
             }
         }
@@ -142,13 +152,13 @@ static int32_t vcp_worker(void* context) {
         // New data received
         if(flags & VcpEvtRx) {
             if(furi_stream_buffer_spaces_available(vcp->rx_stream) >= USB_CDC_PKT_LEN) {
-                int32_t len = furi_hal_cdc_receive(VCP_IF_NUM, vcp->data_buffer, USB_CDC_PKT_LEN);
+                int32_t len = furi_hal_cdc_receive(VCP_IF_NUM, vcp->rx_buffer, USB_CDC_PKT_LEN);
                 VCP_DEBUG("Rx %ld", len);
 
                 if(len > 0) {
                     furi_check(
                         furi_stream_buffer_send(
-                            vcp->rx_stream, vcp->data_buffer, len, FuriWaitForever) ==
+                            vcp->rx_stream, vcp->rx_buffer, len, FuriWaitForever) ==
                         (size_t)len);
                 }
             } else {
@@ -169,13 +179,13 @@ static int32_t vcp_worker(void* context) {
         // CDC write transfer done
         if(flags & VcpEvtTx) {
             size_t len =
-                furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+                furi_stream_buffer_receive(vcp->tx_stream, vcp->tx_buffer, USB_CDC_PKT_LEN, 0);
 
             VCP_DEBUG("Tx %d", len);
 
             if(len > 0) { // Some data left in Tx buffer. Sending it now
                 tx_idle = false;
-                furi_hal_cdc_send(VCP_IF_NUM, vcp->data_buffer, len);
+                furi_hal_cdc_send(VCP_IF_NUM, vcp->tx_buffer, len);
                 last_tx_pkt_len = len;
             } else { // There is nothing to send.
                 if(last_tx_pkt_len == 64) {
@@ -198,7 +208,7 @@ static int32_t vcp_worker(void* context) {
                 furi_hal_usb_unlock();
                 furi_hal_usb_set_config(vcp->usb_if_prev, NULL);
             }
-            furi_stream_buffer_receive(vcp->tx_stream, vcp->data_buffer, USB_CDC_PKT_LEN, 0);
+            vcp_tx_stream_drain();
             furi_stream_buffer_send(vcp->rx_stream, &ascii_eot, 1, FuriWaitForever);
             break;
         }
@@ -254,7 +264,7 @@ static void cli_vcp_tx(const uint8_t* buffer, size_t size) {
 
     while(size > 0 && vcp->connected) {
         size_t batch_size = size;
-        if(batch_size > USB_CDC_PKT_LEN) batch_size = USB_CDC_PKT_LEN;
+        if(batch_size > VCP_TX_BATCH_SIZE) batch_size = VCP_TX_BATCH_SIZE;
 
         furi_stream_buffer_send(vcp->tx_stream, buffer, batch_size, FuriWaitForever);
         furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtStreamTx);
@@ -29,6 +29,21 @@ extern "C" {
  */
 #define EXPANSION_PROTOCOL_MAX_DATA_SIZE (64U)
 
+/**
+ * @brief Maximum data size per extended data frame, in bytes.
+ *
+ * Modules with little RAM MAY define it to a lower value (but not lower than
+ * EXPANSION_PROTOCOL_MAX_DATA_SIZE) and announce it during negotiation.
+ */
+#ifndef EXPANSION_PROTOCOL_MAX_EXT_DATA_SIZE
+#define EXPANSION_PROTOCOL_MAX_EXT_DATA_SIZE (256U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged extended data frames.
+ */
+#define EXPANSION_PROTOCOL_MAX_WINDOW_SIZE (8U)
+
 /**
  * @brief Maximum allowed inactivity period, in milliseconds.
  */
@@ -48,6 +63,9 @@ typedef enum {
     ExpansionFrameTypeBaudRate = 3, /**< Baud rate negotiation frame. */
     ExpansionFrameTypeControl = 4, /**< Control frame. */
     ExpansionFrameTypeData = 5, /**< Data frame. */
+    ExpansionFrameTypeExtension = 6, /**< Extended mode negotiation frame. */
+    ExpansionFrameTypeDataExt = 7, /**< Extended data frame. */
+    ExpansionFrameTypeAck = 8, /**< Extended data acknowledgement frame. */
     ExpansionFrameTypeReserved, /**< Special value. */
 } ExpansionFrameType;
 
@@ -115,6 +133,36 @@ typedef struct {
     uint8_t bytes[EXPANSION_PROTOCOL_MAX_DATA_SIZE];
 } ExpansionFrameData;
 
+/**
+ * @brief Extended mode negotiation frame contents.
+ */
+typedef struct {
+    /** Maximum extended data frame size, little-endian. */
+    uint16_t max_data_size;
+    /** Maximum number of unacknowledged extended data frames. */
+    uint8_t window_size;
+} ExpansionFrameExtension;
+
+/**
+ * @brief Extended data frame contents.
+ */
+typedef struct {
+    /** Sequence number, incremented by one (modulo 256) with every frame. */
+    uint8_t seq;
+    /** Size of the data, little-endian. Must not exceed the negotiated size. */
+    uint16_t size;
+    /** Data bytes. Valid only up to ExpansionFrameDataExt::size bytes. */
+    uint8_t bytes[EXPANSION_PROTOCOL_MAX_EXT_DATA_SIZE];
+} ExpansionFrameDataExt;
+
+/**
+ * @brief Extended data acknowledgement frame contents.
+ */
+typedef struct {
+    /** Sequence number of the next expected frame, acknowledges all previous ones. */
+    uint8_t seq;
+} ExpansionFrameAck;
+
 /**
  * @brief Expansion protocol frame structure.
  */
@@ -126,6 +174,9 @@ typedef struct {
         ExpansionFrameBaudRate baud_rate; /**< Baud rate frame contents. */
         ExpansionFrameControl control; /**< Control frame contents. */
         ExpansionFrameData data; /**< Data frame contents. */
+        ExpansionFrameExtension extension; /**< Extended mode negotiation frame contents. */
+        ExpansionFrameDataExt data_ext; /**< Extended data frame contents. */
+        ExpansionFrameAck ack; /**< Extended data acknowledgement frame contents. */
     } content; /**< Contents of the frame. */
 } ExpansionFrame;
 
@@ -180,6 +231,13 @@ static inline size_t expansion_frame_get_encoded_size(const ExpansionFrame* fram
         return sizeof(frame->header) + sizeof(frame->content.control);
     case ExpansionFrameTypeData:
         return sizeof(frame->header) + sizeof(frame->content.data.size) + frame->content.data.size;
+    case ExpansionFrameTypeExtension:
+        return sizeof(frame->header) + sizeof(frame->content.extension);
+    case ExpansionFrameTypeDataExt:
+        return sizeof(frame->header) + sizeof(frame->content.data_ext.seq) +
+               sizeof(frame->content.data_ext.size) + frame->content.data_ext.size;
+    case ExpansionFrameTypeAck:
+        return sizeof(frame->header) + sizeof(frame->content.ack);
     default:
         return 0;
     }
@@ -233,6 +291,26 @@ static inline bool expansion_frame_get_remaining_size(
             content_size = sizeof(frame->content.data.size) + frame->content.data.size;
         }
         break;
+    case ExpansionFrameTypeExtension:
+        content_size = sizeof(frame->content.extension);
+        break;
+    case ExpansionFrameTypeDataExt: {
+        const size_t data_ext_header_size =
+            sizeof(frame->content.data_ext.seq) + sizeof(frame->content.data_ext.size);
+        if(received_content_size < data_ext_header_size) {
+            // Data size is unknown as of now
+            content_size = data_ext_header_size;
+        } else if(frame->content.data_ext.size > sizeof(frame->content.data_ext.bytes)) {
+            // Malformed frame or garbage input
+            return false;
+        } else {
+            content_size = data_ext_header_size + frame->content.data_ext.size;
+        }
+        break;
+    }
+    case ExpansionFrameTypeAck:
+        content_size = sizeof(frame->content.ack);
+        break;
     default:
         return false;
     }
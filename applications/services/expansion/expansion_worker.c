@@ -11,8 +11,10 @@
 
 #define TAG "ExpansionSrv"
 
-#define EXPANSION_WORKER_STACK_SZIE (768UL)
+#define EXPANSION_WORKER_STACK_SZIE (1536UL)
 #define EXPANSION_WORKER_BUFFER_SIZE (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))
+// Maximum accepted window, receive buffer must hold this many frames
+#define EXPANSION_WORKER_WINDOW_SIZE (4U)
 
 typedef enum {
     ExpansionWorkerStateHandShake,
@@ -39,12 +41,23 @@ struct ExpansionWorker {
     FuriThread* thread;
     FuriStreamBuffer* rx_buf;
     FuriSemaphore* tx_semaphore;
+    FuriMutex* tx_mutex;
 
     FuriHalSerialId serial_id;
     FuriHalSerialHandle* serial_handle;
 
     RpcSession* rpc_session;
 
+    // Extended mode, negotiated in connected state
+    bool ext_enabled;
+    uint16_t ext_data_size;
+    uint8_t ext_window_size;
+    // Extended data frame sequence numbers
+    uint8_t tx_seq;
+    uint8_t tx_acked;
+    uint8_t rx_seq;
+    uint8_t rx_unacked;
+
     ExpansionWorkerState state;
     ExpansionWorkerExitReason exit_reason;
     ExpansionWorkerCallback callback;
@@ -127,10 +140,14 @@ static size_t
     return data_size;
 }
 
-static inline bool
-    expansion_worker_send_frame(ExpansionWorker* instance, const ExpansionFrame* frame) {
-    return expansion_protocol_encode(frame, expansion_worker_send_callback, instance) ==
-           ExpansionProtocolStatusOk;
+// Frames are sent from both worker and Rpc session threads
+static bool expansion_worker_send_frame(ExpansionWorker* instance, const ExpansionFrame* frame) {
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+    const bool success = expansion_protocol_encode(
+                             frame, expansion_worker_send_callback, instance) ==
+                         ExpansionProtocolStatusOk;
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
 }
 
 static bool expansion_worker_send_heartbeat(ExpansionWorker* instance) {
@@ -152,18 +169,49 @@ static bool
     return expansion_worker_send_frame(instance, &frame);
 }
 
+static bool expansion_worker_send_extension_response(ExpansionWorker* instance) {
+    const ExpansionFrame frame = {
+        .header.type = ExpansionFrameTypeExtension,
+        .content.extension =
+            {
+                .max_data_size = instance->ext_data_size,
+                .window_size = instance->ext_window_size,
+            },
+    };
+
+    return expansion_worker_send_frame(instance, &frame);
+}
+
+static bool expansion_worker_send_ack(ExpansionWorker* instance) {
+    const ExpansionFrame frame = {
+        .header.type = ExpansionFrameTypeAck,
+        .content.ack.seq = instance->rx_seq,
+    };
+
+    instance->rx_unacked = 0;
+    return expansion_worker_send_frame(instance, &frame);
+}
+
 static bool expansion_worker_send_data_response(
     ExpansionWorker* instance,
     const uint8_t* data,
     size_t data_size) {
-    furi_assert(data_size <= EXPANSION_PROTOCOL_MAX_DATA_SIZE);
-
-    ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeData,
-        .content.data.size = data_size,
-    };
+    ExpansionFrame frame;
+
+    if(instance->ext_enabled) {
+        furi_assert(data_size <= instance->ext_data_size);
+        frame.header.type = ExpansionFrameTypeDataExt;
+        // Only Rpc session thread sends data, no locking needed
+        frame.content.data_ext.seq = instance->tx_seq++;
+        frame.content.data_ext.size = data_size;
+        memcpy(frame.content.data_ext.bytes, data, data_size);
+    } else {
+        furi_assert(data_size <= EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+        frame.header.type = ExpansionFrameTypeData;
+        frame.content.data.size = data_size;
+        memcpy(frame.content.data.bytes, data, data_size);
+    }
 
-    memcpy(frame.content.data.bytes, data, data_size);
     return expansion_worker_send_frame(instance, &frame);
 }
 
@@ -171,6 +219,10 @@ static bool expansion_worker_send_data_response(
 static void expansion_worker_rpc_send_callback(void* context, uint8_t* data, size_t data_size) {
     ExpansionWorker* instance = context;
 
+    // Up to window size frames are sent before waiting for acknowledgement
+    const size_t max_data_size = instance->ext_enabled ? instance->ext_data_size :
+                                                         EXPANSION_PROTOCOL_MAX_DATA_SIZE;
+
     for(size_t sent_data_size = 0; sent_data_size < data_size;) {
         if(furi_semaphore_acquire(
                instance->tx_semaphore, furi_ms_to_ticks(EXPANSION_PROTOCOL_TIMEOUT_MS)) !=
@@ -179,8 +231,7 @@ static void expansion_worker_rpc_send_callback(void* context, uint8_t* data, siz
             break;
         }
 
-        const size_t current_data_size =
-            MIN(data_size - sent_data_size, EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+        const size_t current_data_size = MIN(data_size - sent_data_size, max_data_size);
         if(!expansion_worker_send_data_response(instance, data + sent_data_size, current_data_size))
             break;
         sent_data_size += current_data_size;
@@ -192,7 +243,12 @@ static bool expansion_worker_rpc_session_open(ExpansionWorker* instance) {
     instance->rpc_session = rpc_session_open(rpc, RpcOwnerUart);
 
     if(instance->rpc_session) {
-        instance->tx_semaphore = furi_semaphore_alloc(1, 1);
+        const uint32_t window_size = instance->ext_enabled ? instance->ext_window_size : 1;
+        instance->tx_semaphore = furi_semaphore_alloc(window_size, window_size);
+        instance->tx_seq = 0;
+        instance->tx_acked = 0;
+        instance->rx_seq = 0;
+        instance->rx_unacked = 0;
         rpc_session_set_context(instance->rpc_session, instance);
         rpc_session_set_send_bytes_callback(
             instance->rpc_session, expansion_worker_rpc_send_callback);
@@ -238,6 +294,66 @@ static bool expansion_worker_handle_state_handshake(
     return success;
 }
 
+static bool expansion_worker_handle_extension(
+    ExpansionWorker* instance,
+    const ExpansionFrameExtension* request) {
+    FURI_LOG_D(
+        TAG,
+        "Proposed extension: data size %u, window %u",
+        request->max_data_size,
+        request->window_size);
+
+    if(request->max_data_size < EXPANSION_PROTOCOL_MAX_DATA_SIZE || request->window_size == 0) {
+        // Stay in legacy mode
+        instance->ext_enabled = false;
+        return expansion_worker_send_status_response(instance, ExpansionFrameErrorUnknown);
+    }
+
+    instance->ext_enabled = true;
+    instance->ext_data_size = MIN(request->max_data_size, EXPANSION_PROTOCOL_MAX_EXT_DATA_SIZE);
+    instance->ext_window_size = MIN(request->window_size, EXPANSION_WORKER_WINDOW_SIZE);
+
+    return expansion_worker_send_extension_response(instance);
+}
+
+static bool expansion_worker_handle_ack(ExpansionWorker* instance, const ExpansionFrameAck* ack) {
+    const uint8_t in_flight = instance->tx_seq - instance->tx_acked;
+    const uint8_t acked = ack->seq - instance->tx_acked;
+
+    // Acknowledging frames that were never sent
+    if(acked > in_flight) return false;
+
+    instance->tx_acked = ack->seq;
+    for(uint8_t i = 0; i < acked; ++i) {
+        furi_semaphore_release(instance->tx_semaphore);
+    }
+
+    return true;
+}
+
+static bool expansion_worker_handle_data_ext(
+    ExpansionWorker* instance,
+    const ExpansionFrameDataExt* data_ext) {
+    if(data_ext->seq != instance->rx_seq) return false;
+    if(data_ext->size > instance->ext_data_size) return false;
+
+    const size_t size_consumed = rpc_session_feed(
+        instance->rpc_session, data_ext->bytes, data_ext->size, EXPANSION_PROTOCOL_TIMEOUT_MS);
+    if(size_consumed != data_ext->size) return false;
+
+    instance->rx_seq++;
+    instance->rx_unacked++;
+
+    // Acknowledge in batches while more frames are coming, but never stall the sender
+    const uint8_t ack_threshold = MAX(instance->ext_window_size / 2, 1);
+    if(instance->rx_unacked >= ack_threshold ||
+       furi_stream_buffer_bytes_available(instance->rx_buf) == 0) {
+        return expansion_worker_send_ack(instance);
+    }
+
+    return true;
+}
+
 static bool expansion_worker_handle_state_connected(
     ExpansionWorker* instance,
     const ExpansionFrame* rx_frame) {
@@ -250,6 +366,9 @@ static bool expansion_worker_handle_state_connected(
             if(!expansion_worker_rpc_session_open(instance)) break;
             if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
 
+        } else if(rx_frame->header.type == ExpansionFrameTypeExtension) {
+            if(!expansion_worker_handle_extension(instance, &rx_frame->content.extension)) break;
+
         } else if(rx_frame->header.type == ExpansionFrameTypeHeartbeat) {
             if(!expansion_worker_send_heartbeat(instance)) break;
 
@@ -278,6 +397,14 @@ static bool expansion_worker_handle_state_rpc_active(
                 EXPANSION_PROTOCOL_TIMEOUT_MS);
             if(size_consumed != rx_frame->content.data.size) break;
 
+        } else if(rx_frame->header.type == ExpansionFrameTypeDataExt) {
+            if(!instance->ext_enabled) break;
+            if(!expansion_worker_handle_data_ext(instance, &rx_frame->content.data_ext)) break;
+
+        } else if(rx_frame->header.type == ExpansionFrameTypeAck) {
+            if(!instance->ext_enabled) break;
+            if(!expansion_worker_handle_ack(instance, &rx_frame->content.ack)) break;
+
         } else if(rx_frame->header.type == ExpansionFrameTypeControl) {
             if(rx_frame->content.control.command != ExpansionFrameControlCommandStopRpc) break;
             instance->state = ExpansionWorkerStateConnected;
@@ -286,7 +413,8 @@ static bool expansion_worker_handle_state_rpc_active(
 
         } else if(rx_frame->header.type == ExpansionFrameTypeStatus) {
             if(rx_frame->content.status.error != ExpansionFrameErrorNone) break;
-            furi_semaphore_release(instance->tx_semaphore);
+            // Extended data frames are confirmed with Ack frames instead
+            if(!instance->ext_enabled) furi_semaphore_release(instance->tx_semaphore);
 
         } else if(rx_frame->header.type == ExpansionFrameTypeHeartbeat) {
             if(!expansion_worker_send_heartbeat(instance)) break;
@@ -330,6 +458,7 @@ static int32_t expansion_worker(void* context) {
 
     instance->state = ExpansionWorkerStateHandShake;
     instance->exit_reason = ExpansionWorkerExitReasonUnknown;
+    instance->ext_enabled = false;
 
     furi_hal_serial_init(instance->serial_handle, EXPANSION_PROTOCOL_DEFAULT_BAUD_RATE);
 
@@ -362,7 +491,9 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
 
     instance->thread = furi_thread_alloc_ex(
         TAG "Worker", EXPANSION_WORKER_STACK_SZIE, expansion_worker, instance);
-    instance->rx_buf = furi_stream_buffer_alloc(EXPANSION_WORKER_BUFFER_SIZE, 1);
+    instance->rx_buf = furi_stream_buffer_alloc(
+        EXPANSION_WORKER_BUFFER_SIZE * EXPANSION_WORKER_WINDOW_SIZE, 1);
+    instance->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     instance->serial_id = serial_id;
 
     // Improves responsiveness in heavy games at the expense of dropped frames
@@ -374,6 +505,7 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
 void expansion_worker_free(ExpansionWorker* instance) {
     furi_stream_buffer_free(instance->rx_buf);
     furi_thread_join(instance->thread);
+    furi_mutex_free(instance->tx_mutex);
     furi_thread_free(instance->thread);
     free(instance);
 }
@@ -29,6 +29,10 @@ Canvas* canvas_init() {
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    // Shadow buffer for partial updates, first commit is always full
+    canvas->shadow_buffer = malloc(canvas_get_buffer_size(canvas));
+    canvas->shadow_valid = false;
+    canvas->shadow_orientation = canvas->orientation;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -46,6 +50,7 @@ void canvas_free(Canvas* canvas) {
     compress_icon_free(canvas->compress_icon);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
+    free(canvas->shadow_buffer);
     free(canvas);
 }
 
@@ -69,20 +74,80 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
+/** Send changed tiles to display and update shadow buffer
+ *
+ * Display RAM is organized in 8 pages of 8 rows, each page is 16 tiles of
+ * 8x8 pixels. For every page only span between first and last changed tile
+ * is transferred.
+ *
+ * @return     true if frame differs from previous one
+ */
+static bool canvas_flush(Canvas* canvas) {
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    uint8_t* shadow = canvas->shadow_buffer;
+    const uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    const uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+    const size_t page_size = tile_width * 8;
+
+    if(!canvas->shadow_valid) {
+        u8g2_SendBuffer(&canvas->fb);
+        memcpy(shadow, buffer, page_size * tile_height);
+        canvas->shadow_valid = true;
+        return true;
+    }
+
+    bool changed = false;
+    for(uint8_t page = 0; page < tile_height; page++) {
+        uint8_t* page_ptr = &buffer[page * page_size];
+        uint8_t* shadow_ptr = &shadow[page * page_size];
+        if(memcmp(page_ptr, shadow_ptr, page_size) == 0) continue;
+
+        uint8_t first = 0;
+        while(memcmp(&page_ptr[first * 8], &shadow_ptr[first * 8], 8) == 0) {
+            first++;
+        }
+        uint8_t last = tile_width - 1;
+        while(memcmp(&page_ptr[last * 8], &shadow_ptr[last * 8], 8) == 0) {
+            last--;
+        }
+
+        const uint8_t count = last - first + 1;
+        u8g2_UpdateDisplayArea(&canvas->fb, first, page, count, 1);
+        memcpy(&shadow_ptr[first * 8], &page_ptr[first * 8], count * 8);
+        changed = true;
+    }
+
+    return changed;
+}
+
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
 
-    // Iterate over callbacks
     canvas_lock(canvas);
-    for
-        M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
-            p->callback(
-                canvas_get_buffer(canvas),
-                canvas_get_buffer_size(canvas),
-                canvas_get_orientation(canvas),
-                p->context);
-        }
+    bool changed = canvas_flush(canvas);
+    if(canvas->shadow_orientation != canvas->orientation) {
+        canvas->shadow_orientation = canvas->orientation;
+        changed = true;
+    }
+
+    // Iterate over callbacks, identical frames are not delivered
+    if(changed) {
+        for
+            M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
+                p->callback(
+                    canvas_get_buffer(canvas),
+                    canvas_get_buffer_size(canvas),
+                    canvas_get_orientation(canvas),
+                    p->context);
+            }
+    }
+    canvas_unlock(canvas);
+}
+
+void canvas_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas_lock(canvas);
+    canvas->shadow_valid = false;
     canvas_unlock(canvas);
 }
 
@@ -628,6 +693,8 @@ void canvas_add_framebuffer_callback(Canvas* canvas, CanvasCommitCallback callba
     canvas_lock(canvas);
     furi_assert(!CanvasCallbackPairArray_count(canvas->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(canvas->canvas_callback_pair, p);
+    // New listener must receive full frame on next commit
+    canvas->shadow_valid = false;
     canvas_unlock(canvas);
 }
 
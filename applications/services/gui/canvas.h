@@ -101,6 +101,15 @@ void canvas_reset(Canvas* canvas);
  */
 void canvas_commit(Canvas* canvas);
 
+/** Invalidate last committed frame
+ *
+ * Next commit will send whole frame to display and framebuffer callbacks.
+ * Use it when display content was changed bypassing canvas.
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_invalidate(Canvas* canvas);
+
 /** Get Canvas width
  *
  * @param      canvas  Canvas instance
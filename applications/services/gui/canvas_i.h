@@ -45,6 +45,10 @@ struct Canvas {
     CompressIcon* compress_icon;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
+    /* Copy of the last committed frame, used to send only changed tiles */
+    uint8_t* shadow_buffer;
+    CanvasOrientation shadow_orientation;
+    bool shadow_valid;
 };
 
 /** Allocate memory and initialize canvas
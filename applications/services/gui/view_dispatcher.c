@@ -73,28 +73,62 @@ void view_dispatcher_set_tick_event_callback(
     view_dispatcher->tick_period = tick_period;
 }
 
+static void view_dispatcher_run_tick_callback(void* context) {
+    ViewDispatcher* view_dispatcher = context;
+    view_dispatcher_handle_tick_event(view_dispatcher);
+    // Tick is delivered only after tick_period without messages
+    furi_event_loop_timer_start(view_dispatcher->tick_timer, view_dispatcher->tick_period);
+}
+
+static void view_dispatcher_run_queue_callback(void* object, void* context) {
+    ViewDispatcher* view_dispatcher = context;
+    ViewDispatcherMessage message;
+
+    if(furi_message_queue_get(object, &message, 0) != FuriStatusOk) return;
+
+    if(message.type == ViewDispatcherMessageTypeStop) {
+        furi_event_loop_stop(view_dispatcher->event_loop);
+        return;
+    } else if(message.type == ViewDispatcherMessageTypeInput) {
+        view_dispatcher_handle_input(view_dispatcher, &message.input);
+    } else if(message.type == ViewDispatcherMessageTypeCustomEvent) {
+        view_dispatcher_handle_custom_event(view_dispatcher, message.custom_event);
+    }
+
+    if(view_dispatcher->tick_timer) {
+        furi_event_loop_timer_start(view_dispatcher->tick_timer, view_dispatcher->tick_period);
+    }
+}
+
 void view_dispatcher_run(ViewDispatcher* view_dispatcher) {
     furi_assert(view_dispatcher);
     furi_assert(view_dispatcher->queue);
 
-    uint32_t tick_period = view_dispatcher->tick_period == 0 ? FuriWaitForever :
-                                                               view_dispatcher->tick_period;
-    ViewDispatcherMessage message;
-    while(1) {
-        if(furi_message_queue_get(view_dispatcher->queue, &message, tick_period) != FuriStatusOk) {
-            view_dispatcher_handle_tick_event(view_dispatcher);
-            continue;
-        }
-        if(message.type == ViewDispatcherMessageTypeStop) {
-            break;
-        } else if(message.type == ViewDispatcherMessageTypeInput) {
-            view_dispatcher_handle_input(view_dispatcher, &message.input);
-        } else if(message.type == ViewDispatcherMessageTypeCustomEvent) {
-            view_dispatcher_handle_custom_event(view_dispatcher, message.custom_event);
-        }
+    view_dispatcher->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        view_dispatcher->event_loop,
+        view_dispatcher->queue,
+        view_dispatcher_run_queue_callback,
+        view_dispatcher);
+
+    if(view_dispatcher->tick_period) {
+        view_dispatcher->tick_timer = furi_event_loop_timer_alloc(
+            view_dispatcher->event_loop,
+            view_dispatcher_run_tick_callback,
+            FuriEventLoopTimerTypeOnce,
+            view_dispatcher);
+        furi_event_loop_timer_start(view_dispatcher->tick_timer, view_dispatcher->tick_period);
     }
 
+    furi_event_loop_run(view_dispatcher->event_loop);
+
+    // Timers and subscriptions are released with event loop
+    furi_event_loop_free(view_dispatcher->event_loop);
+    view_dispatcher->event_loop = NULL;
+    view_dispatcher->tick_timer = NULL;
+
     // Wait till all input events delivered
+    ViewDispatcherMessage message;
     while(view_dispatcher->ongoing_input) {
         furi_message_queue_get(view_dispatcher->queue, &message, FuriWaitForever);
         if(message.type == ViewDispatcherMessageTypeInput) {
@@ -101,7 +101,9 @@ void view_dispatcher_set_event_callback_context(ViewDispatcher* view_dispatcher,
 
 /** Run ViewDispatcher
  *
- * Use only after queue enabled
+ * Use only after queue enabled. Can be called from a callback of another
+ * running ViewDispatcher of the same thread: the outer one is blocked until
+ * this one is stopped.
  *
  * @param      view_dispatcher  ViewDispatcher instance
  */
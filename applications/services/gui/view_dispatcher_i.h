@@ -16,6 +16,8 @@ DICT_DEF2(ViewDict, uint32_t, M_DEFAULT_OPLIST, View*, M_PTR_OPLIST)
 
 struct ViewDispatcher {
     FuriMessageQueue* queue;
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* tick_timer;
     Gui* gui;
     ViewPort* view_port;
     ViewDict_t views;
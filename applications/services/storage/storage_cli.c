@@ -11,6 +11,9 @@
 
 #define MAX_NAME_LENGTH 254
 
+// Transfer block size, chunks requested by host are streamed in blocks of this size
+#define STORAGE_CLI_BLOCK_SIZE 4096
+
 static void storage_cli_print_usage() {
     printf("Usage:\r\n");
     printf("storage <cmd> <path> <args>\r\n");
@@ -192,24 +195,55 @@ static void storage_cli_tree(Cli* cli, FuriString* path) {
     }
 }
 
+// Stream file contents to cli, returns number of bytes sent
+static uint64_t storage_cli_send_file(Cli* cli, File* file, uint8_t* buffer, uint64_t size) {
+    // Keep data after text printed earlier
+    fflush(stdout);
+
+    uint64_t sent_size = 0;
+    while(sent_size < size) {
+        const size_t block_size = MIN(size - sent_size, (uint64_t)STORAGE_CLI_BLOCK_SIZE);
+        const size_t read_size = storage_file_read(file, buffer, block_size);
+        if(read_size == 0) break;
+        cli_write(cli, buffer, read_size);
+        sent_size += read_size;
+    }
+
+    return sent_size;
+}
+
+// Stream data from cli to file, returns false on storage error
+static bool storage_cli_receive_file(Cli* cli, File* file, uint8_t* buffer, uint64_t size) {
+    bool success = true;
+
+    for(uint64_t received_size = 0; received_size < size;) {
+        const size_t block_size = MIN(size - received_size, (uint64_t)STORAGE_CLI_BLOCK_SIZE);
+        const size_t read_size = cli_read(cli, buffer, block_size);
+        if(read_size == 0) {
+            success = false;
+            break;
+        }
+
+        // Keep consuming input after error, host has to be able to send the next command
+        if(success && storage_file_write(file, buffer, read_size) != read_size) {
+            success = false;
+        }
+        received_size += read_size;
+    }
+
+    return success;
+}
+
 static void storage_cli_read(Cli* cli, FuriString* path) {
-    UNUSED(cli);
     Storage* api = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(api);
 
     if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
-        const size_t buffer_size = 128;
-        size_t read_size = 0;
-        uint8_t* data = malloc(buffer_size);
+        uint8_t* data = malloc(STORAGE_CLI_BLOCK_SIZE);
+        const uint64_t file_size = storage_file_size(file);
 
-        printf("Size: %lu\r\n", (uint32_t)storage_file_size(file));
-
-        do {
-            read_size = storage_file_read(file, data, buffer_size);
-            for(size_t i = 0; i < read_size; i++) {
-                printf("%c", data[i]);
-            }
-        } while(read_size > 0);
+        printf("Size: %lu\r\n", (uint32_t)file_size);
+        storage_cli_send_file(cli, file, data, file_size);
         printf("\r\n");
 
         free(data);
@@ -233,36 +267,35 @@ static void storage_cli_write(Cli* cli, FuriString* path) {
     if(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_OPEN_APPEND)) {
         printf("Just write your text data. New line by Ctrl+Enter, exit by Ctrl+C.\r\n");
 
-        uint32_t read_index = 0;
-
-        while(true) {
-            uint8_t symbol = cli_getc(cli);
+        fflush(stdout);
 
-            if(symbol == CliSymbolAsciiETX) {
-                size_t write_size = read_index % buffer_size;
+        size_t buffered_size = 0;
+        bool done = false;
 
-                if(write_size > 0) {
-                    size_t written_size = storage_file_write(file, buffer, write_size);
+        while(!done) {
+            // Wait for input, then take everything that is already there
+            size_t read_size = cli_read(cli, buffer + buffered_size, 1);
+            if(read_size == 0) break;
+            read_size += cli_read_timeout(
+                cli, buffer + buffered_size + 1, buffer_size - buffered_size - 1, 0);
 
-                    if(written_size != write_size) {
-                        storage_cli_print_error(storage_file_get_error(file));
-                    }
-                    break;
-                }
+            uint8_t* etx = memchr(buffer + buffered_size, CliSymbolAsciiETX, read_size);
+            if(etx) {
+                read_size = etx - (buffer + buffered_size);
+                done = true;
             }
 
-            buffer[read_index % buffer_size] = symbol;
-            printf("%c", buffer[read_index % buffer_size]);
-            fflush(stdout);
-            read_index++;
+            cli_write(cli, buffer + buffered_size, read_size);
+            buffered_size += read_size;
 
-            if(((read_index % buffer_size) == 0)) {
-                size_t written_size = storage_file_write(file, buffer, buffer_size);
+            if(buffered_size == buffer_size || (done && buffered_size > 0)) {
+                size_t written_size = storage_file_write(file, buffer, buffered_size);
 
-                if(written_size != buffer_size) {
+                if(written_size != buffered_size) {
                     storage_cli_print_error(storage_file_get_error(file));
                     break;
                 }
+                buffered_size = 0;
             }
         }
         printf("\r\n");
@@ -292,16 +325,16 @@ static void storage_cli_read_chunks(Cli* cli, FuriString* path, FuriString* args
         printf("Size: %llu\r\n", file_size);
 
         if(buffer_size) {
-            uint8_t* data = malloc(buffer_size);
+            // Chunk size is not limited by RAM: every chunk is streamed in blocks
+            uint8_t* data = malloc(STORAGE_CLI_BLOCK_SIZE);
             while(file_size > 0) {
                 printf("\r\nReady?\r\n");
                 cli_getc(cli);
 
-                size_t read_size = storage_file_read(file, data, buffer_size);
-                for(size_t i = 0; i < read_size; i++) {
-                    putchar(data[i]);
-                }
-                file_size -= read_size;
+                const uint64_t chunk_size = MIN(file_size, (uint64_t)buffer_size);
+                const uint64_t sent_size = storage_cli_send_file(cli, file, data, chunk_size);
+                if(sent_size != chunk_size) break;
+                file_size -= sent_size;
             }
             free(data);
         }
@@ -331,13 +364,10 @@ static void storage_cli_write_chunk(Cli* cli, FuriString* path, FuriString* args
             printf("Ready\r\n");
 
             if(buffer_size) {
-                uint8_t* buffer = malloc(buffer_size);
-
-                size_t read_bytes = cli_read(cli, buffer, buffer_size);
-
-                size_t written_size = storage_file_write(file, buffer, read_bytes);
+                // Chunk size is not limited by RAM: data is streamed to file in blocks
+                uint8_t* buffer = malloc(STORAGE_CLI_BLOCK_SIZE);
 
-                if(written_size != buffer_size) {
+                if(!storage_cli_receive_file(cli, file, buffer, buffer_size)) {
                     storage_cli_print_error(storage_file_get_error(file));
                 }
 
@@ -1,6 +1,7 @@
 #include "storage_processing.h"
 #include <m-list.h>
 #include <m-dict.h>
+#include <toolbox/trace.h>
 
 #define STORAGE_PATH_PREFIX_LEN 4u
 _Static_assert(
@@ -774,5 +775,7 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    TRACE_BEGIN(StorageRequest);
     storage_process_message_internal(app, message);
+    TRACE_END(StorageRequest);
 }
@@ -255,6 +255,9 @@ static int32_t js_thread(void* arg) {
 
     mjs_set_exec_flags_poller(mjs, js_exit_flag_poll);
 
+    // Reuse bytecode compiled on previous runs of unchanged scripts
+    mjs_set_generate_jsc(mjs, 1);
+
     mjs_err_t err = mjs_exec_file(mjs, furi_string_get_cstr(worker->path), NULL);
 
 #ifdef JS_DEBUG
@@ -9,12 +9,12 @@
 #include <update_util/dfu_file.h>
 #include <update_util/lfs_backup.h>
 #include <update_util/update_operation.h>
-#include <update_util/resources/manifest.h>
-#include <toolbox/tar/tar_archive.h>
-#include <toolbox/crc32_calc.h>
+#include <update_util/resources/resource_install.h>
 
 #define TAG "UpdWorkerBackup"
 
+#define UPDATE_TASK_RESOURCES_NEW_MANIFEST_NAME "Manifest.new"
+
 static bool update_task_pre_update(UpdateTask* update_task) {
     bool success = false;
     FuriString* backup_file_path;
@@ -36,114 +36,9 @@ static bool update_task_pre_update(UpdateTask* update_task) {
     return success;
 }
 
-typedef enum {
-    UpdateTaskResourcesWeightsFileCleanup = 20,
-    UpdateTaskResourcesWeightsDirCleanup = 20,
-    UpdateTaskResourcesWeightsFileUnpack = 60,
-} UpdateTaskResourcesWeights;
-
-#define UPDATE_TASK_RESOURCES_FILE_TO_TOTAL_PERCENT 90
-
-typedef struct {
-    UpdateTask* update_task;
-    int32_t total_files, processed_files;
-} TarUnpackProgress;
-
-static bool update_task_resource_unpack_cb(const char* name, bool is_directory, void* context) {
-    UNUSED(name);
-    UNUSED(is_directory);
-    TarUnpackProgress* unpack_progress = context;
-    unpack_progress->processed_files++;
-    update_task_set_progress(
-        unpack_progress->update_task,
-        UpdateTaskStageProgress,
-        /* For this stage, last progress segment = extraction */
-        (UpdateTaskResourcesWeightsFileCleanup + UpdateTaskResourcesWeightsDirCleanup) +
-            (unpack_progress->processed_files * UpdateTaskResourcesWeightsFileUnpack) /
-                (unpack_progress->total_files + 1));
-    return true;
-}
-
-static void update_task_cleanup_resources(UpdateTask* update_task, const uint32_t n_tar_entries) {
-    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
-    do {
-        FURI_LOG_D(TAG, "Cleaning up old manifest");
-        if(!resource_manifest_reader_open(manifest_reader, EXT_PATH("Manifest"))) {
-            FURI_LOG_W(TAG, "No existing manifest");
-            break;
-        }
-
-        const uint32_t n_approx_file_entries =
-            n_tar_entries * UPDATE_TASK_RESOURCES_FILE_TO_TOTAL_PERCENT / 100 + 1;
-        uint32_t n_dir_entries = 1;
-
-        ResourceManifestEntry* entry_ptr = NULL;
-        uint32_t n_processed_entries = 0;
-        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
-            if(entry_ptr->type == ResourceManifestEntryTypeFile) {
-                update_task_set_progress(
-                    update_task,
-                    UpdateTaskStageProgress,
-                    /* For this stage, first pass = old manifest's file cleanup */
-                    (n_processed_entries++ * UpdateTaskResourcesWeightsFileCleanup) /
-                        n_approx_file_entries);
-
-                FuriString* file_path = furi_string_alloc();
-                path_concat(
-                    STORAGE_EXT_PATH_PREFIX, furi_string_get_cstr(entry_ptr->name), file_path);
-                FURI_LOG_D(TAG, "Removing %s", furi_string_get_cstr(file_path));
-
-                FS_Error result =
-                    storage_common_remove(update_task->storage, furi_string_get_cstr(file_path));
-                if(result != FSE_OK && result != FSE_EXIST) {
-                    FURI_LOG_E(
-                        TAG,
-                        "%s remove failed, cause %s",
-                        furi_string_get_cstr(file_path),
-                        storage_error_get_desc(result));
-                }
-                furi_string_free(file_path);
-            } else if(entry_ptr->type == ResourceManifestEntryTypeDirectory) {
-                n_dir_entries++;
-            }
-        }
-
-        n_processed_entries = 0;
-        while((entry_ptr = resource_manifest_reader_previous(manifest_reader))) {
-            if(entry_ptr->type == ResourceManifestEntryTypeDirectory) {
-                update_task_set_progress(
-                    update_task,
-                    UpdateTaskStageProgress,
-                    /* For this stage, second 10% of progress = cleanup directories */
-                    UpdateTaskResourcesWeightsFileCleanup +
-                        (n_processed_entries++ * UpdateTaskResourcesWeightsDirCleanup) /
-                            n_dir_entries);
-
-                FuriString* folder_path = furi_string_alloc();
-
-                do {
-                    path_concat(
-                        STORAGE_EXT_PATH_PREFIX,
-                        furi_string_get_cstr(entry_ptr->name),
-                        folder_path);
-
-                    FURI_LOG_D(TAG, "Removing folder %s", furi_string_get_cstr(folder_path));
-                    FS_Error result = storage_common_remove(
-                        update_task->storage, furi_string_get_cstr(folder_path));
-                    if(result != FSE_OK && result != FSE_EXIST) {
-                        FURI_LOG_E(
-                            TAG,
-                            "%s remove failed, cause %s",
-                            furi_string_get_cstr(folder_path),
-                            storage_error_get_desc(result));
-                    }
-                } while(false);
-
-                furi_string_free(folder_path);
-            }
-        }
-    } while(false);
-    resource_manifest_reader_free(manifest_reader);
+static void update_task_resources_progress_cb(uint8_t progress, void* context) {
+    UpdateTask* update_task = context;
+    update_task_set_progress(update_task, UpdateTaskStageProgress, progress);
 }
 
 static bool update_task_post_update(UpdateTask* update_task) {
@@ -152,7 +47,6 @@ static bool update_task_post_update(UpdateTask* update_task) {
     FuriString* file_path;
     file_path = furi_string_alloc();
 
-    TarArchive* archive = tar_archive_alloc(update_task->storage);
     do {
         path_concat(
             furi_string_get_cstr(update_task->update_path),
@@ -175,11 +69,6 @@ static bool update_task_post_update(UpdateTask* update_task) {
 #endif
 
         if(update_task->state.groups & UpdateTaskStageGroupResources) {
-            TarUnpackProgress progress = {
-                .update_task = update_task,
-                .total_files = 0,
-                .processed_files = 0,
-            };
             update_task_set_progress(update_task, UpdateTaskStageResourcesUpdate, 0);
 
             path_concat(
@@ -187,16 +76,22 @@ static bool update_task_post_update(UpdateTask* update_task) {
                 furi_string_get_cstr(update_task->manifest->resource_bundle),
                 file_path);
 
-            tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
-            CHECK_RESULT(
-                tar_archive_open(archive, furi_string_get_cstr(file_path), TAR_OPEN_MODE_READ));
-
-            progress.total_files = tar_archive_get_entries_count(archive);
-            if(progress.total_files > 0) {
-                update_task_cleanup_resources(update_task, progress.total_files);
-
-                CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
-            }
+            FuriString* manifest_path = furi_string_alloc();
+            path_concat(
+                furi_string_get_cstr(update_task->update_path),
+                UPDATE_TASK_RESOURCES_NEW_MANIFEST_NAME,
+                manifest_path);
+
+            bool installed = resource_install(
+                update_task->storage,
+                furi_string_get_cstr(file_path),
+                STORAGE_EXT_PATH_PREFIX,
+                furi_string_get_cstr(manifest_path),
+                update_task_resources_progress_cb,
+                update_task,
+                NULL);
+            furi_string_free(manifest_path);
+            CHECK_RESULT(installed);
         }
 
         if(update_task->state.groups & UpdateTaskStageGroupSplashscreen) {
@@ -215,7 +110,6 @@ static bool update_task_post_update(UpdateTask* update_task) {
         success = true;
     } while(false);
 
-    tar_archive_free(archive);
     furi_string_free(file_path);
     return success;
 }
@@ -0,0 +1,467 @@
+#include "event_loop_i.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "memmgr.h"
+
+#include <m-array.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+typedef enum {
+    FuriEventLoopFlagEvent = (1 << 0), /**< Object state changed */
+    FuriEventLoopFlagThreadFlags = (1 << 1), /**< Thread flags were set */
+    FuriEventLoopFlagStop = (1 << 2), /**< Stop requested */
+} FuriEventLoopFlag;
+
+#define FURI_EVENT_LOOP_FLAG_ALL \
+    (FuriEventLoopFlagEvent | FuriEventLoopFlagThreadFlags | FuriEventLoopFlagStop)
+
+typedef enum {
+    FuriEventLoopObjectTypeMessageQueue,
+    FuriEventLoopObjectTypeStreamBuffer,
+    FuriEventLoopObjectTypeSemaphore,
+} FuriEventLoopObjectType;
+
+typedef struct {
+    void* object;
+    FuriEventLoopObjectType type;
+    FuriEventLoopLink* link;
+    FuriEventLoopEventCallback callback;
+    void* context;
+} FuriEventLoopItem;
+
+ARRAY_DEF(FuriEventLoopItemArray, FuriEventLoopItem, M_POD_OPLIST)
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimerCallback callback;
+    FuriEventLoopTimerType type;
+    void* context;
+    uint32_t interval;
+    uint32_t deadline;
+    bool running;
+    bool freed;
+};
+
+ARRAY_DEF(FuriEventLoopTimerArray, FuriEventLoopTimer*, M_PTR_OPLIST)
+
+#define M_OPL_FuriEventLoopTimerArray_t() ARRAY_OPLIST(FuriEventLoopTimerArray, M_PTR_OPLIST)
+
+struct FuriEventLoop {
+    FuriThreadId thread_id;
+    FuriEventLoop* parent; /**< Event loop this one is nested in */
+    FuriEventLoopItemArray_t items;
+    FuriEventLoopTimerArray_t timers;
+
+    FuriEventLoopThreadFlagsCallback thread_flags_callback;
+    void* thread_flags_context;
+
+    bool items_dirty; /**< Some items were unsubscribed during dispatch */
+    bool timers_dirty; /**< Some timers were freed during dispatch */
+    bool dispatching;
+    volatile bool stop_requested;
+};
+
+static void furi_event_loop_notify_thread(FuriThreadId thread_id, uint32_t flags) {
+    TaskHandle_t task = (TaskHandle_t)thread_id;
+
+    if(FURI_IS_IRQ_MODE()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            task, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits, &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(task, FURI_EVENT_LOOP_NOTIFY_INDEX, flags, eSetBits);
+    }
+}
+
+static void furi_event_loop_notify(FuriEventLoop* instance, uint32_t flags) {
+    furi_event_loop_notify_thread(instance->thread_id, flags);
+}
+
+void furi_event_loop_link_notify(FuriEventLoopLink* link) {
+    // Fast path: nobody is listening
+    if(!link->event_loop) return;
+
+    // Unsubscribe clears link in critical section, so loop can't go away here
+    FURI_CRITICAL_ENTER();
+    if(link->event_loop) {
+        furi_event_loop_notify(link->event_loop, FuriEventLoopFlagEvent);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id) {
+    furi_event_loop_notify_thread(thread_id, FuriEventLoopFlagThreadFlags);
+}
+
+static void furi_event_loop_clear_notifications(void) {
+    (void)xTaskNotifyStateClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX);
+    (void)ulTaskNotifyValueClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX, 0xFFFFFFFFUL);
+}
+
+FuriEventLoop* furi_event_loop_alloc(void) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+    instance->thread_id = furi_thread_get_current_id();
+    instance->parent = thread->event_loop;
+    FuriEventLoopItemArray_init(instance->items);
+    FuriEventLoopTimerArray_init(instance->timers);
+
+    // Leftovers from previous event loop of this thread
+    if(!instance->parent) furi_event_loop_clear_notifications();
+    thread->event_loop = instance;
+
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(!instance->dispatching);
+
+    FuriThread* thread = furi_thread_get_current();
+    // Nested event loops are freed in reverse order
+    furi_check(thread->event_loop == instance);
+    thread->event_loop = instance->parent;
+
+    while(FuriEventLoopItemArray_size(instance->items)) {
+        furi_event_loop_unsubscribe(
+            instance, FuriEventLoopItemArray_back(instance->items)->object);
+    }
+    FuriEventLoopItemArray_clear(instance->items);
+
+    for
+        M_EACH(timer, instance->timers, FuriEventLoopTimerArray_t) {
+            free(*timer);
+        }
+    FuriEventLoopTimerArray_clear(instance->timers);
+
+    if(instance->parent) {
+        // Notifications are shared by the thread: parent events were consumed by this loop
+        furi_event_loop_notify(instance->parent, FURI_EVENT_LOOP_FLAG_ALL);
+    } else {
+        furi_event_loop_clear_notifications();
+    }
+
+    free(instance);
+}
+
+static bool furi_event_loop_item_is_ready(FuriEventLoopItem* item) {
+    switch(item->type) {
+    case FuriEventLoopObjectTypeMessageQueue:
+        return furi_message_queue_get_count(item->object) > 0;
+    case FuriEventLoopObjectTypeStreamBuffer:
+        return !furi_stream_buffer_is_empty(item->object);
+    case FuriEventLoopObjectTypeSemaphore:
+        return furi_semaphore_get_count(item->object) > 0;
+    default:
+        furi_crash();
+    }
+}
+
+static void furi_event_loop_sweep(FuriEventLoop* instance) {
+    if(instance->items_dirty) {
+        FuriEventLoopItemArray_it_t it;
+        FuriEventLoopItemArray_it(it, instance->items);
+        while(!FuriEventLoopItemArray_end_p(it)) {
+            if(FuriEventLoopItemArray_cref(it)->object == NULL) {
+                FuriEventLoopItemArray_remove(instance->items, it);
+            } else {
+                FuriEventLoopItemArray_next(it);
+            }
+        }
+        instance->items_dirty = false;
+    }
+
+    if(instance->timers_dirty) {
+        FuriEventLoopTimerArray_it_t it;
+        FuriEventLoopTimerArray_it(it, instance->timers);
+        while(!FuriEventLoopTimerArray_end_p(it)) {
+            FuriEventLoopTimer* timer = *FuriEventLoopTimerArray_cref(it);
+            if(timer->freed) {
+                FuriEventLoopTimerArray_remove(instance->timers, it);
+                free(timer);
+            } else {
+                FuriEventLoopTimerArray_next(it);
+            }
+        }
+        instance->timers_dirty = false;
+    }
+}
+
+/** Dispatch ready objects and thread flags
+ *
+ * @return     true if some object is still ready after its callback
+ */
+static bool furi_event_loop_process_items(FuriEventLoop* instance) {
+    bool pending = false;
+
+    if(instance->thread_flags_callback) {
+        uint32_t flags = furi_thread_flags_get();
+        if(flags && !(flags & FuriFlagError)) {
+            furi_thread_flags_clear(flags);
+            instance->thread_flags_callback(flags, instance->thread_flags_context);
+        }
+    }
+
+    // Subscriptions may change inside callbacks, so iterate by index
+    for(size_t i = 0; i < FuriEventLoopItemArray_size(instance->items); i++) {
+        FuriEventLoopItem* item = FuriEventLoopItemArray_get(instance->items, i);
+        if(item->object && furi_event_loop_item_is_ready(item)) {
+            item->callback(item->object, item->context);
+            // Array may be reallocated by subscribe in callback
+            item = FuriEventLoopItemArray_get(instance->items, i);
+            pending |= item->object && furi_event_loop_item_is_ready(item);
+        }
+    }
+
+    return pending;
+}
+
+/** Dispatch expired timers
+ *
+ * @return     ticks till next timer deadline or FuriWaitForever
+ */
+static uint32_t furi_event_loop_process_timers(FuriEventLoop* instance) {
+    uint32_t now = furi_get_tick();
+    uint32_t timeout = FuriWaitForever;
+
+    for(size_t i = 0; i < FuriEventLoopTimerArray_size(instance->timers); i++) {
+        FuriEventLoopTimer* timer = *FuriEventLoopTimerArray_get(instance->timers, i);
+        if(!timer->running || timer->freed) continue;
+
+        if((int32_t)(timer->deadline - now) > 0) continue;
+
+        if(timer->type == FuriEventLoopTimerTypePeriodic) {
+            timer->deadline += timer->interval;
+            // Skip missed periods instead of firing them in burst
+            if((int32_t)(timer->deadline - now) <= 0) {
+                timer->deadline = now + timer->interval;
+            }
+        } else {
+            timer->running = false;
+        }
+        timer->callback(timer->context);
+        now = furi_get_tick();
+    }
+
+    // Callbacks may start any timer, so the nearest deadline is found after all of them ran
+    for(size_t i = 0; i < FuriEventLoopTimerArray_size(instance->timers); i++) {
+        FuriEventLoopTimer* timer = *FuriEventLoopTimerArray_get(instance->timers, i);
+        if(!timer->running || timer->freed) continue;
+
+        int32_t remaining = (int32_t)(timer->deadline - now);
+        uint32_t ticks = remaining > 0 ? (uint32_t)remaining : 0;
+        timeout = MIN(timeout, ticks);
+    }
+
+    return timeout;
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(!instance->dispatching);
+
+    while(true) {
+        instance->dispatching = true;
+        bool pending = furi_event_loop_process_items(instance);
+        uint32_t timeout = furi_event_loop_process_timers(instance);
+        instance->dispatching = false;
+        furi_event_loop_sweep(instance);
+
+        if(pending) timeout = 0;
+
+        // Stop notification may also be meant for a loop this one is nested in
+        (void)xTaskNotifyWaitIndexed(
+            FURI_EVENT_LOOP_NOTIFY_INDEX, 0, FURI_EVENT_LOOP_FLAG_ALL, NULL, timeout);
+        if(instance->stop_requested) {
+            instance->stop_requested = false;
+            break;
+        }
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_check(instance);
+    instance->stop_requested = true;
+    furi_event_loop_notify(instance, FuriEventLoopFlagStop);
+}
+
+static void furi_event_loop_subscribe(
+    FuriEventLoop* instance,
+    void* object,
+    FuriEventLoopObjectType type,
+    FuriEventLoopLink* link,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(object);
+    furi_check(callback);
+    furi_check(link->event_loop == NULL);
+
+    FuriEventLoopItem* item = FuriEventLoopItemArray_push_new(instance->items);
+    item->object = object;
+    item->type = type;
+    item->link = link;
+    item->callback = callback;
+    item->context = context;
+
+    FURI_CRITICAL_ENTER();
+    link->event_loop = instance;
+    FURI_CRITICAL_EXIT();
+
+    // Object may already contain data
+    furi_event_loop_notify(instance, FuriEventLoopFlagEvent);
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        message_queue,
+        FuriEventLoopObjectTypeMessageQueue,
+        furi_message_queue_get_event_loop_link(message_queue),
+        callback,
+        context);
+}
+
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        stream_buffer,
+        FuriEventLoopObjectTypeStreamBuffer,
+        furi_stream_buffer_get_event_loop_link(stream_buffer),
+        callback,
+        context);
+}
+
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        semaphore,
+        FuriEventLoopObjectTypeSemaphore,
+        furi_semaphore_get_event_loop_link(semaphore),
+        callback,
+        context);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopItemArray_it_t it;
+    for(FuriEventLoopItemArray_it(it, instance->items); !FuriEventLoopItemArray_end_p(it);
+        FuriEventLoopItemArray_next(it)) {
+        FuriEventLoopItem* item = FuriEventLoopItemArray_ref(it);
+        if(item->object != object) continue;
+
+        FURI_CRITICAL_ENTER();
+        item->link->event_loop = NULL;
+        FURI_CRITICAL_EXIT();
+
+        if(instance->dispatching) {
+            item->object = NULL;
+            instance->items_dirty = true;
+        } else {
+            FuriEventLoopItemArray_remove(instance->items, it);
+        }
+        return;
+    }
+
+    furi_crash("Object is not subscribed");
+}
+
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(callback);
+
+    instance->thread_flags_callback = callback;
+    instance->thread_flags_context = context;
+    furi_event_loop_notify(instance, FuriEventLoopFlagThreadFlags);
+}
+
+void furi_event_loop_unsubscribe_thread_flags(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    instance->thread_flags_callback = NULL;
+    instance->thread_flags_context = NULL;
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(callback);
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->event_loop = instance;
+    timer->callback = callback;
+    timer->type = type;
+    timer->context = context;
+
+    FuriEventLoopTimerArray_push_back(instance->timers, timer);
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    FuriEventLoop* instance = timer->event_loop;
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+    timer->freed = true;
+    instance->timers_dirty = true;
+    if(!instance->dispatching) {
+        furi_event_loop_sweep(instance);
+    }
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_check(timer);
+    furi_check(interval > 0);
+    furi_check(timer->event_loop->thread_id == furi_thread_get_current_id());
+
+    timer->interval = interval;
+    timer->deadline = furi_get_tick() + interval;
+    timer->running = true;
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    furi_check(timer->event_loop->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    return timer->running;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file event_loop.h
+ * Furi Event Loop
+ *
+ * Event loop lets single thread wait for several event sources at once:
+ * message queues, stream buffers, semaphores, thread flags and timers.
+ * Thread sleeps until one of them becomes ready or nearest timer expires,
+ * then corresponding callbacks are dispatched in the context of this thread.
+ *
+ * Object events are level triggered: callback is called on every loop
+ * iteration while object is ready (queue is not empty, stream buffer has
+ * data, semaphore can be acquired), so callback must consume the data.
+ */
+#pragma once
+
+#include "base.h"
+#include "message_queue.h"
+#include "stream_buffer.h"
+#include "semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+/** Object event callback
+ *
+ * @param      object   object that is ready
+ * @param      context  callback context
+ */
+typedef void (*FuriEventLoopEventCallback)(void* object, void* context);
+
+/** Thread flags callback
+ *
+ * @param      flags    flags that were set, they are cleared before the call
+ * @param      context  callback context
+ */
+typedef void (*FuriEventLoopThreadFlagsCallback)(uint32_t flags, void* context);
+
+/** Timer callback
+ *
+ * @param      context  callback context
+ */
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+typedef enum {
+    FuriEventLoopTimerTypeOnce, /**< Fire once, then stop */
+    FuriEventLoopTimerTypePeriodic, /**< Fire periodically until stopped */
+} FuriEventLoopTimerType;
+
+/** Allocate event loop
+ *
+ * Event loop is bound to the current thread: it must be run and freed from
+ * this thread. Event loop can be allocated and run from a callback of another
+ * event loop of the same thread, nested loops must be freed in reverse order
+ * and the outer loop only dispatches again after the nested one is freed.
+ *
+ * @return     FuriEventLoop instance
+ */
+FuriEventLoop* furi_event_loop_alloc(void);
+
+/** Free event loop
+ *
+ * All subscriptions are removed, timers are freed.
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Run event loop
+ *
+ * Dispatches events until furi_event_loop_stop is called.
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Stop event loop
+ *
+ * Can be called from any thread or from ISR.
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue, callback is called while queue is not empty
+ *
+ * Object can be subscribed to only one event loop at a time.
+ *
+ * @param      instance       FuriEventLoop instance
+ * @param      message_queue  FuriMessageQueue instance
+ * @param      callback       FuriEventLoopEventCallback
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Subscribe to stream buffer, callback is called while buffer is not empty
+ *
+ * @param      instance       FuriEventLoop instance
+ * @param      stream_buffer  FuriStreamBuffer instance
+ * @param      callback       FuriEventLoopEventCallback
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Subscribe to semaphore, callback is called while semaphore count is not 0
+ *
+ * @param      instance   FuriEventLoop instance
+ * @param      semaphore  FuriSemaphore instance
+ * @param      callback   FuriEventLoopEventCallback
+ * @param      context    callback context
+ */
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
+/** Unsubscribe from object
+ *
+ * Safe to call from event callbacks.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      object    previously subscribed object
+ */
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object);
+
+/** Subscribe to thread flags of the loop owner thread
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      callback  FuriEventLoopThreadFlagsCallback
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context);
+
+/** Unsubscribe from thread flags
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_unsubscribe_thread_flags(FuriEventLoop* instance);
+
+/** Allocate event loop timer
+ *
+ * Timers are driven by event loop itself and do not use timer service.
+ * All timer functions must be called from the event loop thread.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      callback  FuriEventLoopTimerCallback
+ * @param      type      FuriEventLoopTimerType
+ * @param      context   callback context
+ *
+ * @return     FuriEventLoopTimer instance
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context);
+
+/** Free event loop timer, safe to call from timer callback
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start or restart timer
+ *
+ * @param      timer     FuriEventLoopTimer instance
+ * @param      interval  interval in ticks, must be greater than 0
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop timer
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Check if timer is running
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ *
+ * @return     true if running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "event_loop.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Task notification index used by event loop.
+ * 0 is used by stream buffers, 1 by thread flags. */
+#define FURI_EVENT_LOOP_NOTIFY_INDEX 2
+
+/** Link between object and event loop it is subscribed to */
+typedef struct {
+    FuriEventLoop* volatile event_loop;
+} FuriEventLoopLink;
+
+/** Notify event loop linked to object about object state change
+ *
+ * Called by object implementations after data was added, ISR safe.
+ *
+ * @param      link  FuriEventLoopLink of the object
+ */
+void furi_event_loop_link_notify(FuriEventLoopLink* link);
+
+/** Notify event loop of the thread about thread flags change, ISR safe
+ *
+ * @param      thread_id  event loop owner thread
+ */
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id);
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance);
+
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer);
+
+FuriEventLoopLink* furi_semaphore_get_event_loop_link(FuriSemaphore* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
 #include <m-list.h>
 
@@ -8,10 +9,78 @@ LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+/* Asynchronous log ring
+ *
+ * Records are stored in binary form: header, optional inline strings and
+ * raw arguments captured according to format string. Formatting happens
+ * later in low priority drain thread. Layout is mirrored by
+ * scripts/log_ring_decode.py, keep them in sync.
+ */
+#define FURI_LOG_RING_MAGIC (0x474F4C46UL) /* "FLOG" */
+#define FURI_LOG_RING_SIZE (4096UL) /* Must be power of 2 */
+#define FURI_LOG_RING_STR_MAX (64UL)
+#define FURI_LOG_RING_INLINE_MAX (255UL)
+#define FURI_LOG_RING_SPEC_MAX (24UL)
+
+#define FURI_LOG_RING_DRAIN_STACK_SIZE (1024UL)
+#define FURI_LOG_RING_DRAIN_FLAG_DATA (1UL << 0)
+
+typedef enum {
+    FuriLogRingStateReserved = 0,
+    FuriLogRingStateCommitted = 1,
+    FuriLogRingStatePadding = 2,
+} FuriLogRingState;
+
+typedef enum {
+    FuriLogRingFlagRaw = (1 << 0), /**< No timestamp, level and tag prefix */
+    FuriLogRingFlagTagInline = (1 << 1), /**< Tag copied to record */
+    FuriLogRingFlagFormatInline = (1 << 2), /**< Format copied to record */
+} FuriLogRingFlag;
+
+typedef struct {
+    uint16_t size; /**< Record size including header, multiple of 4 */
+    uint8_t state; /**< FuriLogRingState */
+    uint8_t level; /**< Low nibble: FuriLogLevel, high nibble: FuriLogRingFlag */
+    uint32_t timestamp;
+    const char* tag;
+    const char* format;
+} FuriLogRingRecord;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    volatile uint32_t head; /**< Write position, free running */
+    volatile uint32_t tail; /**< Read position, free running */
+    volatile uint32_t dropped; /**< Records lost due to overflow */
+    uint8_t data[FURI_LOG_RING_SIZE];
+} FuriLogRing;
+
+typedef enum {
+    FuriLogRingArgNone,
+    FuriLogRingArgInt,
+    FuriLogRingArgInt64,
+    FuriLogRingArgDouble,
+    FuriLogRingArgPointer,
+    FuriLogRingArgString,
+} FuriLogRingArg;
+
+#define FURI_LOG_RING_PRECISION_NONE (-1)
+#define FURI_LOG_RING_PRECISION_STAR (-2)
+
+typedef struct {
+    FuriLogRingArg arg;
+    uint8_t stars; /**< Count of '*' width and precision arguments */
+    int precision; /**< Literal precision, FURI_LOG_RING_PRECISION_NONE or _STAR */
+    bool print; /**< false for %n */
+} FuriLogRingSpec;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriMutex* mutex;
     FuriLogHandlersList_t tx_handlers;
+    FuriLogRing* ring;
+    FuriThread* drain_thread;
+    volatile bool async;
 } FuriLogParams;
 
 static FuriLogParams furi_log = {0};
@@ -107,39 +176,480 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
+static const char* furi_log_level_letter(FuriLogLevel level, const char** color) {
+    const char* log_letter = " ";
+    *color = _FURI_LOG_CLR_RESET;
+    switch(level) {
+    case FuriLogLevelError:
+        *color = _FURI_LOG_CLR_E;
+        log_letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        *color = _FURI_LOG_CLR_W;
+        log_letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        *color = _FURI_LOG_CLR_I;
+        log_letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        *color = _FURI_LOG_CLR_D;
+        log_letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        *color = _FURI_LOG_CLR_T;
+        log_letter = "T";
+        break;
+    default:
+        break;
+    }
+    return log_letter;
+}
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
-            break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
-            break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
-            break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
+/** Parse printf conversion specification
+ *
+ * @param      format  pointer to character following '%'
+ * @param      spec    parsed specification
+ *
+ * @return     pointer to character following specification
+ */
+static const char* furi_log_ring_spec_parse(const char* format, FuriLogRingSpec* spec) {
+    spec->arg = FuriLogRingArgNone;
+    spec->stars = 0;
+    spec->precision = FURI_LOG_RING_PRECISION_NONE;
+    spec->print = true;
+
+    while(*format && strchr("-+ #0", *format)) format++;
+    if(*format == '*') {
+        spec->stars++;
+        format++;
+    }
+    while(*format >= '0' && *format <= '9') format++;
+    if(*format == '.') {
+        format++;
+        if(*format == '*') {
+            spec->stars++;
+            spec->precision = FURI_LOG_RING_PRECISION_STAR;
+            format++;
+        } else {
+            spec->precision = 0;
+            while(*format >= '0' && *format <= '9') {
+                spec->precision = spec->precision * 10 + (*format - '0');
+                format++;
+            }
+        }
+    }
+
+    bool is_64bit = false;
+    if(format[0] == 'l' && format[1] == 'l') {
+        is_64bit = true;
+        format += 2;
+    } else if(format[0] == 'h' && format[1] == 'h') {
+        format += 2;
+    } else if(*format == 'j') {
+        is_64bit = (sizeof(intmax_t) == sizeof(int64_t));
+        format++;
+    } else if(*format == 'l') {
+        is_64bit = (sizeof(long) == sizeof(int64_t));
+        format++;
+    } else if(*format == 'z') {
+        is_64bit = (sizeof(size_t) == sizeof(int64_t));
+        format++;
+    } else if(*format == 't') {
+        is_64bit = (sizeof(ptrdiff_t) == sizeof(int64_t));
+        format++;
+    } else if(*format == 'h' || *format == 'L') {
+        format++;
+    }
+
+    switch(*format) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        spec->arg = is_64bit ? FuriLogRingArgInt64 : FuriLogRingArgInt;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->arg = FuriLogRingArgDouble;
+        break;
+    case 'p':
+        spec->arg = FuriLogRingArgPointer;
+        break;
+    case 'n':
+        spec->arg = FuriLogRingArgPointer;
+        spec->print = false;
+        break;
+    case 's':
+        spec->arg = FuriLogRingArgString;
+        break;
+    case '\0':
+        return format;
+    default:
+        break;
+    }
+
+    return format + 1;
+}
+
+static inline void furi_log_ring_put(uint8_t* out, size_t* offset, const void* data, size_t size) {
+    if(out) memcpy(&out[*offset], data, size);
+    *offset += size;
+}
+
+/* String may be not terminated past max, as allowed by printf precision */
+static void furi_log_ring_put_string(uint8_t* out, size_t* offset, const char* str, size_t max) {
+    uint8_t length = strnlen(str, max);
+    furi_log_ring_put(out, offset, &length, sizeof(length));
+    furi_log_ring_put(out, offset, str, length);
+}
+
+/** Capture arguments according to format
+ *
+ * @param      out     output buffer or NULL to calculate size
+ *
+ * @return     encoded size
+ */
+static size_t furi_log_ring_args_encode(uint8_t* out, const char* format, va_list args) {
+    size_t offset = 0;
+    FuriLogRingSpec spec;
+
+    while((format = strchr(format, '%'))) {
+        format = furi_log_ring_spec_parse(format + 1, &spec);
+        int precision = spec.precision;
+        for(uint8_t i = 0; i < spec.stars; i++) {
+            int star = va_arg(args, int);
+            furi_log_ring_put(out, &offset, &star, sizeof(star));
+            // Precision star always goes last, negative one means no precision
+            if(precision == FURI_LOG_RING_PRECISION_STAR && i + 1 == spec.stars) {
+                precision = star < 0 ? FURI_LOG_RING_PRECISION_NONE : star;
+            }
+        }
+        if(spec.arg == FuriLogRingArgInt) {
+            int value = va_arg(args, int);
+            furi_log_ring_put(out, &offset, &value, sizeof(value));
+        } else if(spec.arg == FuriLogRingArgInt64) {
+            int64_t value = va_arg(args, int64_t);
+            furi_log_ring_put(out, &offset, &value, sizeof(value));
+        } else if(spec.arg == FuriLogRingArgDouble) {
+            double value = va_arg(args, double);
+            furi_log_ring_put(out, &offset, &value, sizeof(value));
+        } else if(spec.arg == FuriLogRingArgPointer) {
+            void* value = va_arg(args, void*);
+            furi_log_ring_put(out, &offset, &value, sizeof(value));
+        } else if(spec.arg == FuriLogRingArgString) {
+            const char* value = va_arg(args, const char*);
+            size_t max = FURI_LOG_RING_STR_MAX;
+            if(precision >= 0) max = MIN(max, (size_t)precision);
+            furi_log_ring_put_string(out, &offset, value ? value : "(null)", max);
+        }
+    }
+
+    return offset;
+}
+
+/** Strings living in firmware flash can be referenced by pointer, anything
+ * else (FAP rodata, RAM) may be gone by the time record is formatted */
+static bool furi_log_ring_is_persistent(const char* str) {
+    return (uintptr_t)str >= furi_hal_flash_get_base() &&
+           (uintptr_t)str < (uintptr_t)furi_hal_flash_get_free_start_address();
+}
+
+/** Inline format is never truncated: its arguments would be decoded against other format */
+static bool furi_log_ring_can_store(const char* format) {
+    return furi_log_ring_is_persistent(format) ||
+           strnlen(format, FURI_LOG_RING_INLINE_MAX + 1) <= FURI_LOG_RING_INLINE_MAX;
+}
+
+static FuriLogRingRecord* furi_log_ring_reserve(FuriLogRing* ring, size_t size) {
+    FuriLogRingRecord* record = NULL;
+
+    FURI_CRITICAL_ENTER();
+    do {
+        const uint32_t offset = ring->head & (ring->size - 1);
+        const uint32_t to_end = ring->size - offset;
+        const uint32_t padding = (to_end < size) ? to_end : 0;
+        if(size > ring->size / 2 || ring->head + padding + size - ring->tail > ring->size) {
+            ring->dropped++;
             break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
+        }
+
+        if(padding) {
+            FuriLogRingRecord* pad = (FuriLogRingRecord*)&ring->data[offset];
+            pad->size = padding;
+            pad->state = FuriLogRingStatePadding;
+            ring->head += padding;
+        }
+
+        record = (FuriLogRingRecord*)&ring->data[ring->head & (ring->size - 1)];
+        record->size = size;
+        record->state = FuriLogRingStateReserved;
+        ring->head += size;
+    } while(false);
+    FURI_CRITICAL_EXIT();
+
+    return record;
+}
+
+static void furi_log_ring_write(
+    FuriLogLevel level,
+    uint8_t flags,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    FuriLogRing* ring = furi_log.ring;
+
+    if(tag && !furi_log_ring_is_persistent(tag)) flags |= FuriLogRingFlagTagInline;
+    if(!furi_log_ring_is_persistent(format)) flags |= FuriLogRingFlagFormatInline;
+
+    size_t size = sizeof(FuriLogRingRecord);
+    if(flags & FuriLogRingFlagTagInline) size += 1 + strnlen(tag, FURI_LOG_RING_STR_MAX);
+    if(flags & FuriLogRingFlagFormatInline) size += 1 + strlen(format);
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    size += furi_log_ring_args_encode(NULL, format, args_copy);
+    va_end(args_copy);
+    size = (size + 3) & ~3UL;
+
+    FuriLogRingRecord* record = furi_log_ring_reserve(ring, size);
+    if(!record) return;
+
+    record->level = (level & 0x0F) | (flags << 4);
+    record->timestamp = furi_get_tick();
+    record->tag = tag;
+    record->format = format;
+
+    uint8_t* payload = (uint8_t*)record + sizeof(FuriLogRingRecord);
+    size_t offset = 0;
+    if(flags & FuriLogRingFlagTagInline)
+        furi_log_ring_put_string(payload, &offset, tag, FURI_LOG_RING_STR_MAX);
+    if(flags & FuriLogRingFlagFormatInline)
+        furi_log_ring_put_string(payload, &offset, format, FURI_LOG_RING_INLINE_MAX);
+    furi_log_ring_args_encode(&payload[offset], format, args);
+
+    __DMB();
+    record->state = FuriLogRingStateCommitted;
+
+    furi_thread_flags_set(
+        furi_thread_get_id(furi_log.drain_thread), FURI_LOG_RING_DRAIN_FLAG_DATA);
+}
+
+static void furi_log_ring_get_string(
+    const uint8_t* payload,
+    size_t* offset,
+    char* str,
+    size_t max) {
+    uint8_t length = payload[*offset];
+    length = MIN(length, max - 1);
+    memcpy(str, &payload[*offset + 1], length);
+    str[length] = '\0';
+    *offset += 1 + payload[*offset];
+}
+
+static void furi_log_ring_format(FuriString* output, const FuriLogRingRecord* record) {
+    const uint8_t* payload = (const uint8_t*)record + sizeof(FuriLogRingRecord);
+    const uint8_t flags = record->level >> 4;
+    size_t offset = 0;
+
+    char tag[FURI_LOG_RING_STR_MAX + 1];
+    char format[FURI_LOG_RING_INLINE_MAX + 1];
+    const char* tag_ptr = record->tag;
+    const char* format_ptr = record->format;
+    if(flags & FuriLogRingFlagTagInline) {
+        furi_log_ring_get_string(payload, &offset, tag, sizeof(tag));
+        tag_ptr = tag;
+    }
+    if(flags & FuriLogRingFlagFormatInline) {
+        furi_log_ring_get_string(payload, &offset, format, sizeof(format));
+        format_ptr = format;
+    }
+
+    if(!(flags & FuriLogRingFlagRaw)) {
+        const char* color;
+        const char* log_letter = furi_log_level_letter(record->level & 0x0F, &color);
+        furi_string_cat_printf(
+            output,
+            "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET,
+            record->timestamp,
+            color,
+            log_letter,
+            tag_ptr);
+    }
+
+    char spec_str[FURI_LOG_RING_SPEC_MAX];
+    char str[FURI_LOG_RING_STR_MAX + 1];
+    FuriLogRingSpec spec;
+    const char* cursor = format_ptr;
+    while(*cursor) {
+        const char* spec_start = strchr(cursor, '%');
+        if(!spec_start) {
+            furi_string_cat_str(output, cursor);
             break;
-        default:
+        }
+        furi_string_cat_printf(output, "%.*s", (int)(spec_start - cursor), cursor);
+
+        cursor = furi_log_ring_spec_parse(spec_start + 1, &spec);
+        size_t spec_length = MIN((size_t)(cursor - spec_start), sizeof(spec_str) - 1);
+        memcpy(spec_str, spec_start, spec_length);
+        spec_str[spec_length] = '\0';
+
+        int stars[2] = {0};
+        for(uint8_t i = 0; i < spec.stars; i++) {
+            memcpy(&stars[i], &payload[offset], sizeof(int));
+            offset += sizeof(int);
+        }
+
+        /* Substitute argument through pointer sized carrier, stars go first */
+#define FURI_LOG_RING_CAT(value)                                                        \
+    do {                                                                                \
+        if(spec.stars == 0)                                                             \
+            furi_string_cat_printf(output, spec_str, value);                           \
+        else if(spec.stars == 1)                                                        \
+            furi_string_cat_printf(output, spec_str, stars[0], value);                 \
+        else                                                                            \
+            furi_string_cat_printf(output, spec_str, stars[0], stars[1], value);       \
+    } while(0)
+
+        if(spec.arg == FuriLogRingArgInt) {
+            int value;
+            memcpy(&value, &payload[offset], sizeof(value));
+            offset += sizeof(value);
+            FURI_LOG_RING_CAT(value);
+        } else if(spec.arg == FuriLogRingArgInt64) {
+            int64_t value;
+            memcpy(&value, &payload[offset], sizeof(value));
+            offset += sizeof(value);
+            FURI_LOG_RING_CAT(value);
+        } else if(spec.arg == FuriLogRingArgDouble) {
+            double value;
+            memcpy(&value, &payload[offset], sizeof(value));
+            offset += sizeof(value);
+            FURI_LOG_RING_CAT(value);
+        } else if(spec.arg == FuriLogRingArgPointer) {
+            void* value;
+            memcpy(&value, &payload[offset], sizeof(value));
+            offset += sizeof(value);
+            if(spec.print) FURI_LOG_RING_CAT(value);
+        } else if(spec.arg == FuriLogRingArgString) {
+            furi_log_ring_get_string(payload, &offset, str, sizeof(str));
+            FURI_LOG_RING_CAT(str);
+        } else if(spec_str[1] == '%') {
+            furi_string_push_back(output, '%');
+        }
+#undef FURI_LOG_RING_CAT
+    }
+
+    if(!(flags & FuriLogRingFlagRaw)) furi_string_cat_str(output, "\r\n");
+}
+
+/** Output committed records
+ *
+ * @return     true if drain stopped on record that is still being written
+ */
+static bool furi_log_ring_drain(FuriLogRing* ring, FuriString* output) {
+    uint32_t dropped = 0;
+    bool pending = false;
+
+    while(ring->tail != ring->head) {
+        FuriLogRingRecord* record =
+            (FuriLogRingRecord*)&ring->data[ring->tail & (ring->size - 1)];
+        if(record->state == FuriLogRingStateReserved) {
+            // Writer is still filling it in, preempted or interrupted
+            pending = true;
             break;
         }
 
+        if(record->state == FuriLogRingStateCommitted) {
+            furi_string_reset(output);
+            furi_log_ring_format(output, record);
+            furi_log_tx(
+                (const uint8_t*)furi_string_get_cstr(output), furi_string_size(output));
+        }
+
+        __DMB();
+        ring->tail += record->size;
+    }
+
+    FURI_CRITICAL_ENTER();
+    dropped = ring->dropped;
+    ring->dropped = 0;
+    FURI_CRITICAL_EXIT();
+
+    if(dropped) {
+        furi_string_printf(output, "%lu [log] %lu records dropped\r\n", furi_get_tick(), dropped);
+        furi_log_tx((const uint8_t*)furi_string_get_cstr(output), furi_string_size(output));
+    }
+
+    return pending;
+}
+
+static int32_t furi_log_ring_drain_thread(void* context) {
+    FuriLogRing* ring = context;
+    FuriString* output = furi_string_alloc();
+
+    bool pending = false;
+
+    while(true) {
+        // Poll only while some record is still being written
+        furi_thread_flags_wait(
+            FURI_LOG_RING_DRAIN_FLAG_DATA, FuriFlagWaitAny, pending ? 1 : FuriWaitForever);
+        pending = furi_log_ring_drain(ring, output);
+    }
+
+    furi_string_free(output);
+    return 0;
+}
+
+void furi_log_set_async(bool enable) {
+    furi_check(!FURI_IS_ISR());
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Ring and drain thread are kept once created: writers never block, so
+    // there is no safe point to release them. Disabled ring is drained as usual.
+    if(enable && !furi_log.ring) {
+        furi_log.ring = malloc(sizeof(FuriLogRing));
+        furi_log.ring->magic = FURI_LOG_RING_MAGIC;
+        furi_log.ring->size = FURI_LOG_RING_SIZE;
+
+        furi_log.drain_thread = furi_thread_alloc_ex(
+            "LogDrain", FURI_LOG_RING_DRAIN_STACK_SIZE, furi_log_ring_drain_thread, furi_log.ring);
+        furi_thread_set_priority(furi_log.drain_thread, FuriThreadPriorityLowest);
+        furi_thread_start(furi_log.drain_thread);
+    }
+    furi_log.async = enable;
+
+    furi_mutex_release(furi_log.mutex);
+}
+
+bool furi_log_get_async(void) {
+    return furi_log.async;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level <= furi_log.log_level && furi_log.async && furi_log_ring_can_store(format)) {
+        va_list args;
+        va_start(args, format);
+        furi_log_ring_write(level, 0, tag, format, args);
+        va_end(args);
+    } else if(
+        level <= furi_log.log_level &&
+        furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+        FuriString* string;
+        string = furi_string_alloc();
+
+        const char* color;
+        const char* log_letter = furi_log_level_letter(level, &color);
+
         // Timestamp
         furi_string_printf(
             string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
@@ -161,8 +671,14 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 }
 
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+    if(level <= furi_log.log_level && furi_log.async && furi_log_ring_can_store(format)) {
+        va_list args;
+        va_start(args, format);
+        furi_log_ring_write(level, FuriLogRingFlagRaw, NULL, format, args);
+        va_end(args);
+    } else if(
+        level <= furi_log.log_level &&
+        furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         FuriString* string;
         string = furi_string_alloc();
         va_list args;
@@ -109,6 +109,25 @@ void furi_log_set_level(FuriLogLevel level);
  */
 FuriLogLevel furi_log_get_level(void);
 
+/** Enable or disable asynchronous logging
+ *
+ * In asynchronous mode log records are stored in binary ring together with
+ * their arguments and formatted later by low priority thread. Logging
+ * becomes non-blocking and ISR safe, records that do not fit into ring are
+ * counted and reported as dropped. String arguments are truncated to 64
+ * characters. Records with format longer than 255 characters that is not in
+ * firmware flash are printed synchronously.
+ *
+ * @param[in]  enable  true to enable, false to return to synchronous output
+ */
+void furi_log_set_async(bool enable);
+
+/** Get asynchronous logging state
+ *
+ * @return     true if enabled
+ */
+bool furi_log_get_async(void);
+
 /** Log level to string
  *
  * @param[in]  level  The level
@@ -161,8 +161,9 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
     (void)xTaskResumeAll();
 }
 
-size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+static size_t memmgr_heap_get_thread_stats(FuriThreadId thread_id, size_t* allocations) {
     size_t leftovers = MEMMGR_HEAP_UNKNOWN;
+    *allocations = MEMMGR_HEAP_UNKNOWN;
     vTaskSuspendAll();
     {
         memmgr_heap_thread_trace_depth++;
@@ -170,6 +171,7 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
             MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
         if(alloc_dict) {
             leftovers = 0;
+            *allocations = 0;
             MemmgrHeapAllocDict_it_t alloc_dict_it;
             for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
                 !MemmgrHeapAllocDict_end_p(alloc_dict_it);
@@ -183,6 +185,7 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
                     if((pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
                        pxLink->pxNextFreeBlock == NULL) {
                         leftovers += data->value;
+                        (*allocations)++;
                     }
                 }
             }
@@ -193,6 +196,17 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     return leftovers;
 }
 
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    size_t allocations;
+    return memmgr_heap_get_thread_stats(thread_id, &allocations);
+}
+
+size_t memmgr_heap_get_thread_allocations(FuriThreadId thread_id) {
+    size_t allocations;
+    memmgr_heap_get_thread_stats(thread_id, &allocations);
+    return allocations;
+}
+
 #undef traceMALLOC
 static inline void traceMALLOC(void* pointer, size_t size) {
     FuriThreadId thread_id = furi_thread_get_current_id();
@@ -34,6 +34,14 @@ void memmgr_heap_disable_thread_trace(FuriThreadId taks_handle);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
 
+/** Memmgr heap get count of live thread allocations
+ *
+ * @param      thread_id  - thread id to track
+ *
+ * @return     number of blocks allocated right now
+ */
+size_t memmgr_heap_get_thread_allocations(FuriThreadId thread_id);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
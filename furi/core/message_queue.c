@@ -1,29 +1,51 @@
 #include "kernel.h"
 #include "message_queue.h"
+#include "event_loop_i.h"
 #include "check.h"
+#include "memmgr.h"
 
 #include <FreeRTOS.h>
 #include <queue.h>
 
+typedef struct {
+    QueueHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+} FuriMessageQueueContainer;
+
+static inline QueueHandle_t furi_message_queue_get_handle(FuriMessageQueue* instance) {
+    return instance ? ((FuriMessageQueueContainer*)instance)->handle : NULL;
+}
+
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
     furi_assert((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
 
-    QueueHandle_t handle = xQueueCreate(msg_count, msg_size);
-    furi_check(handle);
+    FuriMessageQueueContainer* container = malloc(sizeof(FuriMessageQueueContainer));
+    container->handle = xQueueCreate(msg_count, msg_size);
+    furi_check(container->handle);
 
-    return ((FuriMessageQueue*)handle);
+    return ((FuriMessageQueue*)container);
 }
 
 void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
 
-    vQueueDelete((QueueHandle_t)instance);
+    FuriMessageQueueContainer* container = instance;
+    // Unsubscribe from event loop before freeing
+    furi_check(container->event_loop_link.event_loop == NULL);
+
+    vQueueDelete(container->handle);
+    free(container);
+}
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    return &((FuriMessageQueueContainer*)instance)->event_loop_link;
 }
 
 FuriStatus
     furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -55,12 +77,16 @@ FuriStatus
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(furi_message_queue_get_event_loop_link(instance));
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -97,7 +123,7 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
 }
 
 uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t capacity;
 
     if(mq == NULL) {
@@ -112,7 +138,7 @@ uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t size;
 
     if(mq == NULL) {
@@ -127,7 +153,7 @@ uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     UBaseType_t count;
 
     if(hQueue == NULL) {
@@ -143,7 +169,7 @@ uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t space;
     uint32_t isrm;
 
@@ -165,7 +191,7 @@ uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
 }
 
 FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
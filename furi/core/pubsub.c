@@ -2,19 +2,50 @@
 #include "memmgr.h"
 #include "check.h"
 #include "mutex.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "message_queue.h"
+#include "semaphore.h"
+#include "thread.h"
 
-#include <m-list.h>
+#define FURI_PUBSUB_DEFERRED_STACK_SIZE (2048UL)
+#define FURI_PUBSUB_DEFERRED_FLAG_MESSAGE (1UL << 0)
+#define FURI_PUBSUB_DEFERRED_FLAG_EXIT (1UL << 1)
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    FuriPubSubSubscription* next;
+    /* Publishers currently holding pointer to this item */
+    uint32_t refs;
+    /* Unsubscribed, unlinked and freed once refs drop to 0 */
+    bool removed;
+    /* Released when last callback in other threads returns, owned by unsubscriber */
+    FuriSemaphore* unsubscribed;
 };
 
-LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
+/* Per publish call record, lives on publisher stack */
+typedef struct FuriPubSubDispatch FuriPubSubDispatch;
+
+struct FuriPubSubDispatch {
+    FuriThreadId thread_id;
+    const FuriPubSubSubscription* current;
+    FuriPubSubDispatch* next;
+};
+
+typedef struct {
+    FuriMessageQueue* queue;
+    void* buffer;
+    FuriThread* thread;
+    FuriThreadId thread_id;
+    volatile uint32_t dropped;
+} FuriPubSubDeferred;
 
 struct FuriPubSub {
-    FuriPubSubSubscriptionList_t items;
+    FuriPubSubSubscription* items;
+    FuriPubSubDispatch* dispatches;
     FuriMutex* mutex;
+    FuriPubSubDeferred* deferred;
 };
 
 FuriPubSub* furi_pubsub_alloc() {
@@ -23,7 +54,51 @@ FuriPubSub* furi_pubsub_alloc() {
     pubsub->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     furi_assert(pubsub->mutex);
 
-    FuriPubSubSubscriptionList_init(pubsub->items);
+    return pubsub;
+}
+
+static void furi_pubsub_dispatch(FuriPubSub* pubsub, const void* message);
+
+static int32_t furi_pubsub_deferred_thread(void* context) {
+    FuriPubSub* pubsub = context;
+    FuriPubSubDeferred* deferred = pubsub->deferred;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            FURI_PUBSUB_DEFERRED_FLAG_MESSAGE | FURI_PUBSUB_DEFERRED_FLAG_EXIT,
+            FuriFlagWaitAny,
+            FuriWaitForever);
+        furi_check(!(flags & FuriFlagError));
+
+        // Messages queued before exit request are still delivered
+        while(furi_message_queue_get(deferred->queue, deferred->buffer, 0) == FuriStatusOk) {
+            furi_pubsub_dispatch(pubsub, deferred->buffer);
+        }
+
+        if(flags & FURI_PUBSUB_DEFERRED_FLAG_EXIT) break;
+    }
+
+    return 0;
+}
+
+FuriPubSub* furi_pubsub_alloc_deferred(size_t message_size, uint32_t queue_size) {
+    furi_check(message_size);
+    furi_check(queue_size);
+
+    FuriPubSub* pubsub = furi_pubsub_alloc();
+
+    FuriPubSubDeferred* deferred = malloc(sizeof(FuriPubSubDeferred));
+    deferred->queue = furi_message_queue_alloc(queue_size, message_size);
+    deferred->buffer = malloc(message_size);
+    pubsub->deferred = deferred;
+
+    deferred->thread = furi_thread_alloc_ex(
+        "PubSubDispatch", FURI_PUBSUB_DEFERRED_STACK_SIZE, furi_pubsub_deferred_thread, pubsub);
+    // Below regular threads, so publisher is not preempted by delivery
+    furi_thread_set_priority(deferred->thread, FuriThreadPriorityLowest);
+    furi_thread_start(deferred->thread);
+    // Publish from ISR can't use thread accessors
+    deferred->thread_id = furi_thread_get_id(deferred->thread);
 
     return pubsub;
 }
@@ -31,9 +106,19 @@ FuriPubSub* furi_pubsub_alloc() {
 void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
-    furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
+    furi_check(pubsub->items == NULL);
+    furi_check(pubsub->dispatches == NULL);
+
+    if(pubsub->deferred) {
+        // Dispatcher delivers queued messages before exit
+        furi_thread_flags_set(pubsub->deferred->thread_id, FURI_PUBSUB_DEFERRED_FLAG_EXIT);
+        furi_thread_join(pubsub->deferred->thread);
+        furi_thread_free(pubsub->deferred->thread);
 
-    FuriPubSubSubscriptionList_clear(pubsub->items);
+        furi_message_queue_free(pubsub->deferred->queue);
+        free(pubsub->deferred->buffer);
+        free(pubsub->deferred);
+    }
 
     furi_mutex_free(pubsub->mutex);
 
@@ -42,54 +127,142 @@ void furi_pubsub_free(FuriPubSub* pubsub) {
 
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
-
-    // initialize item
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
     item->callback = callback;
     item->callback_context = callback_context;
 
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    // newest subscriber goes first, publish in progress will not see it
+    item->next = pubsub->items;
+    pubsub->items = item;
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
 
     return item;
 }
 
+/* Must be called with mutex held */
+static void furi_pubsub_item_unlink(FuriPubSub* pubsub, FuriPubSubSubscription* item) {
+    FuriPubSubSubscription** link = &pubsub->items;
+    while(*link != item) {
+        furi_check(*link);
+        link = &(*link)->next;
+    }
+    *link = item->next;
+    free(item);
+}
+
+/* Must be called with mutex held */
+static bool furi_pubsub_is_dispatching(
+    FuriPubSub* pubsub,
+    const FuriPubSubSubscription* item,
+    FuriThreadId thread_id) {
+    for(FuriPubSubDispatch* dispatch = pubsub->dispatches; dispatch; dispatch = dispatch->next) {
+        if(dispatch->current == item && dispatch->thread_id != thread_id) return true;
+    }
+    return false;
+}
+
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
     furi_assert(pubsub);
     furi_assert(pubsub_subscription);
 
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    bool result = false;
+    FuriThreadId thread_id = furi_thread_get_current_id();
 
-    // iterate over items
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
 
-        // if the iterator is equal to our element
-        if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
+    bool result = false;
+    for(FuriPubSubSubscription* item = pubsub->items; item; item = item->next) {
+        if(item == pubsub_subscription && !item->removed) {
             result = true;
             break;
         }
     }
+    furi_check(result);
+
+    pubsub_subscription->removed = true;
+    if(pubsub_subscription->refs == 0) {
+        furi_pubsub_item_unlink(pubsub, pubsub_subscription);
+    }
+
+    // Callback context may be freed right after return: wait for callbacks
+    // running in other threads. Callback unsubscribing itself is fine.
+    // Item is referenced while dispatching, so it is not freed before signal.
+    if(furi_pubsub_is_dispatching(pubsub, pubsub_subscription, thread_id)) {
+        FuriSemaphore* unsubscribed = furi_semaphore_alloc(1, 0);
+        pubsub_subscription->unsubscribed = unsubscribed;
+        do {
+            furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+            furi_check(furi_semaphore_acquire(unsubscribed, FuriWaitForever) == FuriStatusOk);
+            furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+        } while(furi_pubsub_is_dispatching(pubsub, pubsub_subscription, thread_id));
+        furi_semaphore_free(unsubscribed);
+    }
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
-    furi_check(result);
 }
 
-void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
+static void furi_pubsub_dispatch(FuriPubSub* pubsub, const void* message) {
+    FuriPubSubDispatch dispatch = {
+        .thread_id = furi_thread_get_current_id(),
+    };
+
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
 
-    // iterate over subscribers
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-        item->callback(message, item->callback_context);
+    dispatch.next = pubsub->dispatches;
+    pubsub->dispatches = &dispatch;
+
+    FuriPubSubSubscription* item = pubsub->items;
+    if(item) item->refs++;
+
+    while(item) {
+        if(!item->removed) {
+            // Lock is not held during callback: others can (un)subscribe and publish
+            dispatch.current = item;
+            furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+            item->callback(message, item->callback_context);
+            furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+            dispatch.current = NULL;
+            // Unsubscriber rechecks remaining callbacks itself
+            if(item->unsubscribed) furi_semaphore_release(item->unsubscribed);
+        }
+
+        FuriPubSubSubscription* next = item->next;
+        if(next) next->refs++;
+
+        item->refs--;
+        if(item->removed && item->refs == 0) {
+            furi_pubsub_item_unlink(pubsub, item);
+        }
+
+        item = next;
     }
 
+    FuriPubSubDispatch** link = &pubsub->dispatches;
+    while(*link != &dispatch) link = &(*link)->next;
+    *link = dispatch.next;
+
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
 }
+
+void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
+    FuriPubSubDeferred* deferred = pubsub->deferred;
+
+    if(!deferred) {
+        furi_pubsub_dispatch(pubsub, message);
+        return;
+    }
+
+    if(furi_message_queue_put(deferred->queue, message, 0) == FuriStatusOk) {
+        // Flags are accumulated: one wakeup drains all queued messages
+        furi_thread_flags_set(deferred->thread_id, FURI_PUBSUB_DEFERRED_FLAG_MESSAGE);
+    } else {
+        FURI_CRITICAL_ENTER();
+        deferred->dropped++;
+        FURI_CRITICAL_EXIT();
+    }
+}
+
+uint32_t furi_pubsub_get_dropped_count(FuriPubSub* pubsub) {
+    furi_assert(pubsub);
+    return pubsub->deferred ? pubsub->deferred->dropped : 0;
+}
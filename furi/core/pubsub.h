@@ -1,9 +1,16 @@
 /**
  * @file pubsub.h
  * FuriPubSub
+ *
+ * Subscriber callbacks are called without internal lock held, so callbacks
+ * may subscribe, unsubscribe (including themselves) and publish, and slow
+ * subscriber doesn't block other threads from (un)subscribing.
  */
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +32,24 @@ typedef struct FuriPubSubSubscription FuriPubSubSubscription;
  */
 FuriPubSub* furi_pubsub_alloc();
 
+/** Allocate FuriPubSub with deferred delivery
+ *
+ * Published message is copied to internal queue and publish returns
+ * immediately, callbacks are called later from dispatcher thread owned by
+ * this instance. Publish cost doesn't depend on subscribers and it can be
+ * called from ISR. Messages that don't fit in queue are dropped.
+ *
+ * Dispatcher thread runs with lowest priority and 2KiB stack: keep
+ * callbacks short, slow callback delays delivery of following messages.
+ * Messages still queued are delivered by furi_pubsub_free.
+ *
+ * @param      message_size  size of message in bytes
+ * @param      queue_size    maximum number of messages waiting for delivery
+ *
+ * @return     pointer to FuriPubSub instance
+ */
+FuriPubSub* furi_pubsub_alloc_deferred(size_t message_size, uint32_t queue_size);
+
 /** Free FuriPubSub
  * 
  * @param      pubsub  FuriPubSub instance
@@ -48,6 +73,8 @@ FuriPubSubSubscription*
  * 
  * No use of `pubsub_subscription` allowed after call of this method
  * Threadsafe, Reentrable.
+ * Waits for subscription callback running in other threads to complete,
+ * callback will not be called after return.
  *
  * @param      pubsub               pointer to FuriPubSub instance
  * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
@@ -57,12 +84,23 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 /** Publish message to FuriPubSub
  *
  * Threadsafe, Reentrable.
+ * Subscribers are called in the publisher thread, subscription made during
+ * publish is not called for this message. For deferred FuriPubSub message is
+ * copied and delivered later, ISR safe.
  * 
  * @param      pubsub   pointer to FuriPubSub instance
  * @param      message  message pointer to publish
  */
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message);
 
+/** Get count of messages dropped by deferred FuriPubSub due to full queue
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ *
+ * @return     dropped messages count, always 0 for regular FuriPubSub
+ */
+uint32_t furi_pubsub_get_dropped_count(FuriPubSub* pubsub);
+
 #ifdef __cplusplus
 }
 #endif
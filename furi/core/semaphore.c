@@ -1,10 +1,21 @@
 #include "semaphore.h"
+#include "event_loop_i.h"
 #include "check.h"
 #include "common_defines.h"
+#include "memmgr.h"
 
 #include <FreeRTOS.h>
 #include <semphr.h>
 
+typedef struct {
+    SemaphoreHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+} FuriSemaphoreContainer;
+
+static inline SemaphoreHandle_t furi_semaphore_get_handle(FuriSemaphore* instance) {
+    return ((FuriSemaphoreContainer*)instance)->handle;
+}
+
 FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
     furi_assert(!FURI_IS_IRQ_MODE());
     furi_assert((max_count > 0U) && (initial_count <= max_count));
@@ -24,23 +35,34 @@ FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count)
 
     furi_check(hSemaphore);
 
+    FuriSemaphoreContainer* container = malloc(sizeof(FuriSemaphoreContainer));
+    container->handle = hSemaphore;
+
     /* Return semaphore ID */
-    return ((FuriSemaphore*)hSemaphore);
+    return ((FuriSemaphore*)container);
 }
 
 void furi_semaphore_free(FuriSemaphore* instance) {
     furi_assert(instance);
     furi_assert(!FURI_IS_IRQ_MODE());
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    FuriSemaphoreContainer* container = instance;
+    // Unsubscribe from event loop before freeing
+    furi_check(container->event_loop_link.event_loop == NULL);
 
-    vSemaphoreDelete(hSemaphore);
+    vSemaphoreDelete(container->handle);
+    free(container);
+}
+
+FuriEventLoopLink* furi_semaphore_get_event_loop_link(FuriSemaphore* instance) {
+    furi_assert(instance);
+    return &((FuriSemaphoreContainer*)instance)->event_loop_link;
 }
 
 FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = furi_semaphore_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -75,7 +97,7 @@ FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
 FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = furi_semaphore_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -95,6 +117,10 @@ FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(furi_semaphore_get_event_loop_link(instance));
+    }
+
     /* Return execution status */
     return (stat);
 }
@@ -102,7 +128,7 @@ FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
 uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = furi_semaphore_get_handle(instance);
     uint32_t count;
 
     if(FURI_IS_IRQ_MODE()) {
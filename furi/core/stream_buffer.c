@@ -1,28 +1,52 @@
 #include "base.h"
 #include "check.h"
 #include "stream_buffer.h"
+#include "event_loop_i.h"
 #include "common_defines.h"
+#include "memmgr.h"
 
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/stream_buffer.h>
 
+typedef struct {
+    StreamBufferHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+} FuriStreamBufferContainer;
+
+static inline StreamBufferHandle_t furi_stream_buffer_get_handle(FuriStreamBuffer* stream_buffer) {
+    return ((FuriStreamBufferContainer*)stream_buffer)->handle;
+}
+
 FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
     furi_assert(size != 0);
 
-    StreamBufferHandle_t handle = xStreamBufferCreate(size, trigger_level);
-    furi_check(handle);
+    FuriStreamBufferContainer* container = malloc(sizeof(FuriStreamBufferContainer));
+    container->handle = xStreamBufferCreate(size, trigger_level);
+    furi_check(container->handle);
 
-    return handle;
+    return container;
 };
 
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
     furi_assert(stream_buffer);
-    vStreamBufferDelete(stream_buffer);
+
+    FuriStreamBufferContainer* container = stream_buffer;
+    // Unsubscribe from event loop before freeing
+    furi_check(container->event_loop_link.event_loop == NULL);
+
+    vStreamBufferDelete(container->handle);
+    free(container);
 };
 
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    return &((FuriStreamBufferContainer*)stream_buffer)->event_loop_link;
+}
+
 bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
     furi_assert(stream_buffer);
-    return xStreamBufferSetTriggerLevel(stream_buffer, trigger_level) == pdTRUE;
+    return xStreamBufferSetTriggerLevel(
+               furi_stream_buffer_get_handle(stream_buffer), trigger_level) == pdTRUE;
 };
 
 size_t furi_stream_buffer_send(
@@ -30,14 +54,19 @@ size_t furi_stream_buffer_send(
     const void* data,
     size_t length,
     uint32_t timeout) {
+    StreamBufferHandle_t handle = furi_stream_buffer_get_handle(stream_buffer);
     size_t ret;
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferSendFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferSendFromISR(handle, data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferSend(stream_buffer, data, length, timeout);
+        ret = xStreamBufferSend(handle, data, length, timeout);
+    }
+
+    if(ret) {
+        furi_event_loop_link_notify(furi_stream_buffer_get_event_loop_link(stream_buffer));
     }
 
     return ret;
@@ -48,37 +77,38 @@ size_t furi_stream_buffer_receive(
     void* data,
     size_t length,
     uint32_t timeout) {
+    StreamBufferHandle_t handle = furi_stream_buffer_get_handle(stream_buffer);
     size_t ret;
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferReceiveFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferReceiveFromISR(handle, data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferReceive(stream_buffer, data, length, timeout);
+        ret = xStreamBufferReceive(handle, data, length, timeout);
     }
 
     return ret;
 }
 
 size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferBytesAvailable(stream_buffer);
+    return xStreamBufferBytesAvailable(furi_stream_buffer_get_handle(stream_buffer));
 };
 
 size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferSpacesAvailable(stream_buffer);
+    return xStreamBufferSpacesAvailable(furi_stream_buffer_get_handle(stream_buffer));
 };
 
 bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferIsFull(stream_buffer) == pdTRUE;
+    return xStreamBufferIsFull(furi_stream_buffer_get_handle(stream_buffer)) == pdTRUE;
 };
 
 bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
-    return (xStreamBufferIsEmpty(stream_buffer) == pdTRUE);
+    return (xStreamBufferIsEmpty(furi_stream_buffer_get_handle(stream_buffer)) == pdTRUE);
 };
 
 FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
-    if(xStreamBufferReset(stream_buffer) == pdPASS) {
+    if(xStreamBufferReset(furi_stream_buffer_get_handle(stream_buffer)) == pdPASS) {
         return FuriStatusOk;
     } else {
         return FuriStatusError;
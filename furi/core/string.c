@@ -1,8 +1,19 @@
 #include "string.h"
+#include "check.h"
+#include "common_defines.h"
+
 #include <m-string.h>
+#include <ctype.h>
+
+/* Strings shorter than this are stored inside of FuriString allocation */
+#define FURI_STRING_INLINE_SIZE (24U)
 
 struct FuriString {
-    string_t string;
+    char* data; /**< Points either to buffer or to separate heap block */
+    size_t size; /**< String length, without null terminator */
+    size_t capacity; /**< Bytes available in data, including null terminator */
+    size_t buffer_size; /**< Bytes available in buffer */
+    char buffer[];
 };
 
 #undef furi_string_alloc_set
@@ -22,23 +33,92 @@ struct FuriString {
 #undef furi_string_trim
 #undef furi_string_cat
 
+static inline bool furi_string_on_heap(const FuriString* s) {
+    return s->data != s->buffer;
+}
+
+static inline bool furi_string_is_own_data(const FuriString* s, const char* p) {
+    return p >= s->data && p < s->data + s->capacity;
+}
+
+/* Allocate string with buffer large enough for length characters */
+static FuriString* furi_string_alloc_sized(size_t length) {
+    size_t buffer_size = MAX(FURI_STRING_INLINE_SIZE, length + 1);
+    buffer_size = (buffer_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+
+    FuriString* s = malloc(sizeof(FuriString) + buffer_size);
+    s->data = s->buffer;
+    s->size = 0;
+    s->capacity = buffer_size;
+    s->buffer_size = buffer_size;
+    s->buffer[0] = '\0';
+
+    return s;
+}
+
+/* Make room for length characters, content is preserved */
+static void furi_string_grow(FuriString* s, size_t length) {
+    if(length < s->capacity) return;
+
+    size_t capacity = MAX(length + 1, s->capacity + s->capacity / 2);
+    char* data = malloc(capacity);
+    memcpy(data, s->data, s->size + 1);
+    if(furi_string_on_heap(s)) free(s->data);
+
+    s->data = data;
+    s->capacity = capacity;
+}
+
+static void furi_string_set_size(FuriString* s, size_t size) {
+    s->size = size;
+    s->data[size] = '\0';
+}
+
+static void furi_string_set_bytes(FuriString* s, const char* str, size_t length) {
+    if(furi_string_is_own_data(s, str)) {
+        // Part of itself, fits for sure
+        memmove(s->data, str, length);
+    } else {
+        if(length >= s->capacity) {
+            // Old content is not needed, skip copying it
+            furi_string_set_size(s, 0);
+            furi_string_grow(s, length);
+        }
+        memcpy(s->data, str, length);
+    }
+    furi_string_set_size(s, length);
+}
+
+static void furi_string_cat_bytes(FuriString* s, const char* str, size_t length) {
+    if(furi_string_is_own_data(s, str)) {
+        size_t offset = str - s->data;
+        furi_string_grow(s, s->size + length);
+        str = s->data + offset;
+    } else {
+        furi_string_grow(s, s->size + length);
+    }
+    memmove(s->data + s->size, str, length);
+    furi_string_set_size(s, s->size + length);
+}
+
 FuriString* furi_string_alloc() {
-    FuriString* string = malloc(sizeof(FuriString));
-    string_init(string->string);
-    return string;
+    return furi_string_alloc_sized(0);
 }
 
 FuriString* furi_string_alloc_set(const FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
-    string_init_set(string->string, s->string);
+    FuriString* string = furi_string_alloc_sized(s->size);
+    memcpy(string->data, s->data, s->size);
+    furi_string_set_size(string, s->size);
     return string;
-} //-V773
+}
 
 FuriString* furi_string_alloc_set_str(const char cstr[]) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
-    string_init_set(string->string, cstr);
+    size_t length = strlen(cstr);
+    FuriString* string = furi_string_alloc_sized(length);
+    memcpy(string->data, cstr, length);
+    furi_string_set_size(string, length);
     return string;
-} //-V773
+}
 
 FuriString* furi_string_alloc_printf(const char format[], ...) {
     va_list args;
@@ -49,108 +129,184 @@ FuriString* furi_string_alloc_printf(const char format[], ...) {
 }
 
 FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
-    FuriString* string = malloc(sizeof(FuriString));
-    string_init_vprintf(string->string, format, args);
+    // Format on stack first to allocate string of the right size at once
+    char stack_buffer[64];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int length = vsnprintf(stack_buffer, sizeof(stack_buffer), format, args_copy);
+    va_end(args_copy);
+
+    if(length < 0) return furi_string_alloc();
+
+    FuriString* string = furi_string_alloc_sized(length);
+    if((size_t)length < sizeof(stack_buffer)) {
+        memcpy(string->data, stack_buffer, length);
+    } else {
+        vsnprintf(string->data, string->capacity, format, args);
+    }
+    furi_string_set_size(string, length);
+
     return string;
 }
 
 FuriString* furi_string_alloc_move(FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString));
-    string_init_move(string->string, s->string);
-    free(s);
-    return string;
+    // Nothing to move: source is consumed and content is already in place
+    return s;
 }
 
 void furi_string_free(FuriString* s) {
-    string_clear(s->string);
+    if(furi_string_on_heap(s)) free(s->data);
     free(s);
 }
 
 void furi_string_reserve(FuriString* s, size_t alloc) {
-    string_reserve(s->string, alloc);
+    alloc = MAX(alloc, s->size + 1);
+
+    if(alloc <= s->buffer_size) {
+        if(furi_string_on_heap(s)) {
+            memcpy(s->buffer, s->data, s->size + 1);
+            free(s->data);
+            s->data = s->buffer;
+            s->capacity = s->buffer_size;
+        }
+    } else if(alloc != s->capacity) {
+        char* data = malloc(alloc);
+        memcpy(data, s->data, s->size + 1);
+        if(furi_string_on_heap(s)) free(s->data);
+        s->data = data;
+        s->capacity = alloc;
+    }
 }
 
 void furi_string_reset(FuriString* s) {
-    string_clear(s->string);
-    string_init(s->string);
+    if(furi_string_on_heap(s)) {
+        free(s->data);
+        s->data = s->buffer;
+        s->capacity = s->buffer_size;
+    }
+    furi_string_set_size(s, 0);
 }
 
 void furi_string_swap(FuriString* v1, FuriString* v2) {
-    string_swap(v1->string, v2->string);
+    if(v1 == v2) return;
+
+    if(furi_string_on_heap(v1) && furi_string_on_heap(v2)) {
+        char* data = v1->data;
+        v1->data = v2->data;
+        v2->data = data;
+        size_t capacity = v1->capacity;
+        v1->capacity = v2->capacity;
+        v2->capacity = capacity;
+    } else {
+        // Inline buffers can't be exchanged, exchange content instead
+        size_t size = MAX(v1->size, v2->size);
+        furi_string_grow(v1, size);
+        furi_string_grow(v2, size);
+        for(size_t i = 0; i <= size; i++) {
+            char c = v1->data[i];
+            v1->data[i] = v2->data[i];
+            v2->data[i] = c;
+        }
+    }
+
+    size_t size = v1->size;
+    v1->size = v2->size;
+    v2->size = size;
 }
 
 void furi_string_move(FuriString* v1, FuriString* v2) {
-    string_clear(v1->string);
-    string_init_move(v1->string, v2->string);
+    furi_assert(v1 != v2);
+
+    if(furi_string_on_heap(v2)) {
+        if(furi_string_on_heap(v1)) free(v1->data);
+        v1->data = v2->data;
+        v1->size = v2->size;
+        v1->capacity = v2->capacity;
+    } else {
+        furi_string_set_bytes(v1, v2->data, v2->size);
+    }
     free(v2);
 }
 
 size_t furi_string_hash(const FuriString* v) {
-    return string_hash(v->string);
+    return m_core_hash(v->data, v->size);
 }
 
 char furi_string_get_char(const FuriString* v, size_t index) {
-    return string_get_char(v->string, index);
+    furi_assert(index < v->size);
+    return v->data[index];
 }
 
 const char* furi_string_get_cstr(const FuriString* s) {
-    return string_get_cstr(s->string);
+    return s->data;
 }
 
 void furi_string_set(FuriString* s, FuriString* source) {
-    string_set(s->string, source->string);
+    furi_string_set_bytes(s, source->data, source->size);
 }
 
 void furi_string_set_str(FuriString* s, const char cstr[]) {
-    string_set(s->string, cstr);
+    furi_string_set_bytes(s, cstr, strlen(cstr));
 }
 
 void furi_string_set_strn(FuriString* s, const char str[], size_t n) {
-    string_set_strn(s->string, str, n);
+    const char* end = memchr(str, '\0', n);
+    furi_string_set_bytes(s, str, end ? (size_t)(end - str) : n);
 }
 
 void furi_string_set_char(FuriString* s, size_t index, const char c) {
-    string_set_char(s->string, index, c);
+    furi_assert(index < s->size);
+    s->data[index] = c;
 }
 
 int furi_string_cmp(const FuriString* s1, const FuriString* s2) {
-    return string_cmp(s1->string, s2->string);
+    return strcmp(s1->data, s2->data);
 }
 
 int furi_string_cmp_str(const FuriString* s1, const char str[]) {
-    return string_cmp(s1->string, str);
-}
-
-int furi_string_cmpi(const FuriString* v1, const FuriString* v2) {
-    return string_cmpi(v1->string, v2->string);
+    return strcmp(s1->data, str);
 }
 
 int furi_string_cmpi_str(const FuriString* v1, const char p2[]) {
-    return string_cmpi_str(v1->string, p2);
+    const char* p1 = v1->data;
+    int c1, c2;
+    do {
+        c1 = toupper((unsigned char)*p1++);
+        c2 = toupper((unsigned char)*p2++);
+    } while(c1 == c2 && c1 != '\0');
+    return c1 - c2;
 }
 
-size_t furi_string_search(const FuriString* v, const FuriString* needle, size_t start) {
-    return string_search(v->string, needle->string, start);
+int furi_string_cmpi(const FuriString* v1, const FuriString* v2) {
+    return furi_string_cmpi_str(v1, v2->data);
 }
 
 size_t furi_string_search_str(const FuriString* v, const char needle[], size_t start) {
-    return string_search(v->string, needle, start);
+    furi_assert(start <= v->size);
+    const char* p = strstr(v->data + start, needle);
+    return p ? (size_t)(p - v->data) : FURI_STRING_FAILURE;
+}
+
+size_t furi_string_search(const FuriString* v, const FuriString* needle, size_t start) {
+    return furi_string_search_str(v, needle->data, start);
 }
 
 bool furi_string_equal(const FuriString* v1, const FuriString* v2) {
-    return string_equal_p(v1->string, v2->string);
+    return v1->size == v2->size && memcmp(v1->data, v2->data, v1->size) == 0;
 }
 
 bool furi_string_equal_str(const FuriString* v1, const char v2[]) {
-    return string_equal_p(v1->string, v2);
+    return strcmp(v1->data, v2) == 0;
 }
 
 void furi_string_push_back(FuriString* v, char c) {
-    string_push_back(v->string, c);
+    furi_string_grow(v, v->size + 1);
+    v->data[v->size] = c;
+    furi_string_set_size(v, v->size + 1);
 }
 
 size_t furi_string_size(const FuriString* s) {
-    return string_size(s->string);
+    return s->size;
 }
 
 int furi_string_printf(FuriString* v, const char format[], ...) {
@@ -162,7 +318,8 @@ int furi_string_printf(FuriString* v, const char format[], ...) {
 }
 
 int furi_string_vprintf(FuriString* v, const char format[], va_list args) {
-    return string_vprintf(v->string, format, args);
+    furi_string_set_size(v, 0);
+    return furi_string_cat_vprintf(v, format, args);
 }
 
 int furi_string_cat_printf(FuriString* v, const char format[], ...) {
@@ -174,96 +331,189 @@ int furi_string_cat_printf(FuriString* v, const char format[], ...) {
 }
 
 int furi_string_cat_vprintf(FuriString* v, const char format[], va_list args) {
-    FuriString* string = furi_string_alloc();
-    int ret = furi_string_vprintf(string, format, args);
-    furi_string_cat(v, string);
-    furi_string_free(string);
-    return ret;
+    va_list args_copy;
+    va_copy(args_copy, args);
+    size_t available = v->capacity - v->size;
+    int length = vsnprintf(v->data + v->size, available, format, args_copy);
+    va_end(args_copy);
+
+    if(length < 0) {
+        furi_string_set_size(v, v->size);
+        return length;
+    }
+
+    if((size_t)length >= available) {
+        furi_string_grow(v, v->size + length);
+        vsnprintf(v->data + v->size, v->capacity - v->size, format, args);
+    }
+    furi_string_set_size(v, v->size + length);
+
+    return length;
 }
 
 bool furi_string_empty(const FuriString* v) {
-    return string_empty_p(v->string);
+    return v->size == 0;
 }
 
 void furi_string_replace_at(FuriString* v, size_t pos, size_t len, const char str2[]) {
-    string_replace_at(v->string, pos, len, str2);
+    furi_assert(pos <= v->size);
+    furi_assert(len <= v->size - pos);
+
+    char* copy = NULL;
+    if(furi_string_is_own_data(v, str2)) {
+        // Content is going to move, keep replacement safe
+        copy = strdup(str2);
+        str2 = copy;
+    }
+
+    size_t str2_len = strlen(str2);
+    size_t size = v->size - len + str2_len;
+    furi_string_grow(v, size);
+    memmove(v->data + pos + str2_len, v->data + pos + len, v->size - pos - len + 1);
+    memcpy(v->data + pos, str2, str2_len);
+    v->size = size;
+
+    free(copy);
 }
 
 size_t
     furi_string_replace(FuriString* string, FuriString* needle, FuriString* replace, size_t start) {
-    return string_replace(string->string, needle->string, replace->string, start);
+    return furi_string_replace_str(string, needle->data, replace->data, start);
 }
 
 size_t furi_string_replace_str(FuriString* v, const char str1[], const char str2[], size_t start) {
-    return string_replace_str(v->string, str1, str2, start);
+    size_t pos = furi_string_search_str(v, str1, start);
+    if(pos != FURI_STRING_FAILURE) {
+        furi_string_replace_at(v, pos, strlen(str1), str2);
+    }
+    return pos;
 }
 
 void furi_string_replace_all_str(FuriString* v, const char str1[], const char str2[]) {
-    string_replace_all_str(v->string, str1, str2);
+    size_t str1_len = strlen(str1);
+    size_t str2_len = strlen(str2);
+    furi_assert(str1_len > 0);
+
+    size_t pos = 0;
+    while((pos = furi_string_search_str(v, str1, pos)) != FURI_STRING_FAILURE) {
+        furi_string_replace_at(v, pos, str1_len, str2);
+        pos += str2_len;
+    }
 }
 
 void furi_string_replace_all(FuriString* v, const FuriString* str1, const FuriString* str2) {
-    string_replace_all(v->string, str1->string, str2->string);
+    furi_string_replace_all_str(v, str1->data, str2->data);
 }
 
 bool furi_string_start_with(const FuriString* v, const FuriString* v2) {
-    return string_start_with_string_p(v->string, v2->string);
+    return v->size >= v2->size && memcmp(v->data, v2->data, v2->size) == 0;
 }
 
 bool furi_string_start_with_str(const FuriString* v, const char str[]) {
-    return string_start_with_str_p(v->string, str);
+    size_t length = strlen(str);
+    return v->size >= length && memcmp(v->data, str, length) == 0;
 }
 
 bool furi_string_end_with(const FuriString* v, const FuriString* v2) {
-    return string_end_with_string_p(v->string, v2->string);
+    return v->size >= v2->size &&
+           memcmp(v->data + v->size - v2->size, v2->data, v2->size) == 0;
 }
 
 bool furi_string_end_with_str(const FuriString* v, const char str[]) {
-    return string_end_with_str_p(v->string, str);
+    size_t length = strlen(str);
+    return v->size >= length && memcmp(v->data + v->size - length, str, length) == 0;
 }
 
 size_t furi_string_search_char(const FuriString* v, char c, size_t start) {
-    return string_search_char(v->string, c, start);
+    furi_assert(start <= v->size);
+    const char* p = strchr(v->data + start, c);
+    return p ? (size_t)(p - v->data) : FURI_STRING_FAILURE;
 }
 
 size_t furi_string_search_rchar(const FuriString* v, char c, size_t start) {
-    return string_search_rchar(v->string, c, start);
+    furi_assert(start <= v->size);
+    const char* p = strrchr(v->data + start, c);
+    return p ? (size_t)(p - v->data) : FURI_STRING_FAILURE;
 }
 
 void furi_string_left(FuriString* v, size_t index) {
-    string_left(v->string, index);
+    if(index < v->size) furi_string_set_size(v, index);
 }
 
 void furi_string_right(FuriString* v, size_t index) {
-    string_right(v->string, index);
+    if(index >= v->size) {
+        furi_string_set_size(v, 0);
+    } else {
+        memmove(v->data, v->data + index, v->size - index + 1);
+        v->size -= index;
+    }
 }
 
 void furi_string_mid(FuriString* v, size_t index, size_t size) {
-    string_mid(v->string, index, size);
+    furi_string_right(v, index);
+    furi_string_left(v, size);
 }
 
 void furi_string_trim(FuriString* v, const char charac[]) {
-    string_strim(v->string, charac);
+    size_t begin = 0;
+    size_t end = v->size;
+    while(begin < end && strchr(charac, v->data[begin]) != NULL) begin++;
+    while(end > begin && strchr(charac, v->data[end - 1]) != NULL) end--;
+
+    memmove(v->data, v->data + begin, end - begin);
+    furi_string_set_size(v, end - begin);
 }
 
 void furi_string_cat(FuriString* v, const FuriString* v2) {
-    string_cat(v->string, v2->string);
+    furi_string_cat_bytes(v, v2->data, v2->size);
 }
 
 void furi_string_cat_str(FuriString* v, const char str[]) {
-    string_cat(v->string, str);
+    furi_string_cat_bytes(v, str, strlen(str));
 }
 
 void furi_string_set_n(FuriString* v, const FuriString* ref, size_t offset, size_t length) {
-    string_set_n(v->string, ref->string, offset, length);
+    furi_assert(offset <= ref->size);
+    furi_string_set_bytes(v, ref->data + offset, MIN(ref->size - offset, length));
 }
 
 size_t furi_string_utf8_length(FuriString* str) {
-    return string_length_u(str->string);
+    size_t length = 0;
+    m_str1ng_utf8_state_e state = M_STRING_UTF8_STARTING;
+    string_unicode_t unicode = 0;
+    for(size_t i = 0; i < str->size; i++) {
+        m_str1ng_utf8_decode(str->data[i], &state, &unicode);
+        if(state == M_STRING_UTF8_ERROR) return FURI_STRING_FAILURE;
+        if(state == M_STRING_UTF8_STARTING) length++;
+    }
+    return length;
 }
 
 void furi_string_utf8_push(FuriString* str, FuriStringUnicodeValue u) {
-    string_push_u(str->string, u);
+    char buffer[4];
+    size_t length;
+
+    if(u < 0x80) {
+        buffer[0] = u;
+        length = 1;
+    } else if(u < 0x800) {
+        buffer[0] = 0xC0 | (u >> 6);
+        buffer[1] = 0x80 | (u & 0x3F);
+        length = 2;
+    } else if(u < 0x10000) {
+        buffer[0] = 0xE0 | (u >> 12);
+        buffer[1] = 0x80 | ((u >> 6) & 0x3F);
+        buffer[2] = 0x80 | (u & 0x3F);
+        length = 3;
+    } else {
+        buffer[0] = 0xF0 | (u >> 18);
+        buffer[1] = 0x80 | ((u >> 12) & 0x3F);
+        buffer[2] = 0x80 | ((u >> 6) & 0x3F);
+        buffer[3] = 0x80 | (u & 0x3F);
+        length = 4;
+    }
+
+    furi_string_cat_bytes(str, buffer, length);
 }
 
 static m_str1ng_utf8_state_e furi_state_to_state(FuriStringUTF8State state) {
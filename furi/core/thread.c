@@ -8,6 +8,7 @@
 #include "common_defines.h"
 #include "mutex.h"
 #include "string.h"
+#include "event_loop_i.h"
 
 #include <timers.h>
 #include "log.h"
@@ -350,6 +351,11 @@ uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
             (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
             (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
         }
+        // Wake event loop of the thread, if any
+        FuriThread* thread = pvTaskGetThreadLocalStoragePointer(hTask, 0);
+        if(thread && thread->event_loop) {
+            furi_event_loop_thread_flags_notify(thread_id);
+        }
     }
     /* Return flags after setting */
     return (rflags);
@@ -2,6 +2,7 @@
 
 #include "thread.h"
 #include "string.h"
+#include "event_loop.h"
 
 #include <FreeRTOS.h>
 #include <task.h>
@@ -31,6 +32,8 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    FuriEventLoop* event_loop;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
@@ -3,6 +3,10 @@
 #include <string.h>
 #include <furi_hal_cortex.h>
 
+#define CC1101_STATE_TIMEOUT_US 10000
+#define CC1101_MCSM0_FS_AUTOCAL (0b11 << 4)
+#define CC1101_RSSI_SETTLE_MARGIN 2
+
 static bool cc1101_spi_trx(FuriHalSpiBusHandle* handle, uint8_t* tx, uint8_t* rx, uint8_t size) {
     FuriHalCortexTimer timer = furi_hal_cortex_timer_get(CC1101_TIMEOUT * 1000);
 
@@ -185,4 +189,123 @@ uint8_t cc1101_read_fifo(FuriHalSpiBusHandle* handle, uint8_t* data, uint8_t* si
     furi_hal_spi_bus_trx(handle, NULL, data, *size, CC1101_TIMEOUT);
 
     return *size;
-}
\ No newline at end of file
+}
+
+static void cc1101_write_burst(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size) {
+    uint8_t tx[4] = {reg | CC1101_BURST};
+    CC1101Status rx[4] = {0};
+    rx[0].CHIP_RDYn = 1;
+
+    assert(size < sizeof(tx));
+    memcpy(&tx[1], data, size);
+
+    cc1101_spi_trx(handle, tx, (uint8_t*)rx, size + 1);
+
+    assert(rx[0].CHIP_RDYn == 0);
+}
+
+static void
+    cc1101_read_burst(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t* data, uint8_t size) {
+    uint8_t tx[4] = {reg | CC1101_READ | CC1101_BURST};
+    uint8_t rx[4] = {0};
+
+    assert(size < sizeof(tx));
+
+    cc1101_spi_trx(handle, tx, rx, size + 1);
+
+    memcpy(data, &rx[1], size);
+}
+
+bool cc1101_calibrate_channel(
+    FuriHalSpiBusHandle* handle,
+    uint32_t value,
+    CC1101Channel* channel) {
+    cc1101_switch_to_idle(handle);
+    if(!cc1101_wait_status_state(handle, CC1101StateIDLE, CC1101_STATE_TIMEOUT_US)) return false;
+
+    channel->frequency = cc1101_set_frequency(handle, value);
+    cc1101_calibrate(handle);
+    if(!cc1101_wait_status_state(handle, CC1101StateIDLE, CC1101_STATE_TIMEOUT_US)) return false;
+
+    cc1101_read_burst(handle, CC1101_FREQ2, channel->freq, sizeof(channel->freq));
+    cc1101_read_burst(handle, CC1101_FSCAL3, channel->fscal, sizeof(channel->fscal));
+
+    return true;
+}
+
+void cc1101_set_channel(FuriHalSpiBusHandle* handle, const CC1101Channel* channel) {
+    cc1101_write_burst(handle, CC1101_FREQ2, channel->freq, sizeof(channel->freq));
+    cc1101_write_burst(handle, CC1101_FSCAL3, channel->fscal, sizeof(channel->fscal));
+}
+
+uint32_t cc1101_get_rssi_settle_time(FuriHalSpiBusHandle* handle) {
+    uint8_t mdmcfg4 = 0;
+    uint8_t agcctrl0 = 0;
+    cc1101_read_reg(handle, CC1101_MDMCFG4, &mdmcfg4);
+    cc1101_read_reg(handle, CC1101_AGCCTRL0, &agcctrl0);
+
+    // Channel filter bandwidth is F_XOSC / (8 * (4 + CHANBW_M) * 2^CHANBW_E), RSSI is
+    // estimated once per filter output sample
+    uint32_t sample_cycles = (8 * (4 + ((mdmcfg4 >> 4) & 0b11))) << (mdmcfg4 >> 6);
+    // AGC waits WAIT_TIME samples after a gain change, then averages FILTER_LENGTH samples.
+    // In ASK/OOK mode FILTER_LENGTH selects the decision boundary, counting it anyway keeps
+    // the estimate on the safe side.
+    uint32_t samples = 8 * (1 + ((agcctrl0 >> 4) & 0b11)) + (8 << (agcctrl0 & 0b11));
+
+    uint64_t cycles = (uint64_t)sample_cycles * samples * CC1101_RSSI_SETTLE_MARGIN;
+    return (cycles * 1000000 + CC1101_QUARTZ - 1) / CC1101_QUARTZ;
+}
+
+bool cc1101_sweep(
+    FuriHalSpiBusHandle* handle,
+    const CC1101Channel* channels,
+    size_t count,
+    uint8_t* rssi) {
+    cc1101_switch_to_idle(handle);
+    if(!cc1101_wait_status_state(handle, CC1101StateIDLE, CC1101_STATE_TIMEOUT_US)) return false;
+
+    uint8_t mcsm0 = 0;
+    cc1101_read_reg(handle, CC1101_MCSM0, &mcsm0);
+    cc1101_write_reg(handle, CC1101_MCSM0, mcsm0 & ~CC1101_MCSM0_FS_AUTOCAL);
+
+    uint32_t settle_time = cc1101_get_rssi_settle_time(handle);
+
+    bool result = true;
+    for(size_t i = 0; i < count; i++) {
+        if(i) {
+            cc1101_switch_to_idle(handle);
+            result = cc1101_wait_status_state(handle, CC1101StateIDLE, CC1101_STATE_TIMEOUT_US);
+            if(!result) break;
+        }
+
+        cc1101_set_channel(handle, &channels[i]);
+        cc1101_switch_to_rx(handle);
+        // RX is reported once PLL is locked, demodulator starts from there
+        result = cc1101_wait_status_state(handle, CC1101StateRX, CC1101_STATE_TIMEOUT_US);
+        if(!result) break;
+
+        furi_hal_cortex_delay_us(settle_time);
+        rssi[i] = cc1101_get_rssi(handle);
+    }
+
+    cc1101_switch_to_idle(handle);
+    if(!cc1101_wait_status_state(handle, CC1101StateIDLE, CC1101_STATE_TIMEOUT_US)) {
+        result = false;
+    }
+    cc1101_write_reg(handle, CC1101_MCSM0, mcsm0);
+
+    return result;
+}
+
+float cc1101_rssi_to_dbm(uint8_t rssi) {
+    // Two's complement in 0.5dB steps with typical offset of 74dB
+    if(rssi >= 128) {
+        return ((rssi - 256.0f) / 2.0f) - 74.0f;
+    } else {
+        return (rssi / 2.0f) - 74.0f;
+    }
+}
@@ -3,6 +3,7 @@
 #include "cc1101_regs.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <furi_hal_spi.h>
 
@@ -10,6 +11,13 @@
 extern "C" {
 #endif
 
+/** Frequency synthesizer settings of a calibrated channel */
+typedef struct {
+    uint32_t frequency; /** Real frequency in herz */
+    uint8_t freq[3]; /** FREQ2, FREQ1, FREQ0 */
+    uint8_t fscal[3]; /** FSCAL3, FSCAL2, FSCAL1 */
+} CC1101Channel;
+
 /* Low level API */
 
 /** Strobe command to the device
@@ -190,6 +198,75 @@ uint8_t cc1101_write_fifo(FuriHalSpiBusHandle* handle, const uint8_t* data, uint
  */
 uint8_t cc1101_read_fifo(FuriHalSpiBusHandle* handle, uint8_t* data, uint8_t* size);
 
+/* Sweep API
+ *
+ * Synthesizer calibration takes about 720us, as long as a whole RSSI measurement with
+ * a wide channel filter. Channels are calibrated once with cc1101_calibrate_channel and
+ * then selected by writing back the stored FSCAL values, see "Frequency Hopping and
+ * Multi-Channel Systems" in the datasheet. Calibration depends on temperature and supply
+ * voltage, so long running sweeps should recalibrate from time to time.
+ *
+ * All functions expect the bus to be acquired.
+ */
+
+/** Calibrate channel
+ *
+ * Leaves the chip in IDLE tuned to the channel.
+ *
+ * @param      handle   - pointer to FuriHalSpiHandle
+ * @param      value    - frequency in herz
+ * @param[out] channel  - pointer to CC1101Channel to store calibration in
+ *
+ * @return     true on success, false if calibration didn't complete
+ */
+bool cc1101_calibrate_channel(FuriHalSpiBusHandle* handle, uint32_t value, CC1101Channel* channel);
+
+/** Set calibrated channel
+ *
+ * Chip must be in IDLE. Automatic calibration (MCSM0.FS_AUTOCAL) overwrites the stored
+ * calibration on the next IDLE to RX or TX transition unless disabled.
+ *
+ * @param      handle   - pointer to FuriHalSpiHandle
+ * @param      channel  - pointer to CC1101Channel
+ */
+void cc1101_set_channel(FuriHalSpiBusHandle* handle, const CC1101Channel* channel);
+
+/** Get RSSI settle time
+ *
+ * Time from entering RX until RSSI reflects the channel, derived from the channel filter
+ * bandwidth (MDMCFG4) and AGC wait time and filter length (AGCCTRL0).
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ *
+ * @return     settle time in microseconds
+ */
+uint32_t cc1101_get_rssi_settle_time(FuriHalSpiBusHandle* handle);
+
+/** Measure raw RSSI of calibrated channels
+ *
+ * Automatic calibration is suspended for the sweep, chip is left in IDLE.
+ *
+ * @param      handle    - pointer to FuriHalSpiHandle
+ * @param      channels  - array of calibrated channels
+ * @param      count     - channels count
+ * @param[out] rssi      - array of count raw RSSI values
+ *
+ * @return     true on success, false if chip didn't change state in time
+ */
+bool cc1101_sweep(
+    FuriHalSpiBusHandle* handle,
+    const CC1101Channel* channels,
+    size_t count,
+    uint8_t* rssi);
+
+/** Convert raw RSSI value to dBm
+ *
+ * @param      rssi  - raw RSSI value
+ *
+ * @return     RSSI in dBm
+ */
+float cc1101_rssi_to_dbm(uint8_t rssi);
+
 #ifdef __cplusplus
 }
 #endif
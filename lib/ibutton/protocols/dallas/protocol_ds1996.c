@@ -68,10 +68,7 @@ bool dallas_ds1996_read(OneWireHost* host, iButtonProtocolData* protocol_data) {
     do {
         if(!onewire_host_reset(host)) break;
         if(!dallas_common_read_rom(host, &data->rom_data)) break;
-        if(!onewire_host_reset(host)) break;
-
-        onewire_host_write(host, DALLAS_COMMON_CMD_OVERDRIVE_SKIP_ROM);
-        onewire_host_set_overdrive(host, true);
+        if(!onewire_host_overdrive_skip_rom(host)) break;
 
         if(!dallas_common_read_mem(host, 0, data->sram_data, DS1996_SRAM_DATA_SIZE)) break;
         success = true;
@@ -86,10 +83,7 @@ bool dallas_ds1996_write_copy(OneWireHost* host, iButtonProtocolData* protocol_d
     bool success = false;
 
     do {
-        if(!onewire_host_reset(host)) break;
-
-        onewire_host_write(host, DALLAS_COMMON_CMD_OVERDRIVE_SKIP_ROM);
-        onewire_host_set_overdrive(host, true);
+        if(!onewire_host_overdrive_skip_rom(host)) break;
 
         if(!dallas_common_write_mem(
                host,
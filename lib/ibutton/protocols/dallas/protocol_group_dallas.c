@@ -1,20 +1,86 @@
 #include "protocol_group_dallas.h"
 
+#include <furi_hal_ibutton.h>
 #include <furi_hal_resources.h>
 
 #include "protocol_group_dallas_defs.h"
 
 #define IBUTTON_ONEWIRE_ROM_SIZE 8U
+#define IBUTTON_ONEWIRE_RELEASE_RETRIES 125U
 
 typedef struct {
     OneWireHost* host;
     OneWireSlave* bus;
 } iButtonProtocolGroupDallas;
 
+static void ibutton_protocol_group_dallas_bus_start(void* context) {
+    UNUSED(context);
+    furi_hal_ibutton_host_start();
+}
+
+static void ibutton_protocol_group_dallas_bus_stop(void* context) {
+    UNUSED(context);
+    furi_hal_ibutton_host_stop();
+}
+
+static bool
+    ibutton_protocol_group_dallas_bus_reset(void* context, const OneWireHostTimings* timings) {
+    UNUSED(context);
+
+    // wait until the line is released
+    uint32_t retries = IBUTTON_ONEWIRE_RELEASE_RETRIES;
+    do {
+        if(--retries == 0) return false;
+        furi_delay_us(2);
+    } while(!furi_hal_gpio_read(&gpio_ibutton));
+
+    furi_delay_us(timings->g);
+
+    const FuriHalIbuttonHostSlot slot = {
+        .period = timings->h + timings->i + timings->j,
+        .low_1 = timings->h,
+        .low_0 = timings->h,
+        .sample = timings->h + timings->i,
+    };
+
+    // Failed exchange is reported as no presence
+    uint8_t level;
+    return furi_hal_ibutton_host_exchange(&slot, NULL, &level, 1) && !(level & 0x01);
+}
+
+static void ibutton_protocol_group_dallas_bus_exchange(
+    void* context,
+    const OneWireHostTimings* timings,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    UNUSED(context);
+
+    const FuriHalIbuttonHostSlot slot = {
+        .period = MAX(timings->a + timings->b, timings->c + timings->d),
+        .low_1 = timings->a,
+        .low_0 = timings->c,
+        .sample = timings->a + timings->e,
+    };
+
+    // Failed exchange reads as released line, same as with no device on the bus
+    if(!furi_hal_ibutton_host_exchange(&slot, tx, rx, bit_count) && rx) {
+        memset(rx, 0xFF, (bit_count + 7) / 8);
+    }
+}
+
+/* Slots are generated by the timer, no need for critical sections */
+static const OneWireHostBus ibutton_protocol_group_dallas_bus = {
+    .start = ibutton_protocol_group_dallas_bus_start,
+    .stop = ibutton_protocol_group_dallas_bus_stop,
+    .reset = ibutton_protocol_group_dallas_bus_reset,
+    .exchange = ibutton_protocol_group_dallas_bus_exchange,
+};
+
 static iButtonProtocolGroupDallas* ibutton_protocol_group_dallas_alloc() {
     iButtonProtocolGroupDallas* group = malloc(sizeof(iButtonProtocolGroupDallas));
 
-    group->host = onewire_host_alloc(&gpio_ibutton);
+    group->host = onewire_host_alloc_ex(&ibutton_protocol_group_dallas_bus, NULL);
     group->bus = onewire_slave_alloc(&gpio_ibutton);
 
     return group;
@@ -106,8 +172,6 @@ static bool ibutton_protocol_group_dallas_read(
     onewire_host_start(host);
     furi_delay_ms(100);
 
-    FURI_CRITICAL_ENTER();
-
     if(onewire_host_search(host, rom_data, OneWireHostSearchModeNormal)) {
         /* Considering any found 1-Wire device a success.
          * It can be checked later with ibutton_key_is_valid(). */
@@ -122,8 +186,6 @@ static bool ibutton_protocol_group_dallas_read(
     onewire_host_reset_search(host);
     onewire_host_stop(host);
 
-    FURI_CRITICAL_EXIT();
-
     return success;
 }
 
@@ -140,12 +202,8 @@ static bool ibutton_protocol_group_dallas_write_blank(
     onewire_host_start(host);
     furi_delay_ms(100);
 
-    FURI_CRITICAL_ENTER();
-
     const bool success = protocol->write_blank(host, data);
     onewire_host_stop(host);
-
-    FURI_CRITICAL_EXIT();
     return success;
 }
 
@@ -163,12 +221,8 @@ static bool ibutton_protocol_group_dallas_write_copy(
     onewire_host_start(host);
     furi_delay_ms(100);
 
-    FURI_CRITICAL_ENTER();
-
     const bool success = protocol->write_copy(host, data);
     onewire_host_stop(host);
-
-    FURI_CRITICAL_EXIT();
     return success;
 }
 
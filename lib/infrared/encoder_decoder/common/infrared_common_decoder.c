@@ -217,6 +217,35 @@ InfraredMessage* infrared_common_decoder_check_ready(InfraredCommonDecoder* deco
     return message;
 }
 
+/* Whether this mark can start a message of this protocol */
+bool infrared_common_decoder_match_lead(InfraredCommonDecoder* decoder, uint32_t duration) {
+    furi_assert(decoder);
+    const InfraredTimings* timings = &decoder->protocol->timings;
+
+    if(timings->preamble_mark) {
+        return MATCH_TIMING(duration, timings->preamble_mark, timings->preamble_tolerance);
+    }
+
+    /* Manchester without preamble: first mark is one or two half-bits long */
+    return MATCH_TIMING(duration, timings->bit1_mark, timings->bit_tolerance) ||
+           MATCH_TIMING(duration, 2 * timings->bit1_mark, timings->bit_tolerance);
+}
+
+/* Stop feeding samples until the lead mark shows up again.
+ * Waiting for a preamble the decoder would skip them anyway, so only buffered samples
+ * go and the last message stays for repeat detection. Otherwise the first skipped mark
+ * would have reset it. */
+void infrared_common_decoder_drop(InfraredCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    if(decoder->state == InfraredCommonDecoderStateWaitPreamble &&
+       decoder->protocol->timings.preamble_mark) {
+        decoder->timings_cnt = 0;
+    } else {
+        infrared_common_decoder_reset(decoder);
+    }
+}
+
 InfraredMessage*
     infrared_common_decode(InfraredCommonDecoder* decoder, bool level, uint32_t duration) {
     furi_assert(decoder);
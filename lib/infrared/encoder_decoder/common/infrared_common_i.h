@@ -75,6 +75,8 @@ void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol);
 void infrared_common_decoder_free(InfraredCommonDecoder* decoder);
 void infrared_common_decoder_reset(InfraredCommonDecoder* decoder);
 InfraredMessage* infrared_common_decoder_check_ready(InfraredCommonDecoder* decoder);
+bool infrared_common_decoder_match_lead(InfraredCommonDecoder* decoder, uint32_t duration);
+void infrared_common_decoder_drop(InfraredCommonDecoder* decoder);
 
 InfraredStatus
     infrared_common_encode(InfraredCommonEncoder* encoder, uint32_t* duration, bool* polarity);
@@ -19,6 +19,8 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderMatchLead match_lead;
+    InfraredDecoderDrop drop;
 } InfraredDecoders;
 
 typedef struct {
@@ -28,8 +30,15 @@ typedef struct {
     InfraredFree free;
 } InfraredEncoders;
 
+/* Space that ends a burst: longer than any space inside a message */
+#define INFRARED_DECODER_BURST_SPACE_US 5000
+
 struct InfraredDecoderHandler {
     void** ctx;
+    /* Decoders receiving samples, bit per table index */
+    uint32_t active;
+    /* Next mark starts a new burst: decoders that cannot match it are dropped */
+    bool burst_start;
 };
 
 struct InfraredEncoderHandler {
@@ -50,6 +59,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .match_lead = infrared_decoder_nec_match_lead,
+             .drop = infrared_decoder_nec_drop,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -64,6 +75,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .match_lead = infrared_decoder_samsung32_match_lead,
+             .drop = infrared_decoder_samsung32_drop,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -78,6 +91,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
+             .match_lead = infrared_decoder_rc5_match_lead,
+             .drop = infrared_decoder_rc5_drop,
              .free = infrared_decoder_rc5_free},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
@@ -92,6 +107,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .match_lead = infrared_decoder_rc6_match_lead,
+             .drop = infrared_decoder_rc6_drop,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -106,6 +123,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .match_lead = infrared_decoder_sirc_match_lead,
+             .drop = infrared_decoder_sirc_drop,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -120,6 +139,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .match_lead = infrared_decoder_kaseikyo_match_lead,
+             .drop = infrared_decoder_kaseikyo_drop,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -134,6 +155,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
+             .match_lead = infrared_decoder_rca_match_lead,
+             .drop = infrared_decoder_rca_drop,
              .free = infrared_decoder_rca_free},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
@@ -144,9 +167,36 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
     },
 };
 
+static_assert(COUNT_OF(infrared_encoder_decoder) < 32, "Active decoders mask is too small");
+
+#define INFRARED_DECODERS_ALL ((1UL << COUNT_OF(infrared_encoder_decoder)) - 1)
+
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+/* Activates decoders that can start a message with this mark.
+ * At the start of a burst also drops decoders that can't. */
+static void infrared_select_decoders(InfraredDecoderHandler* handler, uint32_t duration) {
+    if(!handler->burst_start && handler->active == INFRARED_DECODERS_ALL) return;
+
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+        const uint32_t mask = 1UL << i;
+
+        if(!handler->burst_start && (handler->active & mask)) continue;
+
+        if(!decoder->match_lead || decoder->match_lead(handler->ctx[i], duration)) {
+            handler->active |= mask;
+        } else if(handler->active & mask) {
+            // Dropped decoder gets no samples until its lead mark shows up
+            if(decoder->drop) decoder->drop(handler->ctx[i]);
+            handler->active &= ~mask;
+        }
+    }
+
+    handler->burst_start = false;
+}
+
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_assert(handler);
@@ -154,8 +204,12 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    if(level) {
+        infrared_select_decoders(handler, duration);
+    }
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
-        if(infrared_encoder_decoder[i].decoder.decode) {
+        if((handler->active & (1UL << i)) && infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
             if(!result && message) {
                 result = message;
@@ -163,6 +217,10 @@ const InfraredMessage*
         }
     }
 
+    if(!level && duration > INFRARED_DECODER_BURST_SPACE_US) {
+        handler->burst_start = true;
+    }
+
     return result;
 }
 
@@ -198,6 +256,9 @@ void infrared_reset_decoder(InfraredDecoderHandler* handler) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
+
+    handler->active = INFRARED_DECODERS_ALL;
+    handler->burst_start = true;
 }
 
 const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* handler) {
@@ -207,7 +268,7 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     InfraredMessage* result = NULL;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
-        if(infrared_encoder_decoder[i].decoder.check_ready) {
+        if((handler->active & (1UL << i)) && infrared_encoder_decoder[i].decoder.check_ready) {
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
             if(!result && message) {
                 result = message;
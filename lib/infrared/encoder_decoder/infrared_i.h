@@ -33,6 +33,8 @@ typedef void (*InfraredFree)(void*);
 typedef void (*InfraredDecoderReset)(void*);
 typedef InfraredMessage* (*InfraredDecode)(void* ctx, bool level, uint32_t duration);
 typedef InfraredMessage* (*InfraredDecoderCheckReady)(void*);
+typedef bool (*InfraredDecoderMatchLead)(void* ctx, uint32_t duration);
+typedef void (*InfraredDecoderDrop)(void* ctx);
 
 typedef void (*InfraredEncoderReset)(void* encoder, const InfraredMessage* message);
 typedef InfraredStatus (*InfraredEncode)(void* encoder, uint32_t* out, bool* polarity);
@@ -48,3 +48,11 @@ void infrared_decoder_kaseikyo_free(void* decoder) {
 void infrared_decoder_kaseikyo_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+bool infrared_decoder_kaseikyo_match_lead(void* decoder, uint32_t duration) {
+    return infrared_common_decoder_match_lead(decoder, duration);
+}
+
+void infrared_decoder_kaseikyo_drop(void* decoder) {
+    infrared_common_decoder_drop(decoder);
+}
@@ -77,3 +77,13 @@ void infrared_decoder_rc5_reset(void* decoder) {
     InfraredRc5Decoder* decoder_rc5 = decoder;
     infrared_common_decoder_reset(decoder_rc5->common_decoder);
 }
+
+bool infrared_decoder_rc5_match_lead(void* decoder, uint32_t duration) {
+    InfraredRc5Decoder* decoder_rc5 = decoder;
+    return infrared_common_decoder_match_lead(decoder_rc5->common_decoder, duration);
+}
+
+void infrared_decoder_rc5_drop(void* decoder) {
+    InfraredRc5Decoder* decoder_rc5 = decoder;
+    infrared_common_decoder_drop(decoder_rc5->common_decoder);
+}
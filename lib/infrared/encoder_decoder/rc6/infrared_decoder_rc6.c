@@ -110,3 +110,13 @@ void infrared_decoder_rc6_reset(void* decoder) {
     InfraredRc6Decoder* decoder_rc6 = decoder;
     infrared_common_decoder_reset(decoder_rc6->common_decoder);
 }
+
+bool infrared_decoder_rc6_match_lead(void* decoder, uint32_t duration) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    return infrared_common_decoder_match_lead(decoder_rc6->common_decoder, duration);
+}
+
+void infrared_decoder_rc6_drop(void* decoder) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    infrared_common_decoder_drop(decoder_rc6->common_decoder);
+}
@@ -28,6 +28,8 @@ void infrared_decoder_rc6_reset(void* decoder);
 void infrared_decoder_rc6_free(void* decoder);
 InfraredMessage* infrared_decoder_rc6_check_ready(void* ctx);
 InfraredMessage* infrared_decoder_rc6_decode(void* decoder, bool level, uint32_t duration);
+bool infrared_decoder_rc6_match_lead(void* decoder, uint32_t duration);
+void infrared_decoder_rc6_drop(void* decoder);
 
 void* infrared_encoder_rc6_alloc(void);
 void infrared_encoder_rc6_reset(void* encoder_ptr, const InfraredMessage* message);
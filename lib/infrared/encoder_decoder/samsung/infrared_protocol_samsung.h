@@ -21,6 +21,8 @@ void infrared_decoder_samsung32_reset(void* decoder);
 void infrared_decoder_samsung32_free(void* decoder);
 InfraredMessage* infrared_decoder_samsung32_check_ready(void* ctx);
 InfraredMessage* infrared_decoder_samsung32_decode(void* decoder, bool level, uint32_t duration);
+bool infrared_decoder_samsung32_match_lead(void* decoder, uint32_t duration);
+void infrared_decoder_samsung32_drop(void* decoder);
 
 InfraredStatus
     infrared_encoder_samsung32_encode(void* encoder_ptr, uint32_t* duration, bool* level);
@@ -0,0 +1,267 @@
+#include "infrared_raw_compact.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <core/check.h>
+
+#define INFRARED_RAW_COMPACT_REPEAT_MAX 255U
+#define INFRARED_RAW_COMPACT_VARINT_MAX_SIZE 4U
+
+struct InfraredRawCompact {
+    size_t timings_size;
+    size_t symbols_size;
+    uint32_t symbols[INFRARED_RAW_COMPACT_MAX_SYMBOLS];
+    size_t program_size;
+    uint8_t program[];
+};
+
+static InfraredRawCompact* infrared_raw_compact_alloc_empty(size_t program_size) {
+    InfraredRawCompact* compact = malloc(sizeof(InfraredRawCompact) + program_size);
+    compact->timings_size = 0;
+    compact->symbols_size = 0;
+    compact->program_size = program_size;
+    return compact;
+}
+
+static int infrared_raw_compact_compare(const void* a, const void* b) {
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static bool infrared_raw_compact_in_tolerance(uint32_t timing, uint32_t symbol) {
+    const uint32_t diff = timing > symbol ? timing - symbol : symbol - timing;
+    return diff <= timing * INFRARED_RAW_COMPACT_TOLERANCE;
+}
+
+/* Greedy clustering of sorted timings, symbol is the middle of the cluster */
+static bool infrared_raw_compact_make_symbols(
+    InfraredRawCompact* compact,
+    uint32_t* bounds,
+    const uint32_t* timings,
+    size_t timings_size) {
+    uint32_t* sorted = malloc(timings_size * sizeof(uint32_t));
+    memcpy(sorted, timings, timings_size * sizeof(uint32_t));
+    qsort(sorted, timings_size, sizeof(uint32_t), infrared_raw_compact_compare);
+
+    bool success = true;
+    size_t first = 0;
+
+    while(first < timings_size) {
+        if(compact->symbols_size == INFRARED_RAW_COMPACT_MAX_SYMBOLS) {
+            success = false;
+            break;
+        }
+
+        const uint32_t low = sorted[first];
+        size_t last = first;
+        while(last + 1 < timings_size) {
+            const uint32_t high = sorted[last + 1];
+            const uint32_t symbol = low + (high - low) / 2;
+            if(!infrared_raw_compact_in_tolerance(low, symbol) ||
+               !infrared_raw_compact_in_tolerance(high, symbol))
+                break;
+            ++last;
+        }
+
+        const uint32_t high = sorted[last];
+        compact->symbols[compact->symbols_size] = low + (high - low) / 2;
+        bounds[compact->symbols_size] = high;
+        ++compact->symbols_size;
+        first = last + 1;
+    }
+
+    free(sorted);
+    return success;
+}
+
+static size_t infrared_raw_compact_put_varint(uint8_t* data, size_t value) {
+    size_t size = 0;
+    do {
+        data[size] = value & 0x7F;
+        value >>= 7;
+        if(value) data[size] |= 0x80;
+        ++size;
+    } while(value);
+    return size;
+}
+
+static bool infrared_raw_compact_get_varint(
+    const uint8_t* data,
+    size_t data_size,
+    size_t* offset,
+    size_t* value) {
+    *value = 0;
+    for(size_t i = 0; i < INFRARED_RAW_COMPACT_VARINT_MAX_SIZE; ++i) {
+        if(*offset >= data_size) return false;
+        const uint8_t byte = data[(*offset)++];
+        *value |= (size_t)(byte & 0x7F) << (7 * i);
+        if(!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/* Frame ends with a long space or with the signal */
+static size_t infrared_raw_compact_frame_size(
+    const uint32_t* timings,
+    size_t timings_size,
+    size_t start) {
+    for(size_t i = start + 1; i < timings_size; i += 2) {
+        if(timings[i] >= INFRARED_RAW_COMPACT_FRAME_GAP_US) return i + 1 - start;
+    }
+    return timings_size - start;
+}
+
+InfraredRawCompact* infrared_raw_compact_alloc(const uint32_t* timings, size_t timings_size) {
+    furi_assert(timings);
+
+    if(timings_size == 0) return NULL;
+
+    /* Record of n symbols takes a repeat byte, a varint and (n + 1) / 2 bytes. That is at most
+     * 3 * n / 2 bytes for frames of two or more symbols, only the last frame may be shorter. */
+    const size_t program_max_size = timings_size + timings_size / 2 + 3;
+    InfraredRawCompact* compact = infrared_raw_compact_alloc_empty(program_max_size);
+    uint32_t bounds[INFRARED_RAW_COMPACT_MAX_SYMBOLS];
+    uint8_t* indices = NULL;
+    bool success = false;
+
+    do {
+        if(!infrared_raw_compact_make_symbols(compact, bounds, timings, timings_size)) break;
+
+        indices = malloc(timings_size);
+        for(size_t i = 0; i < timings_size; ++i) {
+            uint8_t symbol = 0;
+            while(timings[i] > bounds[symbol]) ++symbol;
+            indices[i] = symbol;
+        }
+
+        size_t offset = 0;
+        size_t start = 0;
+        while(start < timings_size) {
+            const size_t frame_size =
+                infrared_raw_compact_frame_size(timings, timings_size, start);
+            size_t repeat = 1;
+            while(repeat < INFRARED_RAW_COMPACT_REPEAT_MAX &&
+                  start + (repeat + 1) * frame_size <= timings_size &&
+                  !memcmp(
+                      &indices[start], &indices[start + repeat * frame_size], frame_size) &&
+                  infrared_raw_compact_frame_size(
+                      timings, timings_size, start + repeat * frame_size) == frame_size) {
+                ++repeat;
+            }
+
+            compact->program[offset++] = repeat;
+            offset += infrared_raw_compact_put_varint(&compact->program[offset], frame_size);
+            for(size_t i = 0; i < frame_size; i += 2) {
+                uint8_t byte = indices[start + i];
+                if(i + 1 < frame_size) byte |= indices[start + i + 1] << 4;
+                compact->program[offset++] = byte;
+            }
+
+            start += repeat * frame_size;
+        }
+
+        compact->program_size = offset;
+        compact->timings_size = timings_size;
+
+        const size_t compact_size = offset + compact->symbols_size * sizeof(uint32_t);
+        success = compact_size < timings_size * sizeof(uint32_t);
+    } while(false);
+
+    free(indices);
+
+    if(!success) {
+        free(compact);
+        return NULL;
+    }
+
+    /* Give back unused program space */
+    return realloc(compact, sizeof(InfraredRawCompact) + compact->program_size);
+}
+
+InfraredRawCompact* infrared_raw_compact_alloc_copy(const InfraredRawCompact* compact) {
+    furi_assert(compact);
+
+    const size_t size = sizeof(InfraredRawCompact) + compact->program_size;
+    InfraredRawCompact* copy = malloc(size);
+    memcpy(copy, compact, size);
+
+    return copy;
+}
+
+void infrared_raw_compact_free(InfraredRawCompact* compact) {
+    furi_assert(compact);
+    free(compact);
+}
+
+size_t infrared_raw_compact_get_timings_size(const InfraredRawCompact* compact) {
+    furi_assert(compact);
+    return compact->timings_size;
+}
+
+/* Program is well formed, it is only built by infrared_raw_compact_alloc() */
+static void infrared_raw_compact_it_load(
+    const InfraredRawCompact* compact,
+    InfraredRawCompactIterator* it) {
+    size_t offset = it->record;
+    it->repeat = compact->program[offset++];
+    infrared_raw_compact_get_varint(
+        compact->program, compact->program_size, &offset, &it->frame_size);
+    it->frame = offset;
+    it->position = 0;
+}
+
+void infrared_raw_compact_it_init(
+    const InfraredRawCompact* compact,
+    InfraredRawCompactIterator* it) {
+    furi_assert(compact);
+    furi_assert(it);
+
+    it->record = 0;
+    infrared_raw_compact_it_load(compact, it);
+}
+
+bool infrared_raw_compact_it_next(
+    const InfraredRawCompact* compact,
+    InfraredRawCompactIterator* it,
+    uint32_t* duration) {
+    furi_assert(compact);
+    furi_assert(it);
+    furi_assert(duration);
+
+    if(it->position == it->frame_size) {
+        if(--it->repeat) {
+            it->position = 0;
+        } else {
+            it->record = it->frame + (it->frame_size + 1) / 2;
+            if(it->record >= compact->program_size) {
+                /* Stay at the end */
+                it->repeat = 1;
+                return false;
+            }
+            infrared_raw_compact_it_load(compact, it);
+        }
+    }
+
+    const uint8_t byte = compact->program[it->frame + it->position / 2];
+    const uint8_t symbol = (it->position % 2) ? byte >> 4 : byte & 0x0F;
+    ++it->position;
+
+    *duration = compact->symbols[symbol];
+    return true;
+}
+
+void infrared_raw_compact_expand(const InfraredRawCompact* compact, uint32_t* timings) {
+    furi_assert(compact);
+    furi_assert(timings);
+
+    InfraredRawCompactIterator it;
+    infrared_raw_compact_it_init(compact, &it);
+
+    size_t count = 0;
+    while(infrared_raw_compact_it_next(compact, &it, &timings[count])) {
+        ++count;
+    }
+
+    furi_assert(count == compact->timings_size);
+}
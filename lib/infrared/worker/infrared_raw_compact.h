@@ -0,0 +1,107 @@
+/**
+ * @file infrared_raw_compact.h
+ * @brief Compact in-memory representation of raw infrared signals.
+ *
+ * Timings are quantized to a small table of symbol durations, every replayed
+ * timing stays within INFRARED_RAW_COMPACT_TOLERANCE of the original one.
+ * Signal is split into frames at long spaces, consecutive identical frames
+ * are stored once with a repeat count.
+ *
+ * Program layout, one record per run of identical frames:
+ * - repeat count, 1 byte (1 - 255)
+ * - frame length in symbols, LEB128
+ * - symbol indices, 4 bits each, low nibble first
+ *
+ * Signals are replayed with an iterator, full timings array is never built.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INFRARED_RAW_COMPACT_MAX_SYMBOLS 16U
+/** Maximum relative difference between original and replayed timing */
+#define INFRARED_RAW_COMPACT_TOLERANCE 0.1f
+/** Spaces at least this long end a frame */
+#define INFRARED_RAW_COMPACT_FRAME_GAP_US 5000U
+
+typedef struct InfraredRawCompact InfraredRawCompact;
+
+/** Replay position, see infrared_raw_compact_it_next() */
+typedef struct {
+    size_t record; /**< Program offset of current record */
+    size_t frame; /**< Program offset of current frame symbols */
+    size_t frame_size; /**< Symbols in current frame */
+    size_t position; /**< Next symbol in current frame */
+    uint32_t repeat; /**< Remaining repeats of current frame */
+} InfraredRawCompactIterator;
+
+/** Compact raw timings
+ *
+ * @param[in]   timings - raw timings, starting from mark
+ * @param[in]   timings_size - number of timings
+ *
+ * @return      instance or NULL if timings don't fit in symbol table or
+ *              compact form is not smaller
+ */
+InfraredRawCompact* infrared_raw_compact_alloc(const uint32_t* timings, size_t timings_size);
+
+/** Copy instance
+ *
+ * @param[in]   compact - instance to copy
+ *
+ * @return      new instance
+ */
+InfraredRawCompact* infrared_raw_compact_alloc_copy(const InfraredRawCompact* compact);
+
+/** Free instance
+ *
+ * @param[in]   compact - instance to free
+ */
+void infrared_raw_compact_free(InfraredRawCompact* compact);
+
+/** Get number of timings in replayed signal
+ *
+ * @param[in]   compact - instance
+ *
+ * @return      number of timings
+ */
+size_t infrared_raw_compact_get_timings_size(const InfraredRawCompact* compact);
+
+/** Start replay from the first timing
+ *
+ * @param[in]   compact - instance
+ * @param[out]  it - iterator to initialize
+ */
+void infrared_raw_compact_it_init(
+    const InfraredRawCompact* compact,
+    InfraredRawCompactIterator* it);
+
+/** Get next replayed timing
+ *
+ * @param[in]   compact - instance
+ * @param[in,out] it - iterator
+ * @param[out]  duration - timing duration
+ *
+ * @return      false if there are no more timings
+ */
+bool infrared_raw_compact_it_next(
+    const InfraredRawCompact* compact,
+    InfraredRawCompactIterator* it,
+    uint32_t* duration);
+
+/** Write replayed timings to array
+ *
+ * @param[in]   compact - instance
+ * @param[out]  timings - array of infrared_raw_compact_get_timings_size() elements
+ */
+void infrared_raw_compact_expand(const InfraredRawCompact* compact, uint32_t* timings);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "infrared.h"
+#include "infrared_transmit.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -10,6 +11,7 @@ static uint32_t infrared_tx_raw_timings_index = 0;
 static uint32_t infrared_tx_raw_timings_number = 0;
 static uint32_t infrared_tx_raw_start_from_mark = 0;
 static bool infrared_tx_raw_add_silence = false;
+static InfraredRawCompactIterator infrared_tx_raw_compact_it;
 
 FuriHalInfraredTxGetDataState
     infrared_get_raw_data_callback(void* context, uint32_t* duration, bool* level) {
@@ -65,6 +67,47 @@ void infrared_send_raw(const uint32_t timings[], uint32_t timings_cnt, bool star
         INFRARED_COMMON_DUTY_CYCLE);
 }
 
+static FuriHalInfraredTxGetDataState
+    infrared_get_raw_compact_data_callback(void* context, uint32_t* duration, bool* level) {
+    furi_assert(duration);
+    furi_assert(level);
+    furi_assert(context);
+
+    const InfraredRawCompact* compact = context;
+
+    if(infrared_tx_raw_add_silence) {
+        infrared_tx_raw_add_silence = false;
+        *level = false;
+        *duration = INFRARED_RAW_TX_TIMING_DELAY_US;
+    } else {
+        *level = !(infrared_tx_raw_timings_index % 2);
+        furi_check(infrared_raw_compact_it_next(compact, &infrared_tx_raw_compact_it, duration));
+        ++infrared_tx_raw_timings_index;
+    }
+
+    return infrared_tx_raw_timings_number == infrared_tx_raw_timings_index ?
+               FuriHalInfraredTxGetDataStateLastDone :
+               FuriHalInfraredTxGetDataStateOk;
+}
+
+void infrared_send_raw_compact(
+    const InfraredRawCompact* compact,
+    uint32_t frequency,
+    float duty_cycle) {
+    furi_assert(compact);
+
+    infrared_raw_compact_it_init(compact, &infrared_tx_raw_compact_it);
+    infrared_tx_raw_timings_index = 0;
+    infrared_tx_raw_timings_number = infrared_raw_compact_get_timings_size(compact);
+    infrared_tx_raw_add_silence = true;
+    furi_hal_infrared_async_tx_set_data_isr_callback(
+        infrared_get_raw_compact_data_callback, (void*)compact);
+    furi_hal_infrared_async_tx_start(frequency, duty_cycle);
+    furi_hal_infrared_async_tx_wait_termination();
+
+    furi_assert(!furi_hal_infrared_is_busy());
+}
+
 FuriHalInfraredTxGetDataState
     infrared_get_data_callback(void* context, uint32_t* duration, bool* level) {
     FuriHalInfraredTxGetDataState state;
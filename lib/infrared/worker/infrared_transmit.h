@@ -1,6 +1,7 @@
 #include <furi_hal_infrared.h>
 #include <infrared.h>
 #include <stdint.h>
+#include "infrared_raw_compact.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +42,19 @@ void infrared_send_raw_ext(
     uint32_t frequency,
     float duty_cycle);
 
+/**
+ * Send compact raw signal through infrared port.
+ * Timings are produced on the fly, signal starts from mark.
+ *
+ * \param[in]   compact - compact raw signal to send.
+ * \param[in]   frequency - frequency to generate on PWM
+ * \param[in]   duty_cycle - duty cycle to generate on PWM
+ */
+void infrared_send_raw_compact(
+    const InfraredRawCompact* compact,
+    uint32_t frequency,
+    float duty_cycle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,6 +2,7 @@
 
 #include <furi_hal_infrared.h>
 #include <float_tools.h>
+#include <toolbox/trace.h>
 
 #include <core/check.h>
 #include <core/common_defines.h>
@@ -45,6 +46,8 @@ struct InfraredWorkerSignal {
             uint32_t timings[MAX_TIMINGS_AMOUNT + 1];
             uint32_t frequency;
             float duty_cycle;
+            /* Replayed instead of timings if set, owned by caller */
+            const InfraredRawCompact* compact;
         } raw;
     };
 };
@@ -70,6 +73,7 @@ struct InfraredWorker {
             uint32_t frequency;
             float duty_cycle;
             uint32_t tx_raw_cnt;
+            InfraredRawCompactIterator tx_raw_it;
             bool need_reinitialization;
             bool steady_signal_sent;
         } tx;
@@ -179,6 +183,7 @@ static int32_t infrared_worker_rx_thread(void* thread_context) {
             }
             if(instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_backlight_on);
+            TRACE_BEGIN(InfraredWorkerDecode);
             while(sizeof(LevelDuration) ==
                   furi_stream_buffer_receive(
                       instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
@@ -188,8 +193,10 @@ static int32_t infrared_worker_rx_thread(void* thread_context) {
                     infrared_worker_process_timings(instance, duration, level);
                 }
             }
+            TRACE_END(InfraredWorkerDecode);
         }
         if(events & INFRARED_WORKER_OVERRUN) {
+            TRACE_INSTANT(InfraredWorkerOverrun, instance->signal.timings_cnt);
             printf("#");
             infrared_reset_decoder(instance->infrared_decoder);
             instance->signal.timings_cnt = 0;
@@ -270,6 +277,7 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_hal_infrared_async_rx_set_timeout(INFRARED_WORKER_RX_TIMEOUT);
 
     instance->rx.overrun = false;
+    instance->signal.raw.compact = NULL;
     instance->state = InfraredWorkerStateRunRx;
 }
 
@@ -431,7 +439,16 @@ static bool infrared_worker_tx_fill_buffer(InfraredWorker* instance) {
         if(instance->signal.decoded) {
             status = infrared_encode(instance->infrared_encoder, &timing.duration, &timing.level);
         } else {
-            timing.duration = instance->signal.raw.timings[instance->tx.tx_raw_cnt];
+            if(!instance->signal.raw.compact) {
+                timing.duration = instance->signal.raw.timings[instance->tx.tx_raw_cnt];
+            } else if(instance->tx.tx_raw_cnt == 0) {
+                timing.duration = INFRARED_RAW_TX_TIMING_DELAY_US;
+                infrared_raw_compact_it_init(
+                    instance->signal.raw.compact, &instance->tx.tx_raw_it);
+            } else {
+                furi_check(infrared_raw_compact_it_next(
+                    instance->signal.raw.compact, &instance->tx.tx_raw_it, &timing.duration));
+            }
             /* raw always starts from Mark, but we fill it with space delay at start */
             timing.level = (instance->tx.tx_raw_cnt % 2);
             ++instance->tx.tx_raw_cnt;
@@ -616,6 +633,26 @@ void infrared_worker_set_raw_signal(
     instance->signal.raw.duty_cycle = duty_cycle;
     instance->signal.raw.timings[0] = INFRARED_RAW_TX_TIMING_DELAY_US;
     memcpy(&instance->signal.raw.timings[1], timings, timings_cnt * sizeof(uint32_t));
+    instance->signal.raw.compact = NULL;
+    instance->signal.decoded = false;
+    instance->signal.timings_cnt = timings_cnt + 1;
+}
+
+void infrared_worker_set_raw_compact_signal(
+    InfraredWorker* instance,
+    const InfraredRawCompact* compact,
+    uint32_t frequency,
+    float duty_cycle) {
+    furi_assert(instance);
+    furi_assert(compact);
+    furi_assert((frequency <= INFRARED_MAX_FREQUENCY) && (frequency >= INFRARED_MIN_FREQUENCY));
+    furi_assert((duty_cycle < 1.0f) && (duty_cycle > 0.0f));
+    const size_t timings_cnt = infrared_raw_compact_get_timings_size(compact);
+    furi_check(timings_cnt <= MAX_TIMINGS_AMOUNT);
+
+    instance->signal.raw.frequency = frequency;
+    instance->signal.raw.duty_cycle = duty_cycle;
+    instance->signal.raw.compact = compact;
     instance->signal.decoded = false;
     instance->signal.timings_cnt = timings_cnt + 1;
 }
@@ -2,6 +2,7 @@
 
 #include <infrared.h>
 #include <furi_hal.h>
+#include "infrared_raw_compact.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -182,6 +183,22 @@ void infrared_worker_set_raw_signal(
     uint32_t frequency,
     float duty_cycle);
 
+/** Set current compact raw signal for InfraredWorker instance
+ *
+ * Timings are not copied: compact signal must stay valid until transmission
+ * is stopped or another signal is set.
+ *
+ * @param[out]  instance - InfraredWorker instance
+ * @param[in]   compact - compact raw signal
+ * @param[in]   frequency - carrier frequency in Hertz
+ * @param[in]   duty_cycle - carrier duty cycle (0.0 - 1.0)
+ */
+void infrared_worker_set_raw_compact_signal(
+    InfraredWorker* instance,
+    const InfraredRawCompact* compact,
+    uint32_t frequency,
+    float duty_cycle);
+
 #ifdef __cplusplus
 }
 #endif
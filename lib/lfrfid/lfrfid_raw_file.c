@@ -1,10 +1,12 @@
 #include "lfrfid_raw_file.h"
 #include "tools/varint_pair.h"
+#include "tools/raw_block.h"
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/varint.h>
 
 #define LFRFID_RAW_FILE_MAGIC 0x4C464952
-#define LFRFID_RAW_FILE_VERSION 1
+#define LFRFID_RAW_FILE_VERSION_PAIRS 1
+#define LFRFID_RAW_FILE_VERSION_BLOCKS 2
 
 #define TAG "LfRfidRawFile"
 
@@ -18,17 +20,22 @@ typedef struct {
 
 struct LFRFIDRawFile {
     Stream* stream;
+    uint32_t version;
     uint32_t max_buffer_size;
 
     uint8_t* buffer;
     uint32_t buffer_size;
     size_t buffer_counter;
+
+    RawBlockDecoder decoder;
 };
 
 LFRFIDRawFile* lfrfid_raw_file_alloc(Storage* storage) {
     LFRFIDRawFile* file = malloc(sizeof(LFRFIDRawFile));
     file->stream = file_stream_alloc(storage);
     file->buffer = NULL;
+    file->version = 0;
+    file->decoder.count = 0;
     return file;
 }
 
@@ -46,14 +53,15 @@ bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path) {
     return file_stream_open(file->stream, file_path, FSAM_READ, FSOM_OPEN_EXISTING);
 }
 
-bool lfrfid_raw_file_write_header(
+static bool lfrfid_raw_file_write_header_version(
     LFRFIDRawFile* file,
+    uint32_t version,
     float frequency,
     float duty_cycle,
     uint32_t max_buffer_size) {
     LFRFIDRawFileHeader header = {
         .magic = LFRFID_RAW_FILE_MAGIC,
-        .version = LFRFID_RAW_FILE_VERSION,
+        .version = version,
         .frequency = frequency,
         .duty_cycle = duty_cycle,
         .max_buffer_size = max_buffer_size};
@@ -62,6 +70,20 @@ bool lfrfid_raw_file_write_header(
     return (size == sizeof(LFRFIDRawFileHeader));
 }
 
+bool lfrfid_raw_file_write_header(
+    LFRFIDRawFile* file,
+    float frequency,
+    float duty_cycle,
+    uint32_t max_buffer_size) {
+    return lfrfid_raw_file_write_header_version(
+        file, LFRFID_RAW_FILE_VERSION_PAIRS, frequency, duty_cycle, max_buffer_size);
+}
+
+bool lfrfid_raw_file_write_blocks_header(LFRFIDRawFile* file, float frequency, float duty_cycle) {
+    return lfrfid_raw_file_write_header_version(
+        file, LFRFID_RAW_FILE_VERSION_BLOCKS, frequency, duty_cycle, RAW_BLOCK_PAYLOAD_MAX_SIZE);
+}
+
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size) {
     size_t size;
     size = stream_write(file->stream, (uint8_t*)&buffer_size, sizeof(size_t));
@@ -73,17 +95,27 @@ bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, siz
     return true;
 }
 
+bool lfrfid_raw_file_write_blocks(LFRFIDRawFile* file, const uint8_t* data, size_t size) {
+    return stream_write(file->stream, data, size) == size;
+}
+
 bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* duty_cycle) {
     LFRFIDRawFileHeader header;
     size_t size = stream_read(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
     if(size == sizeof(LFRFIDRawFileHeader)) {
-        if(header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION) {
+        bool version_valid = header.version == LFRFID_RAW_FILE_VERSION_PAIRS ||
+                             (header.version == LFRFID_RAW_FILE_VERSION_BLOCKS &&
+                              header.max_buffer_size <= UINT16_MAX);
+        if(header.magic == LFRFID_RAW_FILE_MAGIC && version_valid) {
             *frequency = header.frequency;
             *duty_cycle = header.duty_cycle;
+            file->version = header.version;
             file->max_buffer_size = header.max_buffer_size;
+            if(file->buffer) free(file->buffer);
             file->buffer = malloc(file->max_buffer_size);
             file->buffer_size = 0;
             file->buffer_counter = 0;
+            file->decoder.count = 0;
             return true;
         } else {
             return false;
@@ -93,53 +125,116 @@ bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* d
     }
 }
 
-bool lfrfid_raw_file_read_pair(
-    LFRFIDRawFile* file,
-    uint32_t* duration,
-    uint32_t* pulse,
-    bool* pass_end) {
-    size_t length = 0;
-    if(file->buffer_counter >= file->buffer_size) {
-        if(stream_eof(file->stream)) {
-            // rewind stream and pass header
-            stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
-            if(pass_end) *pass_end = true;
-        }
+static void lfrfid_raw_file_rewind(LFRFIDRawFile* file, bool* pass_end) {
+    if(stream_eof(file->stream)) {
+        // rewind stream and pass header
+        stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
+        if(pass_end) *pass_end = true;
+    }
+}
 
-        length = stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(size_t));
-        if(length != sizeof(size_t)) {
-            FURI_LOG_E(TAG, "read pair: failed to read size");
-            return false;
-        }
+static bool lfrfid_raw_file_read_buffer(LFRFIDRawFile* file, bool* pass_end) {
+    lfrfid_raw_file_rewind(file, pass_end);
 
-        if(file->buffer_size > file->max_buffer_size) {
-            FURI_LOG_E(TAG, "read pair: buffer size is too big");
-            return false;
-        }
+    size_t length = stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(size_t));
+    if(length != sizeof(size_t)) {
+        FURI_LOG_E(TAG, "read pair: failed to read size");
+        return false;
+    }
 
-        length = stream_read(file->stream, file->buffer, file->buffer_size);
-        if(length != file->buffer_size) {
-            FURI_LOG_E(TAG, "read pair: failed to read data");
-            return false;
-        }
+    if(file->buffer_size > file->max_buffer_size) {
+        FURI_LOG_E(TAG, "read pair: buffer size is too big");
+        return false;
+    }
 
-        file->buffer_counter = 0;
+    length = stream_read(file->stream, file->buffer, file->buffer_size);
+    if(length != file->buffer_size) {
+        FURI_LOG_E(TAG, "read pair: failed to read data");
+        return false;
     }
 
-    size_t size = 0;
-    bool result = varint_pair_unpack(
-        &file->buffer[file->buffer_counter],
-        (size_t)(file->buffer_size - file->buffer_counter),
-        pulse,
-        duration,
-        &size);
+    file->buffer_counter = 0;
+    return true;
+}
 
-    if(result) {
-        file->buffer_counter += size;
-    } else {
-        FURI_LOG_E(TAG, "read pair: buffer is too small");
+static bool lfrfid_raw_file_read_block(LFRFIDRawFile* file, bool* pass_end) {
+    lfrfid_raw_file_rewind(file, pass_end);
+
+    RawBlockHeader header;
+    size_t length = stream_read(file->stream, (uint8_t*)&header, sizeof(RawBlockHeader));
+    if(length != sizeof(RawBlockHeader)) {
+        FURI_LOG_E(TAG, "read block: failed to read header");
+        return false;
+    }
+
+    if(header.size > file->max_buffer_size) {
+        FURI_LOG_E(TAG, "read block: block is too big");
+        return false;
+    }
+
+    length = stream_read(file->stream, file->buffer, header.size);
+    if(length != header.size) {
+        FURI_LOG_E(TAG, "read block: failed to read data");
         return false;
     }
 
+    if(!raw_block_decoder_start(&file->decoder, &header, file->buffer)) {
+        FURI_LOG_E(TAG, "read block: malformed header");
+        return false;
+    }
+
+    if(header.lost) {
+        FURI_LOG_W(TAG, "read block: %u pairs lost during capture", header.lost);
+    }
+
     return true;
-}
\ No newline at end of file
+}
+
+size_t lfrfid_raw_file_read_pairs(
+    LFRFIDRawFile* file,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t count,
+    bool* pass_end) {
+    size_t index = 0;
+
+    if(file->version == LFRFID_RAW_FILE_VERSION_BLOCKS) {
+        while(index < count) {
+            if(raw_block_decoder_next(&file->decoder, &pulse[index], &duration[index])) {
+                index++;
+            } else if(!lfrfid_raw_file_read_block(file, pass_end)) {
+                break;
+            }
+        }
+    } else {
+        while(index < count) {
+            if(file->buffer_counter >= file->buffer_size) {
+                if(!lfrfid_raw_file_read_buffer(file, pass_end)) break;
+            }
+
+            size_t size = 0;
+            if(!varint_pair_unpack(
+                   &file->buffer[file->buffer_counter],
+                   (size_t)(file->buffer_size - file->buffer_counter),
+                   &pulse[index],
+                   &duration[index],
+                   &size)) {
+                FURI_LOG_E(TAG, "read pair: buffer is too small");
+                break;
+            }
+
+            file->buffer_counter += size;
+            index++;
+        }
+    }
+
+    return index;
+}
+
+bool lfrfid_raw_file_read_pair(
+    LFRFIDRawFile* file,
+    uint32_t* duration,
+    uint32_t* pulse,
+    bool* pass_end) {
+    return lfrfid_raw_file_read_pairs(file, duration, pulse, 1, pass_end) == 1;
+}
@@ -41,7 +41,9 @@ bool lfrfid_raw_file_open_write(LFRFIDRawFile* file, const char* file_path);
 bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path);
 
 /**
- * @brief Write RAW file header
+ * @brief Write RAW file header, varint pairs format
+ * 
+ * Data must be written with lfrfid_raw_file_write_buffer().
  * 
  * @param file 
  * @param frequency 
@@ -65,6 +67,28 @@ bool lfrfid_raw_file_write_header(
  */
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size);
 
+/**
+ * @brief Write RAW file header, block format
+ * 
+ * Data must be written with lfrfid_raw_file_write_blocks().
+ * 
+ * @param file 
+ * @param frequency 
+ * @param duty_cycle 
+ * @return bool 
+ */
+bool lfrfid_raw_file_write_blocks_header(LFRFIDRawFile* file, float frequency, float duty_cycle);
+
+/**
+ * @brief Write encoded blocks to RAW file, see tools/raw_block.h
+ * 
+ * @param file 
+ * @param data one or more complete blocks
+ * @param size 
+ * @return bool 
+ */
+bool lfrfid_raw_file_write_blocks(LFRFIDRawFile* file, const uint8_t* data, size_t size);
+
 /**
  * @brief Read RAW file header
  * 
@@ -76,7 +100,7 @@ bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, siz
 bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* duty_cycle);
 
 /**
- * @brief Read varint-encoded pair from RAW file
+ * @brief Read pair from RAW file of any format
  * 
  * @param file 
  * @param duration 
@@ -90,6 +114,23 @@ bool lfrfid_raw_file_read_pair(
     uint32_t* pulse,
     bool* pass_end);
 
+/**
+ * @brief Read pairs from RAW file of any format
+ * 
+ * @param file 
+ * @param duration array of count elements
+ * @param pulse array of count elements
+ * @param count 
+ * @param pass_end file was wrapped around, can be NULL
+ * @return size_t pairs read, less than count on error
+ */
+size_t lfrfid_raw_file_read_pairs(
+    LFRFIDRawFile* file,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t count,
+    bool* pass_end);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,12 +5,14 @@
 #include "lfrfid_raw_worker.h"
 #include "lfrfid_raw_file.h"
 #include "tools/varint_pair.h"
+#include "tools/raw_block.h"
 
 #define EMULATE_BUFFER_SIZE 1024
 #define RFID_DATA_BUFFER_SIZE 2048
 #define READ_DATA_BUFFER_COUNT 4
 
 #define TAG_EMULATE "RawEmulate"
+#define TAG_READ "RawRead"
 
 // emulate mode
 typedef struct {
@@ -31,10 +33,34 @@ typedef enum {
 
 // read mode
 #define READ_TEMP_DATA_SIZE 10
+#define READ_WRITE_BUFFER_SIZE 4096
+#define READ_WRITE_BUFFER_COUNT 2
+// write buffer is sent to SD card when less than this is left for the next block
+#define READ_BLOCK_MIN_SIZE 256
+// 2us, well below capture jitter
+#define READ_QUANTUM_SHIFT 1
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+} LFRFIDRawWriteBuffer;
 
 typedef struct {
     BufferStream* stream;
     VarintPair* pair;
+
+    // blocks are encoded into one write buffer while the other one is being written
+    LFRFIDRawFile* file;
+    FuriThread* writer;
+    FuriMessageQueue* free_buffers;
+    FuriMessageQueue* full_buffers;
+    LFRFIDRawWriteBuffer buffers[READ_WRITE_BUFFER_COUNT];
+    volatile bool write_error;
+
+    LFRFIDRawWriteBuffer* current;
+    RawBlockEncoder encoder;
+    uint32_t lost;
+    uint32_t lost_total;
 } LFRFIDRawWorkerReadData;
 
 // main worker
@@ -130,6 +156,89 @@ static void lfrfid_raw_worker_capture(bool level, uint32_t duration, void* conte
     }
 }
 
+static int32_t lfrfid_raw_read_writer_thread(void* context) {
+    LFRFIDRawWorkerReadData* data = context;
+    LFRFIDRawWriteBuffer* buffer;
+
+    while(furi_message_queue_get(data->full_buffers, &buffer, FuriWaitForever) == FuriStatusOk) {
+        // NULL is sent when capture is stopped
+        if(buffer == NULL) break;
+
+        if(!data->write_error &&
+           !lfrfid_raw_file_write_blocks(data->file, buffer->data, buffer->size)) {
+            data->write_error = true;
+        }
+
+        buffer->size = 0;
+        furi_check(furi_message_queue_put(data->free_buffers, &buffer, 0) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+static void lfrfid_raw_read_block_start(LFRFIDRawWorkerReadData* data) {
+    if(data->current == NULL &&
+       furi_message_queue_get(data->free_buffers, &data->current, 0) != FuriStatusOk) {
+        // both buffers are waiting for SD card
+        data->current = NULL;
+        return;
+    }
+
+    raw_block_encoder_start(
+        &data->encoder,
+        &data->current->data[data->current->size],
+        READ_WRITE_BUFFER_SIZE - data->current->size,
+        READ_QUANTUM_SHIFT,
+        data->lost);
+    data->lost = 0;
+}
+
+static void lfrfid_raw_read_block_finish(LFRFIDRawWorkerReadData* data, bool flush) {
+    data->current->size += raw_block_encoder_finish(&data->encoder);
+
+    if(flush || READ_WRITE_BUFFER_SIZE - data->current->size < READ_BLOCK_MIN_SIZE) {
+        if(data->current->size) {
+            furi_check(
+                furi_message_queue_put(data->full_buffers, &data->current, 0) == FuriStatusOk);
+        } else {
+            furi_check(
+                furi_message_queue_put(data->free_buffers, &data->current, 0) == FuriStatusOk);
+        }
+        data->current = NULL;
+    }
+}
+
+static void
+    lfrfid_raw_read_push(LFRFIDRawWorkerReadData* data, uint32_t pulse, uint32_t duration) {
+    if(data->current == NULL) {
+        lfrfid_raw_read_block_start(data);
+    }
+
+    if(data->current != NULL && !raw_block_encoder_push(&data->encoder, pulse, duration)) {
+        lfrfid_raw_read_block_finish(data, false);
+        lfrfid_raw_read_block_start(data);
+        if(data->current != NULL) {
+            furi_check(raw_block_encoder_push(&data->encoder, pulse, duration));
+        }
+    }
+
+    if(data->current == NULL) {
+        data->lost++;
+        data->lost_total++;
+    }
+}
+
+static void lfrfid_raw_read_encode(LFRFIDRawWorkerReadData* data, uint8_t* pairs, size_t size) {
+    size_t index = 0;
+    while(index < size) {
+        uint32_t pulse, duration;
+        size_t length = 0;
+        if(!varint_pair_unpack(&pairs[index], size - index, &pulse, &duration, &length)) break;
+        lfrfid_raw_read_push(data, pulse, duration);
+        index += length;
+    }
+}
+
 static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
     LFRFIDRawWorker* worker = (LFRFIDRawWorker*)thread_context;
 
@@ -143,13 +252,34 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
     data->stream = buffer_stream_alloc(RFID_DATA_BUFFER_SIZE, READ_DATA_BUFFER_COUNT);
     data->pair = varint_pair_alloc();
 
+    data->file = file;
+    data->free_buffers =
+        furi_message_queue_alloc(READ_WRITE_BUFFER_COUNT, sizeof(LFRFIDRawWriteBuffer*));
+    // one more for stop message
+    data->full_buffers =
+        furi_message_queue_alloc(READ_WRITE_BUFFER_COUNT + 1, sizeof(LFRFIDRawWriteBuffer*));
+    for(size_t i = 0; i < READ_WRITE_BUFFER_COUNT; i++) {
+        LFRFIDRawWriteBuffer* buffer = &data->buffers[i];
+        buffer->data = malloc(READ_WRITE_BUFFER_SIZE);
+        buffer->size = 0;
+        furi_message_queue_put(data->free_buffers, &buffer, 0);
+    }
+    data->write_error = false;
+    data->current = NULL;
+    data->lost = 0;
+    data->lost_total = 0;
+    data->writer =
+        furi_thread_alloc_ex("LfrfidRawWriter", 2048, lfrfid_raw_read_writer_thread, data);
+
     if(file_valid) {
         // write header
-        file_valid = lfrfid_raw_file_write_header(
-            file, worker->frequency, worker->duty_cycle, RFID_DATA_BUFFER_SIZE);
+        file_valid =
+            lfrfid_raw_file_write_blocks_header(file, worker->frequency, worker->duty_cycle);
     }
 
     if(file_valid) {
+        furi_thread_start(data->writer);
+
         // setup carrier
         furi_hal_rfid_tim_read_start(worker->frequency, worker->duty_cycle);
 
@@ -163,12 +293,12 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
             Buffer* buffer = buffer_stream_receive(data->stream, 100);
 
             if(buffer != NULL) {
-                file_valid = lfrfid_raw_file_write_buffer(
-                    file, buffer_get_data(buffer), buffer_get_size(buffer));
+                lfrfid_raw_read_encode(data, buffer_get_data(buffer), buffer_get_size(buffer));
                 buffer_reset(buffer);
             }
 
-            if(!file_valid) {
+            if(data->write_error) {
+                file_valid = false;
                 if(worker->read_callback != NULL) {
                     // message file_error to worker
                     worker->read_callback(LFRFIDWorkerReadRawFileError, worker->context);
@@ -176,7 +306,7 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
                 break;
             }
 
-            if(buffer_stream_get_overrun_count(data->stream) > 0 &&
+            if((buffer_stream_get_overrun_count(data->stream) > 0 || data->lost_total > 0) &&
                worker->read_callback != NULL) {
                 // message overrun to worker
                 worker->read_callback(LFRFIDWorkerReadRawOverrun, worker->context);
@@ -190,6 +320,17 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
 
         furi_hal_rfid_tim_read_capture_stop();
         furi_hal_rfid_tim_read_stop();
+
+        if(data->current != NULL) {
+            lfrfid_raw_read_block_finish(data, true);
+        }
+        LFRFIDRawWriteBuffer* stop = NULL;
+        furi_message_queue_put(data->full_buffers, &stop, FuriWaitForever);
+        furi_thread_join(data->writer);
+
+        if(data->lost_total) {
+            FURI_LOG_W(TAG_READ, "pairs lost: %lu", data->lost_total);
+        }
     } else {
         if(worker->read_callback != NULL) {
             // message file_error to worker
@@ -209,6 +350,12 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
         }
     }
 
+    furi_thread_free(data->writer);
+    for(size_t i = 0; i < READ_WRITE_BUFFER_COUNT; i++) {
+        free(data->buffers[i].data);
+    }
+    furi_message_queue_free(data->full_buffers);
+    furi_message_queue_free(data->free_buffers);
     varint_pair_free(data->pair);
     buffer_stream_free(data->stream);
     lfrfid_raw_file_free(file);
@@ -228,6 +375,24 @@ static void rfid_emulate_dma_isr(bool half, void* context) {
     }
 }
 
+static bool lfrfid_raw_emulate_fill(
+    LFRFIDRawFile* file,
+    uint32_t* buffer_arr,
+    uint32_t* buffer_ccr,
+    size_t count) {
+    if(lfrfid_raw_file_read_pairs(file, buffer_arr, buffer_ccr, count, NULL) != count) {
+        return false;
+    }
+
+    // us to carrier periods
+    for(size_t i = 0; i < count; i++) {
+        buffer_arr[i] = buffer_arr[i] / 8 - 1;
+        buffer_ccr[i] /= 8;
+    }
+
+    return true;
+}
+
 static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
     LFRFIDRawWorker* worker = thread_context;
 
@@ -247,14 +412,8 @@ static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
         file_valid = lfrfid_raw_file_read_header(file, &worker->frequency, &worker->duty_cycle);
         if(!file_valid) break;
 
-        for(size_t i = 0; i < EMULATE_BUFFER_SIZE; i++) {
-            file_valid = lfrfid_raw_file_read_pair(
-                file, &data->emulate_buffer_arr[i], &data->emulate_buffer_ccr[i], NULL);
-            if(!file_valid) break;
-            data->emulate_buffer_arr[i] /= 8;
-            data->emulate_buffer_arr[i] -= 1;
-            data->emulate_buffer_ccr[i] /= 8;
-        }
+        file_valid = lfrfid_raw_emulate_fill(
+            file, data->emulate_buffer_arr, data->emulate_buffer_ccr, EMULATE_BUFFER_SIZE);
     } while(false);
 
     furi_hal_rfid_tim_emulate_dma_start(
@@ -282,17 +441,11 @@ static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
                     start = (EMULATE_BUFFER_SIZE / 2);
                 }
 
-                for(size_t i = 0; i < (EMULATE_BUFFER_SIZE / 2); i++) {
-                    file_valid = lfrfid_raw_file_read_pair(
-                        file,
-                        &data->emulate_buffer_arr[start + i],
-                        &data->emulate_buffer_ccr[start + i],
-                        NULL);
-                    if(!file_valid) break;
-                    data->emulate_buffer_arr[i] /= 8;
-                    data->emulate_buffer_arr[i] -= 1;
-                    data->emulate_buffer_ccr[i] /= 8;
-                }
+                file_valid = lfrfid_raw_emulate_fill(
+                    file,
+                    &data->emulate_buffer_arr[start],
+                    &data->emulate_buffer_ccr[start],
+                    EMULATE_BUFFER_SIZE / 2);
             } else if(size != 0) {
                 data->ctx.overrun_count++;
             }
@@ -0,0 +1,162 @@
+#include "raw_block.h"
+#include <string.h>
+#include <toolbox/varint.h>
+
+#define RAW_BLOCK_SHIFT_MAX 15
+#define RAW_BLOCK_VARINT_MAX_SIZE 5
+
+// short pair: 0PPPDDDD, pulse and duration deltas in a single byte
+#define RAW_BLOCK_SHORT_PULSE_MAX 8
+#define RAW_BLOCK_SHORT_DURATION_MAX 16
+// long pair: 1CPPPPPP, C - more pulse delta bits follow as varint, then duration delta varint
+#define RAW_BLOCK_LONG_FLAG 0x80
+#define RAW_BLOCK_LONG_CONTINUE 0x40
+#define RAW_BLOCK_LONG_PULSE_MASK 0x3F
+#define RAW_BLOCK_LONG_PULSE_BITS 6
+
+static uint32_t raw_block_quantize(uint32_t value, uint8_t shift) {
+    if(!shift) return value;
+    // round to nearest without overflowing
+    return (value >> shift) + ((value >> (shift - 1)) & 1);
+}
+
+static uint32_t raw_block_zigzag(uint32_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 31));
+}
+
+static uint32_t raw_block_unzigzag(uint32_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+void raw_block_encoder_start(
+    RawBlockEncoder* encoder,
+    uint8_t* data,
+    size_t capacity,
+    uint8_t shift,
+    uint32_t lost) {
+    encoder->data = data;
+    encoder->capacity = capacity;
+    if(encoder->capacity > sizeof(RawBlockHeader) + RAW_BLOCK_PAYLOAD_MAX_SIZE) {
+        encoder->capacity = sizeof(RawBlockHeader) + RAW_BLOCK_PAYLOAD_MAX_SIZE;
+    }
+    encoder->size = sizeof(RawBlockHeader);
+    encoder->count = 0;
+    encoder->lost = lost > UINT16_MAX ? UINT16_MAX : lost;
+    encoder->shift = shift > RAW_BLOCK_SHIFT_MAX ? RAW_BLOCK_SHIFT_MAX : shift;
+    encoder->last_pulse = 0;
+    encoder->last_duration = 0;
+}
+
+bool raw_block_encoder_push(RawBlockEncoder* encoder, uint32_t pulse, uint32_t duration) {
+    if(encoder->size + RAW_BLOCK_PAIR_MAX_SIZE > encoder->capacity ||
+       encoder->count == UINT16_MAX) {
+        return false;
+    }
+
+    pulse = raw_block_quantize(pulse, encoder->shift);
+    duration = raw_block_quantize(duration, encoder->shift);
+
+    uint32_t pulse_delta = raw_block_zigzag(pulse - encoder->last_pulse);
+    uint32_t duration_delta = raw_block_zigzag(duration - encoder->last_duration);
+
+    uint8_t* output = &encoder->data[encoder->size];
+    if(pulse_delta < RAW_BLOCK_SHORT_PULSE_MAX && duration_delta < RAW_BLOCK_SHORT_DURATION_MAX) {
+        *output++ = pulse_delta << 4 | duration_delta;
+    } else {
+        uint32_t pulse_high = pulse_delta >> RAW_BLOCK_LONG_PULSE_BITS;
+        *output++ = RAW_BLOCK_LONG_FLAG | (pulse_high ? RAW_BLOCK_LONG_CONTINUE : 0) |
+                    (pulse_delta & RAW_BLOCK_LONG_PULSE_MASK);
+        if(pulse_high) output += varint_uint32_pack(pulse_high, output);
+        output += varint_uint32_pack(duration_delta, output);
+    }
+
+    encoder->size = output - encoder->data;
+    encoder->count++;
+    encoder->last_pulse = pulse;
+    encoder->last_duration = duration;
+    return true;
+}
+
+size_t raw_block_encoder_finish(RawBlockEncoder* encoder) {
+    if(!encoder->count) return 0;
+
+    RawBlockHeader header = {
+        .size = encoder->size - sizeof(RawBlockHeader),
+        .count = encoder->count,
+        .shift = encoder->shift,
+        .reserved = 0,
+        .lost = encoder->lost,
+    };
+    memcpy(encoder->data, &header, sizeof(RawBlockHeader));
+
+    return encoder->size;
+}
+
+bool raw_block_decoder_start(
+    RawBlockDecoder* decoder,
+    const RawBlockHeader* header,
+    const uint8_t* payload) {
+    // every pair takes at least one byte
+    if(!header->count || header->shift > RAW_BLOCK_SHIFT_MAX || header->size < header->count ||
+       header->size > header->count * RAW_BLOCK_PAIR_MAX_SIZE) {
+        return false;
+    }
+
+    decoder->data = payload;
+    decoder->size = header->size;
+    decoder->position = 0;
+    decoder->count = header->count;
+    decoder->shift = header->shift;
+    decoder->last_pulse = 0;
+    decoder->last_duration = 0;
+    return true;
+}
+
+static bool raw_block_decoder_read(RawBlockDecoder* decoder, uint32_t* value) {
+    size_t available = decoder->size - decoder->position;
+    if(available > RAW_BLOCK_VARINT_MAX_SIZE) available = RAW_BLOCK_VARINT_MAX_SIZE;
+
+    // varint_uint32_unpack reports one byte more than available on truncated input
+    size_t length = varint_uint32_unpack(value, &decoder->data[decoder->position], available);
+    if(length > available) return false;
+
+    decoder->position += length;
+    return true;
+}
+
+bool raw_block_decoder_next(RawBlockDecoder* decoder, uint32_t* pulse, uint32_t* duration) {
+    if(!decoder->count) return false;
+
+    if(decoder->position >= decoder->size) {
+        decoder->count = 0;
+        return false;
+    }
+
+    uint8_t token = decoder->data[decoder->position++];
+    uint32_t pulse_delta, duration_delta;
+    if(!(token & RAW_BLOCK_LONG_FLAG)) {
+        pulse_delta = token >> 4;
+        duration_delta = token & 0x0F;
+    } else {
+        pulse_delta = token & RAW_BLOCK_LONG_PULSE_MASK;
+        uint32_t pulse_high = 0;
+        if((token & RAW_BLOCK_LONG_CONTINUE) && !raw_block_decoder_read(decoder, &pulse_high)) {
+            decoder->count = 0;
+            return false;
+        }
+        pulse_delta |= pulse_high << RAW_BLOCK_LONG_PULSE_BITS;
+
+        if(!raw_block_decoder_read(decoder, &duration_delta)) {
+            decoder->count = 0;
+            return false;
+        }
+    }
+
+    decoder->last_pulse += raw_block_unzigzag(pulse_delta);
+    decoder->last_duration += raw_block_unzigzag(duration_delta);
+    decoder->count--;
+
+    *pulse = decoder->last_pulse << decoder->shift;
+    *duration = decoder->last_duration << decoder->shift;
+    return true;
+}
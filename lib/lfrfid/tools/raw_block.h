@@ -0,0 +1,114 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Block of captured pulse/duration pairs, used by RAW file version 2.
+ *
+ * Each block starts with RawBlockHeader followed by the payload. Every pair
+ * is quantized to 1 << shift us and stored as zigzag encoded pulse and
+ * duration deltas from the previous pair of the same block: in a single byte
+ * when both deltas are small, as varints otherwise. Blocks are independent of
+ * each other, so a damaged or dropped block does not affect the rest of the
+ * capture.
+ */
+
+/** Maximum payload size of a block */
+#define RAW_BLOCK_PAYLOAD_MAX_SIZE 1024
+/** Maximum size of an encoded pair */
+#define RAW_BLOCK_PAIR_MAX_SIZE 10
+
+typedef struct {
+    uint16_t size; /**< Payload size */
+    uint16_t count; /**< Pairs in block */
+    uint8_t shift; /**< Quantum, 1 << shift us */
+    uint8_t reserved;
+    uint16_t lost; /**< Pairs dropped right before this block, saturated */
+} RawBlockHeader;
+
+typedef struct {
+    uint8_t* data;
+    size_t capacity;
+    size_t size;
+    uint16_t count;
+    uint16_t lost;
+    uint8_t shift;
+    uint32_t last_pulse;
+    uint32_t last_duration;
+} RawBlockEncoder;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    uint16_t count;
+    uint8_t shift;
+    uint32_t last_pulse;
+    uint32_t last_duration;
+} RawBlockDecoder;
+
+/**
+ * @brief Start a new block
+ *
+ * @param encoder RawBlockEncoder instance
+ * @param data block buffer, header included
+ * @param capacity block buffer size, at least header and one pair
+ * @param shift quantum, 1 << shift us
+ * @param lost pairs dropped before this block
+ */
+void raw_block_encoder_start(
+    RawBlockEncoder* encoder,
+    uint8_t* data,
+    size_t capacity,
+    uint8_t shift,
+    uint32_t lost);
+
+/**
+ * @brief Add pair to block
+ *
+ * @param encoder RawBlockEncoder instance
+ * @param pulse pulse duration, us
+ * @param duration pulse and space duration, us
+ * @return bool false if block is full, pair is not added
+ */
+bool raw_block_encoder_push(RawBlockEncoder* encoder, uint32_t pulse, uint32_t duration);
+
+/**
+ * @brief Write block header
+ *
+ * @param encoder RawBlockEncoder instance
+ * @return size_t block size, header included, 0 if block has no pairs
+ */
+size_t raw_block_encoder_finish(RawBlockEncoder* encoder);
+
+/**
+ * @brief Validate header and start decoding block payload
+ *
+ * @param decoder RawBlockDecoder instance
+ * @param header block header
+ * @param payload block payload, header->size bytes
+ * @return bool false if header is malformed
+ */
+bool raw_block_decoder_start(
+    RawBlockDecoder* decoder,
+    const RawBlockHeader* header,
+    const uint8_t* payload);
+
+/**
+ * @brief Get next pair from block
+ *
+ * @param decoder RawBlockDecoder instance
+ * @param pulse pulse duration, us
+ * @param duration pulse and space duration, us
+ * @return bool false if there are no more pairs or payload is malformed
+ */
+bool raw_block_decoder_next(RawBlockDecoder* decoder, uint32_t* pulse, uint32_t* duration);
+
+#ifdef __cplusplus
+}
+#endif
@@ -26,6 +26,35 @@
 #include <sys/stat.h>
 #endif
 
+char* cs_bcode_cache_load(const char* path, const char* src, size_t src_len, size_t* bcode_len)
+    WEAK;
+char* cs_bcode_cache_load(const char* path, const char* src, size_t src_len, size_t* bcode_len) {
+    (void)path;
+    (void)src;
+    (void)src_len;
+    (void)bcode_len;
+    return NULL;
+}
+
+void cs_bcode_cache_store(
+    const char* path,
+    const char* src,
+    size_t src_len,
+    const char* bcode,
+    size_t bcode_len) WEAK;
+void cs_bcode_cache_store(
+    const char* path,
+    const char* src,
+    size_t src_len,
+    const char* bcode,
+    size_t bcode_len) {
+    (void)path;
+    (void)src;
+    (void)src_len;
+    (void)bcode;
+    (void)bcode_len;
+}
+
 #ifdef CS_MMAP
 char* cs_read_file(const char* path, size_t* size) WEAK;
 char* cs_read_file(const char* path, size_t* size) {
@@ -33,6 +33,22 @@ extern "C" {
  */
 char *cs_read_file(const char *path, size_t *size);
 
+/*
+ * Look up compiled bytecode of the source `src` loaded from `path` in
+ * persistent cache. It is responsibility of the caller to `free()` returned
+ * memory. Bytecode size is returned in `bcode_len`.
+ * Return: allocated memory, or NULL on cache miss.
+ */
+char *cs_bcode_cache_load(const char *path, const char *src, size_t src_len,
+                          size_t *bcode_len);
+
+/*
+ * Store compiled bytecode of the source `src` loaded from `path` in
+ * persistent cache.
+ */
+void cs_bcode_cache_store(const char *path, const char *src, size_t src_len,
+                          const char *bcode, size_t bcode_len);
+
 #ifdef CS_MMAP
 /*
  * Only on platforms which support mmapping: mmap file `path` to the returned
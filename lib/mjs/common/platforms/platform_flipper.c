@@ -1,8 +1,146 @@
 #include <furi.h>
 #include <toolbox/stream/file_stream.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/version.h>
 #include "../cs_dbg.h"
+#include "../cs_file.h"
 #include "../frozen/frozen.h"
 
+#define TAG "MjsCache"
+
+#define CS_BCODE_CACHE_DIR EXT_PATH(".tmp/js_cache")
+#define CS_BCODE_CACHE_MAGIC (0x43534A4DUL) /* "MJSC" */
+#define CS_BCODE_CACHE_VERSION (1U)
+#define CS_BCODE_CACHE_MAX_SIZE (64U * 1024U)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    /* Bytecode format may change with any firmware update */
+    uint32_t firmware_crc;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t source_crc;
+    uint32_t bcode_size;
+    uint32_t bcode_crc;
+} CsBcodeCacheHeader;
+
+static void cs_bcode_cache_get_path(FuriString* cache_path, const char* path) {
+    furi_string_printf(
+        cache_path,
+        "%s/%08lX.jsc",
+        CS_BCODE_CACHE_DIR,
+        crc32_calc_buffer(0, path, strlen(path)));
+}
+
+static void cs_bcode_cache_make_header(
+    CsBcodeCacheHeader* header,
+    Storage* storage,
+    const char* path,
+    const char* src,
+    size_t src_len) {
+    const char* githash = version_get_githash(NULL);
+
+    memset(header, 0, sizeof(CsBcodeCacheHeader));
+    header->magic = CS_BCODE_CACHE_MAGIC;
+    header->version = CS_BCODE_CACHE_VERSION;
+    header->firmware_crc = crc32_calc_buffer(0, githash, strlen(githash));
+    header->source_size = src_len;
+    if(storage_common_timestamp(storage, path, &header->source_timestamp) != FSE_OK) {
+        header->source_timestamp = 0;
+    }
+    header->source_crc = crc32_calc_buffer(0, src, src_len);
+}
+
+char* cs_bcode_cache_load(const char* path, const char* src, size_t src_len, size_t* bcode_len) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* cache_path = furi_string_alloc();
+    char* bcode = NULL;
+
+    do {
+        CsBcodeCacheHeader expected, header;
+        cs_bcode_cache_make_header(&expected, storage, path, src, src_len);
+
+        cs_bcode_cache_get_path(cache_path, path);
+        if(!storage_file_open(
+               file, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        expected.bcode_size = header.bcode_size;
+        expected.bcode_crc = header.bcode_crc;
+        if(memcmp(&expected, &header, sizeof(header)) != 0) {
+            FURI_LOG_D(TAG, "Stale: %s", path);
+            break;
+        }
+        if(header.bcode_size == 0 || header.bcode_size > CS_BCODE_CACHE_MAX_SIZE) break;
+
+        bcode = malloc(header.bcode_size);
+        if(storage_file_read(file, bcode, header.bcode_size) != header.bcode_size ||
+           crc32_calc_buffer(0, bcode, header.bcode_size) != header.bcode_crc) {
+            FURI_LOG_W(TAG, "Corrupted: %s", furi_string_get_cstr(cache_path));
+            free(bcode);
+            bcode = NULL;
+            break;
+        }
+
+        *bcode_len = header.bcode_size;
+        FURI_LOG_D(TAG, "Hit: %s", path);
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(cache_path);
+    furi_record_close(RECORD_STORAGE);
+
+    return bcode;
+}
+
+void cs_bcode_cache_store(
+    const char* path,
+    const char* src,
+    size_t src_len,
+    const char* bcode,
+    size_t bcode_len) {
+    if(bcode_len > CS_BCODE_CACHE_MAX_SIZE) return;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* cache_path = furi_string_alloc();
+
+    do {
+        CsBcodeCacheHeader header;
+        cs_bcode_cache_make_header(&header, storage, path, src, src_len);
+        // Source on other storage or without timestamp can't be validated
+        if(header.source_timestamp == 0) break;
+        header.bcode_size = bcode_len;
+        header.bcode_crc = crc32_calc_buffer(0, bcode, bcode_len);
+
+        if(!storage_simply_mkdir(storage, EXT_PATH(".tmp"))) break;
+        if(!storage_simply_mkdir(storage, CS_BCODE_CACHE_DIR)) break;
+
+        cs_bcode_cache_get_path(cache_path, path);
+        if(!storage_file_open(
+               file, furi_string_get_cstr(cache_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+           storage_file_write(file, bcode, bcode_len) != bcode_len) {
+            FURI_LOG_W(TAG, "Failed to write %s", furi_string_get_cstr(cache_path));
+            storage_file_close(file);
+            storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+        }
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(cache_path);
+    furi_record_close(RECORD_STORAGE);
+}
+
 char* cs_read_file(const char* path, size_t* size) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     Stream* stream = file_stream_alloc(storage);
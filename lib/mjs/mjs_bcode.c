@@ -145,3 +145,36 @@ MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs) {
 
     mjs->bcode_len += bp.data.len;
 }
+
+MJS_PRIVATE int
+    mjs_bcode_commit_compiled(struct mjs* mjs, const char* path, char* data, size_t len) {
+    struct mjs_bcode_part bp;
+    mjs_header_item_t hdr[MJS_HDR_ITEMS_CNT];
+    size_t hdr_len = 1 + sizeof(hdr);
+
+    /* Same layout as produced by mjs_parse() */
+    if(len <= hdr_len || (uint8_t)data[0] != OP_BCODE_HEADER) return 0;
+    memcpy(hdr, data + 1, sizeof(hdr));
+    if(hdr[MJS_HDR_ITEM_TOTAL_SIZE] != len - 1) return 0;
+    if(hdr[MJS_HDR_ITEM_BCODE_OFFSET] <= sizeof(hdr) ||
+       hdr[MJS_HDR_ITEM_BCODE_OFFSET] > hdr[MJS_HDR_ITEM_MAP_OFFSET] ||
+       hdr[MJS_HDR_ITEM_MAP_OFFSET] >= hdr[MJS_HDR_ITEM_TOTAL_SIZE]) {
+        return 0;
+    }
+    /* Filename is stored right after header and is used by load() */
+    if(strncmp(data + hdr_len, path, hdr[MJS_HDR_ITEM_BCODE_OFFSET] - sizeof(hdr)) != 0) {
+        return 0;
+    }
+
+    memset(&bp, 0, sizeof(bp));
+    bp.data.p = data;
+    bp.data.len = len;
+    bp.start_idx = mjs->bcode_len;
+    bp.exec_res = MJS_ERRS_CNT;
+
+    mjs_bcode_part_add(mjs, &bp);
+
+    mjs->bcode_len += bp.data.len;
+
+    return 1;
+}
@@ -98,6 +98,15 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs);
  */
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs);
 
+/*
+ * Adds previously compiled bcode of the file `path` as a next bcode part,
+ * takes ownership of `data` on success.
+ *
+ * Returns 0 if bcode is malformed or was compiled from another file.
+ */
+MJS_PRIVATE int
+    mjs_bcode_commit_compiled(struct mjs* mjs, const char* path, char* data, size_t len);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -56,6 +56,8 @@ void mjs_destroy(struct mjs* mjs) {
     mbuf_free(&mjs->arg_stack);
     mbuf_free(&mjs->owned_strings);
     mbuf_free(&mjs->foreign_strings);
+    mbuf_free(&mjs->interned_strings);
+    free(mjs->interned_index);
     mbuf_free(&mjs->owned_values);
     mbuf_free(&mjs->scopes);
     mbuf_free(&mjs->loop_addresses);
@@ -79,6 +81,7 @@ struct mjs* mjs_create(void* context) {
     mbuf_init(&mjs->arg_stack, 0);
     mbuf_init(&mjs->owned_strings, 0);
     mbuf_init(&mjs->foreign_strings, 0);
+    mbuf_init(&mjs->interned_strings, 0);
     mbuf_init(&mjs->bcode_gen, 0);
     mbuf_init(&mjs->bcode_parts, 0);
     mbuf_init(&mjs->owned_values, 0);
@@ -420,3 +423,7 @@ MJS_PRIVATE void mjs_push(struct mjs* mjs, mjs_val_t v) {
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc) {
     mjs->generate_jsc = generate_jsc;
 }
+
+MJS_PRIVATE size_t mjs_get_parse_cnt(struct mjs* mjs) {
+    return mjs->parse_cnt;
+}
@@ -38,6 +38,16 @@ struct mjs_vals {
     mjs_val_t last_getprop_obj;
 };
 
+#if MJS_MEMORY_STATS
+struct mjs_gc_stats {
+    unsigned long runs; /* number of collections */
+    unsigned long full_runs; /* of which full ones */
+    unsigned long total_time; /* cumulative pause time, MJS_GC_CLOCK units */
+    unsigned long max_pause; /* longest pause, MJS_GC_CLOCK units */
+    size_t strings_peak; /* peak size of owned strings buffer */
+};
+#endif
+
 struct mjs_bcode_part {
     /* Global index of the bcode part */
     size_t start_idx;
@@ -71,6 +81,10 @@ struct mjs {
     struct mbuf loop_addresses; /* Addresses for breaks & continues */
     struct mbuf owned_strings; /* Sequence of (varint len, char data[]) */
     struct mbuf foreign_strings; /* Sequence of (varint len, char *data) */
+    struct mbuf interned_strings; /* Same as owned_strings, never collected */
+    mjs_val_t* interned_index; /* Hash table of interned strings */
+    size_t interned_index_size;
+    size_t interned_cnt;
     struct mbuf owned_values;
     struct mbuf json_visited_stack;
     struct mbuf array_buffers;
@@ -82,6 +96,7 @@ struct mjs {
     void* dlsym_handle;
     ffi_cb_args_t* ffi_cb_args; /* List of FFI args descriptors */
     size_t cur_bcode_offset;
+    size_t parse_cnt; /* Number of sources parsed, cached bcode is not counted */
     mjs_flags_poller_t exec_flags_poller;
     void* context;
 
@@ -89,6 +104,10 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+#if MJS_MEMORY_STATS
+    struct mjs_gc_stats gc_stats;
+#endif
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
@@ -130,6 +149,12 @@ MJS_PRIVATE mjs_val_t mjs_pop(struct mjs* mjs);
 MJS_PRIVATE void mjs_push(struct mjs* mjs, mjs_val_t v);
 MJS_PRIVATE void mjs_die(struct mjs* mjs);
 
+/*
+ * Returns number of sources parsed by the instance. Scripts loaded from the
+ * bytecode cache are not counted. Not part of SDK, used by tests.
+ */
+MJS_PRIVATE size_t mjs_get_parse_cnt(struct mjs* mjs);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -257,8 +257,10 @@ const char* mjs_get_stack_trace(struct mjs* mjs);
  * Sets whether *.jsc files are generated when *.js file is executed. By
  * default it's 0.
  *
- * If either `MJS_GENERATE_JSC` or `CS_MMAP` is off, then this function has no
- * effect.
+ * If either `MJS_GENERATE_JSC` or `CS_MMAP` is off, compiled bytecode is
+ * passed to `cs_bcode_cache_store()` instead, and `mjs_exec_file()` tries
+ * `cs_bcode_cache_load()` before parsing the source. Platform decides how
+ * cache entries are stored and validated against the source.
  */
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc);
 
@@ -220,6 +220,9 @@ static int check_equal(struct mjs* mjs, mjs_val_t a, mjs_val_t b) {
      * false
      */
         ret = 0;
+    } else if(mjs_is_interned_string(a) && mjs_is_interned_string(b)) {
+        /* Interned strings are unique, different values mean different content */
+        ret = 0;
     } else if(mjs_is_string(a) && mjs_is_string(b)) {
         ret = s_cmp(mjs, a, b) == 0;
     } else if(mjs_is_foreign(a) && b == MJS_NULL) {
@@ -784,7 +787,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             break;
         case OP_PUSH_STR: {
             int llen, n = cs_varint_decode_unsafe(&code[i + 1], &llen);
-            mjs_push(mjs, mjs_mk_string(mjs, (char*)code + i + 1 + llen, n, 1));
+            mjs_push(mjs, mjs_mk_interned_string(mjs, (char*)code + i + 1 + llen, n));
             i += llen + n;
             break;
         }
@@ -916,7 +919,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             int llen1, llen2, n, arg_no = cs_varint_decode_unsafe(&code[i + 1], &llen1);
             mjs_val_t obj, key, v;
             n = cs_varint_decode_unsafe(&code[i + llen1 + 1], &llen2);
-            key = mjs_mk_string(mjs, (char*)code + i + 1 + llen1 + llen2, n, 1);
+            key = mjs_mk_interned_string(mjs, (char*)code + i + 1 + llen1 + llen2, n);
             obj = vtop(&mjs->scopes);
             v = mjs_arg(mjs, arg_no);
             mjs_set_v(mjs, obj, key, v);
@@ -1067,6 +1070,7 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
     mjs_val_t* res) {
     size_t off = mjs->bcode_len;
     mjs_val_t r = MJS_UNDEFINED;
+    mjs->parse_cnt++;
     mjs->error = mjs_parse(path, src, mjs);
 #if MJS_ENABLE_DEBUG
     if(cs_log_level >= LL_VERBOSE_DEBUG) mjs_dump(mjs, 1);
@@ -1136,7 +1140,11 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
             }
         }
 #else
-        (void)generate_jsc;
+        if(generate_jsc && path != NULL) {
+            /* Keep compiled bcode, so next run of the same file skips parsing */
+            struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+            cs_bcode_cache_store(path, src, strlen(src), bp->data.p, bp->data.len);
+        }
 #endif
 
         mjs_execute(mjs, off, &r);
@@ -1162,6 +1170,21 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     }
 
     r = MJS_UNDEFINED;
+    if(mjs->generate_jsc) {
+        size_t bcode_len = 0;
+        size_t off = mjs->bcode_len;
+        char* bcode = cs_bcode_cache_load(path, source_code, strlen(source_code), &bcode_len);
+        if(bcode != NULL && mjs_bcode_commit_compiled(mjs, path, bcode, bcode_len)) {
+            free(source_code);
+            /* Same state as after a successful mjs_parse() */
+            mjs_set_errorf(mjs, MJS_OK, NULL);
+            mjs_execute(mjs, off, &r);
+            error = mjs->error;
+            goto clean;
+        }
+        free(bcode);
+    }
+
     error = mjs_exec_internal(mjs, path, source_code, -1, &r);
     free(source_code);
 
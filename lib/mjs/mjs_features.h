@@ -14,6 +14,29 @@
 #define MJS_MEMORY_STATS 0
 #endif
 
+/*
+ * MJS_GC_CLOCK: monotonic clock expression (e.g. microseconds counter) used to
+ * collect GC pause stats when MJS_MEMORY_STATS is enabled. Pause stats are
+ * zero unless it is provided by the build.
+ */
+#if !defined(MJS_GC_CLOCK)
+#define MJS_GC_CLOCK() 0
+#endif
+
+/*
+ * MJS_GC_FREE_SPACE_DIV, MJS_GC_FREE_SPACE_MAX: after collection at least
+ * 1/MJS_GC_FREE_SPACE_DIV of each arena and of the owned strings buffer is
+ * kept free, but no more than MJS_GC_FREE_SPACE_MAX bytes each. The reserve
+ * trades peak heap for fewer collections; MJS_GC_FREE_SPACE_DIV 0 disables it.
+ */
+#if !defined(MJS_GC_FREE_SPACE_DIV)
+#define MJS_GC_FREE_SPACE_DIV 4
+#endif
+
+#if !defined(MJS_GC_FREE_SPACE_MAX)
+#define MJS_GC_FREE_SPACE_MAX 1024
+#endif
+
 /*
  * MJS_GENERATE_JSC: if enabled, and if mmapping is also enabled (CS_MMAP),
  * then execution of any .js file will result in creation of a .jsc file with
@@ -37,6 +37,24 @@
  */
 #define GC_ARENA_CELLS_RESERVE 2
 
+/*
+ * After collection part of each arena and of the owned strings buffer is kept
+ * free (see MJS_GC_FREE_SPACE_DIV). Next collection is then scheduled after a
+ * number of new allocations proportional to the surviving heap, instead of
+ * collecting on nearly every allocation when most of the heap is alive.
+ */
+static size_t gc_free_space(size_t total, size_t unit_size) {
+#if MJS_GC_FREE_SPACE_DIV > 0
+    size_t want = total / MJS_GC_FREE_SPACE_DIV;
+    size_t max = MJS_GC_FREE_SPACE_MAX / unit_size;
+    return want < max ? want : max;
+#else
+    (void)total;
+    (void)unit_size;
+    return 0;
+#endif
+}
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
 static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
@@ -166,10 +184,11 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
  * Empty blocks get deallocated. The head of the free list will contais cells
  * from the last (oldest) block. Cells will thus be allocated in block order.
  */
-void gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
+size_t gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
     struct gc_block* b;
     struct gc_cell* cur;
     struct gc_block** prevp = &a->blocks;
+    size_t free_cells = 0;
 #if MJS_MEMORY_STATS
     a->alive = 0;
 #endif
@@ -250,10 +269,42 @@ void gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
             b = *prevp;
             a->free = prev_free;
         } else {
+            free_cells += freed_in_block;
             prevp = &b->next;
             b = b->next;
         }
     }
+
+    return free_cells;
+}
+
+/* Grows the arena if less than the free space reserve of it is free */
+static void gc_arena_reserve(struct gc_arena* a, size_t free_cells) {
+    struct gc_block* b;
+    size_t total = 0, want;
+
+    for(b = a->blocks; b != NULL; b = b->next) {
+        total += b->size;
+    }
+
+    want = gc_free_space(total, a->cell_size);
+    if(free_cells < want) {
+        size_t size = want - free_cells;
+        if(size < a->size_increment) size = a->size_increment;
+
+        /* Keep the initial block at the tail */
+        b = gc_new_block(a, size);
+        b->next = a->blocks;
+        a->blocks = b;
+    }
+}
+
+/* Grows owned strings buffer if the next string would schedule GC again */
+static void gc_strings_reserve(struct mjs* mjs) {
+    struct mbuf* m = &mjs->owned_strings;
+    if(gc_strings_is_gc_needed(mjs)) {
+        mbuf_resize(m, m->len + gc_free_space(m->len, 1) + _MJS_STRING_BUF_RESERVE);
+    }
 }
 
 /* Mark an FFI signature */
@@ -485,6 +536,13 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
+#if MJS_MEMORY_STATS
+    unsigned long start = MJS_GC_CLOCK(), pause;
+    if(mjs->owned_strings.size > mjs->gc_stats.strings_peak) {
+        mjs->gc_stats.strings_peak = mjs->owned_strings.size;
+    }
+#endif
+
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
 
     gc_mark_mbuf_pt(mjs, &mjs->owned_values);
@@ -496,9 +554,9 @@ void mjs_gc(struct mjs* mjs, int full) {
 
     gc_compact_strings(mjs);
 
-    gc_sweep(mjs, &mjs->object_arena, 0);
-    gc_sweep(mjs, &mjs->property_arena, 0);
-    gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
+    gc_arena_reserve(&mjs->object_arena, gc_sweep(mjs, &mjs->object_arena, 0));
+    gc_arena_reserve(&mjs->property_arena, gc_sweep(mjs, &mjs->property_arena, 0));
+    gc_arena_reserve(&mjs->ffi_sig_arena, gc_sweep(mjs, &mjs->ffi_sig_arena, 0));
 
     if(full) {
         /*
@@ -511,6 +569,16 @@ void mjs_gc(struct mjs* mjs, int full) {
             mbuf_resize(&mjs->owned_strings, trimmed_size);
         }
     }
+
+    gc_strings_reserve(mjs);
+
+#if MJS_MEMORY_STATS
+    pause = MJS_GC_CLOCK() - start;
+    mjs->gc_stats.runs++;
+    if(full) mjs->gc_stats.full_runs++;
+    mjs->gc_stats.total_time += pause;
+    if(pause > mjs->gc_stats.max_pause) mjs->gc_stats.max_pause = pause;
+#endif
 }
 
 MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
@@ -50,6 +50,28 @@ int mjs_is_object_based(mjs_val_t v) {
            ((v & MJS_TAG_MASK) == MJS_TAG_ARRAY_BUF_VIEW);
 }
 
+/*
+ * Looks up property with a name longer than 5 chars. `key` is the interned
+ * string with the same content or MJS_UNDEFINED if there is none: names
+ * interned as well are then matched by value.
+ */
+static struct mjs_property* get_own_property_long(
+    struct mjs* mjs,
+    struct mjs_object* o,
+    mjs_val_t key,
+    const char* name,
+    size_t len) {
+    struct mjs_property* p;
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        if(p->name == key) return p;
+        if(mjs_is_interned_string(p->name)) continue;
+        if(mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
+    }
+
+    return NULL;
+}
+
 MJS_PRIVATE struct mjs_property*
     mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
     struct mjs_property* p;
@@ -61,16 +83,18 @@ MJS_PRIVATE struct mjs_property*
 
     o = get_object_struct(obj);
 
+    if(len == (size_t)~0) {
+        len = strlen(name);
+    }
+
     if(len <= 5) {
         mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
         for(p = o->properties; p != NULL; p = p->next) {
             if(p->name == ss) return p;
         }
     } else {
-        for(p = o->properties; p != NULL; p = p->next) {
-            if(mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
-        }
-        return p;
+        mjs_val_t key = mjs_find_interned_string(mjs, name, len);
+        return get_own_property_long(mjs, o, key, name, len);
     }
 
     return NULL;
@@ -82,7 +106,14 @@ MJS_PRIVATE struct mjs_property*
     char* s = NULL;
     int need_free = 0;
     struct mjs_property* p = NULL;
-    mjs_err_t err = mjs_to_string(mjs, &key, &s, &n, &need_free);
+    mjs_err_t err;
+
+    if(mjs_is_interned_string(key) && mjs_is_object_based(obj)) {
+        const char* name = mjs_get_string(mjs, &key, &n);
+        return get_own_property_long(mjs, get_object_struct(obj), key, name, n);
+    }
+
+    err = mjs_to_string(mjs, &key, &s, &n, &need_free);
     if(err == MJS_OK) {
         p = mjs_get_own_property(mjs, obj, s, n);
     }
@@ -191,7 +222,7 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
      * `name_v`, which will be a string.
      */
         if(!mjs_is_string(name_v)) {
-            name_v = mjs_mk_string(mjs, name, name_len, 1);
+            name_v = mjs_mk_interned_string(mjs, name, name_len);
         }
 
         p = mjs_mk_property(mjs, name_v, val);
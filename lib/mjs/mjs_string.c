@@ -26,6 +26,23 @@ static int runetochar(char* str, Rune* rune) {
 #define MJS_STRING_BUF_RESERVE 100
 #endif
 
+/*
+ * Strings longer than that are never interned
+ */
+#ifndef MJS_INTERNED_STRING_MAX_LEN
+#define MJS_INTERNED_STRING_MAX_LEN 64
+#endif
+
+/*
+ * Once interned strings take that many bytes, new strings are created as
+ * ordinary owned ones
+ */
+#ifndef MJS_INTERNED_STRINGS_MAX_SIZE
+#define MJS_INTERNED_STRINGS_MAX_SIZE 4096
+#endif
+
+#define MJS_INTERNED_INDEX_MIN_SIZE 32
+
 MJS_PRIVATE size_t unescape(const char* s, size_t len, char* to);
 
 MJS_PRIVATE void embed_string(
@@ -78,10 +95,6 @@ mjs_val_t mjs_mk_string(struct mjs* mjs, const char* p, size_t len, int copy) {
                 memcpy(s, p, len);
             }
             tag = MJS_TAG_STRING_5;
-            // } else if ((dict_index = v_find_string_in_dictionary(p, len)) >= 0) {
-            //   offset = 0;
-            //   GET_VAL_NAN_PAYLOAD(offset)[0] = dict_index;
-            //   tag = MJS_TAG_STRING_D;
         } else {
             if(gc_strings_is_gc_needed(mjs)) {
                 mjs->need_gc = 1;
@@ -132,6 +145,108 @@ mjs_val_t mjs_mk_string(struct mjs* mjs, const char* p, size_t len, int copy) {
     return (offset & ~MJS_TAG_MASK) | tag;
 }
 
+/*
+ * Interned strings live in a separate buffer which is never collected, each
+ * content is stored only once. Values tagged with MJS_TAG_STRING_D hold an
+ * offset into that buffer, so two interned strings are equal if and only if
+ * their values are equal. Index is an open addressing hash table of values.
+ */
+static uint32_t mjs_interned_hash(const char* p, size_t len) {
+    uint32_t h = 2166136261u;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)p[i]) * 16777619u;
+    }
+    return h;
+}
+
+static const char* mjs_interned_get(struct mjs* mjs, mjs_val_t v, size_t* len) {
+    size_t offset = (size_t)gc_string_mjs_val_to_offset(v);
+    int llen;
+    *len = cs_varint_decode_unsafe((uint8_t*)mjs->interned_strings.buf + offset, &llen);
+    return mjs->interned_strings.buf + offset + llen;
+}
+
+/*
+ * Returns index slot holding the string with given content, or the empty slot
+ * where it should be inserted
+ */
+static mjs_val_t* mjs_interned_slot(struct mjs* mjs, const char* p, size_t len) {
+    size_t mask = mjs->interned_index_size - 1;
+    size_t i = mjs_interned_hash(p, len) & mask;
+
+    for(;; i = (i + 1) & mask) {
+        mjs_val_t* slot = &mjs->interned_index[i];
+        size_t n;
+        const char* s;
+        if(*slot == 0) return slot;
+        s = mjs_interned_get(mjs, *slot, &n);
+        if(n == len && memcmp(s, p, len) == 0) return slot;
+    }
+}
+
+static void mjs_interned_index_grow(struct mjs* mjs) {
+    mjs_val_t* old_index = mjs->interned_index;
+    size_t old_size = mjs->interned_index_size;
+    size_t i;
+
+    mjs->interned_index_size = old_size ? old_size * 2 : MJS_INTERNED_INDEX_MIN_SIZE;
+    mjs->interned_index = calloc(mjs->interned_index_size, sizeof(mjs_val_t));
+
+    for(i = 0; i < old_size; i++) {
+        if(old_index[i] != 0) {
+            size_t n;
+            const char* s = mjs_interned_get(mjs, old_index[i], &n);
+            *mjs_interned_slot(mjs, s, n) = old_index[i];
+        }
+    }
+    free(old_index);
+}
+
+MJS_PRIVATE int mjs_is_interned_string(mjs_val_t v) {
+    return (v & MJS_TAG_MASK) == MJS_TAG_STRING_D;
+}
+
+MJS_PRIVATE mjs_val_t mjs_find_interned_string(struct mjs* mjs, const char* p, size_t len) {
+    mjs_val_t* slot;
+    if(mjs->interned_cnt == 0) return MJS_UNDEFINED;
+    slot = mjs_interned_slot(mjs, p, len);
+    return *slot != 0 ? *slot : MJS_UNDEFINED;
+}
+
+MJS_PRIVATE mjs_val_t mjs_mk_interned_string(struct mjs* mjs, const char* p, size_t len) {
+    struct mbuf* m = &mjs->interned_strings;
+    mjs_val_t v;
+    mjs_val_t* slot;
+
+    if(len == ~((size_t)0)) len = strlen(p);
+
+    /* Short strings are inlined anyway */
+    if(len <= 5 || len > MJS_INTERNED_STRING_MAX_LEN) {
+        return mjs_mk_string(mjs, p, len, 1);
+    }
+
+    v = mjs_find_interned_string(mjs, p, len);
+    if(v != MJS_UNDEFINED) return v;
+
+    if(m->len + len > MJS_INTERNED_STRINGS_MAX_SIZE) {
+        return mjs_mk_string(mjs, p, len, 1);
+    }
+
+    /* Keep index at most 3/4 full */
+    if((mjs->interned_cnt + 1) * 4 > mjs->interned_index_size * 3) {
+        mjs_interned_index_grow(mjs);
+    }
+
+    v = (m->len & ~MJS_TAG_MASK) | MJS_TAG_STRING_D;
+    slot = mjs_interned_slot(mjs, p, len);
+    embed_string(m, m->len, p, len, EMBSTR_ZERO_TERM);
+    *slot = v;
+    mjs->interned_cnt++;
+
+    return v;
+}
+
 /* Get a pointer to string and string length. */
 const char* mjs_get_string(struct mjs* mjs, mjs_val_t* v, size_t* sizep) {
     uint64_t tag = v[0] & MJS_TAG_MASK;
@@ -148,10 +263,8 @@ const char* mjs_get_string(struct mjs* mjs, mjs_val_t* v, size_t* sizep) {
     } else if(tag == MJS_TAG_STRING_5) {
         p = GET_VAL_NAN_PAYLOAD(*v);
         size = 5;
-        // } else if (tag == MJS_TAG_STRING_D) {
-        //   int index = ((unsigned char *) GET_VAL_NAN_PAYLOAD(*v))[0];
-        //   size = v_dictionary_strings[index].len;
-        //   p = v_dictionary_strings[index].p;
+    } else if(tag == MJS_TAG_STRING_D) {
+        p = mjs_interned_get(mjs, *v, &size);
     } else if(tag == MJS_TAG_STRING_O) {
         size_t offset = (size_t)gc_string_mjs_val_to_offset(*v);
         char* s = mjs->owned_strings.buf + offset;
@@ -247,6 +360,8 @@ MJS_PRIVATE int s_cmp(struct mjs* mjs, mjs_val_t a, mjs_val_t b) {
     size_t a_len, b_len;
     const char *a_ptr, *b_ptr;
 
+    if(a == b) return 0;
+
     a_ptr = mjs_get_string(mjs, &a, &a_len);
     b_ptr = mjs_get_string(mjs, &b, &b_len);
 
@@ -24,6 +24,21 @@ MJS_PRIVATE mjs_err_t str_to_ulong(struct mjs* mjs, mjs_val_t v, int* ok, unsign
 MJS_PRIVATE int s_cmp(struct mjs* mjs, mjs_val_t a, mjs_val_t b);
 MJS_PRIVATE mjs_val_t s_concat(struct mjs* mjs, mjs_val_t a, mjs_val_t b);
 
+/*
+ * Returns interned string with the given content, interning it if needed.
+ * Falls back to an ordinary owned string if the string is too short or too
+ * long to be interned or interned strings buffer is full.
+ */
+MJS_PRIVATE mjs_val_t mjs_mk_interned_string(struct mjs* mjs, const char* p, size_t len);
+
+/*
+ * Returns interned string with the given content or MJS_UNDEFINED if there is
+ * none. Never allocates.
+ */
+MJS_PRIVATE mjs_val_t mjs_find_interned_string(struct mjs* mjs, const char* p, size_t len);
+
+MJS_PRIVATE int mjs_is_interned_string(mjs_val_t v);
+
 MJS_PRIVATE void embed_string(
     struct mbuf* m,
     size_t offset,
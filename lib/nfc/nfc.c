@@ -4,6 +4,7 @@
 
 #include <furi_hal_nfc.h>
 #include <furi/furi.h>
+#include <toolbox/trace.h>
 
 #define TAG "Nfc"
 
@@ -470,6 +471,7 @@ NfcError
 
     NfcError ret = NfcErrorNone;
     FuriHalNfcError error = FuriHalNfcErrorNone;
+    TRACE_BEGIN(NfcPollerTrx);
     do {
         furi_hal_nfc_trx_reset();
         while(furi_hal_nfc_timer_block_tx_is_running()) {
@@ -502,6 +504,8 @@ NfcError
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
     } while(false);
 
+    TRACE_END(NfcPollerTrx);
+
     return ret;
 }
 
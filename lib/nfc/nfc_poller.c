@@ -31,6 +31,10 @@ struct NfcPoller {
 
     NfcGenericCallbackEx callback;
     void* context;
+
+    // Tail poller callback set by nfc_poller_start, restored after children detection
+    NfcGenericCallback tail_callback;
+    void* tail_context;
 };
 
 static void nfc_poller_list_alloc(NfcPoller* instance) {
@@ -125,6 +129,8 @@ void nfc_poller_start(NfcPoller* instance, NfcGenericCallback callback, void* co
 
     NfcPollerListElement* tail_poller = instance->list.tail;
     tail_poller->poller_api->set_callback(tail_poller->poller, callback, context);
+    instance->tail_callback = callback;
+    instance->tail_context = context;
 
     instance->session_state = NfcPollerSessionStateActive;
     nfc_start(instance->nfc, nfc_poller_start_callback, instance);
@@ -269,6 +275,105 @@ bool nfc_poller_detect(NfcPoller* instance) {
     return instance->protocol_detected;
 }
 
+typedef struct {
+    NfcPoller* instance;
+    const NfcProtocol* protocols;
+    NfcGenericInstance** pollers;
+    size_t protocols_num;
+    bool* detected;
+} NfcPollerDetectChildrenContext;
+
+static NfcCommand nfc_poller_detect_children_tail_callback(NfcGenericEvent event, void* context) {
+    furi_assert(context);
+
+    NfcPollerDetectChildrenContext* ctx = context;
+    for(size_t i = 0; i < ctx->protocols_num; i++) {
+        const NfcPollerBase* poller_api = nfc_pollers_api[ctx->protocols[i]];
+        ctx->detected[i] = poller_api->detect(event, ctx->pollers[i]);
+    }
+
+    return NfcCommandStop;
+}
+
+static NfcCommand nfc_poller_detect_children_idle_callback(NfcGenericEvent event, void* context) {
+    UNUSED(event);
+    UNUSED(context);
+
+    return NfcCommandStop;
+}
+
+static NfcCommand nfc_poller_detect_children_head_callback(NfcEvent event, void* context) {
+    furi_assert(context);
+
+    NfcPollerDetectChildrenContext* ctx = context;
+    NfcPollerListElement* head_poller = ctx->instance->list.head;
+
+    NfcCommand command = NfcCommandContinue;
+    NfcGenericEvent poller_event = {
+        .protocol = NfcProtocolInvalid,
+        .instance = ctx->instance->nfc,
+        .event_data = &event,
+    };
+
+    if(event.type == NfcEventTypePollerReady) {
+        command = head_poller->poller_api->run(poller_event, head_poller->poller);
+    }
+
+    return command;
+}
+
+void nfc_poller_detect_children(
+    NfcPoller* instance,
+    const NfcProtocol* protocols,
+    size_t protocols_num,
+    bool* detected) {
+    furi_assert(instance);
+    furi_assert(protocols);
+    furi_assert(protocols_num);
+    furi_assert(detected);
+    furi_assert(instance->session_state == NfcPollerSessionStateIdle);
+
+    NfcPollerListElement* tail_poller = instance->list.tail;
+    NfcGenericInstance* pollers[NfcProtocolNum] = {};
+    furi_check(protocols_num <= COUNT_OF(pollers));
+
+    for(size_t i = 0; i < protocols_num; i++) {
+        furi_check(nfc_protocol_get_parent(protocols[i]) == instance->protocol);
+        pollers[i] = nfc_pollers_api[protocols[i]]->alloc(tail_poller->poller);
+        detected[i] = false;
+    }
+
+    NfcPollerDetectChildrenContext ctx = {
+        .instance = instance,
+        .protocols = protocols,
+        .pollers = pollers,
+        .protocols_num = protocols_num,
+        .detected = detected,
+    };
+
+    // Parent chain runs in regular mode and activates the card once for all children
+    tail_poller->poller_api->set_callback(
+        tail_poller->poller, nfc_poller_detect_children_tail_callback, &ctx);
+
+    instance->session_state = NfcPollerSessionStateActive;
+    nfc_start(instance->nfc, nfc_poller_detect_children_head_callback, &ctx);
+    nfc_stop(instance->nfc);
+    instance->session_state = NfcPollerSessionStateIdle;
+
+    // Tail poller must not keep pointing to the context on this stack
+    if(instance->tail_callback) {
+        tail_poller->poller_api->set_callback(
+            tail_poller->poller, instance->tail_callback, instance->tail_context);
+    } else {
+        tail_poller->poller_api->set_callback(
+            tail_poller->poller, nfc_poller_detect_children_idle_callback, NULL);
+    }
+
+    for(size_t i = 0; i < protocols_num; i++) {
+        nfc_pollers_api[protocols[i]]->free(pollers[i]);
+    }
+}
+
 NfcProtocol nfc_poller_get_protocol(const NfcPoller* instance) {
     furi_assert(instance);
 
@@ -120,6 +120,33 @@ void nfc_poller_stop(NfcPoller* instance);
  */
 bool nfc_poller_detect(NfcPoller* instance);
 
+/**
+ * @brief Detect which of the given child protocols the card in the vicinity supports.
+ *
+ * The card is activated once with the protocol the instance was created with, then
+ * the detection routines of all child protocols run on this activation in the given order.
+ * This saves the field cycle and the activation sequence that a separate nfc_poller_detect()
+ * call would take for every child protocol.
+ *
+ * All child protocols must have the instance protocol as the immediate parent. Detection
+ * routines that leave the card halted (e.g. MfUltralight) must go last.
+ *
+ * It is used automatically inside NfcScanner, so there is usually no need
+ * to call it explicitly.
+ *
+ * @see nfc_scanner.h
+ *
+ * @param[in,out] instance pointer to the parent protocol instance to perform the detection with.
+ * @param[in] protocols pointer to the array of child protocol identifiers.
+ * @param[in] protocols_num number of child protocols, one or more.
+ * @param[out] detected pointer to the array of results, one per child protocol.
+ */
+void nfc_poller_detect_children(
+    NfcPoller* instance,
+    const NfcProtocol* protocols,
+    size_t protocols_num,
+    bool* detected);
+
 /**
  * @brief Get the protocol identifier an NfcPoller instance was created with.
  *
@@ -2,11 +2,15 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+// NXP AN10833: SAK bit 4 is set by MIFARE Classic and compatible cards
+#define NFC_SCANNER_SAK_MF_CLASSIC_BIT (1U << 3)
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -23,6 +27,12 @@ typedef enum {
     NfcScannerSessionStateStopRequest,
 } NfcScannerSessionState;
 
+typedef enum {
+    NfcScannerChildNotSupported, /**< Ruled out by the parent activation data. */
+    NfcScannerChildSupported, /**< Confirmed by the parent activation data. */
+    NfcScannerChildProbe, /**< Parent activation data is ambiguous, detection is required. */
+} NfcScannerChild;
+
 struct NfcScanner {
     Nfc* nfc;
     NfcScannerState state;
@@ -51,6 +61,8 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    Iso14443_3aData* iso14443_3a_data;
+
     FuriThread* scan_worker;
 };
 
@@ -94,6 +106,10 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        if(protocol_detected && instance->current_protocol == NfcProtocolIso14443_3a) {
+            // ATQA and SAK drive classification of ISO14443-3A children
+            iso14443_3a_copy(instance->iso14443_3a_data, nfc_poller_get_data(poller));
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -116,10 +132,58 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
     } while(false);
 }
 
+static bool nfc_scanner_is_base_detected(NfcScanner* instance, NfcProtocol protocol) {
+    bool base_detected = false;
+
+    for(size_t i = 0; i < instance->detected_base_protocols_num; i++) {
+        if(nfc_protocol_has_parent(protocol, instance->detected_base_protocols[i])) {
+            base_detected = true;
+            break;
+        }
+    }
+
+    return base_detected;
+}
+
+static NfcScannerChild nfc_scanner_classify_child(NfcScanner* instance, NfcProtocol protocol) {
+    NfcScannerChild child = NfcScannerChildProbe;
+
+    if(nfc_protocol_has_parent(protocol, NfcProtocolIso14443_3a)) {
+        const bool iso14443_4 = iso14443_3a_supports_iso14443_4(instance->iso14443_3a_data);
+        const bool mf_classic = iso14443_3a_get_sak(instance->iso14443_3a_data) &
+                                NFC_SCANNER_SAK_MF_CLASSIC_BIT;
+
+        if(protocol == NfcProtocolIso14443_4a) {
+            child = iso14443_4 ? NfcScannerChildSupported : NfcScannerChildNotSupported;
+        } else if(protocol == NfcProtocolMfClassic) {
+            child = mf_classic ? NfcScannerChildProbe : NfcScannerChildNotSupported;
+        } else if(protocol == NfcProtocolMfUltralight) {
+            // Type 2 tags report neither ISO14443-4 nor MIFARE Classic in SAK
+            child = (iso14443_4 || mf_classic) ? NfcScannerChildNotSupported :
+                                                 NfcScannerChildProbe;
+        } else if(nfc_protocol_has_parent(protocol, NfcProtocolIso14443_4a) && !iso14443_4) {
+            child = NfcScannerChildNotSupported;
+        }
+    }
+
+    return child;
+}
+
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
-    for(size_t i = 0; i < NfcProtocolNum; i++) {
-        for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
-            if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
+    size_t children_num = 0;
+
+    // Children of the same parent are kept together to be probed within a single activation
+    for(size_t parent = 0; parent < NfcProtocolNum; parent++) {
+        for(size_t i = 0; i < NfcProtocolNum; i++) {
+            if(nfc_protocol_get_parent(i) != parent) continue;
+            if(!nfc_scanner_is_base_detected(instance, i)) continue;
+            children_num++;
+
+            NfcScannerChild child = nfc_scanner_classify_child(instance, i);
+            if(child == NfcScannerChildSupported) {
+                instance->detected_protocols[instance->detected_protocols_num] = i;
+                instance->detected_protocols_num++;
+            } else if(child == NfcScannerChildProbe) {
                 instance->children_protocols[instance->children_protocols_num] = i;
                 instance->children_protocols_num++;
             }
@@ -131,25 +195,36 @@ void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     } else {
         instance->state = NfcScannerStateComplete;
     }
-    FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
+    FURI_LOG_D(
+        TAG, "Found %zu children, %zu to probe", children_num, instance->children_protocols_num);
 }
 
 void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
     furi_assert(instance->children_protocols_num);
 
-    instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
+    NfcProtocol* children = &instance->children_protocols[instance->children_protocols_idx];
+    size_t children_left = instance->children_protocols_num - instance->children_protocols_idx;
+    NfcProtocol parent_protocol = nfc_protocol_get_parent(children[0]);
+
+    size_t children_num = 1;
+    while(children_num < children_left &&
+          nfc_protocol_get_parent(children[children_num]) == parent_protocol) {
+        children_num++;
+    }
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
+    bool detected[NfcProtocolNum] = {};
+    NfcPoller* poller = nfc_poller_alloc(instance->nfc, parent_protocol);
+    nfc_poller_detect_children(poller, children, children_num, detected);
     nfc_poller_free(poller);
 
-    if(protocol_detected) {
-        instance->detected_protocols[instance->detected_protocols_num] =
-            instance->current_protocol;
-        instance->detected_protocols_num++;
+    for(size_t i = 0; i < children_num; i++) {
+        if(detected[i]) {
+            instance->detected_protocols[instance->detected_protocols_num] = children[i];
+            instance->detected_protocols_num++;
+        }
     }
 
-    instance->children_protocols_idx++;
+    instance->children_protocols_idx += children_num;
     if(instance->children_protocols_idx == instance->children_protocols_num) {
         instance->state = NfcScannerStateComplete;
     }
@@ -173,7 +248,10 @@ static void nfc_scanner_filter_detected_protocols(NfcScanner* instance) {
     }
 
     instance->detected_protocols_num = filtered_protocols_num;
-    memcpy(instance->detected_protocols, filtered_protocols, filtered_protocols_num);
+    memcpy(
+        instance->detected_protocols,
+        filtered_protocols,
+        filtered_protocols_num * sizeof(NfcProtocol));
 }
 
 void nfc_scanner_state_handler_complete(NfcScanner* instance) {
@@ -222,6 +300,7 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc) {
 
     NfcScanner* instance = malloc(sizeof(NfcScanner));
     instance->nfc = nfc;
+    instance->iso14443_3a_data = iso14443_3a_alloc();
 
     return instance;
 }
@@ -229,6 +308,7 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc) {
 void nfc_scanner_free(NfcScanner* instance) {
     furi_assert(instance);
 
+    iso14443_3a_free(instance->iso14443_3a_data);
     free(instance);
 }
 
@@ -9,6 +9,11 @@
  * a just one protocol and will try others as well until all possibilities are exhausted.
  * This is to allow for multi-protocol card support.
  *
+ * Child protocols are classified by the activation data of their base protocol where possible,
+ * e.g. ISO14443-4A and MIFARE Classic support is derived from the ISO14443-3A SAK. Only
+ * the remaining candidates are probed, all children of the same parent within a single
+ * activation of the latter.
+ *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
  */
@@ -79,6 +79,49 @@ static void mf_classic_poller_check_key_b_is_readable(
     } while(false);
 }
 
+static MfClassicKey* mf_classic_poller_get_found_key(
+    MfClassicPoller* instance,
+    uint8_t sector,
+    MfClassicKeyType key_type) {
+    MfClassicSectorTrailer* sec_tr =
+        mf_classic_get_sector_trailer_by_sector(instance->data, sector);
+    return (key_type == MfClassicKeyTypeA) ? &sec_tr->key_a : &sec_tr->key_b;
+}
+
+static bool mf_classic_poller_is_key_tried(
+    MfClassicPollerDictAttackContext* dict_attack_ctx,
+    uint8_t sector,
+    MfClassicKeyType key_type) {
+    uint64_t mask = (key_type == MfClassicKeyTypeA) ? dict_attack_ctx->key_a_tried_mask :
+                                                      dict_attack_ctx->key_b_tried_mask;
+    return FURI_BIT(mask, sector);
+}
+
+// Marks found keys equal to given one as tried, returns true if key was tried before
+static bool mf_classic_poller_set_key_tried(MfClassicPoller* instance, const MfClassicKey* key) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    bool tried = false;
+
+    for(uint8_t i = 0; i < instance->sectors_total; i++) {
+        for(MfClassicKeyType key_type = MfClassicKeyTypeA; key_type <= MfClassicKeyTypeB;
+            key_type++) {
+            if(!mf_classic_is_key_found(instance->data, i, key_type)) continue;
+            MfClassicKey* found_key = mf_classic_poller_get_found_key(instance, i, key_type);
+            if(memcmp(found_key, key, sizeof(MfClassicKey))) continue;
+
+            if(mf_classic_poller_is_key_tried(dict_attack_ctx, i, key_type)) {
+                tried = true;
+            } else if(key_type == MfClassicKeyTypeA) {
+                FURI_BIT_SET(dict_attack_ctx->key_a_tried_mask, i);
+            } else {
+                FURI_BIT_SET(dict_attack_ctx->key_b_tried_mask, i);
+            }
+        }
+    }
+
+    return tried;
+}
+
 NfcCommand mf_classic_poller_handler_detect_type(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandReset;
 
@@ -122,7 +165,7 @@ NfcCommand mf_classic_poller_handler_start(MfClassicPoller* instance) {
 
     if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeDictAttack) {
         mf_classic_copy(instance->data, instance->mfc_event_data.poller_mode.data);
-        instance->state = MfClassicPollerStateRequestKey;
+        instance->state = MfClassicPollerStateKeyReuseNextKey;
     } else if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeRead) {
         instance->state = MfClassicPollerStateRequestReadSector;
     } else if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeWrite) {
@@ -513,7 +556,10 @@ NfcCommand mf_classic_poller_handler_request_key(MfClassicPoller* instance) {
     command = instance->callback(instance->general_event, instance->context);
     if(instance->mfc_event_data.key_request_data.key_provided) {
         dict_attack_ctx->current_key = instance->mfc_event_data.key_request_data.key;
-        instance->state = MfClassicPollerStateAuthKeyA;
+        // Found keys were already tried against all sectors
+        if(!mf_classic_poller_set_key_tried(instance, &dict_attack_ctx->current_key)) {
+            instance->state = MfClassicPollerStateAuthKeyA;
+        }
     } else {
         instance->state = MfClassicPollerStateNextSector;
     }
@@ -664,6 +710,8 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
         if(dict_attack_ctx->current_sector == instance->sectors_total) {
             instance->state = MfClassicPollerStateNextSector;
         } else {
+            // Reuse starts from current sector, previous ones had the whole dictionary tried
+            mf_classic_poller_set_key_tried(instance, &dict_attack_ctx->current_key);
             dict_attack_ctx->reuse_key_sector = dict_attack_ctx->current_sector;
             instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
             instance->mfc_event_data.key_attack_data.current_sector =
@@ -676,6 +724,43 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
     return command;
 }
 
+NfcCommand mf_classic_poller_handler_key_reuse_next_key(MfClassicPoller* instance) {
+    NfcCommand command = NfcCommandContinue;
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+
+    // Keys known to the card, including ones read from sector trailers, go before dictionary
+    bool key_selected = false;
+    for(uint8_t i = 0; (i < instance->sectors_total) && !key_selected; i++) {
+        for(MfClassicKeyType key_type = MfClassicKeyTypeA; key_type <= MfClassicKeyTypeB;
+            key_type++) {
+            if(!mf_classic_is_key_found(instance->data, i, key_type)) continue;
+            if(mf_classic_poller_is_key_tried(dict_attack_ctx, i, key_type)) continue;
+
+            MfClassicKey* key = mf_classic_poller_get_found_key(instance, i, key_type);
+            if(!mf_classic_poller_set_key_tried(instance, key)) {
+                dict_attack_ctx->current_key = *key;
+                key_selected = true;
+                break;
+            }
+        }
+    }
+
+    if(key_selected) {
+        dict_attack_ctx->reuse_key_sector = 0;
+        dict_attack_ctx->current_key_type = MfClassicKeyTypeA;
+        instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
+        instance->mfc_event_data.key_attack_data.current_sector = 0;
+        command = instance->callback(instance->general_event, instance->context);
+        instance->state = MfClassicPollerStateKeyReuseAuthKeyA;
+    } else {
+        instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStop;
+        command = instance->callback(instance->general_event, instance->context);
+        instance->state = MfClassicPollerStateRequestKey;
+    }
+
+    return command;
+}
+
 NfcCommand mf_classic_poller_handler_key_reuse_start(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
@@ -686,9 +771,7 @@ NfcCommand mf_classic_poller_handler_key_reuse_start(MfClassicPoller* instance)
     } else {
         dict_attack_ctx->reuse_key_sector++;
         if(dict_attack_ctx->reuse_key_sector == instance->sectors_total) {
-            instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStop;
-            command = instance->callback(instance->general_event, instance->context);
-            instance->state = MfClassicPollerStateRequestKey;
+            instance->state = MfClassicPollerStateKeyReuseNextKey;
         } else {
             instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
             instance->mfc_event_data.key_attack_data.current_sector =
@@ -864,6 +947,7 @@ static const MfClassicPollerReadHandler
         [MfClassicPollerStateAuthKeyA] = mf_classic_poller_handler_auth_a,
         [MfClassicPollerStateAuthKeyB] = mf_classic_poller_handler_auth_b,
         [MfClassicPollerStateReadSector] = mf_classic_poller_handler_read_sector,
+        [MfClassicPollerStateKeyReuseNextKey] = mf_classic_poller_handler_key_reuse_next_key,
         [MfClassicPollerStateKeyReuseStart] = mf_classic_poller_handler_key_reuse_start,
         [MfClassicPollerStateKeyReuseAuthKeyA] = mf_classic_poller_handler_key_reuse_auth_key_a,
         [MfClassicPollerStateKeyReuseAuthKeyB] = mf_classic_poller_handler_key_reuse_auth_key_b,
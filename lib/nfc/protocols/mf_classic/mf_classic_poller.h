@@ -40,6 +40,11 @@ typedef enum {
 
 /**
  * @brief MfClassic poller mode.
+ *
+ * In dictionary attack mode keys found on the card are tried against all sectors before
+ * dictionary keys are requested, and every new key is tried against the remaining sectors.
+ * Dictionary keys equal to found ones are skipped. Dictionary must be rewound only on
+ * MfClassicPollerEventTypeNextSector event.
  */
 typedef enum {
     MfClassicPollerModeRead, /**< Poller reading mode. */
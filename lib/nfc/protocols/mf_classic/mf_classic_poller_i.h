@@ -42,6 +42,7 @@ typedef enum {
     MfClassicPollerStateReadSector,
     MfClassicPollerStateAuthKeyA,
     MfClassicPollerStateAuthKeyB,
+    MfClassicPollerStateKeyReuseNextKey,
     MfClassicPollerStateKeyReuseStart,
     MfClassicPollerStateKeyReuseAuthKeyA,
     MfClassicPollerStateKeyReuseAuthKeyB,
@@ -70,6 +71,9 @@ typedef struct {
     bool auth_passed;
     uint16_t current_block;
     uint8_t reuse_key_sector;
+    // Found keys already tried against all sectors
+    uint64_t key_a_tried_mask;
+    uint64_t key_b_tried_mask;
 } MfClassicPollerDictAttackContext;
 
 typedef struct {
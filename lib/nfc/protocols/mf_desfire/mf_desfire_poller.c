@@ -153,6 +153,7 @@ static NfcCommand mf_desfire_poller_handler_read_applications(MfDesfirePoller* i
 static NfcCommand mf_desfire_poller_handler_read_fail(MfDesfirePoller* instance) {
     FURI_LOG_D(TAG, "Read Failed");
     iso14443_4a_poller_halt(instance->iso14443_4a_poller);
+    instance->mf_desfire_event.type = MfDesfirePollerEventTypeReadFailed;
     instance->mf_desfire_event.data->error = instance->error;
     NfcCommand command = instance->callback(instance->general_event, instance->context);
     instance->state = MfDesfirePollerStateIdle;
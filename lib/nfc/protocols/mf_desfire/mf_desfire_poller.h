@@ -228,6 +228,9 @@ MfDesfireError mf_desfire_poller_read_file_records(
 /**
  * @brief Read data from multiple files on MfDesfire card.
  *
+ * Data and record files are read in windows sized to whole card frames, each window
+ * is stored in the file data as soon as it is received.
+ *
  * Must ONLY be used inside the callback function.
  *
  * @param[in, out] instance pointer to the instance to be used in the transaction.
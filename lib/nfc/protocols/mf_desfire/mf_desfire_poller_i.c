@@ -6,6 +6,9 @@
 
 #define TAG "MfDesfirePoller"
 
+// PCB, status byte and CRC of every card frame
+#define MF_DESFIRE_FRAME_OVERHEAD (4U)
+
 MfDesfireError mf_desfire_process_error(Iso14443_4aError error) {
     switch(error) {
     case Iso14443_4aErrorNone:
@@ -63,10 +66,13 @@ MfDesfireError mf_desfire_send_chunks(
             const size_t rx_capacity_remaining =
                 bit_buffer_get_capacity_bytes(rx_buffer) - bit_buffer_get_size_bytes(rx_buffer);
 
-            if(rx_size <= rx_capacity_remaining) {
+            if(rx_size - sizeof(uint8_t) <= rx_capacity_remaining) {
                 bit_buffer_append_right(rx_buffer, instance->rx_buffer, sizeof(uint8_t));
             } else {
-                FURI_LOG_W(TAG, "RX buffer overflow: ignoring %zu bytes", rx_size);
+                // Partial response would be taken for complete data
+                FURI_LOG_E(TAG, "RX buffer overflow: %zu bytes", rx_size);
+                error = MfDesfireErrorProtocol;
+                break;
             }
         }
     } while(false);
@@ -285,33 +291,54 @@ MfDesfireError mf_desfire_poller_read_file_settings_multi(
         simple_array_init(data, file_id_count);
     }
 
+    // Settings of all files are fetched back to back, only the file id changes
+    bit_buffer_set_size_bytes(instance->input_buffer, sizeof(uint8_t) * 2);
+    bit_buffer_set_byte(instance->input_buffer, 0, MF_DESFIRE_CMD_GET_FILE_SETTINGS);
+
     for(uint32_t i = 0; i < file_id_count; ++i) {
         const MfDesfireFileId file_id = *(const MfDesfireFileId*)simple_array_cget(file_ids, i);
-        error = mf_desfire_poller_read_file_settings(instance, file_id, simple_array_get(data, i));
+        bit_buffer_set_byte(instance->input_buffer, 1, file_id);
+
+        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
         if(error != MfDesfireErrorNone) break;
+
+        if(!mf_desfire_file_settings_parse(simple_array_get(data, i), instance->result_buffer)) {
+            error = MfDesfireErrorProtocol;
+            break;
+        }
     }
 
     return error;
 }
 
-MfDesfireError mf_desfire_poller_read_file_data(
+static MfDesfireError mf_desfire_poller_read_file_part(
     MfDesfirePoller* instance,
+    uint8_t cmd,
     MfDesfireFileId id,
     uint32_t offset,
-    size_t size,
-    MfDesfireFileData* data) {
-    furi_assert(instance);
-
+    uint32_t size) {
     bit_buffer_reset(instance->input_buffer);
-    bit_buffer_append_byte(instance->input_buffer, MF_DESFIRE_CMD_READ_DATA);
+    bit_buffer_append_byte(instance->input_buffer, cmd);
     bit_buffer_append_byte(instance->input_buffer, id);
     bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&offset, 3);
     bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&size, 3);
 
+    return mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
+}
+
+MfDesfireError mf_desfire_poller_read_file_data(
+    MfDesfirePoller* instance,
+    MfDesfireFileId id,
+    uint32_t offset,
+    size_t size,
+    MfDesfireFileData* data) {
+    furi_assert(instance);
+
     MfDesfireError error;
 
     do {
-        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
+        error = mf_desfire_poller_read_file_part(
+            instance, MF_DESFIRE_CMD_READ_DATA, id, offset, size);
 
         if(error != MfDesfireErrorNone) break;
 
@@ -356,16 +383,11 @@ MfDesfireError mf_desfire_poller_read_file_records(
     MfDesfireFileData* data) {
     furi_assert(instance);
 
-    bit_buffer_reset(instance->input_buffer);
-    bit_buffer_append_byte(instance->input_buffer, MF_DESFIRE_CMD_READ_RECORDS);
-    bit_buffer_append_byte(instance->input_buffer, id);
-    bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&offset, 3);
-    bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&size, 3);
-
     MfDesfireError error;
 
     do {
-        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
+        error = mf_desfire_poller_read_file_part(
+            instance, MF_DESFIRE_CMD_READ_RECORDS, id, offset, size);
 
         if(error != MfDesfireErrorNone) break;
 
@@ -377,6 +399,67 @@ MfDesfireError mf_desfire_poller_read_file_records(
     return error;
 }
 
+static size_t mf_desfire_poller_get_window_size(MfDesfirePoller* instance) {
+    const size_t capacity = bit_buffer_get_capacity_bytes(instance->result_buffer);
+    const uint16_t frame_size =
+        iso14443_4a_get_frame_size_max(iso14443_4a_poller_get_data(instance->iso14443_4a_poller));
+
+    if(frame_size <= MF_DESFIRE_FRAME_OVERHEAD) return capacity;
+
+    // Whole frames only, so that windows do not end with a short frame
+    const size_t frame_data_size = frame_size - MF_DESFIRE_FRAME_OVERHEAD;
+    return MAX(capacity / frame_data_size, 1U) * frame_data_size;
+}
+
+/*
+ * Reads unit_count units of unit_size bytes (bytes of data files, records of record files)
+ * in windows that fit result_buffer. Every window is written to its place in the file data,
+ * so no buffer of the file size is needed besides the file data itself.
+ */
+static MfDesfireError mf_desfire_poller_read_file_windowed(
+    MfDesfirePoller* instance,
+    uint8_t cmd,
+    MfDesfireFileId id,
+    uint32_t unit_size,
+    uint32_t unit_count,
+    MfDesfireFileData* data) {
+    MfDesfireError error = MfDesfireErrorNone;
+
+    if(unit_size == 0 || unit_count == 0) return error;
+
+    const uint32_t window_units = MAX(mf_desfire_poller_get_window_size(instance) / unit_size, 1U);
+    uint8_t* file_data = NULL;
+
+    for(uint32_t offset = 0; offset < unit_count;) {
+        const uint32_t units = MIN(window_units, unit_count - offset);
+
+        error = mf_desfire_poller_read_file_part(instance, cmd, id, offset, units);
+        if(error != MfDesfireErrorNone) break;
+
+        const size_t size = bit_buffer_get_size_bytes(instance->result_buffer);
+        if(file_data == NULL) {
+            // No access to the file, same as when reading it at once
+            if(size == 0) break;
+            simple_array_init(data->data, unit_count * unit_size);
+            file_data = simple_array_get_data(data->data);
+        }
+
+        if(size != units * unit_size) {
+            FURI_LOG_E(TAG, "File %u: %zu bytes at %lu", id, size, offset * unit_size);
+            error = MfDesfireErrorProtocol;
+            break;
+        }
+
+        // ReadRecords offset counts back from the newest record, replies are oldest first
+        const uint32_t position =
+            cmd == MF_DESFIRE_CMD_READ_RECORDS ? unit_count - offset - units : offset;
+        bit_buffer_write_bytes(instance->result_buffer, &file_data[position * unit_size], size);
+        offset += units;
+    }
+
+    return error;
+}
+
 MfDesfireError mf_desfire_poller_read_file_data_multi(
     MfDesfirePoller* instance,
     const SimpleArray* file_ids,
@@ -400,15 +483,25 @@ MfDesfireError mf_desfire_poller_read_file_data_multi(
         MfDesfireFileData* file_data = simple_array_get(data, i);
 
         if(file_type == MfDesfireFileTypeStandard || file_type == MfDesfireFileTypeBackup) {
-            error = mf_desfire_poller_read_file_data(
-                instance, file_id, 0, file_settings_cur->data.size, file_data);
+            error = mf_desfire_poller_read_file_windowed(
+                instance,
+                MF_DESFIRE_CMD_READ_DATA,
+                file_id,
+                sizeof(uint8_t),
+                file_settings_cur->data.size,
+                file_data);
         } else if(file_type == MfDesfireFileTypeValue) {
             error = mf_desfire_poller_read_file_value(instance, file_id, file_data);
         } else if(
             file_type == MfDesfireFileTypeLinearRecord ||
             file_type == MfDesfireFileTypeCyclicRecord) {
-            error = mf_desfire_poller_read_file_records(
-                instance, file_id, 0, file_settings_cur->data.size, file_data);
+            error = mf_desfire_poller_read_file_windowed(
+                instance,
+                MF_DESFIRE_CMD_READ_RECORDS,
+                file_id,
+                file_settings_cur->record.size,
+                file_settings_cur->record.cur,
+                file_data);
         }
 
         if(error != MfDesfireErrorNone) break;
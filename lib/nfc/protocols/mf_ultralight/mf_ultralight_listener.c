@@ -174,7 +174,9 @@ static MfUltralightCommand
             break;
         }
 
-        if(end_page < start_page) {
+        // Response must fit into single frame
+        if((end_page < start_page) ||
+           (end_page - start_page >= MF_ULTRALIGHT_FAST_READ_PAGES_MAX)) {
             command = MfUltralightCommandNotProcessedNAK;
             break;
         }
@@ -187,7 +189,7 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[64] = {};
+        MfUltralightPage pages[MF_ULTRALIGHT_FAST_READ_PAGES_MAX] = {};
         uint8_t page_cnt = (end_page - start_page) + 1;
         mf_ultralight_listener_perform_read(pages, instance, start_page, page_cnt, do_i2c_check);
 
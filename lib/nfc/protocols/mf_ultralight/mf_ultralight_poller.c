@@ -224,6 +224,8 @@ static NfcCommand mf_ultralight_poller_handler_idle(MfUltralightPoller* instance
     instance->tearing_flag_read = 0;
     instance->tearing_flag_total = 3;
     instance->pages_read = 0;
+    instance->fast_read_disabled = false;
+    instance->reauth_required = false;
     instance->state = MfUltralightPollerStateRequestMode;
     instance->current_page = 0;
     return NfcCommandContinue;
@@ -444,7 +446,61 @@ static NfcCommand mf_ultralight_poller_handler_auth(MfUltralightPoller* instance
     return command;
 }
 
+static void mf_ultralight_poller_store_pages(
+    MfUltralightPoller* instance,
+    uint16_t start_page,
+    const MfUltralightPage* pages,
+    size_t pages_num) {
+    for(size_t i = 0; i < pages_num; i++) {
+        if(start_page + i < instance->pages_total) {
+            FURI_LOG_D(TAG, "Read page %d success", start_page + i);
+            instance->data->page[start_page + i] = pages[i];
+            instance->pages_read++;
+            instance->data->pages_read = instance->pages_read;
+        }
+    }
+}
+
+static NfcCommand mf_ultralight_poller_handler_fast_read_pages(MfUltralightPoller* instance) {
+    NfcCommand command = NfcCommandContinue;
+    MfUltralightPage pages[MF_ULTRALIGHT_FAST_READ_PAGES_MAX] = {};
+    uint16_t start_page = instance->pages_read;
+    uint16_t end_page =
+        MIN(start_page + MF_ULTRALIGHT_FAST_READ_PAGES_MAX, instance->pages_total) - 1;
+
+    instance->error = mf_ultralight_poller_fast_read_pages(instance, start_page, end_page, pages);
+    if(instance->error == MfUltralightErrorNone) {
+        mf_ultralight_poller_store_pages(instance, start_page, pages, end_page - start_page + 1);
+        if(instance->pages_read == instance->pages_total) {
+            instance->state = MfUltralightPollerStateReadCounters;
+        }
+    } else {
+        // Range may cross protected area or card may not like long frames.
+        // Card goes to idle state after NAK, so reactivate it and continue with READ
+        FURI_LOG_D(TAG, "Fast read %d-%d failed, fallback to read", start_page, end_page);
+        instance->fast_read_disabled = true;
+        instance->reauth_required = instance->auth_context.auth_success;
+        command = NfcCommandReset;
+    }
+
+    return command;
+}
+
 static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* instance) {
+    if(mf_ultralight_support_feature(instance->feature_set, MfUltralightFeatureSupportFastRead) &&
+       !MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type) && !instance->fast_read_disabled) {
+        return mf_ultralight_poller_handler_fast_read_pages(instance);
+    }
+
+    if(instance->reauth_required) {
+        // Restore authentication lost during reactivation
+        instance->reauth_required = false;
+        instance->error = mf_ultralight_poller_auth_pwd(instance, &instance->auth_context);
+        if(instance->error != MfUltralightErrorNone) {
+            FURI_LOG_D(TAG, "Reauth failed");
+        }
+    }
+
     MfUltralightPageReadCommandData data = {};
     uint16_t start_page = instance->pages_read;
     if(MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type)) {
@@ -464,14 +520,7 @@ static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* in
     }
 
     if(instance->error == MfUltralightErrorNone) {
-        for(size_t i = 0; i < 4; i++) {
-            if(start_page + i < instance->pages_total) {
-                FURI_LOG_D(TAG, "Read page %d success", start_page + i);
-                instance->data->page[start_page + i] = data.page[i];
-                instance->pages_read++;
-                instance->data->pages_read = instance->pages_read;
-            }
-        }
+        mf_ultralight_poller_store_pages(instance, start_page, data.page, COUNT_OF(data.page));
         if(instance->pages_read == instance->pages_total) {
             instance->state = MfUltralightPollerStateReadCounters;
         }
@@ -110,6 +110,26 @@ MfUltralightError mf_ultralight_poller_read_page(
     uint8_t start_page,
     MfUltralightPageReadCommandData* data);
 
+/**
+ * @brief Read range of pages from card with single FAST_READ command.
+ *
+ * Must ONLY be used inside the callback function.
+ *
+ * Card must support FAST_READ command. Range is limited by
+ * MF_ULTRALIGHT_FAST_READ_PAGES_MAX pages to fit into single frame.
+ *
+ * @param[in, out] instance pointer to the instance to be used in the transaction.
+ * @param[in] start_page first page to be read.
+ * @param[in] end_page last page to be read, inclusive.
+ * @param[out] data pointer to the array of end_page - start_page + 1 pages to be filled.
+ * @return MfUltralightErrorNone on success, an error code on failure.
+ */
+MfUltralightError mf_ultralight_poller_fast_read_pages(
+    MfUltralightPoller* instance,
+    uint8_t start_page,
+    uint8_t end_page,
+    MfUltralightPage* data);
+
 /**
  * @brief Read page from sector.
  *
@@ -9,7 +9,7 @@ extern "C" {
 #endif
 
 #define MF_ULTRALIGHT_POLLER_STANDARD_FWT_FC (60000)
-#define MF_ULTRALIGHT_MAX_BUFF_SIZE (64)
+#define MF_ULTRALIGHT_MAX_BUFF_SIZE (256)
 
 #define MF_ULTRALIGHT_DEFAULT_PASSWORD (0xffffffffUL)
 
@@ -81,6 +81,8 @@ struct MfUltralightPoller {
     uint32_t feature_set;
     uint16_t pages_read;
     uint16_t pages_total;
+    bool fast_read_disabled;
+    bool reauth_required;
     uint8_t counters_read;
     uint8_t counters_total;
     uint8_t tearing_flag_read;
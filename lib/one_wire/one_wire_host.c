@@ -7,18 +7,7 @@
 
 #include "one_wire_host.h"
 
-typedef struct {
-    uint16_t a;
-    uint16_t b;
-    uint16_t c;
-    uint16_t d;
-    uint16_t e;
-    uint16_t f;
-    uint16_t g;
-    uint16_t h;
-    uint16_t i;
-    uint16_t j;
-} OneWireHostTimings;
+#define ONEWIRE_HOST_CMD_OVERDRIVE_SKIP_ROM 0x3CU
 
 static const OneWireHostTimings onewire_host_timings_normal = {
     .a = 9,
@@ -47,7 +36,8 @@ static const OneWireHostTimings onewire_host_timings_overdrive = {
 };
 
 struct OneWireHost {
-    const GpioPin* gpio_pin;
+    const OneWireHostBus* bus;
+    void* bus_context;
     const OneWireHostTimings* timings;
     unsigned char saved_rom[8]; /** < global search state */
     uint8_t last_discrepancy;
@@ -55,132 +45,173 @@ struct OneWireHost {
     bool last_device_flag;
 };
 
-OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin) {
-    OneWireHost* host = malloc(sizeof(OneWireHost));
-    host->gpio_pin = gpio_pin;
-    onewire_host_reset_search(host);
-    onewire_host_set_overdrive(host, false);
-    return host;
+static void onewire_host_gpio_start(void* context) {
+    const GpioPin* gpio_pin = context;
+    furi_hal_gpio_write(gpio_pin, true);
+    furi_hal_gpio_init(gpio_pin, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
 }
 
-void onewire_host_free(OneWireHost* host) {
-    onewire_host_stop(host);
-    free(host);
+static void onewire_host_gpio_stop(void* context) {
+    const GpioPin* gpio_pin = context;
+    furi_hal_gpio_write(gpio_pin, true);
+    furi_hal_gpio_init(gpio_pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
 }
 
-bool onewire_host_reset(OneWireHost* host) {
+static bool onewire_host_gpio_reset(void* context, const OneWireHostTimings* timings) {
+    const GpioPin* gpio_pin = context;
     uint8_t r;
     uint8_t retries = 125;
 
-    const OneWireHostTimings* timings = host->timings;
-
     // wait until the gpio is high
-    furi_hal_gpio_write(host->gpio_pin, true);
+    furi_hal_gpio_write(gpio_pin, true);
     do {
         if(--retries == 0) return 0;
         furi_delay_us(2);
-    } while(!furi_hal_gpio_read(host->gpio_pin));
+    } while(!furi_hal_gpio_read(gpio_pin));
 
     // pre delay
     furi_delay_us(timings->g);
 
     // drive low
-    furi_hal_gpio_write(host->gpio_pin, false);
+    furi_hal_gpio_write(gpio_pin, false);
     furi_delay_us(timings->h);
 
     // release
-    furi_hal_gpio_write(host->gpio_pin, true);
+    furi_hal_gpio_write(gpio_pin, true);
     furi_delay_us(timings->i);
 
     // read and post delay
-    r = !furi_hal_gpio_read(host->gpio_pin);
+    r = !furi_hal_gpio_read(gpio_pin);
     furi_delay_us(timings->j);
 
     return r;
 }
 
-bool onewire_host_read_bit(OneWireHost* host) {
-    bool result;
+static bool onewire_host_gpio_slot(
+    const GpioPin* gpio_pin,
+    const OneWireHostTimings* timings,
+    bool value) {
+    bool result = false;
 
-    const OneWireHostTimings* timings = host->timings;
+    if(value) {
+        // drive low
+        furi_hal_gpio_write(gpio_pin, false);
+        furi_delay_us(timings->a);
 
-    // drive low
-    furi_hal_gpio_write(host->gpio_pin, false);
-    furi_delay_us(timings->a);
+        // release
+        furi_hal_gpio_write(gpio_pin, true);
+        furi_delay_us(timings->e);
 
-    // release
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_delay_us(timings->e);
+        // read and post delay, e + f equals b
+        result = furi_hal_gpio_read(gpio_pin);
+        furi_delay_us(timings->f);
+    } else {
+        // drive low
+        furi_hal_gpio_write(gpio_pin, false);
+        furi_delay_us(timings->c);
 
-    // read and post delay
-    result = furi_hal_gpio_read(host->gpio_pin);
-    furi_delay_us(timings->f);
+        // release
+        furi_hal_gpio_write(gpio_pin, true);
+        furi_delay_us(timings->d);
+    }
 
     return result;
 }
 
-uint8_t onewire_host_read(OneWireHost* host) {
-    uint8_t result = 0;
-
-    for(uint8_t bitMask = 0x01; bitMask; bitMask <<= 1) {
-        if(onewire_host_read_bit(host)) {
-            result |= bitMask;
-        }
+static void onewire_host_gpio_exchange(
+    void* context,
+    const OneWireHostTimings* timings,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    const GpioPin* gpio_pin = context;
+
+    for(size_t i = 0; i < bit_count; i++) {
+        const uint8_t mask = 1U << (i % 8);
+        const bool value = tx ? (tx[i / 8] & mask) : true;
+        const bool result = onewire_host_gpio_slot(gpio_pin, timings, value);
+
+        if(!rx) continue;
+        if(mask == 0x01) rx[i / 8] = 0;
+        if(result) rx[i / 8] |= mask;
     }
+}
 
-    return result;
+static const OneWireHostBus onewire_host_gpio_bus = {
+    .start = onewire_host_gpio_start,
+    .stop = onewire_host_gpio_stop,
+    .reset = onewire_host_gpio_reset,
+    .exchange = onewire_host_gpio_exchange,
+};
+
+static inline void onewire_host_exchange(
+    OneWireHost* host,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    host->bus->exchange(host->bus_context, host->timings, tx, rx, bit_count);
 }
 
-void onewire_host_read_bytes(OneWireHost* host, uint8_t* buffer, uint16_t count) {
-    for(uint16_t i = 0; i < count; i++) {
-        buffer[i] = onewire_host_read(host);
-    }
+OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin) {
+    // The pin is never written through the context
+    return onewire_host_alloc_ex(&onewire_host_gpio_bus, (void*)gpio_pin);
 }
 
-void onewire_host_write_bit(OneWireHost* host, bool value) {
-    const OneWireHostTimings* timings = host->timings;
+OneWireHost* onewire_host_alloc_ex(const OneWireHostBus* bus, void* context) {
+    furi_check(bus);
 
-    if(value) {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->a);
+    OneWireHost* host = malloc(sizeof(OneWireHost));
+    host->bus = bus;
+    host->bus_context = context;
+    onewire_host_reset_search(host);
+    onewire_host_set_overdrive(host, false);
+    return host;
+}
 
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->b);
-    } else {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->c);
+void onewire_host_free(OneWireHost* host) {
+    onewire_host_stop(host);
+    free(host);
+}
 
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->d);
-    }
+bool onewire_host_reset(OneWireHost* host) {
+    return host->bus->reset(host->bus_context, host->timings);
 }
 
-void onewire_host_write(OneWireHost* host, uint8_t value) {
-    uint8_t bitMask;
+bool onewire_host_read_bit(OneWireHost* host) {
+    uint8_t result;
+    onewire_host_exchange(host, NULL, &result, 1);
+    return result & 0x01;
+}
 
-    for(bitMask = 0x01; bitMask; bitMask <<= 1) {
-        onewire_host_write_bit(host, (bitMask & value) ? 1 : 0);
-    }
+uint8_t onewire_host_read(OneWireHost* host) {
+    uint8_t result;
+    onewire_host_exchange(host, NULL, &result, 8);
+    return result;
+}
+
+void onewire_host_read_bytes(OneWireHost* host, uint8_t* buffer, uint16_t count) {
+    onewire_host_exchange(host, NULL, buffer, count * 8);
+}
+
+void onewire_host_write_bit(OneWireHost* host, bool value) {
+    const uint8_t data = value ? 0x01 : 0x00;
+    onewire_host_exchange(host, &data, NULL, 1);
+}
+
+void onewire_host_write(OneWireHost* host, uint8_t value) {
+    onewire_host_exchange(host, &value, NULL, 8);
 }
 
 void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t count) {
-    for(uint16_t i = 0; i < count; ++i) {
-        onewire_host_write(host, buffer[i]);
-    }
+    onewire_host_exchange(host, buffer, NULL, count * 8);
 }
 
 void onewire_host_start(OneWireHost* host) {
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_hal_gpio_init(host->gpio_pin, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
+    host->bus->start(host->bus_context);
 }
 
 void onewire_host_stop(OneWireHost* host) {
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_hal_gpio_init(host->gpio_pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+    host->bus->stop(host->bus_context);
 }
 
 void onewire_host_reset_search(OneWireHost* host) {
@@ -236,11 +267,15 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
             break;
         }
 
+        // read the first bit and its complement
+        uint8_t slots_tx = 0x03;
+        uint8_t slots_rx = 0;
+        onewire_host_exchange(host, &slots_tx, &slots_rx, 2);
+
         // loop to do the search
         do {
-            // read a bit and its complement
-            id_bit = onewire_host_read_bit(host);
-            cmp_id_bit = onewire_host_read_bit(host);
+            id_bit = slots_rx & 0x01;
+            cmp_id_bit = (slots_rx >> 1) & 0x01;
 
             // check for no devices on 1-wire
             if((id_bit == 1) && (cmp_id_bit == 1))
@@ -275,8 +310,16 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
                 else
                     host->saved_rom[rom_byte_number] &= ~rom_byte_mask;
 
-                // serial number search direction write bit
-                onewire_host_write_bit(host, search_direction);
+                // serial number search direction write bit, batched with reading
+                // the next bit and its complement to save a bus transaction
+                slots_tx = search_direction;
+                if(id_bit_number < 64) {
+                    slots_tx |= 0x06;
+                    onewire_host_exchange(host, &slots_tx, &slots_rx, 3);
+                    slots_rx >>= 1;
+                } else {
+                    onewire_host_exchange(host, &slots_tx, NULL, 1);
+                }
 
                 // increment the byte counter id_bit_number
                 // and shift the mask rom_byte_mask
@@ -319,3 +362,12 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
 void onewire_host_set_overdrive(OneWireHost* host, bool set) {
     host->timings = set ? &onewire_host_timings_overdrive : &onewire_host_timings_normal;
 }
+
+bool onewire_host_overdrive_skip_rom(OneWireHost* host) {
+    onewire_host_set_overdrive(host, false);
+    if(!onewire_host_reset(host)) return false;
+
+    onewire_host_write(host, ONEWIRE_HOST_CMD_OVERDRIVE_SKIP_ROM);
+    onewire_host_set_overdrive(host, true);
+    return true;
+}
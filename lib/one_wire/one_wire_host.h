@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <furi_hal_gpio.h>
@@ -18,15 +19,66 @@ typedef enum {
     OneWireHostSearchModeNormal = 1, /**< Search for all devices */
 } OneWireHostSearchMode;
 
+/**
+ * Reset pulse and time slot timings in microseconds, see Application Note 126:
+ * https://www.analog.com/media/en/technical-documentation/tech-articles/1wire-communication-through-software--maxim-integrated.pdf
+ */
+typedef struct {
+    uint16_t a; /**< Write 1 and read slot low time */
+    uint16_t b; /**< Write 1 slot release time */
+    uint16_t c; /**< Write 0 slot low time */
+    uint16_t d; /**< Write 0 slot release time */
+    uint16_t e; /**< Read slot sample delay after release */
+    uint16_t f; /**< Read slot release time after sample */
+    uint16_t g; /**< Delay before reset pulse */
+    uint16_t h; /**< Reset pulse low time */
+    uint16_t i; /**< Presence sample delay after release */
+    uint16_t j; /**< Reset release time after sample */
+} OneWireHostTimings;
+
+/**
+ * 1-Wire bus backend
+ *
+ * Generates reset pulses and time slots with the given timings. Slots come in batches,
+ * so that a backend is free to generate them in hardware while the calling thread sleeps.
+ */
+typedef struct {
+    /** Take over the bus and leave the line released */
+    void (*start)(void* context);
+    /** Give up the bus */
+    void (*stop)(void* context);
+    /** Generate a reset pulse, return true if presence was detected */
+    bool (*reset)(void* context, const OneWireHostTimings* timings);
+    /**
+     * Generate bit_count time slots, LSB first. A 1 bit in tx makes a write 1 slot which also
+     * samples the line into the same bit of rx, a 0 bit makes a write 0 slot which reads as 0.
+     * NULL tx means read slots only, NULL rx discards the samples.
+     */
+    void (*exchange)(
+        void* context,
+        const OneWireHostTimings* timings,
+        const uint8_t* tx,
+        uint8_t* rx,
+        size_t bit_count);
+} OneWireHostBus;
+
 typedef struct OneWireHost OneWireHost;
 
 /**
- * Allocate OneWireHost instance
+ * Allocate OneWireHost instance bit-banging the bus on a GPIO pin
  * @param [in] gpio_pin connection pin
  * @return pointer to OneWireHost instance
  */
 OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin);
 
+/**
+ * Allocate OneWireHost instance on a custom bus backend
+ * @param [in] bus pointer to the backend, must outlive the instance
+ * @param [in] context backend context
+ * @return pointer to OneWireHost instance
+ */
+OneWireHost* onewire_host_alloc_ex(const OneWireHostBus* bus, void* context);
+
 /**
  * Destroy OneWireHost instance, free resources
  * @param [in] host pointer to OneWireHost instance
@@ -110,7 +162,7 @@ void onewire_host_reset_search(OneWireHost* host);
 void onewire_host_target_search(OneWireHost* host, uint8_t family_code);
 
 /**
- * Search for devices on the 1-Wire bus
+ * Search for devices on the 1-Wire bus at the current speed
  * @param [in] host pointer to OneWireHost instance
  * @param [out] new_addr pointer to the buffer to contain the unique ROM of the found device
  * @param [in] mode search mode
@@ -125,6 +177,18 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
  */
 void onewire_host_set_overdrive(OneWireHost* host, bool set);
 
+/**
+ * Reset the bus at standard speed and issue Overdrive Skip ROM, then enable overdrive mode
+ *
+ * Devices supporting overdrive are selected and switch to overdrive speed together with
+ * the host, so that the following resets, searches, reads and writes run at overdrive.
+ * Other devices ignore the bus until overdrive is turned off and the bus is reset again.
+ *
+ * @param [in] host pointer to OneWireHost instance
+ * @return true if presence was detected at standard speed, false otherwise
+ */
+bool onewire_host_overdrive_skip_rom(OneWireHost* host);
+
 #ifdef __cplusplus
 }
 #endif
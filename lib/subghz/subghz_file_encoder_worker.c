@@ -9,15 +9,23 @@
 
 #define SUBGHZ_FILE_ENCODER_LOAD 512
 
+typedef enum {
+    SubGhzFileEncoderWorkerEventExit = (1 << 0),
+    SubGhzFileEncoderWorkerEventRefill = (1 << 1),
+} SubGhzFileEncoderWorkerEvent;
+
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* timer;
 
     Storage* storage;
     FlipperFormat* flipper_format;
 
     volatile bool worker_running;
     volatile bool worker_stopping;
+    volatile bool refill_requested;
     bool is_storage_slow;
     FuriString* str_data;
     FuriString* file_path;
@@ -98,6 +106,16 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     int32_t duration;
     int ret = furi_stream_buffer_receive(instance->stream, &duration, sizeof(int32_t), 0);
+
+    // Wake worker once there is room for next portion of data
+    if(instance->worker_running && !instance->refill_requested &&
+       furi_stream_buffer_spaces_available(instance->stream) >=
+           SUBGHZ_FILE_ENCODER_LOAD * sizeof(int32_t)) {
+        instance->refill_requested = true;
+        furi_thread_flags_set(
+            furi_thread_get_id(instance->thread), SubGhzFileEncoderWorkerEventRefill);
+    }
+
     if(ret == sizeof(int32_t)) {
         LevelDuration level_duration = {.level = LEVEL_DURATION_RESET};
         if(duration < 0) {
@@ -116,7 +134,88 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     }
 }
 
+static void subghz_file_encoder_worker_end_callback(void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+    if(instance->worker_stopping) {
+        if(instance->callback_end) instance->callback_end(instance->context_end);
+    }
+}
+
+static void subghz_file_encoder_worker_wait_tx_callback(void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+    if(instance->device && !subghz_devices_is_async_complete_tx(instance->device)) return;
+
+    FURI_LOG_I(TAG, "End transmission");
+    furi_event_loop_timer_free(instance->timer);
+    instance->timer = furi_event_loop_timer_alloc(
+        instance->event_loop,
+        subghz_file_encoder_worker_end_callback,
+        FuriEventLoopTimerTypePeriodic,
+        instance);
+    furi_event_loop_timer_start(instance->timer, furi_ms_to_ticks(50));
+    subghz_file_encoder_worker_end_callback(instance);
+}
+
+/** Switch to waiting for the end of the transfer */
+static void subghz_file_encoder_worker_file_end(SubGhzFileEncoderWorker* instance) {
+    if(instance->is_storage_slow) {
+        FURI_LOG_E(TAG, "Storage is slow");
+    }
+
+    FURI_LOG_I(TAG, "End read file");
+    instance->timer = furi_event_loop_timer_alloc(
+        instance->event_loop,
+        subghz_file_encoder_worker_wait_tx_callback,
+        FuriEventLoopTimerTypePeriodic,
+        instance);
+    furi_event_loop_timer_start(instance->timer, furi_ms_to_ticks(5));
+    subghz_file_encoder_worker_wait_tx_callback(instance);
+}
+
+/** Fill stream buffer with file data while there is room for it
+ * 
+ * @param instance 
+ * @return true if file has more data
+ */
+static bool subghz_file_encoder_worker_refill(SubGhzFileEncoderWorker* instance) {
+    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+
+    // Rearm consumer notification before checking free space, so no refill is missed
+    instance->refill_requested = false;
+
+    while((furi_stream_buffer_spaces_available(instance->stream) / sizeof(int32_t)) >=
+          SUBGHZ_FILE_ENCODER_LOAD) {
+        if(!stream_read_line(stream, instance->str_data)) {
+            subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+            return false;
+        }
+        furi_string_trim(instance->str_data);
+        if(!subghz_file_encoder_worker_data_parse(
+               instance, furi_string_get_cstr(instance->str_data))) {
+            subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void subghz_file_encoder_worker_thread_flags_callback(uint32_t flags, void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+
+    if(flags & SubGhzFileEncoderWorkerEventExit) {
+        furi_event_loop_stop(instance->event_loop);
+    } else if((flags & SubGhzFileEncoderWorkerEventRefill) && !instance->timer) {
+        if(!subghz_file_encoder_worker_refill(instance)) {
+            subghz_file_encoder_worker_file_end(instance);
+        }
+    }
+}
+
 /** Worker thread
+ * 
+ * Sleeps in event loop, file is read when transmitter has consumed
+ * enough data from stream buffer.
  * 
  * @param context 
  * @return exit code 
@@ -126,6 +225,7 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
     instance->is_storage_slow = false;
+    instance->timer = NULL;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
@@ -148,42 +248,21 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
-    while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
-            }
-        } else {
-            furi_delay_ms(1);
-        }
-    }
-    //waiting for the end of the transfer
-    if(instance->is_storage_slow) {
-        FURI_LOG_E(TAG, "Storage is slow");
-    }
+    instance->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_thread_flags(
+        instance->event_loop, subghz_file_encoder_worker_thread_flags_callback, instance);
 
-    FURI_LOG_I(TAG, "End read file");
-    while(instance->device && !subghz_devices_is_async_complete_tx(instance->device) &&
-          instance->worker_running) {
-        furi_delay_ms(5);
+    if(!res || !subghz_file_encoder_worker_refill(instance)) {
+        subghz_file_encoder_worker_file_end(instance);
     }
 
-    FURI_LOG_I(TAG, "End transmission");
-    while(instance->worker_running) {
-        if(instance->worker_stopping) {
-            if(instance->callback_end) instance->callback_end(instance->context_end);
-        }
-        furi_delay_ms(50);
-    }
+    furi_event_loop_run(instance->event_loop);
+
+    // Timer is freed with event loop
+    furi_event_loop_free(instance->event_loop);
+    instance->event_loop = NULL;
+    instance->timer = NULL;
+
     flipper_format_file_close(instance->flipper_format);
 
     FURI_LOG_I(TAG, "Worker stop");
@@ -231,6 +310,7 @@ bool subghz_file_encoder_worker_start(
 
     furi_stream_buffer_reset(instance->stream);
     furi_string_set(instance->file_path, file_path);
+    instance->refill_requested = false;
     if(radio_device_name) {
         instance->device = subghz_devices_get_by_name(radio_device_name);
     }
@@ -245,6 +325,7 @@ void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance->worker_running);
 
     instance->worker_running = false;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzFileEncoderWorkerEventExit);
     furi_thread_join(instance->thread);
 }
 
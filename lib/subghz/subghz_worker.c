@@ -1,12 +1,18 @@
 #include "subghz_worker.h"
 
 #include <furi.h>
+#include <toolbox/trace.h>
 
 #define TAG "SubGhzWorker"
 
+typedef enum {
+    SubGhzWorkerEventExit = (1 << 0),
+} SubGhzWorkerEvent;
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
+    FuriEventLoop* event_loop;
 
     volatile bool running;
     volatile bool overrun;
@@ -35,46 +41,77 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     }
     size_t ret =
         furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(sizeof(LevelDuration) != ret) {
+        if(!instance->overrun) TRACE_INSTANT(SubGhzWorkerOverrun, duration);
+        instance->overrun = true;
+    }
 }
 
-/** Worker callback thread
+/** Stream buffer callback, drains all received pairs
  * 
+ * @param object FuriStreamBuffer instance
  * @param context 
- * @return exit code 
  */
-static int32_t subghz_worker_thread_callback(void* context) {
+static void subghz_worker_stream_callback(void* object, void* context) {
     SubGhzWorker* instance = context;
 
     LevelDuration level_duration;
-    while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
-                }
+    TRACE_BEGIN(SubGhzWorkerDrain);
+    while(furi_stream_buffer_receive(object, &level_duration, sizeof(LevelDuration), 0) ==
+          sizeof(LevelDuration)) {
+        if(level_duration_is_reset(level_duration)) {
+            FURI_LOG_E(TAG, "Overrun buffer");
+            if(instance->overrun_callback) instance->overrun_callback(instance->context);
+        } else {
+            bool level = level_duration_get_level(level_duration);
+            uint32_t duration = level_duration_get_duration(level_duration);
+
+            if((duration < instance->filter_duration) ||
+               (instance->filter_level_duration.level == level)) {
+                instance->filter_level_duration.duration += duration;
+
+            } else if(instance->filter_level_duration.level != level) {
+                if(instance->pair_callback)
+                    instance->pair_callback(
+                        instance->context,
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
+
+                instance->filter_level_duration.duration = duration;
+                instance->filter_level_duration.level = level;
             }
         }
     }
+    TRACE_END(SubGhzWorkerDrain);
+}
+
+static void subghz_worker_thread_flags_callback(uint32_t flags, void* context) {
+    SubGhzWorker* instance = context;
+    if(flags & SubGhzWorkerEventExit) {
+        furi_event_loop_stop(instance->event_loop);
+    }
+}
+
+/** Worker callback thread
+ * 
+ * Sleeps in event loop until radio delivers data or worker is stopped.
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_worker_thread_callback(void* context) {
+    SubGhzWorker* instance = context;
+
+    instance->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_stream_buffer(
+        instance->event_loop, instance->stream, subghz_worker_stream_callback, instance);
+    furi_event_loop_subscribe_thread_flags(
+        instance->event_loop, subghz_worker_thread_flags_callback, instance);
+
+    furi_event_loop_run(instance->event_loop);
+
+    furi_event_loop_free(instance->event_loop);
+    instance->event_loop = NULL;
 
     return 0;
 }
@@ -135,6 +172,7 @@ void subghz_worker_stop(SubGhzWorker* instance) {
 
     instance->running = false;
 
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzWorkerEventExit);
     furi_thread_join(instance->thread);
 }
 
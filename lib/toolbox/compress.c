@@ -259,3 +259,130 @@ bool compress_decode(
 
     return result;
 }
+
+#define COMPRESS_STREAM_SKIP_BUFF_SIZE (256u)
+
+struct CompressStreamDecoder {
+    heatshrink_decoder* decoder;
+    uint8_t* input_buffer;
+    size_t input_buffer_size;
+    size_t input_buffer_pos;
+    size_t input_buffer_len;
+    size_t position;
+    bool input_finished;
+    CompressIoCallback read_cb;
+    void* read_context;
+};
+
+CompressStreamDecoder* compress_stream_decoder_alloc(
+    uint16_t window_log,
+    uint16_t lookahead_log,
+    size_t input_buffer_size,
+    CompressIoCallback read_cb,
+    void* read_context) {
+    furi_assert(read_cb);
+    CompressStreamDecoder* instance = malloc(sizeof(CompressStreamDecoder));
+    instance->decoder = heatshrink_decoder_alloc(input_buffer_size, window_log, lookahead_log);
+    furi_check(instance->decoder);
+    instance->input_buffer = malloc(input_buffer_size);
+    instance->input_buffer_size = input_buffer_size;
+    instance->read_cb = read_cb;
+    instance->read_context = read_context;
+    compress_stream_decoder_rewind(instance);
+    return instance;
+}
+
+void compress_stream_decoder_free(CompressStreamDecoder* instance) {
+    furi_assert(instance);
+    heatshrink_decoder_free(instance->decoder);
+    free(instance->input_buffer);
+    free(instance);
+}
+
+bool compress_stream_decoder_read(CompressStreamDecoder* instance, uint8_t* data_out, size_t size) {
+    furi_assert(instance);
+    furi_assert(data_out);
+
+    size_t decoded = 0;
+    while(decoded < size) {
+        // Drain already decoded data first
+        size_t poll_size = 0;
+        HSD_poll_res poll_res = heatshrink_decoder_poll(
+            instance->decoder, &data_out[decoded], size - decoded, &poll_size);
+        if(poll_res < 0) {
+            return false;
+        }
+        decoded += poll_size;
+        instance->position += poll_size;
+        if(decoded == size || poll_res == HSDR_POLL_MORE) {
+            continue;
+        }
+
+        // Decoder is empty: feed more compressed data
+        if(instance->input_buffer_pos == instance->input_buffer_len) {
+            if(instance->input_finished) {
+                // Flush what's left in decoder
+                HSD_finish_res finish_res = heatshrink_decoder_finish(instance->decoder);
+                if(finish_res == HSDR_FINISH_DONE || finish_res < 0) {
+                    return false;
+                }
+                continue;
+            }
+            int32_t read = instance->read_cb(
+                instance->read_context, instance->input_buffer, instance->input_buffer_size);
+            if(read < 0) {
+                return false;
+            } else if(read == 0) {
+                instance->input_finished = true;
+                continue;
+            }
+            instance->input_buffer_pos = 0;
+            instance->input_buffer_len = read;
+        }
+
+        size_t sink_size = 0;
+        HSD_sink_res sink_res = heatshrink_decoder_sink(
+            instance->decoder,
+            &instance->input_buffer[instance->input_buffer_pos],
+            instance->input_buffer_len - instance->input_buffer_pos,
+            &sink_size);
+        if(sink_res < 0) {
+            return false;
+        }
+        instance->input_buffer_pos += sink_size;
+    }
+
+    return true;
+}
+
+bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position) {
+    furi_assert(instance);
+
+    if(position < instance->position) {
+        return false;
+    }
+
+    uint8_t skip_buffer[COMPRESS_STREAM_SKIP_BUFF_SIZE];
+    while(instance->position < position) {
+        size_t skip_size = MIN(position - instance->position, sizeof(skip_buffer));
+        if(!compress_stream_decoder_read(instance, skip_buffer, skip_size)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t compress_stream_decoder_tell(CompressStreamDecoder* instance) {
+    furi_assert(instance);
+    return instance->position;
+}
+
+void compress_stream_decoder_rewind(CompressStreamDecoder* instance) {
+    furi_assert(instance);
+    heatshrink_decoder_reset(instance->decoder);
+    instance->input_buffer_pos = 0;
+    instance->input_buffer_len = 0;
+    instance->position = 0;
+    instance->input_finished = false;
+}
@@ -91,6 +91,83 @@ bool compress_decode(
     size_t data_out_size,
     size_t* data_res_size);
 
+/** Compress stream decoder read callback
+ *
+ * @param   context     callback context
+ * @param   buffer      buffer to fill with compressed data
+ * @param   size        buffer size
+ *
+ * @return  number of bytes read, 0 on end of stream, negative on error
+ */
+typedef int32_t (*CompressIoCallback)(void* context, uint8_t* buffer, size_t size);
+
+/** Compress stream decoder control structure */
+typedef struct CompressStreamDecoder CompressStreamDecoder;
+
+/** Allocate stream decoder
+ *
+ * Decodes heatshrink stream pulled with read callback, allowing to
+ * decompress data that doesn't fit in RAM.
+ *
+ * @param   window_log      heatshrink window size, log2
+ * @param   lookahead_log   heatshrink lookahead size, log2
+ * @param   input_buffer_size  size of compressed data buffer
+ * @param   read_cb         compressed data read callback
+ * @param   read_context    read callback context
+ *
+ * @return  CompressStreamDecoder instance
+ */
+CompressStreamDecoder* compress_stream_decoder_alloc(
+    uint16_t window_log,
+    uint16_t lookahead_log,
+    size_t input_buffer_size,
+    CompressIoCallback read_cb,
+    void* read_context);
+
+/** Free stream decoder
+ *
+ * @param   instance    CompressStreamDecoder instance
+ */
+void compress_stream_decoder_free(CompressStreamDecoder* instance);
+
+/** Read decoded data
+ *
+ * @param   instance    CompressStreamDecoder instance
+ * @param   data_out    output buffer
+ * @param   size        number of bytes to read
+ *
+ * @return  true if exactly size bytes were decoded
+ */
+bool compress_stream_decoder_read(CompressStreamDecoder* instance, uint8_t* data_out, size_t size);
+
+/** Seek to position in decoded data
+ *
+ * Seeking forward decodes and discards data, seeking backward requires
+ * compress_stream_decoder_rewind first.
+ *
+ * @param   instance    CompressStreamDecoder instance
+ * @param   position    decoded data position
+ *
+ * @return  true on success
+ */
+bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position);
+
+/** Get current position in decoded data
+ *
+ * @param   instance    CompressStreamDecoder instance
+ *
+ * @return  decoded data position
+ */
+size_t compress_stream_decoder_tell(CompressStreamDecoder* instance);
+
+/** Reset decoder to the beginning of the stream
+ *
+ * @warning caller must rewind the underlying source before calling this
+ *
+ * @param   instance    CompressStreamDecoder instance
+ */
+void compress_stream_decoder_rewind(CompressStreamDecoder* instance);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,10 +4,13 @@
 #include <storage/storage.h>
 #include <furi.h>
 #include <toolbox/path.h>
+#include <toolbox/compress.h>
 
 #define TAG "TarArch"
 #define MAX_NAME_LEN 254
 #define FILE_BLOCK_SIZE 512
+#define FILE_EXTRACT_BLOCK_SIZE (8 * FILE_BLOCK_SIZE)
+#define HEATSHRINK_INPUT_BUFFER_SIZE FILE_EXTRACT_BLOCK_SIZE
 
 #define FILE_OPEN_NTRIES 10
 #define FILE_OPEN_RETRY_DELAY 25
@@ -19,6 +22,22 @@ typedef struct TarArchive {
     void* unpack_cb_context;
 } TarArchive;
 
+/* Heatshrink compressed stream, used as mtar stream in TAR_OPEN_MODE_READ_HEATSHRINK.
+ * Decoding is forward only. microtar seeks back to the header it has just read after every
+ * header read and at the end of every file, so the last header block is kept and those
+ * seeks are served from it. Other backward seeks restart decoding from the beginning. */
+typedef struct {
+    File* file;
+    CompressStreamDecoder* decoder;
+    size_t position;
+    uint8_t* block;
+    size_t block_position;
+    uint8_t* header;
+    size_t header_position;
+} TarHeatshrinkStream;
+
+#define TAR_HEATSHRINK_NO_BLOCK SIZE_MAX
+
 /* API WRAPPER */
 static int mtar_storage_file_write(void* stream, const void* data, unsigned size) {
     uint16_t bytes_written = storage_file_write(stream, data, size);
@@ -50,6 +69,125 @@ const struct mtar_ops filesystem_ops = {
     .close = mtar_storage_file_close,
 };
 
+static int32_t tar_heatshrink_file_read(void* context, uint8_t* buffer, size_t size) {
+    File* file = context;
+    size_t bytes_read = storage_file_read(file, buffer, size);
+    return (storage_file_get_error(file) == FSE_OK) ? (int32_t)bytes_read : -1;
+}
+
+/* Bring decoder to the stream position */
+static bool tar_heatshrink_stream_sync(TarHeatshrinkStream* hs_stream) {
+    if(hs_stream->position < compress_stream_decoder_tell(hs_stream->decoder)) {
+        FURI_LOG_D(TAG, "Restarting decoding for offset %zu", hs_stream->position);
+        if(!storage_file_seek(hs_stream->file, sizeof(TarHeatshrinkHeader), true)) {
+            return false;
+        }
+        compress_stream_decoder_rewind(hs_stream->decoder);
+    }
+    return compress_stream_decoder_seek(hs_stream->decoder, hs_stream->position);
+}
+
+static int mtar_heatshrink_read(void* stream, void* data, unsigned size) {
+    TarHeatshrinkStream* hs_stream = stream;
+    uint8_t* data_out = data;
+    const size_t header_end = hs_stream->header_position + FILE_BLOCK_SIZE;
+
+    if(hs_stream->header_position != TAR_HEATSHRINK_NO_BLOCK &&
+       hs_stream->position >= hs_stream->header_position && hs_stream->position < header_end) {
+        size_t cached = MIN(size, header_end - hs_stream->position);
+        memcpy(
+            data_out,
+            &hs_stream->header[hs_stream->position - hs_stream->header_position],
+            cached);
+        hs_stream->position += cached;
+        data_out += cached;
+        if(cached == size) {
+            return (int)size;
+        }
+    }
+
+    const size_t remaining = size - (data_out - (uint8_t*)data);
+    if(!tar_heatshrink_stream_sync(hs_stream) ||
+       !compress_stream_decoder_read(hs_stream->decoder, data_out, remaining)) {
+        return MTAR_EREADFAIL;
+    }
+
+    if(remaining == FILE_BLOCK_SIZE) {
+        memcpy(hs_stream->block, data_out, FILE_BLOCK_SIZE);
+        hs_stream->block_position = hs_stream->position;
+    }
+    hs_stream->position += remaining;
+
+    return (int)size;
+}
+
+static int mtar_heatshrink_seek(void* stream, unsigned offset) {
+    TarHeatshrinkStream* hs_stream = stream;
+
+    if(offset == hs_stream->block_position) {
+        /* Seek back to the block just read: that is a header, keep it */
+        uint8_t* header = hs_stream->header;
+        hs_stream->header = hs_stream->block;
+        hs_stream->header_position = hs_stream->block_position;
+        hs_stream->block = header;
+        hs_stream->block_position = TAR_HEATSHRINK_NO_BLOCK;
+    }
+
+    /* Decoder is brought to the position by the next read */
+    hs_stream->position = offset;
+    return MTAR_ESUCCESS;
+}
+
+static int mtar_heatshrink_close(void* stream) {
+    TarHeatshrinkStream* hs_stream = stream;
+    if(hs_stream) {
+        compress_stream_decoder_free(hs_stream->decoder);
+        storage_file_close(hs_stream->file);
+        storage_file_free(hs_stream->file);
+        free(hs_stream->block);
+        free(hs_stream->header);
+        free(hs_stream);
+    }
+    return MTAR_ESUCCESS;
+}
+
+const struct mtar_ops heatshrink_ops = {
+    .read = mtar_heatshrink_read,
+    .write = NULL,
+    .seek = mtar_heatshrink_seek,
+    .close = mtar_heatshrink_close,
+};
+
+static bool tar_archive_open_heatshrink(TarArchive* archive, File* stream) {
+    TarHeatshrinkHeader header;
+    if(storage_file_read(stream, &header, sizeof(header)) != sizeof(header) ||
+       memcmp(header.magic, TAR_HEATSHRINK_MAGIC, sizeof(header.magic)) != 0) {
+        FURI_LOG_E(TAG, "Invalid heatshrink header");
+        return false;
+    }
+    if(header.window_log < 4 || header.window_log > 15 || header.lookahead_log < 3 ||
+       header.lookahead_log >= header.window_log) {
+        FURI_LOG_E(TAG, "Unsupported heatshrink parameters");
+        return false;
+    }
+
+    TarHeatshrinkStream* hs_stream = malloc(sizeof(TarHeatshrinkStream));
+    hs_stream->file = stream;
+    hs_stream->position = 0;
+    hs_stream->block = malloc(FILE_BLOCK_SIZE);
+    hs_stream->block_position = TAR_HEATSHRINK_NO_BLOCK;
+    hs_stream->header = malloc(FILE_BLOCK_SIZE);
+    hs_stream->header_position = TAR_HEATSHRINK_NO_BLOCK;
+    hs_stream->decoder = compress_stream_decoder_alloc(
+        header.window_log,
+        header.lookahead_log,
+        HEATSHRINK_INPUT_BUFFER_SIZE,
+        tar_heatshrink_file_read,
+        stream);
+    mtar_init(&archive->tar, MTAR_READ, &heatshrink_ops, hs_stream);
+    return true;
+}
+
 TarArchive* tar_archive_alloc(Storage* storage) {
     furi_check(storage);
     TarArchive* archive = malloc(sizeof(TarArchive));
@@ -75,6 +213,11 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         access_mode = FSAM_WRITE;
         open_mode = FSOM_CREATE_ALWAYS;
         break;
+    case TAR_OPEN_MODE_READ_HEATSHRINK:
+        mtar_access = MTAR_READ;
+        access_mode = FSAM_READ;
+        open_mode = FSOM_OPEN_EXISTING;
+        break;
     default:
         return false;
     }
@@ -84,7 +227,15 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         storage_file_free(stream);
         return false;
     }
-    mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
+
+    if(mode == TAR_OPEN_MODE_READ_HEATSHRINK) {
+        if(!tar_archive_open_heatshrink(archive, stream)) {
+            storage_file_free(stream);
+            return false;
+        }
+    } else {
+        mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
+    }
 
     return true;
 }
@@ -172,7 +323,7 @@ typedef struct {
 static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
     mtar_t* tar = &archive->tar;
     File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+    uint8_t* readbuf = malloc(FILE_EXTRACT_BLOCK_SIZE);
 
     bool success = true;
     uint8_t n_tries = FILE_OPEN_NTRIES;
@@ -192,8 +343,8 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
         }
 
         while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
+            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_EXTRACT_BLOCK_SIZE);
+            if(readcnt <= 0 || storage_file_write(out_file, readbuf, readcnt) != (size_t)readcnt) {
                 success = false;
                 break;
             }
@@ -15,9 +15,19 @@ typedef struct Storage Storage;
 typedef enum {
     TAR_OPEN_MODE_READ = 'r',
     TAR_OPEN_MODE_WRITE = 'w',
-    TAR_OPEN_MODE_STDOUT = 's' /* to be implemented */
+    TAR_OPEN_MODE_STDOUT = 's', /* to be implemented */
+    TAR_OPEN_MODE_READ_HEATSHRINK = 'h', /* heatshrink compressed tar, see TarHeatshrinkHeader */
 } TarOpenMode;
 
+/* Header of heatshrink compressed tar stream */
+typedef struct {
+    uint8_t magic[2]; /* TAR_HEATSHRINK_MAGIC */
+    uint8_t window_log;
+    uint8_t lookahead_log;
+} TarHeatshrinkHeader;
+
+#define TAR_HEATSHRINK_MAGIC "HS"
+
 TarArchive* tar_archive_alloc(Storage* storage);
 
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode);
@@ -0,0 +1,294 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef TRACE_HOST
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#else
+#include <furi.h>
+#include <furi_hal_cortex.h>
+#endif
+
+#define TRACE_LINE_SIZE (192)
+#define TRACE_EXPORT_THREADS_MAX (32)
+// Records are tagged with this thread id when made from interrupt context
+#define TRACE_THREAD_ISR (0)
+
+typedef struct {
+    uint32_t sequence; // Record index + 1 once complete
+    uint32_t timestamp;
+    uint32_t thread;
+    uint32_t arg;
+    uint16_t event;
+    uint8_t phase;
+} TraceRecord;
+
+typedef struct {
+    TraceRecord* records;
+    uint32_t mask;
+    uint32_t head;
+    uint32_t writers;
+    bool started;
+} Trace;
+
+static Trace trace = {0};
+
+static const char* const trace_event_categories[TraceEventNum] = {
+#define TRACE_EVENT_CATEGORY(id, category, name) category,
+    TRACE_EVENTS(TRACE_EVENT_CATEGORY)
+#undef TRACE_EVENT_CATEGORY
+};
+
+static const char* const trace_event_names[TraceEventNum] = {
+#define TRACE_EVENT_NAME(id, category, name) name,
+    TRACE_EVENTS(TRACE_EVENT_NAME)
+#undef TRACE_EVENT_NAME
+};
+
+#ifdef TRACE_HOST
+
+/* Nanoseconds, consecutive records must be less than 2 seconds apart */
+static inline uint32_t trace_port_get_timestamp(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+static uint32_t trace_port_get_ticks_per_us(void) {
+    return 1000;
+}
+
+static inline uint32_t trace_port_get_thread(void) {
+    return (uint32_t)(uintptr_t)pthread_self();
+}
+
+static const char* trace_port_get_thread_name(uint32_t thread) {
+    (void)thread;
+    return NULL;
+}
+
+static void trace_port_wait(void) {
+    sched_yield();
+}
+
+#else
+
+/* CPU cycles, consecutive records must be less than 33 seconds apart */
+static inline uint32_t trace_port_get_timestamp(void) {
+    return DWT->CYCCNT;
+}
+
+static uint32_t trace_port_get_ticks_per_us(void) {
+    return furi_hal_cortex_instructions_per_microsecond();
+}
+
+static inline uint32_t trace_port_get_thread(void) {
+    return FURI_IS_ISR() ? TRACE_THREAD_ISR : (uint32_t)furi_thread_get_current_id();
+}
+
+static const char* trace_port_get_thread_name(uint32_t thread) {
+    // Threads that exited since are left unnamed, their ids can't be dereferenced
+    FuriThreadId threads[TRACE_EXPORT_THREADS_MAX];
+    uint32_t count = furi_thread_enumerate(threads, TRACE_EXPORT_THREADS_MAX);
+    for(uint32_t i = 0; i < count; i++) {
+        if((uint32_t)threads[i] == thread) return furi_thread_get_name(threads[i]);
+    }
+    return NULL;
+}
+
+static void trace_port_wait(void) {
+    // Let preempted lower priority writers finish
+    furi_delay_tick(1);
+}
+
+#endif
+
+bool trace_start(size_t capacity) {
+    if(trace.started || !capacity) return false;
+
+    trace_free();
+
+    size_t size = 1;
+    while(size < capacity) size <<= 1;
+
+    trace.records = calloc(size, sizeof(TraceRecord));
+    if(!trace.records) return false;
+    trace.mask = size - 1;
+    trace.head = 0;
+
+    __atomic_store_n(&trace.started, true, __ATOMIC_RELEASE);
+    return true;
+}
+
+void trace_stop(void) {
+    // Sequentially consistent on both sides: either writer sees the stop or stop sees
+    // the writer, release/acquire alone allows both to miss each other
+    __atomic_store_n(&trace.started, false, __ATOMIC_SEQ_CST);
+    while(__atomic_load_n(&trace.writers, __ATOMIC_SEQ_CST)) {
+        trace_port_wait();
+    }
+}
+
+bool trace_is_started(void) {
+    return __atomic_load_n(&trace.started, __ATOMIC_ACQUIRE);
+}
+
+void trace_free(void) {
+    if(trace_is_started()) return;
+
+    free(trace.records);
+    trace.records = NULL;
+    trace.mask = 0;
+    trace.head = 0;
+}
+
+void trace_record(TraceEvent event, TracePhase phase, uint32_t arg) {
+    // Stopped trace point only loads the flag
+    if(!__atomic_load_n(&trace.started, __ATOMIC_ACQUIRE)) return;
+
+    __atomic_add_fetch(&trace.writers, 1, __ATOMIC_SEQ_CST);
+
+    // Stop may have happened before the writer was counted
+    if(__atomic_load_n(&trace.started, __ATOMIC_SEQ_CST)) {
+        uint32_t index = __atomic_fetch_add(&trace.head, 1, __ATOMIC_RELAXED);
+        TraceRecord* record = &trace.records[index & trace.mask];
+
+        // Invalidate first, export skips records overwritten halfway
+        __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+        record->timestamp = trace_port_get_timestamp();
+        record->thread = trace_port_get_thread();
+        record->arg = arg;
+        record->event = event;
+        record->phase = phase;
+        __atomic_store_n(&record->sequence, index + 1, __ATOMIC_RELEASE);
+    }
+
+    __atomic_sub_fetch(&trace.writers, 1, __ATOMIC_RELEASE);
+}
+
+size_t trace_get_count(void) {
+    if(!trace.records) return 0;
+    uint32_t head = __atomic_load_n(&trace.head, __ATOMIC_ACQUIRE);
+    return head > trace.mask ? trace.mask + 1 : head;
+}
+
+size_t trace_get_dropped(void) {
+    if(!trace.records) return 0;
+    uint32_t head = __atomic_load_n(&trace.head, __ATOMIC_ACQUIRE);
+    return head > trace.mask ? head - trace.mask - 1 : 0;
+}
+
+static void trace_output(TraceOutputCallback callback, void* context, const char* line, int size) {
+    if(size <= 0) return;
+    if(size >= TRACE_LINE_SIZE) size = TRACE_LINE_SIZE - 1;
+    callback(line, size, context);
+}
+
+static int trace_format_record(
+    char* line,
+    const TraceRecord* record,
+    unsigned long us,
+    unsigned long ns,
+    bool first) {
+    static const char* const phases[] = {
+        [TracePhaseBegin] = "B",
+        [TracePhaseEnd] = "E",
+        [TracePhaseInstant] = "i",
+        [TracePhaseCounter] = "C",
+    };
+
+    int size = snprintf(
+        line,
+        TRACE_LINE_SIZE,
+        "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":%lu",
+        first ? "" : ",\n",
+        trace_event_names[record->event],
+        trace_event_categories[record->event],
+        phases[record->phase],
+        us,
+        ns,
+        (unsigned long)record->thread);
+
+    if(size > 0 && size < TRACE_LINE_SIZE) {
+        const char* tail = "}";
+        if(record->phase == TracePhaseInstant) {
+            tail = ",\"s\":\"t\",\"args\":{\"arg\":%lu}}";
+        } else if(record->phase == TracePhaseCounter) {
+            tail = ",\"args\":{\"value\":%lu}}";
+        }
+        size += snprintf(&line[size], TRACE_LINE_SIZE - size, tail, (unsigned long)record->arg);
+    }
+
+    return size;
+}
+
+size_t trace_export_chrome(TraceOutputCallback callback, void* context) {
+    char line[TRACE_LINE_SIZE];
+    size_t exported = 0;
+
+    trace_output(callback, context, line, snprintf(line, sizeof(line), "{\"traceEvents\":[\n"));
+
+    uint32_t threads[TRACE_EXPORT_THREADS_MAX];
+    size_t thread_count = 0;
+
+    if(trace.records && !trace_is_started()) {
+        uint32_t ticks_per_us = trace_port_get_ticks_per_us();
+        uint32_t head = trace.head;
+        uint32_t index = head > trace.mask ? head - trace.mask - 1 : 0;
+        uint32_t previous = 0;
+        int64_t time = 0;
+
+        for(; index != head; index++) {
+            const TraceRecord* record = &trace.records[index & trace.mask];
+            if(record->sequence != index + 1) continue;
+            if(record->event >= TraceEventNum || record->phase > TracePhaseCounter) continue;
+
+            // Timestamp is taken after the slot is reserved, an interrupt in between makes
+            // neighbours slightly out of order, hence the signed difference
+            if(exported) time += (int32_t)(record->timestamp - previous);
+            previous = record->timestamp;
+            uint64_t ticks = time > 0 ? time : 0;
+
+            int size = trace_format_record(
+                line,
+                record,
+                ticks / ticks_per_us,
+                (ticks % ticks_per_us) * 1000 / ticks_per_us,
+                !exported);
+            trace_output(callback, context, line, size);
+            exported++;
+
+            size_t thread = 0;
+            while(thread < thread_count && threads[thread] != record->thread) thread++;
+            if(thread == thread_count && thread_count < TRACE_EXPORT_THREADS_MAX) {
+                threads[thread_count++] = record->thread;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < thread_count; i++) {
+        const char* name = threads[i] == TRACE_THREAD_ISR ? "ISR" :
+                                                            trace_port_get_thread_name(threads[i]);
+        if(!name) continue;
+        int size = snprintf(
+            line,
+            sizeof(line),
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+            "\"args\":{\"name\":\"%s\"}}",
+            (unsigned long)threads[i],
+            name);
+        trace_output(callback, context, line, size);
+    }
+
+    trace_output(
+        callback,
+        context,
+        line,
+        snprintf(line, sizeof(line), "\n],\"displayTimeUnit\":\"ns\"}\n"));
+
+    return exported;
+}
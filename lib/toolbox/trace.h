@@ -0,0 +1,114 @@
+/**
+ * @file trace.h
+ *
+ * @brief Low overhead event tracing.
+ *
+ * Trace points refer to events declared at compile time in trace_events.h and are
+ * recorded with cycle counter timestamps into a lock-free ring buffer shared by threads
+ * and interrupts. Once the buffer is full the oldest records are overwritten. A disabled
+ * trace point costs a call and a load, an enabled one three atomic read-modify-writes,
+ * two loads and a few stores, so trace points can stay in interrupt handlers and decoder
+ * loops.
+ *
+ * Captured trace is exported in Chrome trace event format, which chrome://tracing and
+ * https://ui.perfetto.dev open directly. On the device it is controlled with the `trace`
+ * CLI command and can be saved to storage for retrieval over RPC.
+ *
+ * Building trace.c with TRACE_HOST defined replaces the cycle counter and FuriThread
+ * with the host monotonic clock and pthreads, so instrumented code runs in host builds.
+ */
+#pragma once
+
+#include "trace_events.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Trace event identifiers, one per X() entry of TRACE_EVENTS */
+typedef enum {
+#define TRACE_EVENT_ID(id, category, name) TraceEvent##id,
+    TRACE_EVENTS(TRACE_EVENT_ID)
+#undef TRACE_EVENT_ID
+    TraceEventNum,
+} TraceEvent;
+
+/** Record kind, maps to Chrome trace event phase */
+typedef enum {
+    TracePhaseBegin, /**< Start of a duration on the current thread */
+    TracePhaseEnd, /**< End of the innermost duration on the current thread */
+    TracePhaseInstant, /**< Point in time with an argument */
+    TracePhaseCounter, /**< Value of a counter */
+} TracePhase;
+
+/** Export output callback
+ *
+ * @param data    chunk of exported text, not null terminated
+ * @param size    chunk size
+ * @param context output context
+ */
+typedef void (*TraceOutputCallback)(const char* data, size_t size, void* context);
+
+#define TRACE_BEGIN(event) trace_record(TraceEvent##event, TracePhaseBegin, 0)
+#define TRACE_END(event) trace_record(TraceEvent##event, TracePhaseEnd, 0)
+#define TRACE_INSTANT(event, arg) trace_record(TraceEvent##event, TracePhaseInstant, (arg))
+#define TRACE_COUNTER(event, value) trace_record(TraceEvent##event, TracePhaseCounter, (value))
+
+/** Allocate ring buffer and start recording, previous trace is discarded
+ *
+ * @param capacity  ring buffer size in records, rounded up to a power of two
+ *
+ * @return true on success, false if already started or capacity is 0
+ */
+bool trace_start(size_t capacity);
+
+/** Stop recording, captured trace is kept until trace_free or the next trace_start */
+void trace_stop(void);
+
+/** Check if recording */
+bool trace_is_started(void);
+
+/** Free ring buffer of a stopped trace */
+void trace_free(void);
+
+/** Record event, use TRACE_* macros instead
+ *
+ * Safe to call from any thread or interrupt, does nothing unless started.
+ *
+ * @param event  event identifier
+ * @param phase  record kind
+ * @param arg    instant argument or counter value, ignored for durations
+ */
+void trace_record(TraceEvent event, TracePhase phase, uint32_t arg);
+
+/** Get number of records available for export
+ *
+ * @return records count, at most capacity
+ */
+size_t trace_get_count(void);
+
+/** Get number of records overwritten or lost since start
+ *
+ * @return dropped records count
+ */
+size_t trace_get_dropped(void);
+
+/** Export stopped trace in Chrome trace event JSON format
+ *
+ * Records are exported oldest first with timestamps in microseconds since the first
+ * exported record.
+ *
+ * @param callback  output callback
+ * @param context   output context
+ *
+ * @return number of exported records
+ */
+size_t trace_export_chrome(TraceOutputCallback callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file trace_events.h
+ *
+ * @brief Trace event declarations.
+ *
+ * Every trace point refers to an event declared here as X(id, category, name). The id
+ * becomes TraceEvent<id>, category and name end up in the exported trace. Keep the list
+ * sorted by category, append new events at the end of their category.
+ */
+#pragma once
+
+#define TRACE_EVENTS(X)                                    \
+    X(InfraredWorkerDecode, "infrared", "worker_decode")   \
+    X(InfraredWorkerOverrun, "infrared", "worker_overrun") \
+    X(NfcPollerTrx, "nfc", "poller_trx")                   \
+    X(StorageRequest, "storage", "request")                \
+    X(SubGhzWorkerDrain, "subghz", "worker_drain")         \
+    X(SubGhzWorkerOverrun, "subghz", "worker_overrun")     \
+    X(UnitTest, "unit_tests", "unit_test")
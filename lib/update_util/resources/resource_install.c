@@ -0,0 +1,374 @@
+#include "resource_install.h"
+#include "manifest.h"
+
+#include <furi.h>
+#include <toolbox/path.h>
+#include <toolbox/tar/tar_archive.h>
+#include <toolbox/crc32_calc.h>
+#include <m-array.h>
+
+#define TAG "ResourceInstall"
+
+typedef enum {
+    ResourceInstallWeightsFileCleanup = 20,
+    ResourceInstallWeightsDirCleanup = 20,
+    ResourceInstallWeightsFileUnpack = 60,
+} ResourceInstallWeights;
+
+#define RESOURCE_INSTALL_FILE_TO_TOTAL_PERCENT 90
+
+/* Differential install: compact index of the new resources manifest.
+ * Entries are keyed by CRC32 and m-lib hash of the path instead of the path
+ * itself, so only a few bytes per file are kept in RAM even for large
+ * resource bundles. Two unrelated 32 bit hashes make a false match between
+ * different paths practically impossible. */
+typedef enum {
+    ResourceIndexFlagDirectory = (1 << 0),
+    ResourceIndexFlagUnchanged = (1 << 1),
+    ResourceIndexFlagCollision = (1 << 2),
+} ResourceIndexFlag;
+
+typedef struct {
+    uint32_t name_crc;
+    uint32_t name_hash;
+    uint32_t size;
+    uint8_t hash[8];
+    uint8_t flags;
+} ResourceIndexEntry;
+
+ARRAY_DEF(ResourceIndex, ResourceIndexEntry, M_POD_OPLIST)
+
+typedef struct {
+    Storage* storage;
+    const char* dest_path;
+    ResourceInstallProgressCallback callback;
+    void* context;
+    ResourceIndex_t* index;
+    ResourceInstallStats stats;
+} ResourceInstall;
+
+static void resource_index_entry_set_name(ResourceIndexEntry* entry, const char* name) {
+    size_t name_len = strlen(name);
+    entry->name_crc = crc32_calc_buffer(0, name, name_len);
+    entry->name_hash = m_core_hash(name, name_len);
+#ifdef APP_UNIT_TESTS
+    if(strncmp(
+           name,
+           RESOURCE_INSTALL_TEST_COLLISION_PREFIX,
+           strlen(RESOURCE_INSTALL_TEST_COLLISION_PREFIX)) == 0) {
+        entry->name_crc = 0;
+        entry->name_hash = 0;
+    }
+#endif
+}
+
+static int resource_index_entry_cmp(const void* a, const void* b) {
+    const ResourceIndexEntry* entry_a = a;
+    const ResourceIndexEntry* entry_b = b;
+    if(entry_a->name_crc != entry_b->name_crc) {
+        return (entry_a->name_crc < entry_b->name_crc) ? -1 : 1;
+    }
+    if(entry_a->name_hash != entry_b->name_hash) {
+        return (entry_a->name_hash < entry_b->name_hash) ? -1 : 1;
+    }
+    return 0;
+}
+
+static ResourceIndexEntry* resource_index_find(ResourceIndex_t index, const char* name) {
+    size_t count = ResourceIndex_size(index);
+    if(!count) return NULL;
+    ResourceIndexEntry key;
+    resource_index_entry_set_name(&key, name);
+    return bsearch(
+        &key,
+        ResourceIndex_get(index, 0),
+        count,
+        sizeof(ResourceIndexEntry),
+        resource_index_entry_cmp);
+}
+
+static void resource_install_set_progress(ResourceInstall* install, uint8_t progress) {
+    if(install->callback) {
+        install->callback(progress, install->context);
+    }
+}
+
+/* Extract new manifest from resource bundle and index it.
+ * Returns false if differential install is not possible. */
+static bool resource_install_load_index(
+    ResourceInstall* install,
+    TarArchive* archive,
+    const char* manifest_path,
+    ResourceIndex_t index) {
+    bool success = false;
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(install->storage);
+
+    do {
+        if(!tar_archive_unpack_file(archive, RESOURCE_INSTALL_MANIFEST_NAME, manifest_path)) {
+            FURI_LOG_W(TAG, "No manifest in resource bundle");
+            break;
+        }
+        if(!resource_manifest_reader_open(manifest_reader, manifest_path)) {
+            break;
+        }
+
+        ResourceManifestEntry* entry_ptr = NULL;
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            if(entry_ptr->type != ResourceManifestEntryTypeFile &&
+               entry_ptr->type != ResourceManifestEntryTypeDirectory) {
+                continue;
+            }
+            ResourceIndexEntry* entry = ResourceIndex_push_new(index);
+            resource_index_entry_set_name(entry, furi_string_get_cstr(entry_ptr->name));
+            entry->size = entry_ptr->size;
+            memcpy(entry->hash, entry_ptr->hash, sizeof(entry->hash));
+            entry->flags = (entry_ptr->type == ResourceManifestEntryTypeDirectory) ?
+                               ResourceIndexFlagDirectory :
+                               0;
+        }
+
+        size_t count = ResourceIndex_size(index);
+        if(!count) break;
+        qsort(
+            ResourceIndex_get(index, 0),
+            count,
+            sizeof(ResourceIndexEntry),
+            resource_index_entry_cmp);
+
+        /* Never trust entries which names share both hashes: they are always installed */
+        for(size_t i = 1; i < count; i++) {
+            ResourceIndexEntry* prev = ResourceIndex_get(index, i - 1);
+            ResourceIndexEntry* entry = ResourceIndex_get(index, i);
+            if(resource_index_entry_cmp(prev, entry) == 0) {
+                prev->flags |= ResourceIndexFlagCollision;
+                entry->flags |= ResourceIndexFlagCollision;
+            }
+        }
+
+        FURI_LOG_I(TAG, "New manifest: %zu entries", count);
+        success = true;
+    } while(false);
+
+    resource_manifest_reader_free(manifest_reader);
+    storage_simply_remove(install->storage, manifest_path);
+    return success;
+}
+
+/* Check if old manifest entry is installed and identical in new bundle */
+static bool resource_install_is_unchanged(
+    ResourceInstall* install,
+    ResourceIndexEntry* new_entry,
+    ResourceManifestEntry* old_entry,
+    const char* file_path) {
+    if((new_entry->flags & (ResourceIndexFlagDirectory | ResourceIndexFlagCollision)) ||
+       new_entry->size != old_entry->size ||
+       memcmp(new_entry->hash, old_entry->hash, sizeof(new_entry->hash)) != 0) {
+        return false;
+    }
+
+    FileInfo file_info;
+    return storage_common_stat(install->storage, file_path, &file_info) == FSE_OK &&
+           !file_info_is_dir(&file_info) && file_info.size == old_entry->size;
+}
+
+static bool resource_install_unpack_cb(const char* name, bool is_directory, void* context) {
+    ResourceInstall* install = context;
+    install->stats.processed_entries++;
+    resource_install_set_progress(
+        install,
+        /* Last progress segment = extraction */
+        (ResourceInstallWeightsFileCleanup + ResourceInstallWeightsDirCleanup) +
+            (install->stats.processed_entries * ResourceInstallWeightsFileUnpack) /
+                (install->stats.total_entries + 1));
+
+    if(install->index && !is_directory) {
+        ResourceIndexEntry* entry = resource_index_find(*install->index, name);
+        if(entry && (entry->flags & ResourceIndexFlagUnchanged)) {
+            install->stats.skipped_files++;
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Remove resources of old manifest. In differential mode (index != NULL)
+ * only entries missing from the new bundle are removed and unchanged files
+ * are marked in index to skip their extraction. */
+static void resource_install_cleanup(ResourceInstall* install) {
+    ResourceIndex_t* index = install->index;
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(install->storage);
+    FuriString* manifest_path = furi_string_alloc();
+    path_concat(install->dest_path, RESOURCE_INSTALL_MANIFEST_NAME, manifest_path);
+
+    do {
+        FURI_LOG_D(TAG, "Cleaning up old manifest");
+        if(!resource_manifest_reader_open(manifest_reader, furi_string_get_cstr(manifest_path))) {
+            FURI_LOG_W(TAG, "No existing manifest");
+            break;
+        }
+
+        const uint32_t n_approx_file_entries =
+            install->stats.total_entries * RESOURCE_INSTALL_FILE_TO_TOTAL_PERCENT / 100 + 1;
+        uint32_t n_dir_entries = 1;
+
+        ResourceManifestEntry* entry_ptr = NULL;
+        uint32_t n_processed_entries = 0;
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+            if(entry_ptr->type == ResourceManifestEntryTypeFile) {
+                resource_install_set_progress(
+                    install,
+                    /* First pass = old manifest's file cleanup */
+                    (n_processed_entries++ * ResourceInstallWeightsFileCleanup) /
+                        n_approx_file_entries);
+
+                FuriString* file_path = furi_string_alloc();
+                path_concat(
+                    install->dest_path, furi_string_get_cstr(entry_ptr->name), file_path);
+
+                if(index) {
+                    ResourceIndexEntry* new_entry =
+                        resource_index_find(*index, furi_string_get_cstr(entry_ptr->name));
+                    if(new_entry) {
+                        if(resource_install_is_unchanged(
+                               install, new_entry, entry_ptr, furi_string_get_cstr(file_path))) {
+                            new_entry->flags |= ResourceIndexFlagUnchanged;
+                        }
+                        /* Still in bundle: unchanged or overwritten on extraction */
+                        furi_string_free(file_path);
+                        continue;
+                    }
+                }
+
+                FURI_LOG_D(TAG, "Removing %s", furi_string_get_cstr(file_path));
+
+                FS_Error result =
+                    storage_common_remove(install->storage, furi_string_get_cstr(file_path));
+                if(result != FSE_OK && result != FSE_EXIST) {
+                    FURI_LOG_E(
+                        TAG,
+                        "%s remove failed, cause %s",
+                        furi_string_get_cstr(file_path),
+                        storage_error_get_desc(result));
+                }
+                furi_string_free(file_path);
+            } else if(entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+                n_dir_entries++;
+            }
+        }
+
+        n_processed_entries = 0;
+        while((entry_ptr = resource_manifest_reader_previous(manifest_reader))) {
+            if(entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+                resource_install_set_progress(
+                    install,
+                    /* Second pass = cleanup directories */
+                    ResourceInstallWeightsFileCleanup +
+                        (n_processed_entries++ * ResourceInstallWeightsDirCleanup) /
+                            n_dir_entries);
+
+                if(index && resource_index_find(*index, furi_string_get_cstr(entry_ptr->name))) {
+                    continue;
+                }
+
+                FuriString* folder_path = furi_string_alloc();
+
+                do {
+                    path_concat(
+                        install->dest_path, furi_string_get_cstr(entry_ptr->name), folder_path);
+
+                    FURI_LOG_D(TAG, "Removing folder %s", furi_string_get_cstr(folder_path));
+                    FS_Error result = storage_common_remove(
+                        install->storage, furi_string_get_cstr(folder_path));
+                    if(result != FSE_OK && result != FSE_EXIST) {
+                        FURI_LOG_E(
+                            TAG,
+                            "%s remove failed, cause %s",
+                            furi_string_get_cstr(folder_path),
+                            storage_error_get_desc(result));
+                    }
+                } while(false);
+
+                furi_string_free(folder_path);
+            }
+        }
+    } while(false);
+
+    furi_string_free(manifest_path);
+    resource_manifest_reader_free(manifest_reader);
+}
+
+static bool resource_install_is_heatshrink(const char* bundle_path) {
+    const size_t path_len = strlen(bundle_path);
+    const size_t ext_len = strlen(RESOURCE_INSTALL_HEATSHRINK_EXT);
+    return path_len >= ext_len &&
+           strcmp(&bundle_path[path_len - ext_len], RESOURCE_INSTALL_HEATSHRINK_EXT) == 0;
+}
+
+bool resource_install(
+    Storage* storage,
+    const char* bundle_path,
+    const char* dest_path,
+    const char* manifest_path,
+    ResourceInstallProgressCallback callback,
+    void* context,
+    ResourceInstallStats* stats) {
+    furi_assert(storage);
+    furi_assert(bundle_path);
+    furi_assert(dest_path);
+    furi_assert(manifest_path);
+
+    ResourceInstall install = {
+        .storage = storage,
+        .dest_path = dest_path,
+        .callback = callback,
+        .context = context,
+        .index = NULL,
+        .stats = {0},
+    };
+
+    ResourceIndex_t index;
+    ResourceIndex_init(index);
+    TarArchive* archive = tar_archive_alloc(storage);
+    bool success = false;
+
+    do {
+        const TarOpenMode open_mode = resource_install_is_heatshrink(bundle_path) ?
+                                          TAR_OPEN_MODE_READ_HEATSHRINK :
+                                          TAR_OPEN_MODE_READ;
+        if(!tar_archive_open(archive, bundle_path, open_mode)) break;
+
+        /* Manifest comes first in bundles, so indexing it only decodes the start of the
+         * bundle, and the entry count of the manifest saves a pass over the whole bundle */
+        if(resource_install_load_index(&install, archive, manifest_path, index)) {
+            install.index = &index;
+            install.stats.differential = true;
+            install.stats.total_entries = ResourceIndex_size(index);
+        } else {
+            FURI_LOG_W(TAG, "Differential install unavailable, installing everything");
+            install.stats.total_entries = tar_archive_get_entries_count(archive);
+        }
+
+        if(install.stats.total_entries <= 0) {
+            success = true;
+            break;
+        }
+
+        resource_install_cleanup(&install);
+
+        tar_archive_set_file_callback(archive, resource_install_unpack_cb, &install);
+        success = tar_archive_unpack_to(archive, dest_path, NULL);
+        FURI_LOG_I(
+            TAG,
+            "Resources: %ld entries, %ld unchanged",
+            install.stats.processed_entries,
+            install.stats.skipped_files);
+    } while(false);
+
+    tar_archive_free(archive);
+    ResourceIndex_clear(index);
+
+    if(stats) {
+        *stats = install.stats;
+    }
+    return success;
+}
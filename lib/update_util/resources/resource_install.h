@@ -0,0 +1,76 @@
+/**
+ * @file resource_install.h
+ * Resource bundle installation
+ *
+ * Installs a tar resource bundle, plain or heatshrink compressed, over the
+ * resources described by the Manifest of the destination directory.
+ *
+ * If the bundle has a Manifest, installation is differential: files that the
+ * old and new manifests describe identically and that are in place are left
+ * untouched, and only old resources missing from the new bundle are removed.
+ * Otherwise all old resources are removed and the whole bundle is extracted.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Name of the manifest in resource bundle and destination directory */
+#define RESOURCE_INSTALL_MANIFEST_NAME "Manifest"
+
+/** Extension of heatshrink compressed bundles, see TAR_OPEN_MODE_READ_HEATSHRINK */
+#define RESOURCE_INSTALL_HEATSHRINK_EXT ".ths"
+
+#ifdef APP_UNIT_TESTS
+/** Both name hashes of resources with this prefix collide, unit tests only */
+#define RESOURCE_INSTALL_TEST_COLLISION_PREFIX "__collision__"
+#endif
+
+/** Installation progress callback
+ *
+ * @param      progress  progress of installation, 0 - 100
+ * @param      context   callback context
+ */
+typedef void (*ResourceInstallProgressCallback)(uint8_t progress, void* context);
+
+typedef struct {
+    int32_t total_entries; /**< Bundle entries, as listed by new manifest in differential mode */
+    int32_t processed_entries; /**< Bundle entries passed to extraction */
+    int32_t skipped_files; /**< Unchanged files left in place */
+    bool differential; /**< Bundle had a manifest and installation was differential */
+} ResourceInstallStats;
+
+/** Install resource bundle
+ *
+ * Bundles with RESOURCE_INSTALL_HEATSHRINK_EXT extension are read as
+ * heatshrink compressed tar. Compressed bundles are decoded once if their
+ * Manifest is the first entry.
+ *
+ * @param      storage        Storage API pointer
+ * @param      bundle_path    path to resource bundle
+ * @param      dest_path      destination directory
+ * @param      manifest_path  temporary path to extract new manifest to
+ * @param      callback       progress callback, can be NULL
+ * @param      context        progress callback context
+ * @param[out] stats          installation statistics, can be NULL
+ *
+ * @return     true on success
+ */
+bool resource_install(
+    Storage* storage,
+    const char* bundle_path,
+    const char* dest_path,
+    const char* manifest_path,
+    ResourceInstallProgressCallback callback,
+    void* context,
+    ResourceInstallStats* stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
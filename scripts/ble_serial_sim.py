@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+
+# Model of BLE serial service flow control
+# (see targets/f7/ble_glue/services/serial_service.c)
+#
+# Time advances in connection events. Client may send a few packets per event,
+# flow control updates reach it one or more events later, RPC consumes buffer
+# at a fixed rate between events. Modes:
+#   baseline - whole buffer is granted once it is empty and previous grant is used
+#   legacy   - absolute grant once previous one is used and half of buffer is free
+#   credit   - cumulative grants returned as buffer is freed
+# Upload runs are checked for buffer overflow, stress run uses random timings.
+
+import random
+
+from flipper.app import App
+
+MODES = ("baseline", "legacy", "credit")
+
+CREDIT_UPDATE_DIV = 4
+
+
+class BufferOverflow(Exception):
+    pass
+
+
+class Flipper:
+    def __init__(self, mode, buffer_size):
+        self.mode = mode
+        self.buffer_size = buffer_size
+        self.level = 0
+        # Legacy: bytes client may send, credit: cumulative counters
+        self.ready = buffer_size
+        self.received = 0
+        self.granted = buffer_size
+
+    def grant(self, free_size, on_empty):
+        if self.mode == "credit":
+            granted = self.received + free_size
+            increment = granted - self.granted
+            if increment <= 0:
+                return None
+            if increment < self.buffer_size // CREDIT_UPDATE_DIV and not on_empty:
+                return None
+            self.granted = granted
+            return granted
+        if self.ready != 0:
+            return None
+        if self.mode == "baseline" and not on_empty:
+            return None
+        if free_size < self.buffer_size // 2:
+            return None
+        self.ready = free_size
+        return free_size
+
+    def receive(self, size):
+        self.level += size
+        if self.level > self.buffer_size:
+            raise BufferOverflow(
+                f"{self.level} bytes in {self.buffer_size} byte buffer"
+            )
+        self.ready -= min(self.ready, size)
+        self.received += size
+        return self.grant(self.buffer_size - self.level, False)
+
+    def consume(self, size):
+        if self.level == 0:
+            return None
+        self.level -= min(self.level, size)
+        if self.level == 0:
+            return self.grant(self.buffer_size, True)
+        return None
+
+
+class Client:
+    def __init__(self, mode, buffer_size):
+        self.mode = mode
+        self.sent = 0
+        # Legacy: remaining bytes, credit: cumulative limit
+        self.limit = buffer_size
+
+    def update(self, value):
+        if self.mode == "credit":
+            self.limit = max(self.limit, value)
+        else:
+            self.limit = value
+
+    def allowed(self):
+        if self.mode == "credit":
+            return self.limit - self.sent
+        return self.limit
+
+    def send(self, size):
+        self.sent += size
+        if self.mode != "credit":
+            self.limit -= size
+
+
+def simulate_upload(args, mode, rng=None):
+    flipper = Flipper(mode, args.buffer)
+    client = Client(mode, args.buffer)
+    payload = args.mtu - 3
+    consume_per_event = int(args.consume * 1024 * args.interval / 1000)
+
+    pending = []
+    left = args.size
+    event = 0
+    while left > 0 or flipper.level > 0:
+        if event > args.size * 1000:
+            raise RuntimeError(f"{mode}: transfer stalled")
+
+        # Notifications sent earlier reach client in order
+        while pending and pending[0][0] <= event:
+            client.update(pending.pop(0)[1])
+
+        packets = rng.randint(0, args.packets) if rng else args.packets
+        latency = rng.randint(1, 3) if rng else args.latency
+        for _ in range(packets):
+            size = min(payload, left, client.allowed())
+            if size <= 0:
+                break
+            client.send(size)
+            left -= size
+            value = flipper.receive(size)
+            if value is not None:
+                pending.append((event + latency, value))
+
+        consumed = rng.randint(0, 2 * consume_per_event) if rng else consume_per_event
+        value = flipper.consume(consumed)
+        if value is not None:
+            pending.append((event + latency, value))
+        event += 1
+
+    return args.size / (event * args.interval / 1000) / 1024
+
+
+def simulate_download(args, mode):
+    payload = args.mtu - 3
+    if mode == "credit":
+        # Notifications: limited by client and by stack tx buffers
+        per_event = min(args.packets, args.tx_buffers) * payload
+    else:
+        # Indication is confirmed in the next connection event
+        per_event = payload / 2
+    return per_event / args.interval * 1000 / 1024
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument(
+            "-s", "--size", type=int, default=256 * 1024, help="Transfer size, bytes"
+        )
+        self.parser.add_argument(
+            "--interval", type=float, default=30, help="Connection interval, ms"
+        )
+        self.parser.add_argument(
+            "--packets", type=int, default=4, help="Packets per connection event"
+        )
+        self.parser.add_argument(
+            "--mtu", type=int, default=247, help="Negotiated ATT MTU"
+        )
+        self.parser.add_argument(
+            "--buffer", type=int, default=1024, help="RPC buffer size, bytes"
+        )
+        self.parser.add_argument(
+            "--consume", type=float, default=64, help="RPC consume rate, KiB/s"
+        )
+        self.parser.add_argument(
+            "--latency",
+            type=int,
+            default=1,
+            help="Flow control notification delay, connection events",
+        )
+        self.parser.add_argument(
+            "--tx-buffers", type=int, default=6, help="Stack notification buffers"
+        )
+        self.parser.add_argument(
+            "--stress", type=int, default=200, help="Randomized overflow check runs"
+        )
+        self.parser.set_defaults(func=self.simulate)
+
+    def simulate(self):
+        payload = self.args.mtu - 3
+        line = self.args.packets * payload / self.args.interval * 1000 / 1024
+        print(
+            f"MTU {self.args.mtu}, {self.args.packets} packets "
+            f"per {self.args.interval} ms event, link {line:.1f} KiB/s, "
+            f"RPC {self.args.consume:.1f} KiB/s"
+        )
+        print(f"{'Mode':>9} {'Upload KiB/s':>13} {'Download KiB/s':>15}")
+
+        for mode in MODES:
+            try:
+                upload = simulate_upload(self.args, mode)
+            except BufferOverflow as e:
+                self.logger.error(f"{mode}: overflow: {e}")
+                return 1
+            download = simulate_download(self.args, mode)
+            print(f"{mode:>9} {upload:>13.1f} {download:>15.1f}")
+
+        rng = random.Random(0)
+        for mode in MODES:
+            for _ in range(self.args.stress):
+                try:
+                    simulate_upload(self.args, mode, rng)
+                except BufferOverflow as e:
+                    self.logger.error(f"{mode}: overflow under random timing: {e}")
+                    return 1
+        print(f"No overflow in {self.args.stress} randomized runs per mode")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+# Host harness of gui canvas partial flush
+#
+# Builds applications/services/gui/canvas.c and lib/u8g2 with the host
+# compiler together with scripts/canvas_bench, which replaces the display bus
+# with a byte counting model of display RAM. Static, clock and cursor blink
+# screens are committed frame by frame; display bus bytes per frame are
+# reported against a full flush, and display RAM after every partial flush is
+# checked against the framebuffer and against RAM of a fully flushed display.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+U8G2_DIR = os.path.join(ROOT_DIR, "lib", "u8g2")
+MLIB_DIR = os.path.join(ROOT_DIR, "lib", "mlib")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "canvas_bench")
+CANVAS_SOURCE = os.path.join(ROOT_DIR, "applications", "services", "gui", "canvas.c")
+
+# Shared with other host tools: core/check.h, core/common_defines.h
+STUB_DIRS = [
+    os.path.join(BENCH_DIR, "furi_stub"),
+    os.path.join(ROOT_DIR, "scripts", "infrared_bench", "furi_stub"),
+]
+INCLUDE_DIRS = [
+    os.path.join(ROOT_DIR, "applications", "services"),
+    os.path.join(ROOT_DIR, "lib"),
+    U8G2_DIR,
+    # furi_hal_serial_types.h for cfw/cfw.h
+    os.path.join(ROOT_DIR, "targets", "f7", "furi_hal"),
+]
+
+# Font tables are not drawn by the harness, unused code referencing them is dropped
+CFLAGS = ["-O2", "-ffunction-sections", "-fdata-sections"]
+LDFLAGS = ["-Wl,--gc-sections"]
+
+RESULT_FIELDS = (
+    "frames",
+    "command_bytes",
+    "data_bytes",
+    "full_bytes",
+    "framebuffer_mismatches",
+    "full_mismatches",
+)
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument("--mlib", default=MLIB_DIR, help="M*LIB source tree")
+        self.parser.add_argument(
+            "-n", "--frames", type=int, default=60, help="Frames per screen"
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _sources(self):
+        yield CANVAS_SOURCE
+        for filename in sorted(os.listdir(U8G2_DIR)):
+            if filename.endswith(".c"):
+                yield os.path.join(U8G2_DIR, filename)
+
+    def _build(self, build_dir):
+        includes = []
+        for path in (*STUB_DIRS, *INCLUDE_DIRS, self.args.mlib):
+            includes += ["-I", path]
+
+        objects = []
+        for index, source in enumerate(self._sources()):
+            obj = os.path.join(build_dir, f"{index}.o")
+            subprocess.check_call(
+                [self.args.cc, *CFLAGS, "-w", *includes, "-c", source, "-o", obj]
+            )
+            objects.append(obj)
+
+        binary = os.path.join(build_dir, "canvas_bench")
+        subprocess.check_call(
+            [
+                self.args.cc,
+                *CFLAGS,
+                *("-Wall", "-Wextra", "-Werror"),
+                *includes,
+                os.path.join(BENCH_DIR, "canvas_bench.c"),
+                *objects,
+                *LDFLAGS,
+                "-o",
+                binary,
+            ]
+        )
+        return binary
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        if not os.path.isfile(os.path.join(self.args.mlib, "m-array.h")):
+            self.logger.error(
+                f"M*LIB sources not found in {self.args.mlib}, "
+                "run git submodule update --init lib/mlib"
+            )
+            return 1
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            try:
+                output = subprocess.check_output(
+                    [binary, str(self.args.frames)], text=True
+                )
+            except subprocess.CalledProcessError:
+                self.logger.error("Harness failed")
+                return 1
+
+        result = 0
+        print(
+            f"{'Screen':<14} {'Frames':>7} {'Cmd/frame':>10} {'Data/frame':>11} "
+            f"{'Bytes/frame':>12} {'Full/frame':>11} {'Saved':>7}"
+        )
+        for line in output.splitlines():
+            kind, screen, *values = line.split()
+            if kind != "result":
+                continue
+            values = dict(zip(RESULT_FIELDS, map(int, values)))
+            frames = max(values["frames"], 1)
+            partial = values["command_bytes"] + values["data_bytes"]
+            saved = 100 * (1 - partial / max(values["full_bytes"], 1))
+            print(
+                f"{screen:<14} {frames:>7} {values['command_bytes'] / frames:>10.1f} "
+                f"{values['data_bytes'] / frames:>11.1f} {partial / frames:>12.1f} "
+                f"{values['full_bytes'] / frames:>11.1f} {saved:>6.1f}%"
+            )
+            if values["framebuffer_mismatches"]:
+                self.logger.error(
+                    f"{screen}: display differs from framebuffer in "
+                    f"{values['framebuffer_mismatches']} pages over all frames"
+                )
+                result = 1
+            if values["full_mismatches"]:
+                self.logger.error(
+                    f"{screen}: display differs from full flush in "
+                    f"{values['full_mismatches']} pages over all frames"
+                )
+                result = 1
+
+        return result
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,267 @@
+/* Host harness of canvas partial flush, see scripts/canvas_bench.py
+ *
+ * Display bus of u8g2 glue is replaced with a model of ST756x display RAM
+ * that counts command and data bytes. Every frame of a screen is committed
+ * as on device, then display RAM is compared with the framebuffer and with
+ * RAM of a second display that receives the same frame as full flush.
+ */
+
+#include <gui/canvas_i.h>
+#include <cfw/cfw.h>
+#include <furi_hal.h>
+
+/* ST756x RAM is wider than the panel */
+#define CANVAS_BENCH_PAGES (8U)
+#define CANVAS_BENCH_COLUMNS (132U)
+#define CANVAS_BENCH_WIDTH (128U)
+
+#define CANVAS_BENCH_CMD_COLUMN_MSB (0x10U)
+#define CANVAS_BENCH_CMD_COLUMN_LSB (0x00U)
+#define CANVAS_BENCH_CMD_PAGE (0xB0U)
+
+typedef struct {
+    uint8_t ram[CANVAS_BENCH_PAGES][CANVAS_BENCH_COLUMNS];
+    uint8_t page;
+    uint8_t column;
+} CanvasBenchDisplay;
+
+typedef struct {
+    size_t command_bytes;
+    size_t data_bytes;
+} CanvasBenchCounters;
+
+static struct {
+    CanvasBenchDisplay* display;
+    CanvasBenchCounters counters;
+    bool data_mode;
+} bench;
+
+const GpioPin gpio_display_di = {.pin = 0};
+const GpioPin gpio_display_rst_n = {.pin = 1};
+FuriHalSpiBusHandle furi_hal_spi_bus_handle_display = {.bus = 0};
+
+CfwSettings cfw_settings;
+
+void furi_hal_gpio_write(const GpioPin* gpio, const bool state) {
+    if(gpio == &gpio_display_di) bench.data_mode = state;
+}
+
+void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle) {
+    UNUSED(handle);
+}
+
+void furi_hal_spi_release(FuriHalSpiBusHandle* handle) {
+    UNUSED(handle);
+}
+
+/* Only addressing commands matter, the rest is display setup */
+static void canvas_bench_command(CanvasBenchDisplay* display, uint8_t command) {
+    if((command & 0xF0) == CANVAS_BENCH_CMD_PAGE) {
+        display->page = command & 0x0F;
+    } else if((command & 0xF0) == CANVAS_BENCH_CMD_COLUMN_MSB) {
+        display->column = (display->column & 0x0F) | ((command & 0x0F) << 4);
+    } else if((command & 0xF0) == CANVAS_BENCH_CMD_COLUMN_LSB) {
+        display->column = (display->column & 0xF0) | (command & 0x0F);
+    }
+}
+
+bool furi_hal_spi_bus_tx(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* buffer,
+    size_t size,
+    uint32_t timeout) {
+    UNUSED(handle);
+    UNUSED(timeout);
+    CanvasBenchDisplay* display = bench.display;
+
+    if(bench.data_mode) {
+        bench.counters.data_bytes += size;
+        for(size_t i = 0; i < size; i++) {
+            if(display->page < CANVAS_BENCH_PAGES && display->column < CANVAS_BENCH_COLUMNS) {
+                display->ram[display->page][display->column] = buffer[i];
+            }
+            display->column++;
+        }
+    } else {
+        bench.counters.command_bytes += size;
+        for(size_t i = 0; i < size; i++) {
+            canvas_bench_command(display, buffer[i]);
+        }
+    }
+    return true;
+}
+
+/* Icons are not drawn, decoder is never called */
+CompressIcon* compress_icon_alloc() {
+    return malloc(1);
+}
+
+void compress_icon_free(CompressIcon* instance) {
+    free(instance);
+}
+
+/* Screens only use primitives: font tables are not part of lib/u8g2 sources */
+
+/* Status bar and dialog frame, same on every screen */
+static void canvas_bench_draw_background(Canvas* canvas) {
+    canvas_draw_line(canvas, 0, 10, 127, 10);
+    canvas_draw_frame(canvas, 100, 1, 24, 8);
+    canvas_draw_box(canvas, 102, 3, 16, 4);
+    canvas_draw_rframe(canvas, 0, 13, 128, 51, 3);
+    canvas_draw_circle(canvas, 16, 36, 9);
+    canvas_draw_disc(canvas, 16, 36, 4);
+}
+
+/* Text-like rows of glyph sized boxes */
+static void canvas_bench_draw_text(Canvas* canvas, uint8_t x, uint8_t y, uint8_t length) {
+    for(uint8_t i = 0; i < length; i++) {
+        canvas_draw_box(canvas, x + i * 6, y, 5, 7);
+    }
+}
+
+static void canvas_bench_draw_static(Canvas* canvas, uint32_t frame) {
+    UNUSED(frame);
+    canvas_bench_draw_background(canvas);
+    canvas_bench_draw_text(canvas, 32, 20, 14);
+    canvas_bench_draw_text(canvas, 32, 32, 10);
+    canvas_bench_draw_text(canvas, 32, 44, 12);
+}
+
+/* Seven segment digit, 7x13 pixels */
+static void canvas_bench_draw_digit(Canvas* canvas, uint8_t x, uint8_t y, uint8_t digit) {
+    static const uint8_t segments[10] = {
+        0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+    const uint8_t mask = segments[digit % 10];
+    if(mask & 0x01) canvas_draw_box(canvas, x + 1, y, 5, 1);
+    if(mask & 0x02) canvas_draw_box(canvas, x + 6, y + 1, 1, 5);
+    if(mask & 0x04) canvas_draw_box(canvas, x + 6, y + 7, 1, 5);
+    if(mask & 0x08) canvas_draw_box(canvas, x + 1, y + 12, 5, 1);
+    if(mask & 0x10) canvas_draw_box(canvas, x, y + 7, 1, 5);
+    if(mask & 0x20) canvas_draw_box(canvas, x, y + 1, 1, 5);
+    if(mask & 0x40) canvas_draw_box(canvas, x + 1, y + 6, 5, 1);
+}
+
+/* MM:SS clock, one second per frame */
+static void canvas_bench_draw_clock(Canvas* canvas, uint32_t frame) {
+    canvas_bench_draw_background(canvas);
+    const uint32_t minutes = (frame / 60) % 60;
+    const uint32_t seconds = frame % 60;
+    canvas_bench_draw_digit(canvas, 40, 30, minutes / 10);
+    canvas_bench_draw_digit(canvas, 50, 30, minutes % 10);
+    canvas_draw_box(canvas, 60, 33, 2, 2);
+    canvas_draw_box(canvas, 60, 39, 2, 2);
+    canvas_bench_draw_digit(canvas, 65, 30, seconds / 10);
+    canvas_bench_draw_digit(canvas, 75, 30, seconds % 10);
+}
+
+/* Text input with blinking cursor, toggled every frame */
+static void canvas_bench_draw_cursor(Canvas* canvas, uint32_t frame) {
+    canvas_bench_draw_background(canvas);
+    canvas_draw_frame(canvas, 30, 28, 94, 13);
+    canvas_bench_draw_text(canvas, 32, 31, 8);
+    if(frame % 2 == 0) canvas_draw_box(canvas, 32 + 8 * 6, 30, 2, 9);
+}
+
+typedef struct {
+    const char* name;
+    void (*draw)(Canvas* canvas, uint32_t frame);
+} CanvasBenchScreen;
+
+static const CanvasBenchScreen canvas_bench_screens[] = {
+    {"static", canvas_bench_draw_static},
+    {"clock", canvas_bench_draw_clock},
+    {"cursor_blink", canvas_bench_draw_cursor},
+};
+
+static size_t canvas_bench_compare_framebuffer(Canvas* canvas, const CanvasBenchDisplay* display) {
+    const uint8_t* buffer = canvas_get_buffer(canvas);
+    size_t mismatches = 0;
+    for(uint8_t page = 0; page < CANVAS_BENCH_PAGES; page++) {
+        mismatches += memcmp(
+                          display->ram[page],
+                          &buffer[page * CANVAS_BENCH_WIDTH],
+                          CANVAS_BENCH_WIDTH) != 0;
+    }
+    return mismatches;
+}
+
+static size_t
+    canvas_bench_compare_display(const CanvasBenchDisplay* a, const CanvasBenchDisplay* b) {
+    size_t mismatches = 0;
+    for(uint8_t page = 0; page < CANVAS_BENCH_PAGES; page++) {
+        mismatches += memcmp(a->ram[page], b->ram[page], CANVAS_BENCH_WIDTH) != 0;
+    }
+    return mismatches;
+}
+
+/* Send current frame in full to given display, bus traffic is returned, not counted */
+static CanvasBenchCounters canvas_bench_full_flush(Canvas* canvas, CanvasBenchDisplay* display) {
+    CanvasBenchDisplay* current_display = bench.display;
+    CanvasBenchCounters counters = bench.counters;
+    bench.display = display;
+    memset(&bench.counters, 0, sizeof(bench.counters));
+
+    canvas_invalidate(canvas);
+    canvas_commit(canvas);
+    CanvasBenchCounters full = bench.counters;
+
+    bench.display = current_display;
+    bench.counters = counters;
+    return full;
+}
+
+static void canvas_bench_run(
+    Canvas* canvas,
+    const CanvasBenchScreen* screen,
+    uint32_t frames,
+    CanvasBenchDisplay* display,
+    CanvasBenchDisplay* reference) {
+    /* First frame of the screen is sent in full, as after a view switch */
+    canvas_clear(canvas);
+    screen->draw(canvas, 0);
+    canvas_bench_full_flush(canvas, display);
+
+    memset(&bench.counters, 0, sizeof(bench.counters));
+    size_t full_bytes = 0;
+    size_t framebuffer_mismatches = 0;
+    size_t full_mismatches = 0;
+
+    for(uint32_t frame = 1; frame <= frames; frame++) {
+        canvas_clear(canvas);
+        screen->draw(canvas, frame);
+        canvas_commit(canvas);
+        framebuffer_mismatches += canvas_bench_compare_framebuffer(canvas, display);
+
+        CanvasBenchCounters full = canvas_bench_full_flush(canvas, reference);
+        full_bytes += full.command_bytes + full.data_bytes;
+        full_mismatches += canvas_bench_compare_display(display, reference);
+    }
+
+    printf(
+        "result %s %lu %zu %zu %zu %zu %zu\n",
+        screen->name,
+        (unsigned long)frames,
+        bench.counters.command_bytes,
+        bench.counters.data_bytes,
+        full_bytes,
+        framebuffer_mismatches,
+        full_mismatches);
+}
+
+int main(int argc, char* argv[]) {
+    const uint32_t frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 60;
+
+    CanvasBenchDisplay* display = calloc(1, sizeof(CanvasBenchDisplay));
+    CanvasBenchDisplay* reference = calloc(1, sizeof(CanvasBenchDisplay));
+    bench.display = display;
+
+    Canvas* canvas = canvas_init();
+    for(size_t i = 0; i < COUNT_OF(canvas_bench_screens); i++) {
+        canvas_bench_run(canvas, &canvas_bench_screens[i], frames, display, reference);
+    }
+    canvas_free(canvas);
+
+    free(reference);
+    free(display);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/* Minimal furi replacement for host builds of gui canvas, see scripts/canvas_bench.py */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+} FuriStatus;
+
+typedef enum {
+    FuriMutexTypeNormal,
+    FuriMutexTypeRecursive,
+} FuriMutexType;
+
+/* Harness is single threaded, mutex only checks lock pairing */
+typedef struct {
+    bool locked;
+} FuriMutex;
+
+typedef struct FuriTimer FuriTimer;
+
+static inline FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    UNUSED(type);
+    return calloc(1, sizeof(FuriMutex));
+}
+
+static inline void furi_mutex_free(FuriMutex* mutex) {
+    furi_check(!mutex->locked);
+    free(mutex);
+}
+
+static inline FuriStatus furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout) {
+    UNUSED(timeout);
+    if(mutex->locked) return FuriStatusError;
+    mutex->locked = true;
+    return FuriStatusOk;
+}
+
+static inline FuriStatus furi_mutex_release(FuriMutex* mutex) {
+    if(!mutex->locked) return FuriStatusError;
+    mutex->locked = false;
+    return FuriStatusOk;
+}
+
+static inline void furi_delay_ms(uint32_t milliseconds) {
+    UNUSED(milliseconds);
+}
+
+static inline void furi_delay_us(uint32_t microseconds) {
+    UNUSED(microseconds);
+}
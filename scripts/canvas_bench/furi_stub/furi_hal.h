@@ -0,0 +1,39 @@
+#pragma once
+
+/* Display bus of u8g2 glue, implemented by scripts/canvas_bench/canvas_bench.c */
+
+#include <furi.h>
+
+typedef struct {
+    uint8_t pin;
+} GpioPin;
+
+typedef struct {
+    uint8_t bus;
+} FuriHalSpiBusHandle;
+
+typedef enum {
+    FuriHalVersionDisplayUnknown,
+    FuriHalVersionDisplayErc,
+    FuriHalVersionDisplayMgg,
+} FuriHalVersionDisplay;
+
+extern const GpioPin gpio_display_di;
+extern const GpioPin gpio_display_rst_n;
+extern FuriHalSpiBusHandle furi_hal_spi_bus_handle_display;
+
+void furi_hal_gpio_write(const GpioPin* gpio, const bool state);
+
+void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle);
+
+void furi_hal_spi_release(FuriHalSpiBusHandle* handle);
+
+bool furi_hal_spi_bus_tx(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* buffer,
+    size_t size,
+    uint32_t timeout);
+
+static inline FuriHalVersionDisplay furi_hal_version_get_hw_display(void) {
+    return FuriHalVersionDisplayErc;
+}
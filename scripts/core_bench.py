@@ -0,0 +1,430 @@
+#!/usr/bin/env python3
+
+# Host performance regression harness for core libraries
+#
+# Builds flipper_format, stream, protocol_dict with LF RFID protocols, SubGhz
+# and infrared decoders, crypto1, heatshrink and the TRACE_HOST backend of
+# toolbox/trace with the host compiler against stubbed furi, together with
+# scripts/core_bench/core_bench.c. Replays unit test vectors: SubGhz .sub
+# files, infrared .irtest signals and LF RFID signals synthesized with
+# protocol encoders, and records trace points. Results are checked, then
+# ops/sec, allocations, peak and leftover heap are reported per case. Heap
+# figures come from the check run of each case, not from the timed rounds.
+# Save results of one commit with --output and pass them as --baseline on
+# another to compare.
+
+import json
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+from infrared_bench import load_tests as load_infrared_tests
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+LIB_DIR = os.path.join(ROOT_DIR, "lib")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "core_bench")
+RESOURCES_DIR = os.path.join(
+    ROOT_DIR, "applications", "debug", "unit_tests", "resources", "unit_tests"
+)
+# Shared with other host tools: core/check.h, core/common_defines.h, furi_hal_rtc.h
+STUB_DIRS = [
+    os.path.join(BENCH_DIR, "furi_stub"),
+    os.path.join(ROOT_DIR, "scripts", "infrared_bench", "furi_stub"),
+    os.path.join(ROOT_DIR, "scripts", "lfrfid_raw", "furi_stub"),
+]
+INCLUDE_DIRS = [
+    ROOT_DIR,
+    LIB_DIR,
+    os.path.join(LIB_DIR, "subghz"),
+    os.path.join(LIB_DIR, "infrared", "encoder_decoder"),
+    os.path.join(LIB_DIR, "mlib"),
+    # storage/filesystem_api_defines.h
+    os.path.join(ROOT_DIR, "applications", "services"),
+]
+
+LIB_SOURCES = [
+    "flipper_format/flipper_format.c",
+    "flipper_format/flipper_format_stream.c",
+    "toolbox/stream/stream.c",
+    "toolbox/stream/string_stream.c",
+    "toolbox/stream/file_stream.c",
+    "toolbox/stream/buffered_file_stream.c",
+    "toolbox/stream/stream_cache.c",
+    "toolbox/protocols/protocol_dict.c",
+    "toolbox/pulse_protocols/pulse_glue.c",
+    "toolbox/manchester_decoder.c",
+    "toolbox/manchester_encoder.c",
+    "toolbox/bit_buffer.c",
+    "toolbox/hex.c",
+    "toolbox/varint.c",
+    "toolbox/trace.c",
+    "bit_lib/bit_lib.c",
+    "lfrfid/tools/fsk_demod.c",
+    "lfrfid/tools/fsk_ocs.c",
+    "nfc/helpers/nfc_util.c",
+    "nfc/protocols/mf_classic/crypto1.c",
+    "subghz/protocols/base.c",
+]
+LIB_SOURCE_DIRS = [
+    "lfrfid/protocols",
+    "infrared/encoder_decoder",
+    "subghz/blocks",
+]
+HEATSHRINK_SOURCES = [
+    "heatshrink/heatshrink_encoder.c",
+    "heatshrink/heatshrink_decoder.c",
+    "toolbox/compress.c",
+]
+
+# Static code protocols, the rest need keystore, rolling counter HAL or storage
+# Emulation waveforms of these protocols are not what a reader sees: PSK cards
+# are synthesized as carrier modulation, EM4100 clock variants and FDX-A alias
+# with other decoders. They are still fed for timing, but not checked.
+LFRFID_NO_LOOPBACK = {
+    "EM4100/RAW/40",
+    "EM4100/32",
+    "Idteck",
+    "Indala26",
+    "Indala224",
+    "AWID",
+    "FDX-A",
+    "Keri",
+    "Nexwatch",
+}
+SUBGHZ_PROTOCOLS = {
+    "ansonic": "subghz_protocol_ansonic",
+    "bett": "subghz_protocol_bett",
+    "came": "subghz_protocol_came",
+    "came_twee": "subghz_protocol_came_twee",
+    "chamberlain_code": "subghz_protocol_chamb_code",
+    "clemsa": "subghz_protocol_clemsa",
+    "doitrand": "subghz_protocol_doitrand",
+    "dooya": "subghz_protocol_dooya",
+    "gate_tx": "subghz_protocol_gate_tx",
+    "holtek": "subghz_protocol_holtek",
+    "holtek_ht12x": "subghz_protocol_holtek_th12x",
+    "honeywell_wdb": "subghz_protocol_honeywell_wdb",
+    "hormann": "subghz_protocol_hormann",
+    "ido": "subghz_protocol_ido",
+    "intertechno_v3": "subghz_protocol_intertechno_v3",
+    "linear": "subghz_protocol_linear",
+    "linear_delta3": "subghz_protocol_linear_delta3",
+    "magellan": "subghz_protocol_magellan",
+    "marantec": "subghz_protocol_marantec",
+    "mastercode": "subghz_protocol_mastercode",
+    "megacode": "subghz_protocol_megacode",
+    "nero_radio": "subghz_protocol_nero_radio",
+    "nero_sketch": "subghz_protocol_nero_sketch",
+    "nice_flo": "subghz_protocol_nice_flo",
+    "phoenix_v2": "subghz_protocol_phoenix_v2",
+    "power_smart": "subghz_protocol_power_smart",
+    "princeton": "subghz_protocol_princeton",
+    "scher_khan": "subghz_protocol_scher_khan",
+    "secplus_v1": "subghz_protocol_secplus_v1",
+    "smc5326": "subghz_protocol_smc5326",
+    "x10": "subghz_protocol_x10",
+}
+
+CFLAGS = [
+    "-O2",
+    "-DNDEBUG",
+    "-DTRACE_HOST",
+    "-include",
+    os.path.join(BENCH_DIR, "core_bench_alloc.h"),
+]
+TRACE_CAPACITY = 4096
+TRACE_RECORDS = 100000
+
+RESULT_FIELDS = (
+    "ops",
+    "time_ns",
+    "allocations",
+    "allocated_bytes",
+    "peak_heap",
+    "leftover_heap",
+)
+
+
+def read_sub_protocol(path):
+    with open(path) as file:
+        for line in file:
+            key, sep, value = line.partition(":")
+            if sep and key.strip() == "Protocol":
+                return value.strip()
+    return None
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument(
+            "-r", "--rounds", type=int, default=20, help="Timed rounds per case"
+        )
+        self.parser.add_argument("-o", "--output", help="Save results as JSON")
+        self.parser.add_argument(
+            "-b", "--baseline", help="Compare with results saved by --output"
+        )
+        self.parser.add_argument(
+            "-t",
+            "--threshold",
+            type=float,
+            default=10.0,
+            help="Allowed ops/sec drop against baseline, percent",
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _sources(self):
+        sources = [os.path.join(LIB_DIR, source) for source in LIB_SOURCES]
+        sources += [
+            os.path.join(LIB_DIR, "subghz", "protocols", f"{name}.c")
+            for name in SUBGHZ_PROTOCOLS
+        ]
+        for directory in LIB_SOURCE_DIRS:
+            for dirpath, _, filenames in os.walk(os.path.join(LIB_DIR, directory)):
+                sources += [
+                    os.path.join(dirpath, name)
+                    for name in sorted(filenames)
+                    if name.endswith(".c")
+                ]
+        return sources
+
+    def _build(self, build_dir):
+        includes = []
+        for path in (*STUB_DIRS, *INCLUDE_DIRS):
+            includes += ["-I", path]
+        defines = [
+            "-DCORE_BENCH_SUBGHZ_PROTOCOLS(X)="
+            + " ".join(f"X({symbol})" for symbol in SUBGHZ_PROTOCOLS.values())
+        ]
+
+        sources = self._sources()
+        # Submodule may be missing in source snapshots
+        if os.path.exists(os.path.join(LIB_DIR, HEATSHRINK_SOURCES[0])):
+            sources += [os.path.join(LIB_DIR, source) for source in HEATSHRINK_SOURCES]
+            defines.append("-DCORE_BENCH_HEATSHRINK")
+        else:
+            self.logger.warning(
+                "lib/heatshrink is not checked out, skipping heatshrink"
+            )
+
+        objects = []
+        for index, source in enumerate(sources):
+            obj = os.path.join(build_dir, f"{index}.o")
+            subprocess.check_call(
+                [self.args.cc, *CFLAGS, "-w", *includes, "-c", source, "-o", obj]
+            )
+            objects.append(obj)
+
+        # Accounting itself calls the host allocator
+        alloc_obj = os.path.join(build_dir, "core_bench_alloc.o")
+        subprocess.check_call(
+            [
+                self.args.cc,
+                *("-O2", "-Wall", "-Wextra", "-Werror"),
+                "-c",
+                os.path.join(BENCH_DIR, "core_bench_alloc.c"),
+                "-o",
+                alloc_obj,
+            ]
+        )
+
+        binary = os.path.join(build_dir, "core_bench")
+        subprocess.check_call(
+            [
+                self.args.cc,
+                *CFLAGS,
+                *("-Wall", "-Wextra", "-Werror"),
+                *includes,
+                *defines,
+                os.path.join(BENCH_DIR, "core_bench.c"),
+                alloc_obj,
+                *objects,
+                "-o",
+                binary,
+                "-lm",
+                "-pthread",
+            ]
+        )
+        return binary
+
+    def _vectors(self):
+        subghz_dir = os.path.join(RESOURCES_DIR, "subghz")
+        sub_files = sorted(
+            os.path.join(subghz_dir, name)
+            for name in os.listdir(subghz_dir)
+            if name.endswith(".sub")
+        )
+        lines = [f"sub {path}\n" for path in sub_files]
+
+        infrared_dir = os.path.join(RESOURCES_DIR, "infrared")
+        infrared_expected = {}
+        for name in sorted(os.listdir(infrared_dir)):
+            if not name.endswith(".irtest"):
+                continue
+            tests = load_infrared_tests(os.path.join(infrared_dir, name))
+            for index, (timings, expected) in tests.items():
+                signal = f"{os.path.splitext(name)[0]}:{index}"
+                lines.append(f"ir {signal} {' '.join(map(str, timings))}\n")
+                infrared_expected[signal] = len(expected)
+
+        return "".join(lines), sub_files, infrared_expected
+
+    def _verify(self, checks, sub_files, infrared_expected):
+        errors = []
+
+        for name, values in checks["flipper_format"].items():
+            if int(values[0]) < 3:
+                errors.append(f"flipper_format: {name} not parsed")
+
+        subghz_names = set(checks["subghz_protocol"])
+        for path in sub_files:
+            name = os.path.basename(path)
+            key_file = path.replace("_raw.sub", ".sub")
+            if not name.endswith("_raw.sub") or not os.path.exists(key_file):
+                continue
+            protocol = read_sub_protocol(key_file)
+            decoded = checks["subghz_decode"].get(name, [])
+            if protocol in subghz_names and protocol not in decoded:
+                errors.append(
+                    f"subghz_decode: {name} decoded as {decoded}, expected {protocol}"
+                )
+
+        for signal, expected in infrared_expected.items():
+            decoded = int(checks["infrared_decode"][signal][0])
+            if decoded != expected:
+                errors.append(
+                    f"infrared_decode: {signal} {decoded} messages, expected {expected}"
+                )
+
+        for protocol, (decoded,) in checks["lfrfid_decode"].items():
+            if decoded != protocol and protocol not in LFRFID_NO_LOOPBACK:
+                errors.append(f"lfrfid_decode: {protocol} decoded as {decoded}")
+
+        exported = int(checks["trace"]["exported"][0])
+        dropped = int(checks["trace"]["dropped"][0])
+        if exported != TRACE_CAPACITY or dropped != TRACE_RECORDS - TRACE_CAPACITY:
+            errors.append(f"trace: {exported} exported, {dropped} dropped")
+
+        for case in ("crypto1", "heatshrink"):
+            mismatches = checks.get(case, {}).get("mismatches", ["0"])[0]
+            if mismatches != "0":
+                errors.append(f"{case}: {mismatches} mismatches")
+
+        return errors
+
+    def _run(self, binary, vectors):
+        output = subprocess.check_output(
+            [binary, str(self.args.rounds)], input=vectors, text=True
+        )
+        checks = {}
+        results = {}
+        for line in output.splitlines():
+            kind, case, *fields = line.split()
+            if kind == "check":
+                item, *values = fields
+                checks.setdefault(case, {})[item] = values
+            elif kind == "result":
+                result = dict(zip(RESULT_FIELDS, map(int, fields)))
+                result["ops_per_sec"] = result["ops"] * 1e9 / max(result["time_ns"], 1)
+                results[case] = result
+        return checks, results
+
+    @staticmethod
+    def _revision():
+        try:
+            return subprocess.check_output(
+                ["git", "rev-parse", "--short", "HEAD"],
+                cwd=ROOT_DIR,
+                text=True,
+                stderr=subprocess.DEVNULL,
+            ).strip()
+        except (OSError, subprocess.CalledProcessError):
+            return None
+
+    def _compare(self, results, baseline):
+        regressions = 0
+        for case, result in results.items():
+            base = baseline.get(case)
+            if not base:
+                continue
+            change = (result["ops_per_sec"] / base["ops_per_sec"] - 1) * 100
+            if change < -self.args.threshold:
+                self.logger.error(f"{case}: ops/sec {change:+.1f}%")
+                regressions += 1
+            for field in ("allocations", "peak_heap", "leftover_heap"):
+                if field in base and result[field] > base[field]:
+                    self.logger.error(
+                        f"{case}: {field} {base[field]} -> {result[field]}"
+                    )
+                    regressions += 1
+        return regressions
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        baseline = None
+        if self.args.baseline:
+            with open(self.args.baseline) as file:
+                baseline = json.load(file)["cases"]
+
+        vectors, sub_files, infrared_expected = self._vectors()
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            try:
+                checks, results = self._run(binary, vectors)
+            except subprocess.CalledProcessError:
+                self.logger.error("Benchmark failed")
+                return 1
+
+        errors = self._verify(checks, sub_files, infrared_expected)
+        for error in errors:
+            self.logger.error(error)
+
+        print(
+            f"{'Case':<16} {'Ops':>10} {'Ops/sec':>12} {'Allocs':>8} {'Bytes':>10} "
+            f"{'Peak':>8} {'Leftover':>8} {'Change':>8}"
+        )
+        for case, result in results.items():
+            change = ""
+            if baseline and case in baseline:
+                ratio = result["ops_per_sec"] / baseline[case]["ops_per_sec"]
+                change = f"{(ratio - 1) * 100:+.1f}%"
+            print(
+                f"{case:<16} {result['ops']:>10} {result['ops_per_sec']:>12.0f} "
+                f"{result['allocations']:>8} {result['allocated_bytes']:>10} "
+                f"{result['peak_heap']:>8} {result['leftover_heap']:>8} {change:>8}"
+            )
+
+        if self.args.output:
+            with open(self.args.output, "w") as file:
+                json.dump(
+                    {
+                        "revision": self._revision(),
+                        "rounds": self.args.rounds,
+                        "cases": results,
+                    },
+                    file,
+                    indent=2,
+                )
+
+        if errors:
+            self.logger.error(f"{len(errors)} checks failed")
+            return 1
+        if baseline and self._compare(results, baseline):
+            return 1
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,609 @@
+/*
+ * Host benchmark of core libraries, see scripts/core_bench.py
+ *
+ * Usage: core_bench <rounds> < vectors
+ *
+ * Vectors are read from stdin, one per line:
+ *     sub <path>                  SubGhz file, key or RAW
+ *     ir <name> <timing> ...      infrared signal, as in scripts/infrared_bench
+ *
+ * Every case runs once with heap accounting and prints correctness checks as
+ * "check <case> <item> <value>", then runs <rounds> times for timing. Prints
+ * "result <case> <ops> <time ns> <allocations> <allocated bytes> <peak bytes>
+ * <leftover bytes>" per case. Heap figures are taken on the check run, not on
+ * the timed rounds: peak and leftover are bytes in use at most and at the end,
+ * both including heap held by loaded vectors.
+ *
+ * SubGhz protocols are compiled in with -DCORE_BENCH_SUBGHZ_PROTOCOLS="X(sym) ...",
+ * heatshrink with -DCORE_BENCH_HEATSHRINK when the submodule is checked out.
+ */
+
+#include <furi.h>
+#include <time.h>
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <infrared.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <nfc/protocols/mf_classic/crypto1.h>
+#include <subghz/protocols/base.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/trace.h>
+
+#ifdef CORE_BENCH_HEATSHRINK
+#include <toolbox/compress.h>
+#endif
+
+#include "core_bench_alloc.h"
+
+#define CORE_BENCH_LINE_SIZE (256 * 1024)
+#define CORE_BENCH_LFRFID_PAIRS (2000)
+/* Same as lfrfid_raw_worker.c, encoder durations are in 1/8 us */
+#define CORE_BENCH_LFRFID_TIMING_MULTIPLIER (8)
+#define CORE_BENCH_CRYPTO1_BLOCK_SIZE (64)
+#define CORE_BENCH_CRYPTO1_BLOCKS (256)
+#define CORE_BENCH_HEATSHRINK_CHUNK (1024)
+#define CORE_BENCH_TRACE_CAPACITY (4096)
+#define CORE_BENCH_TRACE_RECORDS (100000)
+
+#define CORE_BENCH_SUBGHZ_EXTERN(symbol) extern const SubGhzProtocol symbol;
+#define CORE_BENCH_SUBGHZ_ITEM(symbol) &symbol,
+
+#ifdef CORE_BENCH_SUBGHZ_PROTOCOLS
+CORE_BENCH_SUBGHZ_PROTOCOLS(CORE_BENCH_SUBGHZ_EXTERN)
+static const SubGhzProtocol* const subghz_protocols[] = {
+    CORE_BENCH_SUBGHZ_PROTOCOLS(CORE_BENCH_SUBGHZ_ITEM)};
+#else
+static const SubGhzProtocol* const subghz_protocols[] = {NULL};
+#endif
+
+typedef struct {
+    char* name;
+    char* data;
+    size_t size;
+    int32_t* timings; /* RAW_Data of RAW files */
+    size_t timings_count;
+} CoreBenchSub;
+
+typedef struct {
+    char* name;
+    uint32_t* timings;
+    size_t count;
+} CoreBenchIr;
+
+typedef struct {
+    ProtocolId protocol;
+    uint32_t* pulses;
+    uint32_t* durations;
+    size_t count;
+} CoreBenchRfid;
+
+typedef struct {
+    CoreBenchSub* subs;
+    size_t sub_count;
+    CoreBenchIr* irs;
+    size_t ir_count;
+    CoreBenchRfid* rfids;
+    size_t rfid_count;
+    uint8_t* blob; /* All SubGhz files back to back */
+    size_t blob_size;
+} CoreBench;
+
+typedef struct {
+    const char* name;
+    /* Returns number of operations done, checks are printed when check is set */
+    size_t (*run)(CoreBench* bench, bool check);
+} CoreBenchCase;
+
+static uint64_t core_bench_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Value sink, keeps the optimizer from dropping decoded results */
+static volatile uint32_t core_bench_sink;
+
+/******************************** flipper_format ********************************/
+
+/* Reads a SubGhz file the way the SubGhz app loads it, returns number of values read.
+ * RAW_Data of RAW files is appended to timings when given, which must fit every value. */
+static size_t
+    core_bench_sub_parse(const CoreBenchSub* sub, int32_t* timings, size_t* timings_count) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    FuriString* string = furi_string_alloc();
+    size_t values = 0;
+
+    stream_write(stream, (const uint8_t*)sub->data, sub->size);
+    stream_rewind(stream);
+
+    do {
+        uint32_t version = 0;
+        if(!flipper_format_read_header(flipper_format, string, &version)) break;
+
+        uint32_t frequency = 0;
+        if(!flipper_format_read_uint32(flipper_format, "Frequency", &frequency, 1)) break;
+        if(!flipper_format_read_string(flipper_format, "Preset", string)) break;
+        if(!flipper_format_read_string(flipper_format, "Protocol", string)) break;
+        values = 3;
+
+        if(furi_string_cmp_str(string, "RAW") == 0) {
+            int32_t buffer[512];
+            uint32_t count = 0;
+            while(flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) {
+                if(!count || count > COUNT_OF(buffer)) break;
+                if(!flipper_format_read_int32(flipper_format, "RAW_Data", buffer, count)) break;
+                if(timings) {
+                    memcpy(&timings[*timings_count], buffer, count * sizeof(int32_t));
+                    *timings_count += count;
+                }
+                values += count;
+            }
+        } else {
+            uint32_t bit = 0;
+            uint8_t key[8];
+            if(flipper_format_read_uint32(flipper_format, "Bit", &bit, 1)) values++;
+            if(flipper_format_read_hex(flipper_format, "Key", key, sizeof(key))) values++;
+            core_bench_sink = bit + key[7];
+        }
+    } while(false);
+
+    furi_string_free(string);
+    flipper_format_free(flipper_format);
+    return values;
+}
+
+static size_t core_bench_flipper_format(CoreBench* bench, bool check) {
+    for(size_t i = 0; i < bench->sub_count; i++) {
+        size_t values = core_bench_sub_parse(&bench->subs[i], NULL, NULL);
+        if(check) printf("check flipper_format %s %zu\n", bench->subs[i].name, values);
+    }
+    return bench->sub_count;
+}
+
+/******************************** stream ********************************/
+
+static size_t core_bench_stream(CoreBench* bench, bool check) {
+    Stream* stream = string_stream_alloc();
+    FuriString* line = furi_string_alloc();
+    size_t total = 0;
+
+    for(size_t i = 0; i < bench->sub_count; i++) {
+        stream_clean(stream);
+        stream_write(stream, (const uint8_t*)bench->subs[i].data, bench->subs[i].size);
+        stream_rewind(stream);
+
+        size_t lines = 0;
+        while(stream_read_line(stream, line)) {
+            lines++;
+        }
+        if(check) printf("check stream %s %zu\n", bench->subs[i].name, lines);
+        total += lines;
+    }
+
+    furi_string_free(line);
+    stream_free(stream);
+    return total;
+}
+
+/******************************** subghz ********************************/
+
+typedef struct {
+    const char* decoded[COUNT_OF(subghz_protocols)];
+    size_t decoded_count;
+} CoreBenchSubGhzResult;
+
+static void core_bench_subghz_callback(SubGhzProtocolDecoderBase* decoder, void* context) {
+    CoreBenchSubGhzResult* result = context;
+    if(!result) return;
+
+    const char* name = decoder->protocol->name;
+    for(size_t i = 0; i < result->decoded_count; i++) {
+        if(result->decoded[i] == name) return;
+    }
+    result->decoded[result->decoded_count++] = name;
+}
+
+static size_t core_bench_subghz_decode(CoreBench* bench, bool check) {
+    const size_t protocol_count = subghz_protocols[0] ? COUNT_OF(subghz_protocols) : 0;
+    SubGhzProtocolDecoderBase* decoders[COUNT_OF(subghz_protocols)];
+    CoreBenchSubGhzResult result;
+    size_t samples = 0;
+
+    // Same as SubGhzReceiver: one decoder per protocol, every duration goes to all of them
+    for(size_t i = 0; i < protocol_count; i++) {
+        decoders[i] = subghz_protocols[i]->decoder->alloc(NULL);
+        subghz_protocol_decoder_base_set_decoder_callback(
+            decoders[i], core_bench_subghz_callback, check ? &result : NULL);
+        if(check) printf("check subghz_protocol %s 1\n", subghz_protocols[i]->name);
+    }
+
+    for(size_t i = 0; i < bench->sub_count; i++) {
+        const CoreBenchSub* sub = &bench->subs[i];
+        if(!sub->timings_count) continue;
+
+        result.decoded_count = 0;
+        for(size_t j = 0; j < protocol_count; j++) {
+            subghz_protocols[j]->decoder->reset(decoders[j]);
+        }
+        for(size_t k = 0; k < sub->timings_count; k++) {
+            bool level = sub->timings[k] > 0;
+            uint32_t duration = level ? sub->timings[k] : -sub->timings[k];
+            for(size_t j = 0; j < protocol_count; j++) {
+                subghz_protocols[j]->decoder->feed(decoders[j], level, duration);
+            }
+        }
+        samples += sub->timings_count;
+
+        if(check) {
+            printf("check subghz_decode %s", sub->name);
+            for(size_t j = 0; j < result.decoded_count; j++) {
+                printf(" %s", result.decoded[j]);
+            }
+            printf("\n");
+        }
+    }
+
+    for(size_t i = 0; i < protocol_count; i++) {
+        subghz_protocols[i]->decoder->free(decoders[i]);
+    }
+    return samples;
+}
+
+/******************************** infrared ********************************/
+
+static size_t core_bench_infrared_decode(CoreBench* bench, bool check) {
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+    size_t samples = 0;
+
+    // Same replay as infrared unit tests and scripts/infrared_bench
+    for(size_t i = 0; i < bench->ir_count; i++) {
+        const CoreBenchIr* ir = &bench->irs[i];
+        size_t messages = 0;
+        bool level = false;
+
+        infrared_reset_decoder(decoder);
+        for(size_t j = 0; j < ir->count; j++) {
+            if(ir->timings[j] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+                messages += infrared_check_decoder_ready(decoder) != NULL;
+            }
+            messages += infrared_decode(decoder, level, ir->timings[j]) != NULL;
+            level = !level;
+        }
+        messages += infrared_check_decoder_ready(decoder) != NULL;
+        samples += ir->count;
+
+        if(check) printf("check infrared_decode %s %zu\n", ir->name, messages);
+    }
+
+    infrared_free_decoder(decoder);
+    return samples;
+}
+
+/******************************** lfrfid ********************************/
+
+static void core_bench_rfid_synth(CoreBench* bench) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    bench->rfids = calloc(LFRFIDProtocolMax, sizeof(CoreBenchRfid));
+
+    for(size_t protocol = 0; protocol < LFRFIDProtocolMax; protocol++) {
+        size_t data_size = protocol_dict_get_data_size(dict, protocol);
+        uint8_t* data = malloc(data_size);
+        for(size_t i = 0; i < data_size; i++) {
+            data[i] = 0x1D * (i + 1);
+        }
+        protocol_dict_set_data(dict, protocol, data, data_size);
+        free(data);
+
+        // Protocols without encoder can't be synthesized
+        if(!protocol_dict_encoder_start(dict, protocol)) continue;
+
+        CoreBenchRfid* rfid = &bench->rfids[bench->rfid_count++];
+        rfid->protocol = protocol;
+        rfid->pulses = malloc(CORE_BENCH_LFRFID_PAIRS * sizeof(uint32_t));
+        rfid->durations = malloc(CORE_BENCH_LFRFID_PAIRS * sizeof(uint32_t));
+
+        pulse_glue_reset(pulse_glue);
+        while(rfid->count < CORE_BENCH_LFRFID_PAIRS) {
+            LevelDuration level_duration = protocol_dict_encoder_yield(dict, protocol);
+            if(!pulse_glue_push(
+                   pulse_glue,
+                   level_duration_get_level(level_duration),
+                   level_duration_get_duration(level_duration) *
+                       CORE_BENCH_LFRFID_TIMING_MULTIPLIER)) {
+                continue;
+            }
+            pulse_glue_pop(
+                pulse_glue, &rfid->durations[rfid->count], &rfid->pulses[rfid->count]);
+            rfid->count++;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+    protocol_dict_free(dict);
+}
+
+static size_t core_bench_lfrfid_decode(CoreBench* bench, bool check) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    size_t pairs = 0;
+
+    // Same feeding as lfrfid read worker, decoders of the modulation being read
+    for(size_t i = 0; i < bench->rfid_count; i++) {
+        const CoreBenchRfid* rfid = &bench->rfids[i];
+        ProtocolId decoded = PROTOCOL_NO;
+        uint32_t feature = protocol_dict_get_features(dict, rfid->protocol) & LFRFIDFeaturePSK ?
+                               LFRFIDFeaturePSK :
+                               LFRFIDFeatureASK;
+
+        protocol_dict_decoders_start(dict);
+        for(size_t j = 0; j < rfid->count; j++) {
+            ProtocolId protocol = protocol_dict_decoders_feed_by_feature(
+                dict, feature, true, rfid->pulses[j]);
+            if(protocol == PROTOCOL_NO) {
+                protocol = protocol_dict_decoders_feed_by_feature(
+                    dict, feature, false, rfid->durations[j] - rfid->pulses[j]);
+            }
+            if(protocol != PROTOCOL_NO && decoded == PROTOCOL_NO) decoded = protocol;
+        }
+        pairs += rfid->count;
+
+        if(check) {
+            printf(
+                "check lfrfid_decode %s %s\n",
+                protocol_dict_get_name(dict, rfid->protocol),
+                decoded == PROTOCOL_NO ? "-" : protocol_dict_get_name(dict, decoded));
+        }
+    }
+
+    protocol_dict_free(dict);
+    return pairs;
+}
+
+/******************************** crypto1 ********************************/
+
+static size_t core_bench_crypto1(CoreBench* bench, bool check) {
+    UNUSED(bench);
+    const uint64_t key = 0xA0A1A2A3A4A5;
+    Crypto1* crypto = crypto1_alloc();
+    BitBuffer* plain = bit_buffer_alloc(CORE_BENCH_CRYPTO1_BLOCK_SIZE);
+    BitBuffer* encrypted = bit_buffer_alloc(CORE_BENCH_CRYPTO1_BLOCK_SIZE);
+    BitBuffer* decrypted = bit_buffer_alloc(CORE_BENCH_CRYPTO1_BLOCK_SIZE);
+    size_t mismatches = 0;
+
+    for(size_t i = 0; i < CORE_BENCH_CRYPTO1_BLOCK_SIZE; i++) {
+        bit_buffer_append_byte(plain, i * 7);
+    }
+
+    // Reader side encrypts, card side decrypts with its own cipher state
+    for(size_t block = 0; block < CORE_BENCH_CRYPTO1_BLOCKS; block++) {
+        crypto1_init(crypto, key ^ block);
+        crypto1_encrypt(crypto, NULL, plain, encrypted);
+        crypto1_init(crypto, key ^ block);
+        crypto1_decrypt(crypto, encrypted, decrypted);
+        mismatches += memcmp(
+                          bit_buffer_get_data(plain),
+                          bit_buffer_get_data(decrypted),
+                          CORE_BENCH_CRYPTO1_BLOCK_SIZE) != 0;
+    }
+    core_bench_sink = bit_buffer_get_byte(encrypted, 0);
+
+    if(check) printf("check crypto1 mismatches %zu\n", mismatches);
+
+    bit_buffer_free(decrypted);
+    bit_buffer_free(encrypted);
+    bit_buffer_free(plain);
+    crypto1_free(crypto);
+    return 2 * CORE_BENCH_CRYPTO1_BLOCKS * CORE_BENCH_CRYPTO1_BLOCK_SIZE;
+}
+
+/******************************** heatshrink ********************************/
+
+#ifdef CORE_BENCH_HEATSHRINK
+static size_t core_bench_heatshrink(CoreBench* bench, bool check) {
+    // Worst case: header and incompressible chunk
+    const size_t encoded_size = CORE_BENCH_HEATSHRINK_CHUNK + 16;
+    Compress* compress = compress_alloc(CORE_BENCH_HEATSHRINK_CHUNK);
+    uint8_t* encoded = malloc(encoded_size);
+    uint8_t* decoded = malloc(CORE_BENCH_HEATSHRINK_CHUNK);
+    size_t compressed = 0;
+    size_t mismatches = 0;
+
+    for(size_t offset = 0; offset < bench->blob_size; offset += CORE_BENCH_HEATSHRINK_CHUNK) {
+        size_t size = MIN((size_t)CORE_BENCH_HEATSHRINK_CHUNK, bench->blob_size - offset);
+        size_t encoded_result = 0;
+        size_t decoded_result = 0;
+
+        if(!compress_encode(
+               compress, &bench->blob[offset], size, encoded, encoded_size, &encoded_result) ||
+           !compress_decode(
+               compress,
+               encoded,
+               encoded_result,
+               decoded,
+               CORE_BENCH_HEATSHRINK_CHUNK,
+               &decoded_result) ||
+           decoded_result != size || memcmp(decoded, &bench->blob[offset], size) != 0) {
+            mismatches++;
+        }
+        compressed += encoded_result;
+    }
+
+    if(check) {
+        printf("check heatshrink mismatches %zu\n", mismatches);
+        printf("check heatshrink ratio %.3f\n", (double)compressed / bench->blob_size);
+    }
+
+    free(decoded);
+    free(encoded);
+    compress_free(compress);
+    return 2 * bench->blob_size;
+}
+#endif
+
+/******************************** trace ********************************/
+
+static void core_bench_trace_output(const char* data, size_t size, void* context) {
+    UNUSED(data);
+    *(size_t*)context += size;
+}
+
+/* Trace points stopped, then recording with ring buffer wraparound */
+static size_t core_bench_trace(CoreBench* bench, bool check) {
+    UNUSED(bench);
+
+    for(uint32_t i = 0; i < CORE_BENCH_TRACE_RECORDS; i++) {
+        TRACE_COUNTER(UnitTest, i);
+    }
+
+    furi_check(trace_start(CORE_BENCH_TRACE_CAPACITY));
+    for(uint32_t i = 0; i < CORE_BENCH_TRACE_RECORDS; i++) {
+        TRACE_COUNTER(UnitTest, i);
+    }
+    trace_stop();
+
+    if(check) {
+        size_t size = 0;
+        size_t exported = trace_export_chrome(core_bench_trace_output, &size);
+        printf("check trace exported %zu\n", exported);
+        printf("check trace dropped %zu\n", trace_get_dropped());
+    }
+    trace_free();
+
+    return CORE_BENCH_TRACE_RECORDS * 2;
+}
+
+/******************************** runner ********************************/
+
+static const CoreBenchCase core_bench_cases[] = {
+    {.name = "flipper_format", .run = core_bench_flipper_format},
+    {.name = "stream", .run = core_bench_stream},
+    {.name = "subghz_decode", .run = core_bench_subghz_decode},
+    {.name = "infrared_decode", .run = core_bench_infrared_decode},
+    {.name = "lfrfid_decode", .run = core_bench_lfrfid_decode},
+    {.name = "crypto1", .run = core_bench_crypto1},
+#ifdef CORE_BENCH_HEATSHRINK
+    {.name = "heatshrink", .run = core_bench_heatshrink},
+#endif
+    {.name = "trace", .run = core_bench_trace},
+};
+
+static bool core_bench_load_sub(CoreBench* bench, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+
+    CoreBenchSub* sub = &bench->subs[bench->sub_count];
+    fseek(file, 0, SEEK_END);
+    sub->size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    sub->data = malloc(sub->size);
+    bool success = fread(sub->data, 1, sub->size, file) == sub->size;
+    fclose(file);
+    if(!success) {
+        free(sub->data);
+        return false;
+    }
+
+    const char* name = strrchr(path, '/');
+    sub->name = strdup(name ? name + 1 : path);
+    // Every value takes at least two characters
+    sub->timings = malloc((sub->size / 2 + 1) * sizeof(int32_t));
+    sub->timings_count = 0;
+    core_bench_sub_parse(sub, sub->timings, &sub->timings_count);
+
+    bench->blob = realloc(bench->blob, bench->blob_size + sub->size);
+    memcpy(&bench->blob[bench->blob_size], sub->data, sub->size);
+    bench->blob_size += sub->size;
+    bench->sub_count++;
+    return true;
+}
+
+static void core_bench_load_ir(CoreBench* bench, const char* name, char* timings) {
+    CoreBenchIr* ir = &bench->irs[bench->ir_count++];
+    size_t capacity = 0;
+    char* save = NULL;
+
+    ir->name = strdup(name);
+    ir->timings = NULL;
+    ir->count = 0;
+    for(char* token = strtok_r(timings, " \n", &save); token;
+        token = strtok_r(NULL, " \n", &save)) {
+        if(ir->count == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            ir->timings = realloc(ir->timings, capacity * sizeof(uint32_t));
+        }
+        ir->timings[ir->count++] = strtoul(token, NULL, 10);
+    }
+}
+
+static bool core_bench_load(CoreBench* bench) {
+    char* line = malloc(CORE_BENCH_LINE_SIZE);
+    size_t sub_capacity = 0;
+    size_t ir_capacity = 0;
+    bool success = true;
+
+    while(success && fgets(line, CORE_BENCH_LINE_SIZE, stdin)) {
+        char* save = NULL;
+        const char* kind = strtok_r(line, " \n", &save);
+        const char* name = strtok_r(NULL, " \n", &save);
+        if(!kind || !name) continue;
+
+        if(!strcmp(kind, "sub")) {
+            if(bench->sub_count == sub_capacity) {
+                sub_capacity = sub_capacity ? sub_capacity * 2 : 64;
+                bench->subs = realloc(bench->subs, sub_capacity * sizeof(CoreBenchSub));
+            }
+            success = core_bench_load_sub(bench, name);
+            if(!success) fprintf(stderr, "can't load %s\n", name);
+        } else if(!strcmp(kind, "ir")) {
+            if(bench->ir_count == ir_capacity) {
+                ir_capacity = ir_capacity ? ir_capacity * 2 : 64;
+                bench->irs = realloc(bench->irs, ir_capacity * sizeof(CoreBenchIr));
+            }
+            core_bench_load_ir(bench, name, save);
+        }
+    }
+
+    free(line);
+    core_bench_rfid_synth(bench);
+    return success;
+}
+
+int main(int argc, char** argv) {
+    unsigned rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 10;
+    CoreBench bench = {0};
+
+    if(!core_bench_load(&bench)) return 1;
+
+    for(size_t i = 0; i < COUNT_OF(core_bench_cases); i++) {
+        const CoreBenchCase* bench_case = &core_bench_cases[i];
+
+        core_bench_alloc_reset();
+        bench_case->run(&bench, true);
+        CoreBenchAllocStats stats = *core_bench_alloc_get_stats();
+
+        size_t ops = 0;
+        uint64_t start = core_bench_clock_ns();
+        for(unsigned round = 0; round < rounds; round++) {
+            ops += bench_case->run(&bench, false);
+        }
+        uint64_t time = core_bench_clock_ns() - start;
+
+        printf(
+            "result %s %zu %llu %zu %zu %zu %zu\n",
+            bench_case->name,
+            ops,
+            (unsigned long long)time,
+            stats.count,
+            stats.bytes,
+            stats.peak,
+            stats.current);
+        fflush(stdout);
+    }
+
+    return 0;
+}
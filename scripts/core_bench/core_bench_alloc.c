@@ -0,0 +1,64 @@
+#define CORE_BENCH_ALLOC_IMPLEMENTATION
+#include "core_bench_alloc.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Requested size is kept in front of every block */
+typedef union {
+    size_t size;
+    max_align_t align;
+} CoreBenchAllocHeader;
+
+static CoreBenchAllocStats stats;
+
+static void* core_bench_alloc_account(CoreBenchAllocHeader* header, size_t size) {
+    if(!header) return NULL;
+    header->size = size;
+    stats.count++;
+    stats.bytes += size;
+    stats.current += size;
+    if(stats.current > stats.peak) stats.peak = stats.current;
+    return header + 1;
+}
+
+/* Firmware heap hands out zeroed blocks and library code relies on it */
+void* core_bench_malloc(size_t size) {
+    return core_bench_alloc_account(calloc(1, sizeof(CoreBenchAllocHeader) + size), size);
+}
+
+void* core_bench_calloc(size_t count, size_t size) {
+    if(size && count > (SIZE_MAX - sizeof(CoreBenchAllocHeader)) / size) return NULL;
+    return core_bench_alloc_account(
+        calloc(1, sizeof(CoreBenchAllocHeader) + count * size), count * size);
+}
+
+void* core_bench_realloc(void* ptr, size_t size) {
+    if(!ptr) return core_bench_malloc(size);
+
+    CoreBenchAllocHeader* header = (CoreBenchAllocHeader*)ptr - 1;
+    size_t previous = header->size;
+    header = realloc(header, sizeof(CoreBenchAllocHeader) + size);
+    if(!header) return NULL;
+
+    stats.current -= previous;
+    return core_bench_alloc_account(header, size);
+}
+
+void core_bench_free(void* ptr) {
+    if(!ptr) return;
+
+    CoreBenchAllocHeader* header = (CoreBenchAllocHeader*)ptr - 1;
+    stats.current -= header->size;
+    free(header);
+}
+
+void core_bench_alloc_reset(void) {
+    stats.count = 0;
+    stats.bytes = 0;
+    stats.peak = stats.current;
+}
+
+const CoreBenchAllocStats* core_bench_alloc_get_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+/*
+ * Heap accounting for scripts/core_bench.py
+ *
+ * Force included into every benchmarked source. Allocator calls are renamed
+ * with object-like macros, so struct members named free or malloc are renamed
+ * consistently and keep working. System headers are included first to keep
+ * their declarations intact.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    size_t count; /**< Allocations, realloc counts as one */
+    size_t bytes; /**< Bytes requested by allocations */
+    size_t current; /**< Bytes in use */
+    size_t peak; /**< Maximum of current since last reset */
+} CoreBenchAllocStats;
+
+void* core_bench_malloc(size_t size);
+void* core_bench_calloc(size_t count, size_t size);
+void* core_bench_realloc(void* ptr, size_t size);
+void core_bench_free(void* ptr);
+
+/** Clear counters, peak starts from bytes in use */
+void core_bench_alloc_reset(void);
+
+const CoreBenchAllocStats* core_bench_alloc_get_stats(void);
+
+#ifndef CORE_BENCH_ALLOC_IMPLEMENTATION
+#define malloc core_bench_malloc
+#define calloc core_bench_calloc
+#define realloc core_bench_realloc
+#define free core_bench_free
+#endif
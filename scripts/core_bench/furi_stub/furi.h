@@ -0,0 +1,241 @@
+#pragma once
+
+/* Minimal furi replacement for host builds of core libraries, see scripts/core_bench.py */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <core/check.h>
+#include <core/common_defines.h>
+
+/* newlib attribute macro used by printf-like declarations */
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
+
+#ifndef FURI_BIT
+#define FURI_BIT(x, n) (((x) >> (n)) & 1)
+#endif
+
+#ifndef FURI_SWAP
+#define FURI_SWAP(x, y)     \
+    do {                    \
+        typeof(x) SWAP = x; \
+        x = y;              \
+        y = SWAP;           \
+    } while(0)
+#endif
+
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+#define FURI_STRING_FAILURE ((size_t) - 1)
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} FuriString;
+
+static inline void furi_string_reserve(FuriString* string, size_t size) {
+    if(size + 1 <= string->capacity) return;
+    string->capacity = MAX(size + 1, string->capacity * 2);
+    string->data = realloc(string->data, string->capacity);
+}
+
+static inline FuriString* furi_string_alloc(void) {
+    FuriString* string = malloc(sizeof(FuriString));
+    string->capacity = 16;
+    string->data = malloc(string->capacity);
+    string->data[0] = '\0';
+    string->size = 0;
+    return string;
+}
+
+static inline void furi_string_free(FuriString* string) {
+    free(string->data);
+    free(string);
+}
+
+static inline void furi_string_reset(FuriString* string) {
+    string->size = 0;
+    string->data[0] = '\0';
+}
+
+static inline const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+static inline size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+static inline bool furi_string_empty(const FuriString* string) {
+    return string->size == 0;
+}
+
+static inline char furi_string_get_char(const FuriString* string, size_t index) {
+    furi_check(index < string->size);
+    return string->data[index];
+}
+
+static inline void furi_string_set_char(FuriString* string, size_t index, const char c) {
+    furi_check(index < string->size);
+    string->data[index] = c;
+}
+
+static inline void furi_string_set_strn(FuriString* string, const char source[], size_t length) {
+    furi_string_reserve(string, length);
+    memmove(string->data, source, length);
+    string->size = length;
+    string->data[length] = '\0';
+}
+
+static inline void furi_string_set_str(FuriString* string, const char source[]) {
+    furi_string_set_strn(string, source, strlen(source));
+}
+
+static inline void furi_string_set_string(FuriString* string, const FuriString* source) {
+    furi_string_set_strn(string, source->data, source->size);
+}
+
+static inline void furi_string_cat_strn(FuriString* string, const char source[], size_t length) {
+    furi_string_reserve(string, string->size + length);
+    memcpy(&string->data[string->size], source, length);
+    string->size += length;
+    string->data[string->size] = '\0';
+}
+
+static inline void furi_string_cat_str(FuriString* string, const char source[]) {
+    furi_string_cat_strn(string, source, strlen(source));
+}
+
+static inline void furi_string_cat_string(FuriString* string, const FuriString* source) {
+    furi_string_cat_strn(string, source->data, source->size);
+}
+
+static inline void furi_string_push_back(FuriString* string, char c) {
+    furi_string_cat_strn(string, &c, 1);
+}
+
+static inline void furi_string_left(FuriString* string, size_t index) {
+    if(index < string->size) {
+        string->size = index;
+        string->data[index] = '\0';
+    }
+}
+
+static inline void
+    furi_string_replace_at(FuriString* string, size_t pos, size_t len, const char replace[]) {
+    furi_check(pos + len <= string->size);
+    size_t replace_size = strlen(replace);
+    size_t size = string->size - len + replace_size;
+    furi_string_reserve(string, size);
+    memmove(
+        &string->data[pos + replace_size],
+        &string->data[pos + len],
+        string->size - pos - len + 1);
+    memcpy(&string->data[pos], replace, replace_size);
+    string->size = size;
+}
+
+static inline int furi_string_cmp_str(const FuriString* string, const char cstring[]) {
+    return strcmp(string->data, cstring);
+}
+
+static inline int furi_string_cmp_string(const FuriString* string_1, const FuriString* string_2) {
+    return strcmp(string_1->data, string_2->data);
+}
+
+static inline int furi_string_cmpi_str(const FuriString* string, const char cstring[]) {
+    return strcasecmp(string->data, cstring);
+}
+
+static inline int
+    furi_string_cmpi_string(const FuriString* string_1, const FuriString* string_2) {
+    return strcasecmp(string_1->data, string_2->data);
+}
+
+static inline int furi_string_cat_vprintf(FuriString* string, const char format[], va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int size = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if(size < 0) return size;
+
+    furi_string_reserve(string, string->size + size);
+    vsnprintf(&string->data[string->size], size + 1, format, args);
+    string->size += size;
+    return size;
+}
+
+static inline int furi_string_cat_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+static inline int furi_string_vprintf(FuriString* string, const char format[], va_list args) {
+    furi_string_reset(string);
+    return furi_string_cat_vprintf(string, format, args);
+}
+
+static inline int furi_string_printf(FuriString* string, const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_vprintf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+static inline FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
+    FuriString* string = furi_string_alloc();
+    furi_string_cat_vprintf(string, format, args);
+    return string;
+}
+
+static inline FuriString* furi_string_alloc_printf(const char format[], ...) {
+    va_list args;
+    va_start(args, format);
+    FuriString* string = furi_string_alloc_vprintf(format, args);
+    va_end(args);
+    return string;
+}
+
+static inline FuriString* furi_string_alloc_set_str(const char source[]) {
+    FuriString* string = furi_string_alloc();
+    furi_string_set_str(string, source);
+    return string;
+}
+
+static inline FuriString* furi_string_alloc_set_string(const FuriString* source) {
+    FuriString* string = furi_string_alloc();
+    furi_string_set_string(string, source);
+    return string;
+}
+
+/* Same dispatch on the second argument as furi/core/string.h */
+#define FURI_STRING_SELECT(name, b) \
+    _Generic(                       \
+        (b),                        \
+        char*: name##_str,          \
+        const char*: name##_str,    \
+        FuriString*: name##_string, \
+        const FuriString*: name##_string)
+
+#define furi_string_set(a, b) FURI_STRING_SELECT(furi_string_set, b)(a, b)
+#define furi_string_cat(a, b) FURI_STRING_SELECT(furi_string_cat, b)(a, b)
+#define furi_string_cmp(a, b) FURI_STRING_SELECT(furi_string_cmp, b)(a, b)
+#define furi_string_cmpi(a, b) FURI_STRING_SELECT(furi_string_cmpi, b)(a, b)
+#define furi_string_alloc_set(a) FURI_STRING_SELECT(furi_string_alloc_set, a)(a)
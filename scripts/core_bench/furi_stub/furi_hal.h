@@ -0,0 +1,5 @@
+#pragma once
+
+/* Core libraries only need furi_hal.h for radio and RTC helpers that host builds leave out */
+
+#include <furi.h>
@@ -0,0 +1,104 @@
+#pragma once
+
+/* Host builds have no storage, file streams fail to open and benchmarks use string streams */
+
+#include <furi.h>
+#include <storage/filesystem_api_defines.h>
+
+#define STORAGE_ANY_PATH_PREFIX "/any"
+#define ANY_PATH(path) STORAGE_ANY_PATH_PREFIX "/" path
+#define EXT_PATH(path) "/ext/" path
+
+typedef struct Storage Storage;
+
+static inline File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return NULL;
+}
+
+static inline void storage_file_free(File* file) {
+    UNUSED(file);
+}
+
+static inline bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    UNUSED(file);
+    UNUSED(path);
+    UNUSED(access_mode);
+    UNUSED(open_mode);
+    return false;
+}
+
+static inline bool storage_file_close(File* file) {
+    UNUSED(file);
+    return false;
+}
+
+static inline FS_Error storage_file_get_error(File* file) {
+    UNUSED(file);
+    return FSE_NOT_READY;
+}
+
+static inline size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    UNUSED(file);
+    UNUSED(buff);
+    UNUSED(bytes_to_read);
+    return 0;
+}
+
+static inline size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    UNUSED(file);
+    UNUSED(buff);
+    UNUSED(bytes_to_write);
+    return 0;
+}
+
+static inline bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    UNUSED(file);
+    UNUSED(offset);
+    UNUSED(from_start);
+    return false;
+}
+
+static inline uint64_t storage_file_tell(File* file) {
+    UNUSED(file);
+    return 0;
+}
+
+static inline bool storage_file_truncate(File* file) {
+    UNUSED(file);
+    return false;
+}
+
+static inline uint64_t storage_file_size(File* file) {
+    UNUSED(file);
+    return 0;
+}
+
+static inline bool storage_file_eof(File* file) {
+    UNUSED(file);
+    return true;
+}
+
+static inline FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    UNUSED(path);
+    return FSE_NOT_READY;
+}
+
+static inline void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    UNUSED(storage);
+    UNUSED(dirname);
+    UNUSED(fileextension);
+    UNUSED(max_len);
+    furi_string_set(nextfilename, filename);
+}
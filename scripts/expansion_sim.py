@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+
+# Throughput model of expansion module protocol (see documentation/ExpansionModules.md)
+#
+# Both ends are simulated in-process: frames are serialized over a full-duplex
+# UART with 10 bits per byte, every received frame costs fixed processing time
+# on the receiving side. Legacy stop-and-wait DATA transfer is compared to
+# negotiated extended mode with windowed cumulative acknowledgements.
+
+from flipper.app import App
+
+DEFAULT_BAUD_RATES = (9600, 115200, 230400, 460800, 921600, 1843200, 3686400)
+
+BITS_PER_BYTE = 10
+
+# Header + checksum
+FRAME_OVERHEAD = 2
+# Size byte
+DATA_OVERHEAD = 1
+# Sequence number + 2 size bytes
+DATA_EXT_OVERHEAD = 3
+STATUS_FRAME_SIZE = FRAME_OVERHEAD + 1
+ACK_FRAME_SIZE = FRAME_OVERHEAD + 1
+
+LEGACY_DATA_SIZE = 64
+
+
+class Link:
+    def __init__(self, baud_rate, rx_latency, tx_latency):
+        self.byte_time = BITS_PER_BYTE / baud_rate
+        # Receiver: time from last frame byte until the frame is consumed
+        self.rx_latency = rx_latency
+        # Sender: time from last confirmation byte until the next frame is sent
+        self.tx_latency = tx_latency
+
+    def duration(self, size):
+        return size * self.byte_time
+
+
+def simulate_legacy(link, total_size):
+    time = 0.0
+    for offset in range(0, total_size, LEGACY_DATA_SIZE):
+        chunk = min(LEGACY_DATA_SIZE, total_size - offset)
+        time += link.duration(FRAME_OVERHEAD + DATA_OVERHEAD + chunk)
+        time += link.rx_latency
+        time += link.duration(STATUS_FRAME_SIZE)
+        time += link.tx_latency
+    return time
+
+
+def simulate_windowed(link, total_size, data_size, window_size):
+    chunks = [
+        min(data_size, total_size - offset)
+        for offset in range(0, total_size, data_size)
+    ]
+    count = len(chunks)
+    ack_threshold = max(window_size // 2, 1)
+
+    start = [None] * count
+    arrival = [None] * count
+    # Time the sender learns that frame was acknowledged
+    acked = [None] * count
+
+    tx_free = 0.0
+    rx_free = 0.0
+    ack_line_free = 0.0
+    unacked = []
+
+    def try_start(index):
+        if index >= count or start[index] is not None:
+            return
+        if index >= window_size:
+            released = acked[index - window_size]
+            if released is None:
+                return
+        else:
+            released = 0.0
+        nonlocal tx_free
+        start[index] = max(tx_free, released)
+        tx_free = start[index] + link.duration(
+            FRAME_OVERHEAD + DATA_EXT_OVERHEAD + chunks[index]
+        )
+        arrival[index] = tx_free
+
+    for index in range(min(window_size, count)):
+        try_start(index)
+
+    for index in range(count):
+        try_start(index)
+        rx_free = max(rx_free, arrival[index]) + link.rx_latency
+        unacked.append(index)
+
+        # Receive buffer is empty when next frame was not started yet
+        try_start(index + 1)
+        buffer_empty = index + 1 >= count or start[index + 1] is None
+        buffer_empty = buffer_empty or start[index + 1] >= rx_free
+
+        if len(unacked) >= ack_threshold or buffer_empty:
+            ack_line_free = max(ack_line_free, rx_free) + link.duration(ACK_FRAME_SIZE)
+            for pending in unacked:
+                acked[pending] = ack_line_free + link.tx_latency
+            unacked.clear()
+
+    return max(acked[-1], rx_free)
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument(
+            "-s", "--size", type=int, default=64 * 1024, help="Transfer size, bytes"
+        )
+        self.parser.add_argument(
+            "--data-size", type=int, default=256, help="Extended data frame size"
+        )
+        self.parser.add_argument(
+            "-w", "--window", type=int, default=4, help="Extended mode window size"
+        )
+        self.parser.add_argument(
+            "--rx-latency",
+            type=float,
+            default=0.5,
+            help="Frame processing time on receiving side, ms",
+        )
+        self.parser.add_argument(
+            "--tx-latency",
+            type=float,
+            default=0.1,
+            help="Confirmation processing time on sending side, ms",
+        )
+        self.parser.add_argument(
+            "-b",
+            "--baud",
+            type=int,
+            action="append",
+            help="Baud rate to simulate, can be repeated",
+        )
+        self.parser.set_defaults(func=self.simulate)
+
+    def simulate(self):
+        if self.args.size <= 0 or self.args.data_size <= 0 or self.args.window <= 0:
+            self.logger.error("Size, data size and window must be positive")
+            return 1
+
+        baud_rates = self.args.baud or DEFAULT_BAUD_RATES
+
+        print(
+            f"{self.args.size} bytes, extended frames of {self.args.data_size} bytes, "
+            f"window {self.args.window}"
+        )
+        print(
+            f"{'Baud':>9} {'Line KiB/s':>11} {'Legacy KiB/s':>13} "
+            f"{'Ext KiB/s':>10} {'Gain':>6}"
+        )
+
+        for baud_rate in baud_rates:
+            link = Link(
+                baud_rate, self.args.rx_latency / 1000, self.args.tx_latency / 1000
+            )
+            line = baud_rate / BITS_PER_BYTE / 1024
+            legacy = self.args.size / simulate_legacy(link, self.args.size) / 1024
+            extended = (
+                self.args.size
+                / simulate_windowed(
+                    link, self.args.size, self.args.data_size, self.args.window
+                )
+                / 1024
+            )
+            print(
+                f"{baud_rate:>9} {line:>11.1f} {legacy:>13.1f} {extended:>10.1f} "
+                f"{extended / legacy:>5.2f}x"
+            )
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
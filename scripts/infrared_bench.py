@@ -0,0 +1,282 @@
+#!/usr/bin/env python3
+
+# Host benchmark of infrared decoders
+#
+# Builds lib/infrared/encoder_decoder with the host compiler together with
+# scripts/infrared_bench/infrared_bench.c and replays decoder inputs from unit
+# test resources. Decoded messages are checked against expected ones, decoding
+# cost is reported in nanoseconds per sample. Run it on two commits to compare.
+#
+# Then scripts/infrared_bench/infrared_splice.c splices random jittered slices
+# of the same inputs and checks that the library decodes them exactly as a
+# reference feeding every sample to every protocol decoder.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+INFRARED_DIR = os.path.join(ROOT_DIR, "lib", "infrared", "encoder_decoder")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "infrared_bench")
+TESTS_DIR = os.path.join(
+    ROOT_DIR, "applications", "debug", "unit_tests", "resources", "unit_tests"
+)
+TESTS_DIR = os.path.join(TESTS_DIR, "infrared")
+
+CFLAGS = ["-O2", "-DNDEBUG"]
+HARNESS_CFLAGS = ["-Wall", "-Wextra", "-Werror"]
+
+
+def parse_hex(value):
+    return int.from_bytes(bytes.fromhex(value), "little")
+
+
+def load_tests(path):
+    """Returns {index: (timings, [(protocol, address, command, repeat)])}"""
+    records = []
+    record = {}
+    with open(path) as file:
+        for line in file:
+            line = line.strip()
+            if line.startswith("#"):
+                if record:
+                    records.append(record)
+                record = {}
+                continue
+            key, sep, value = line.partition(":")
+            key = key.strip()
+            # Long arrays are split into several lines with the same key
+            if sep and key in record:
+                record[key] += " " + value.strip()
+            elif sep:
+                record[key] = value.strip()
+    if record:
+        records.append(record)
+
+    inputs = {}
+    expected = {}
+    current = None
+    for record in records:
+        name = record.get("name")
+        if name is not None:
+            current = None
+        if name and name.startswith("decoder_input") and record.get("type") == "raw":
+            inputs[name[len("decoder_input") :]] = [
+                int(timing) for timing in record["data"].split()
+            ]
+        elif name and name.startswith("decoder_expected"):
+            current = expected.setdefault(name[len("decoder_expected") :], [])
+        # First message may share a block with array header
+        if "protocol" in record and current is not None:
+            current.append(
+                (
+                    record["protocol"],
+                    parse_hex(record["address"]),
+                    parse_hex(record["command"]),
+                    record["repeat"] == "true",
+                )
+            )
+
+    return {
+        index: (timings, expected.get(index, []))
+        for index, timings in inputs.items()
+    }
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument(
+            "-r", "--rounds", type=int, default=200, help="Timed replays per signal"
+        )
+        self.parser.add_argument(
+            "-s",
+            "--splices",
+            type=int,
+            default=9000,
+            help="Spliced signals checked against reference decoding, 0 to skip",
+        )
+        self.parser.add_argument(
+            "--seed", type=int, default=1, help="Seed of spliced signals"
+        )
+        self.parser.add_argument(
+            "files",
+            nargs="*",
+            help="Test files, defaults to unit test infrared/test_*.irtest",
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _build(self, build_dir):
+        includes = ["-I", os.path.join(BENCH_DIR, "furi_stub"), "-I", INFRARED_DIR]
+
+        objects = []
+        for dirpath, _, filenames in os.walk(INFRARED_DIR):
+            for name in sorted(filenames):
+                if not name.endswith(".c"):
+                    continue
+                obj = os.path.join(build_dir, f"{len(objects)}.o")
+                source = os.path.join(dirpath, name)
+                subprocess.check_call(
+                    [self.args.cc, *CFLAGS, "-w", *includes, "-c", source, "-o", obj]
+                )
+                objects.append(obj)
+
+        binaries = []
+        for harness in ("infrared_bench", "infrared_splice"):
+            binary = os.path.join(build_dir, harness)
+            subprocess.check_call(
+                [
+                    self.args.cc,
+                    *CFLAGS,
+                    *HARNESS_CFLAGS,
+                    *includes,
+                    os.path.join(BENCH_DIR, f"{harness}.c"),
+                    *objects,
+                    "-o",
+                    binary,
+                ]
+            )
+            binaries.append(binary)
+        return binaries
+
+    def _run(self, binary, tests):
+        signals = "".join(
+            f"{index} {' '.join(map(str, timings))}\n"
+            for index, (timings, _) in tests.items()
+        )
+        output = subprocess.check_output(
+            [binary, str(self.args.rounds)], input=signals, text=True
+        )
+        decoded = {index: [] for index in tests}
+        cost = {}
+        for line in output.splitlines():
+            index, *fields = line.split()
+            if fields[0] == "cost":
+                cost[index] = float(fields[1])
+            else:
+                protocol, address, command, repeat = fields
+                decoded[index].append(
+                    (protocol, int(address, 16), int(command, 16), repeat == "1")
+                )
+        return decoded, cost
+
+    def _splice(self, binary, signals):
+        output = subprocess.check_output(
+            [binary, str(self.args.splices), str(self.args.seed)],
+            input=signals,
+            text=True,
+        )
+        mismatches = 0
+        for line in output.splitlines():
+            kind, *fields = line.split()
+            if kind == "mismatch":
+                index, sample, expected, got = fields
+                self.logger.error(
+                    f"splice {index} sample {sample}: {got}, reference {expected}"
+                )
+            elif kind == "splice":
+                splices, samples, messages, mismatches = map(int, fields)
+                print(
+                    f"{'Spliced':<20} {splices:>8} {samples:>9} {messages:>9} "
+                    f"{mismatches:>10} mismatches"
+                )
+        return mismatches
+
+    @staticmethod
+    def _difference(decoded, expected):
+        for number, (got, want) in enumerate(zip(decoded, expected)):
+            if got != want:
+                return f"message {number} is {got}, expected {want}"
+        return f"{len(decoded)} messages decoded, expected {len(expected)}"
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        files = self.args.files or sorted(
+            os.path.join(TESTS_DIR, name)
+            for name in os.listdir(TESTS_DIR)
+            if name.endswith(".irtest")
+        )
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary, splice_binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            print(
+                f"{'File':<20} {'Signals':>8} {'Samples':>9} {'Messages':>9} "
+                f"{'ns/sample':>10}"
+            )
+            failed = 0
+            total_samples = 0
+            total_cost = 0.0
+            signals = []
+            for path in files:
+                tests = load_tests(path)
+                # Encoder-decoder only files have no raw inputs
+                if not tests:
+                    continue
+                signals += [
+                    f"{index} {' '.join(map(str, timings))}\n"
+                    for index, (timings, _) in tests.items()
+                ]
+                try:
+                    decoded, cost = self._run(binary, tests)
+                except subprocess.CalledProcessError:
+                    self.logger.error(f"{path} failed")
+                    return 1
+
+                samples = 0
+                weighted = 0.0
+                messages = 0
+                for index, (timings, expected) in tests.items():
+                    if decoded[index] != expected:
+                        self.logger.error(
+                            f"{os.path.basename(path)} decoder_input{index}: "
+                            f"{self._difference(decoded[index], expected)}"
+                        )
+                        failed += 1
+                    samples += len(timings)
+                    weighted += cost[index] * len(timings)
+                    messages += len(decoded[index])
+
+                name = os.path.splitext(os.path.basename(path))[0]
+                print(
+                    f"{name:<20} {len(tests):>8} {samples:>9} {messages:>9} "
+                    f"{weighted / samples:>10.1f}"
+                )
+                total_samples += samples
+                total_cost += weighted
+
+            print(
+                f"{'Total':<20} {'':>8} {total_samples:>9} {'':>9} "
+                f"{total_cost / total_samples:>10.1f}"
+            )
+
+            mismatches = 0
+            if self.args.splices > 0:
+                try:
+                    mismatches = self._splice(splice_binary, "".join(signals))
+                except subprocess.CalledProcessError:
+                    self.logger.error("Splice check failed")
+                    return 1
+
+        if failed:
+            self.logger.error(f"{failed} signals decoded differently from expected")
+        if mismatches:
+            self.logger.error(
+                f"{mismatches} samples of spliced signals decoded differently "
+                "from reference"
+            )
+        return 1 if failed or mismatches else 0
+
+
+if __name__ == "__main__":
+    Main()()
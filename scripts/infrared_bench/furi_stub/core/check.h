@@ -0,0 +1,15 @@
+#pragma once
+
+/* Minimal furi replacement for host builds of lib/infrared */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define furi_assert(x) assert(x)
+#define furi_check(x) \
+    do {              \
+        if(!(x)) {    \
+            abort();  \
+        }             \
+    } while(0)
+#define furi_crash(...) abort()
@@ -0,0 +1,94 @@
+/*
+ * Host benchmark for lib/infrared decoders, see scripts/infrared_bench.py
+ *
+ * Input: one signal per line, "<name> <timing> <timing> ...", first timing
+ * is a space. Each signal is decoded the same way unit tests do it, decoded
+ * messages are printed as "<name> <protocol> <address> <command> <repeat>".
+ * Then the signal is replayed for timing and "<name> cost <ns per sample>"
+ * is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "infrared.h"
+
+#define SIGNAL_MAX_TIMINGS 16384
+#define LINE_MAX_SIZE (SIGNAL_MAX_TIMINGS * 12)
+
+static uint64_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void print_message(const char* name, const InfraredMessage* message) {
+    printf(
+        "%s %s %08lX %08lX %d\n",
+        name,
+        infrared_get_protocol_name(message->protocol),
+        (unsigned long)message->address,
+        (unsigned long)message->command,
+        message->repeat);
+}
+
+static void replay(
+    InfraredDecoderHandler* decoder,
+    const char* name,
+    const uint32_t* timings,
+    size_t count) {
+    bool level = false;
+
+    infrared_reset_decoder(decoder);
+    for(size_t i = 0; i < count; ++i) {
+        const InfraredMessage* message = NULL;
+
+        if(timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+            message = infrared_check_decoder_ready(decoder);
+        }
+        if(name && message) print_message(name, message);
+
+        message = infrared_decode(decoder, level, timings[i]);
+        if(name && message) print_message(name, message);
+
+        level = !level;
+    }
+
+    const InfraredMessage* message = infrared_check_decoder_ready(decoder);
+    if(name && message) print_message(name, message);
+}
+
+int main(int argc, char** argv) {
+    unsigned rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 100;
+    char* line = malloc(LINE_MAX_SIZE);
+    uint32_t* timings = malloc(SIGNAL_MAX_TIMINGS * sizeof(uint32_t));
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+
+    while(fgets(line, LINE_MAX_SIZE, stdin)) {
+        char* save = NULL;
+        const char* name = strtok_r(line, " \n", &save);
+        if(!name) continue;
+
+        size_t count = 0;
+        for(char* token; count < SIGNAL_MAX_TIMINGS && (token = strtok_r(NULL, " \n", &save));) {
+            timings[count++] = strtoul(token, NULL, 10);
+        }
+
+        replay(decoder, name, timings, count);
+
+        uint64_t start = clock_ns();
+        for(unsigned i = 0; i < rounds; ++i) {
+            replay(decoder, NULL, timings, count);
+        }
+        uint64_t elapsed = clock_ns() - start;
+
+        printf("%s cost %.1f\n", name, (double)elapsed / ((double)rounds * count));
+    }
+
+    infrared_free_decoder(decoder);
+    free(timings);
+    free(line);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Host round-trip test for lib/infrared raw signal compaction,
+ * see scripts/infrared_compact.py
+ *
+ * Input: one raw signal per line, "<name> <timing> <timing> ...".
+ * Output: "<name> <status> <timings bytes> <compact bytes> <compact ns>"
+ * where status is "ok", "raw" (signal kept as is) or "fail: <reason>".
+ * Byte counts are heap sizes of the signal held as plain timings and in
+ * compact form, compaction time is the time added to loading the signal.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Source is included to measure instance size, struct is private */
+#include "infrared_raw_compact.c"
+
+#define SIGNAL_MAX_TIMINGS 16384
+#define LINE_MAX_SIZE (SIGNAL_MAX_TIMINGS * 12)
+#define COMPACT_ROUNDS 50
+
+static uint64_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static const char* check(const uint32_t* timings, size_t count, uint32_t* replay) {
+    InfraredRawCompact* compact = infrared_raw_compact_alloc(timings, count);
+    if(!compact) return "raw";
+
+    const char* error = NULL;
+
+    do {
+        if(infrared_raw_compact_get_timings_size(compact) != count) {
+            error = "fail: timings count";
+            break;
+        }
+
+        infrared_raw_compact_expand(compact, replay);
+
+        InfraredRawCompactIterator it;
+        infrared_raw_compact_it_init(compact, &it);
+        for(size_t i = 0; i < count; ++i) {
+            uint32_t duration;
+            if(!infrared_raw_compact_it_next(compact, &it, &duration) || duration != replay[i]) {
+                error = "fail: iterator and expanded timings differ";
+                break;
+            }
+            uint32_t diff = duration > timings[i] ? duration - timings[i] : timings[i] - duration;
+            if(diff > timings[i] * INFRARED_RAW_COMPACT_TOLERANCE) {
+                error = "fail: timing out of tolerance";
+                break;
+            }
+        }
+        if(error) break;
+
+        uint32_t extra;
+        if(infrared_raw_compact_it_next(compact, &it, &extra)) {
+            error = "fail: extra timings";
+        }
+    } while(0);
+
+    infrared_raw_compact_free(compact);
+    return error ? error : "ok";
+}
+
+static void measure(const char* name, const char* status, const uint32_t* timings, size_t count) {
+    const size_t raw_size = count * sizeof(uint32_t);
+    size_t compact_size = raw_size;
+
+    uint64_t start = clock_ns();
+    for(unsigned i = 0; i < COMPACT_ROUNDS; ++i) {
+        InfraredRawCompact* compact = infrared_raw_compact_alloc(timings, count);
+        if(compact) {
+            compact_size = sizeof(InfraredRawCompact) + compact->program_size;
+            infrared_raw_compact_free(compact);
+        }
+    }
+    const uint64_t compact_time = (clock_ns() - start) / COMPACT_ROUNDS;
+
+    printf(
+        "%s %s %zu %zu %llu\n",
+        name,
+        status,
+        raw_size,
+        compact_size,
+        (unsigned long long)compact_time);
+}
+
+int main(void) {
+    char* line = malloc(LINE_MAX_SIZE);
+    uint32_t* timings = malloc(SIGNAL_MAX_TIMINGS * sizeof(uint32_t));
+    uint32_t* replay = malloc(SIGNAL_MAX_TIMINGS * sizeof(uint32_t));
+
+    while(fgets(line, LINE_MAX_SIZE, stdin)) {
+        char* save = NULL;
+        const char* name = strtok_r(line, " \n", &save);
+        if(!name) continue;
+
+        size_t count = 0;
+        for(char* token; count < SIGNAL_MAX_TIMINGS && (token = strtok_r(NULL, " \n", &save));) {
+            timings[count++] = strtoul(token, NULL, 10);
+        }
+
+        const char* status = check(timings, count, replay);
+        if(!strncmp(status, "fail", 4)) {
+            printf("%s %s\n", name, status);
+            continue;
+        }
+        measure(name, status, timings, count);
+    }
+
+    free(replay);
+    free(timings);
+    free(line);
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * Equivalence check of infrared decoder dispatch, see scripts/infrared_bench.py
+ *
+ * Usage: infrared_splice <signals> <seed> < signals
+ *
+ * Input is the same as for infrared_bench. Random slices of input signals are
+ * spliced together and jittered, then fed both to the library decoder and to
+ * a reference that feeds every sample to every protocol decoder, as the
+ * library did before decoders were selected by lead mark. Messages returned
+ * after every sample must be the same. Prints mismatches as
+ * "mismatch <signal> <sample> <reference message> <library message>" and a
+ * summary "splice <signals> <samples> <messages> <mismatches>".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "infrared.h"
+#include "kaseikyo/infrared_protocol_kaseikyo.h"
+#include "nec/infrared_protocol_nec.h"
+#include "rc5/infrared_protocol_rc5.h"
+#include "rc6/infrared_protocol_rc6.h"
+#include "rca/infrared_protocol_rca.h"
+#include "samsung/infrared_protocol_samsung.h"
+#include "sirc/infrared_protocol_sirc.h"
+
+#define SIGNALS_MAX 256
+#define SIGNAL_MAX_TIMINGS 16384
+#define LINE_MAX_SIZE (SIGNAL_MAX_TIMINGS * 12)
+
+#define SPLICE_PIECES_MAX 4
+/* Timings move by up to this share of their duration */
+#define SPLICE_JITTER_PERCENT 10
+#define SPLICE_MISMATCHES_PRINTED 20
+
+typedef struct {
+    void* (*alloc)(void);
+    void (*free)(void*);
+    void (*reset)(void*);
+    InfraredMessage* (*decode)(void*, bool, uint32_t);
+    InfraredMessage* (*check_ready)(void*);
+} SpliceDecoder;
+
+/* Same order as infrared.c, first decoded message wins */
+static const SpliceDecoder splice_decoders[] = {
+#define SPLICE_DECODER(name)                                                      \
+    {infrared_decoder_##name##_alloc,                                             \
+     infrared_decoder_##name##_free,                                              \
+     infrared_decoder_##name##_reset,                                             \
+     infrared_decoder_##name##_decode,                                            \
+     infrared_decoder_##name##_check_ready}
+    SPLICE_DECODER(nec),
+    SPLICE_DECODER(samsung32),
+    SPLICE_DECODER(rc5),
+    SPLICE_DECODER(rc6),
+    SPLICE_DECODER(sirc),
+    SPLICE_DECODER(kaseikyo),
+    SPLICE_DECODER(rca),
+#undef SPLICE_DECODER
+};
+
+#define SPLICE_DECODERS_COUNT (sizeof(splice_decoders) / sizeof(splice_decoders[0]))
+
+typedef struct {
+    void* ctx[SPLICE_DECODERS_COUNT];
+} SpliceReference;
+
+typedef struct {
+    uint32_t* timings;
+    size_t count;
+} SpliceSignal;
+
+/* Own generator, same splices on every libc for the same seed */
+static uint32_t splice_random_state;
+
+static uint32_t splice_random(uint32_t range) {
+    splice_random_state ^= splice_random_state << 13;
+    splice_random_state ^= splice_random_state >> 17;
+    splice_random_state ^= splice_random_state << 5;
+    return range ? splice_random_state % range : 0;
+}
+
+static void splice_reference_reset(SpliceReference* reference) {
+    for(size_t i = 0; i < SPLICE_DECODERS_COUNT; ++i) {
+        splice_decoders[i].reset(reference->ctx[i]);
+    }
+}
+
+static const InfraredMessage*
+    splice_reference_decode(SpliceReference* reference, bool level, uint32_t duration) {
+    const InfraredMessage* result = NULL;
+    for(size_t i = 0; i < SPLICE_DECODERS_COUNT; ++i) {
+        const InfraredMessage* message =
+            splice_decoders[i].decode(reference->ctx[i], level, duration);
+        if(!result) result = message;
+    }
+    return result;
+}
+
+static const InfraredMessage* splice_reference_check_ready(SpliceReference* reference) {
+    const InfraredMessage* result = NULL;
+    for(size_t i = 0; i < SPLICE_DECODERS_COUNT; ++i) {
+        const InfraredMessage* message = splice_decoders[i].check_ready(reference->ctx[i]);
+        if(!result) result = message;
+    }
+    return result;
+}
+
+static bool splice_message_equal(const InfraredMessage* a, const InfraredMessage* b) {
+    if(!a || !b) return a == b;
+    return a->protocol == b->protocol && a->address == b->address &&
+           a->command == b->command && a->repeat == b->repeat;
+}
+
+static void splice_message_print(const InfraredMessage* message) {
+    if(message) {
+        printf(
+            " %s/%08lX/%08lX/%d",
+            infrared_get_protocol_name(message->protocol),
+            (unsigned long)message->address,
+            (unsigned long)message->command,
+            message->repeat);
+    } else {
+        printf(" -");
+    }
+}
+
+/* Slices start on the level the output continues with, first timing is a space */
+static size_t splice_generate(uint32_t* out, const SpliceSignal* signals, size_t signal_count) {
+    const size_t pieces = 1 + splice_random(SPLICE_PIECES_MAX);
+    size_t count = 0;
+
+    for(size_t piece = 0; piece < pieces && count < SIGNAL_MAX_TIMINGS; ++piece) {
+        const SpliceSignal* signal = &signals[splice_random(signal_count)];
+        if(signal->count < 2) continue;
+
+        size_t start = splice_random(signal->count - 1);
+        if((start & 1) != (count & 1)) start++;
+        size_t length = 1 + splice_random(signal->count - start);
+        if(length > SIGNAL_MAX_TIMINGS - count) length = SIGNAL_MAX_TIMINGS - count;
+
+        for(size_t i = 0; i < length; ++i) {
+            const uint32_t timing = signal->timings[start + i];
+            const uint32_t jitter = timing * SPLICE_JITTER_PERCENT / 100;
+            const uint32_t shifted = timing - jitter + splice_random(2 * jitter + 1);
+            out[count++] = shifted ? shifted : 1;
+        }
+    }
+
+    return count;
+}
+
+/* Same feeding as infrared_bench replay and unit tests, returns messages compared */
+static size_t splice_compare(
+    InfraredDecoderHandler* decoder,
+    SpliceReference* reference,
+    size_t index,
+    const uint32_t* timings,
+    size_t count,
+    size_t* mismatches) {
+    size_t messages = 0;
+    bool level = false;
+
+    infrared_reset_decoder(decoder);
+    splice_reference_reset(reference);
+
+    for(size_t i = 0; i <= count; ++i) {
+        for(int step = 0; step < 2; ++step) {
+            const InfraredMessage* expected = NULL;
+            const InfraredMessage* message = NULL;
+
+            if(step == 0 && (i == count || timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US)) {
+                expected = splice_reference_check_ready(reference);
+                message = infrared_check_decoder_ready(decoder);
+            } else if(step == 1 && i < count) {
+                expected = splice_reference_decode(reference, level, timings[i]);
+                message = infrared_decode(decoder, level, timings[i]);
+            }
+
+            messages += expected != NULL;
+            if(!splice_message_equal(expected, message)) {
+                if(*mismatches < SPLICE_MISMATCHES_PRINTED) {
+                    printf("mismatch %zu %zu", index, i);
+                    splice_message_print(expected);
+                    splice_message_print(message);
+                    printf("\n");
+                }
+                (*mismatches)++;
+            }
+        }
+        level = !level;
+    }
+
+    return messages;
+}
+
+int main(int argc, char** argv) {
+    const size_t splices = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000;
+    splice_random_state = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+    if(!splice_random_state) splice_random_state = 1;
+
+    char* line = malloc(LINE_MAX_SIZE);
+    SpliceSignal* signals = calloc(SIGNALS_MAX, sizeof(SpliceSignal));
+    size_t signal_count = 0;
+
+    while(signal_count < SIGNALS_MAX && fgets(line, LINE_MAX_SIZE, stdin)) {
+        char* save = NULL;
+        if(!strtok_r(line, " \n", &save)) continue;
+
+        SpliceSignal* signal = &signals[signal_count];
+        signal->timings = malloc(SIGNAL_MAX_TIMINGS * sizeof(uint32_t));
+        for(char* token; signal->count < SIGNAL_MAX_TIMINGS &&
+                         (token = strtok_r(NULL, " \n", &save));) {
+            signal->timings[signal->count++] = strtoul(token, NULL, 10);
+        }
+        signal_count++;
+    }
+
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+    SpliceReference reference;
+    for(size_t i = 0; i < SPLICE_DECODERS_COUNT; ++i) {
+        reference.ctx[i] = splice_decoders[i].alloc();
+    }
+
+    uint32_t* timings = malloc(SIGNAL_MAX_TIMINGS * sizeof(uint32_t));
+    size_t samples = 0;
+    size_t messages = 0;
+    size_t mismatches = 0;
+
+    for(size_t index = 0; signal_count && index < splices; ++index) {
+        const size_t count = splice_generate(timings, signals, signal_count);
+        messages += splice_compare(decoder, &reference, index, timings, count, &mismatches);
+        samples += count;
+    }
+
+    printf("splice %zu %zu %zu %zu\n", splices, samples, messages, mismatches);
+
+    free(timings);
+    for(size_t i = 0; i < SPLICE_DECODERS_COUNT; ++i) {
+        splice_decoders[i].free(reference.ctx[i]);
+    }
+    infrared_free_decoder(decoder);
+    for(size_t i = 0; i < signal_count; ++i) {
+        free(signals[i].timings);
+    }
+    free(signals);
+    free(line);
+    return 0;
+}
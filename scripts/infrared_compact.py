@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+
+# Host round-trip test of infrared raw signal compaction
+#
+# Builds scripts/infrared_bench/infrared_compact.c, which includes
+# lib/infrared/worker/infrared_raw_compact.c, with the host compiler and runs
+# every raw signal of the given .ir files through it. Every replayed timing
+# must be within tolerance of the original one, iterator replay must match
+# expanded timings exactly. Reports heap held by the signals as plain timings
+# and in compact form, as they are held after loading, and the time
+# compaction adds to loading.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+WORKER_DIR = os.path.join(ROOT_DIR, "lib", "infrared", "worker")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "infrared_bench")
+ASSETS_DIR = os.path.join(
+    ROOT_DIR, "applications", "main", "infrared", "resources", "infrared", "assets"
+)
+
+CFLAGS = ["-O2", "-Wall", "-Wextra", "-Werror"]
+
+def load_raw_signals(path):
+    """Returns [(name, [timings])] for raw signals of .ir file"""
+    signals = []
+    record = {}
+
+    def flush():
+        if record.get("type") == "raw" and "data" in record:
+            signals.append((record["name"], [int(t) for t in record["data"].split()]))
+
+    with open(path) as file:
+        for line in file:
+            key, sep, value = line.partition(":")
+            key = key.strip()
+            if not sep or key.startswith("#"):
+                continue
+            # Comment lines between signals are optional
+            if key == "name":
+                flush()
+                record = {}
+            record[key] = value.strip()
+    flush()
+
+    return signals
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument(
+            "files",
+            nargs="*",
+            help="IR files, defaults to infrared application assets",
+        )
+        self.parser.set_defaults(func=self.test)
+
+    def _build(self, build_dir):
+        sources = [os.path.join(BENCH_DIR, "infrared_compact.c")]
+        includes = ["-I", os.path.join(BENCH_DIR, "furi_stub"), "-I", WORKER_DIR]
+        binary = os.path.join(build_dir, "infrared_compact")
+        subprocess.check_call(
+            [self.args.cc, *CFLAGS, *includes, *sources, "-o", binary]
+        )
+        return binary
+
+    def test(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        files = self.args.files or sorted(
+            os.path.join(ASSETS_DIR, name)
+            for name in os.listdir(ASSETS_DIR)
+            if name.endswith(".ir")
+        )
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            print(
+                f"{'File':<16} {'Raw':>5} {'Packed':>7} {'Heap':>8} {'Compact':>8} "
+                f"{'Load +us':>8}"
+            )
+            failed = 0
+            totals = [0, 0, 0, 0, 0]
+            for path in files:
+                signals = load_raw_signals(path)
+                lines = "".join(
+                    f"{index} {' '.join(map(str, timings))}\n"
+                    for index, (_, timings) in enumerate(signals)
+                )
+                output = subprocess.check_output([binary], input=lines, text=True)
+
+                packed = 0
+                heap = 0
+                compact_heap = 0
+                compact_time = 0
+                for line in output.splitlines():
+                    index, status, *fields = line.split(maxsplit=2)
+                    if status.startswith("fail"):
+                        name = signals[int(index)][0]
+                        self.logger.error(f"{os.path.basename(path)} {name}: {line}")
+                        failed += 1
+                        continue
+                    raw_size, compact_size, compact_ns = map(int, fields[0].split())
+                    heap += raw_size
+                    compact_heap += compact_size
+                    compact_time += compact_ns
+                    if status == "ok":
+                        packed += 1
+
+                name = os.path.basename(path)
+                print(
+                    f"{name:<16} {len(signals):>5} {packed:>7} {heap:>8} "
+                    f"{compact_heap:>8} {compact_time / 1000:>8.1f}"
+                )
+                for i, value in enumerate(
+                    (len(signals), packed, heap, compact_heap, compact_time)
+                ):
+                    totals[i] += value
+
+            signals, packed, heap, compact_heap, compact_time = totals
+            print(
+                f"{'Total':<16} {signals:>5} {packed:>7} {heap:>8} {compact_heap:>8} "
+                f"{compact_time / 1000:>8.1f}"
+            )
+
+        if failed:
+            self.logger.error(f"{failed} signals failed round trip")
+            return 1
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+
+# Host tool for LF RFID raw captures
+#
+# Builds protocol decoders from lib/lfrfid together with
+# scripts/lfrfid_raw/lfrfid_raw.c using the host compiler. Converts captures
+# between varint pairs (version 1) and block (version 2) formats, decodes them
+# offline and checks that both formats decode to the same cards.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+LIB_DIR = os.path.join(ROOT_DIR, "lib")
+TOOL_DIR = os.path.join(ROOT_DIR, "scripts", "lfrfid_raw")
+# Shared with infrared host tools: core/check.h, core/common_defines.h
+STUB_DIRS = [
+    os.path.join(TOOL_DIR, "furi_stub"),
+    os.path.join(ROOT_DIR, "scripts", "infrared_bench", "furi_stub"),
+]
+
+LIB_SOURCES = [
+    "lfrfid/tools/fsk_demod.c",
+    "lfrfid/tools/fsk_ocs.c",
+    "lfrfid/tools/raw_block.c",
+    "lfrfid/tools/varint_pair.c",
+    "toolbox/protocols/protocol_dict.c",
+    "toolbox/pulse_protocols/pulse_glue.c",
+    "toolbox/manchester_decoder.c",
+    "toolbox/hex.c",
+    "toolbox/varint.c",
+    "bit_lib/bit_lib.c",
+]
+
+FORMATS = {"pairs": 1, "blocks": 2}
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_convert = self.subparsers.add_parser(
+            "convert", help="Convert capture"
+        )
+        self.parser_convert.add_argument("input", help="Source capture")
+        self.parser_convert.add_argument("output", help="Destination capture")
+        self.parser_convert.add_argument(
+            "-f", "--format", choices=FORMATS.keys(), default="blocks"
+        )
+        self.parser_convert.add_argument(
+            "-s", "--shift", type=int, default=1, help="Block quantum, 1 << shift us"
+        )
+        self.parser_convert.set_defaults(func=self.convert)
+
+        self.parser_decode = self.subparsers.add_parser(
+            "decode", help="Decode capture with all protocols"
+        )
+        self.parser_decode.add_argument("input", help="Capture")
+        self.parser_decode.set_defaults(func=self.decode)
+
+        self.parser_test = self.subparsers.add_parser(
+            "test",
+            help="Round trip synthetic and given captures through both formats",
+        )
+        self.parser_test.add_argument("files", nargs="*", help="Captures")
+        self.parser_test.add_argument(
+            "-p", "--pairs", type=int, default=4000, help="Pairs per synthetic capture"
+        )
+        self.parser_test.add_argument(
+            "-j", "--jitter", type=int, default=3, help="Synthetic edge jitter, us"
+        )
+        self.parser_test.add_argument(
+            "-s", "--shift", type=int, default=1, help="Block quantum, 1 << shift us"
+        )
+        self.parser_test.set_defaults(func=self.test)
+
+    def _build(self, build_dir):
+        includes = []
+        for path in (*STUB_DIRS, ROOT_DIR, LIB_DIR):
+            includes += ["-I", path]
+
+        sources = [os.path.join(LIB_DIR, source) for source in LIB_SOURCES]
+        protocols_dir = os.path.join(LIB_DIR, "lfrfid", "protocols")
+        sources += sorted(
+            os.path.join(protocols_dir, name)
+            for name in os.listdir(protocols_dir)
+            if name.endswith(".c")
+        )
+
+        objects = []
+        for index, source in enumerate(sources):
+            obj = os.path.join(build_dir, f"{index}.o")
+            subprocess.check_call(
+                [self.args.cc, "-O2", "-w", *includes, "-c", source, "-o", obj]
+            )
+            objects.append(obj)
+
+        binary = os.path.join(build_dir, "lfrfid_raw")
+        subprocess.check_call(
+            [
+                self.args.cc,
+                *("-O2", "-Wall", "-Wextra", "-Werror"),
+                *includes,
+                os.path.join(TOOL_DIR, "lfrfid_raw.c"),
+                *objects,
+                "-o",
+                binary,
+                "-lm",
+            ]
+        )
+        return binary
+
+    def _run(self, func):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                self.binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+            self.work_dir = build_dir
+            return func()
+
+    def _tool(self, *args):
+        return subprocess.check_output(
+            [self.binary, *map(str, args)], text=True
+        ).splitlines()
+
+    def _info(self, path):
+        _, pairs, _, _, size = map(int, self._tool("info", path)[0].split())
+        return pairs, size
+
+    def convert(self):
+        def run():
+            self._tool(
+                "convert",
+                self.args.input,
+                self.args.output,
+                FORMATS[self.args.format],
+                self.args.shift,
+            )
+            pairs, size = self._info(self.args.output)
+            self.logger.info(f"{pairs} pairs, {size} bytes")
+            return 0
+
+        return self._run(run)
+
+    def decode(self):
+        def run():
+            for line in self._tool("decode", self.args.input):
+                print(line)
+            return 0
+
+        return self._run(run)
+
+    def _round_trip(self, name, source):
+        blocks = os.path.join(self.work_dir, "blocks.raw")
+        pairs = os.path.join(self.work_dir, "pairs.raw")
+        self._tool("convert", source, blocks, FORMATS["blocks"], self.args.shift)
+        self._tool("convert", blocks, pairs, FORMATS["pairs"])
+
+        source_pairs, source_size = self._info(source)
+        blocks_pairs, blocks_size = self._info(blocks)
+        pairs_pairs, _ = self._info(pairs)
+
+        decoded = self._tool("decode", source)
+        match = (
+            source_pairs == blocks_pairs == pairs_pairs
+            and decoded == self._tool("decode", blocks) == self._tool("decode", pairs)
+        )
+
+        # Nothing decoded from the source matches trivially but proves nothing
+        status = "MISMATCH" if not match else "NODECODE" if not decoded else "ok"
+        print(
+            f"{name:<16} {source_pairs:>6} {source_size:>7} {blocks_size:>7} "
+            f"{blocks_size / source_size:>6.2f} {len(decoded):>7} {status:>8}"
+        )
+        return match, bool(decoded), source_size, blocks_size
+
+    def test(self):
+        def run():
+            print(
+                f"{'Capture':<16} {'Pairs':>6} {'V1':>7} {'V2':>7} {'Ratio':>6} "
+                f"{'Decoded':>7} {'Match':>8}"
+            )
+            failed = 0
+            undecoded = []
+            total_source = 0
+            total_blocks = 0
+
+            results = []
+            path = os.path.join(self.work_dir, "synth.raw")
+            for protocol in self._tool("protocols"):
+                synth = [self.binary, "synth", protocol, path]
+                synth += map(str, (self.args.pairs, self.args.jitter))
+                # Protocols without encoder can't be synthesized
+                if subprocess.run(synth, capture_output=True).returncode:
+                    continue
+                results.append((protocol, True, *self._round_trip(protocol, path)))
+            for path in self.args.files:
+                name = os.path.basename(path)
+                results.append((name, False, *self._round_trip(name, path)))
+
+            for name, synthetic, match, decoded, source_size, blocks_size in results:
+                if synthetic and not decoded:
+                    undecoded.append(name)
+                else:
+                    failed += not (match and decoded)
+                total_source += source_size
+                total_blocks += blocks_size
+
+            print(
+                f"{'Total':<16} {'':>6} {total_source:>7} {total_blocks:>7} "
+                f"{total_blocks / total_source:>6.2f}"
+            )
+            if undecoded:
+                # PSK and some other encoders emulate a tag, their output is not
+                # what the reader front end sees and can't be decoded offline
+                self.logger.warning(
+                    f"{len(undecoded)} synthetic captures decode to no cards, "
+                    f"not compared: {', '.join(undecoded)}"
+                )
+            if failed:
+                self.logger.error(f"{failed} captures decode differently or not at all")
+                return 1
+            return 0
+
+        return self._run(run)
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,82 @@
+#pragma once
+
+/* Minimal furi replacement for host builds of lib/lfrfid protocols */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#define FURI_LOG_E(tag, ...)
+#define FURI_LOG_W(tag, ...)
+#define FURI_LOG_I(tag, ...)
+#define FURI_LOG_D(tag, ...)
+#define FURI_LOG_T(tag, ...)
+
+typedef struct {
+    char* data;
+    size_t size;
+} FuriString;
+
+static inline FuriString* furi_string_alloc(void) {
+    FuriString* string = calloc(1, sizeof(FuriString));
+    string->data = calloc(1, 1);
+    return string;
+}
+
+static inline void furi_string_free(FuriString* string) {
+    free(string->data);
+    free(string);
+}
+
+static inline void furi_string_reset(FuriString* string) {
+    string->size = 0;
+    string->data[0] = '\0';
+}
+
+static inline const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+static inline size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+static inline int furi_string_cat_vprintf(FuriString* string, const char* format, va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int size = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if(size < 0) return size;
+
+    string->data = realloc(string->data, string->size + size + 1);
+    vsnprintf(&string->data[string->size], size + 1, format, args);
+    string->size += size;
+    return size;
+}
+
+static inline int furi_string_cat_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+static inline int furi_string_printf(FuriString* string, const char* format, ...) {
+    furi_string_reset(string);
+    va_list args;
+    va_start(args, format);
+    int size = furi_string_cat_vprintf(string, format, args);
+    va_end(args);
+    return size;
+}
+
+static inline void furi_string_cat_str(FuriString* string, const char* text) {
+    furi_string_cat_printf(string, "%s", text);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+/* Host builds always render metric units */
+
+typedef enum {
+    FuriHalRtcLocaleUnitsMetric,
+    FuriHalRtcLocaleUnitsImperial,
+} FuriHalRtcLocaleUnits;
+
+static inline FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    return FuriHalRtcLocaleUnitsMetric;
+}
@@ -0,0 +1,374 @@
+/*
+ * Host tool for LF RFID raw captures, see scripts/lfrfid_raw.py
+ *
+ * lfrfid_raw protocols
+ *     list protocol names
+ * lfrfid_raw synth <protocol> <out> <pairs> [jitter us] [seed]
+ *     encode test data with protocol encoder, write version 1 capture
+ * lfrfid_raw convert <in> <out> <version> [shift]
+ *     rewrite capture as version 1 (varint pairs) or 2 (blocks)
+ * lfrfid_raw decode <in>
+ *     feed capture to protocol decoders, print "<pair> <protocol> <data>" per decode
+ * lfrfid_raw info <in>
+ *     print "<version> <pairs> <blocks> <lost> <size>"
+ *
+ * Mirrors lib/lfrfid/lfrfid_raw_file.c, except that captures are not
+ * wrapped around and buffer sizes are 32 bit like on the device.
+ */
+
+#include <furi.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/tools/raw_block.h>
+#include <lfrfid/tools/varint_pair.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+
+#define LFRFID_RAW_FILE_MAGIC 0x4C464952
+#define LFRFID_RAW_FILE_VERSION_PAIRS 1
+#define LFRFID_RAW_FILE_VERSION_BLOCKS 2
+/* Same as read buffer of lib/lfrfid/lfrfid_raw_worker.c */
+#define LFRFID_RAW_PAIRS_BUFFER_SIZE 2048
+#define LFRFID_RAW_DEFAULT_SHIFT 1
+#define LFRFID_RAW_TIMING_MULTIPLIER 8
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} LFRFIDRawFileHeader;
+
+typedef struct {
+    FILE* file;
+    LFRFIDRawFileHeader header;
+    uint8_t* buffer;
+    uint32_t buffer_size;
+    size_t buffer_counter;
+    RawBlockDecoder decoder;
+    size_t blocks;
+    size_t lost;
+} RawReader;
+
+typedef struct {
+    FILE* file;
+    uint32_t version;
+    uint8_t shift;
+    uint8_t buffer[LFRFID_RAW_PAIRS_BUFFER_SIZE];
+    size_t size;
+    RawBlockEncoder encoder;
+    bool started;
+} RawWriter;
+
+static bool raw_reader_open(RawReader* reader, const char* path) {
+    memset(reader, 0, sizeof(RawReader));
+    reader->file = fopen(path, "rb");
+    if(!reader->file) return false;
+
+    LFRFIDRawFileHeader* header = &reader->header;
+    if(fread(header, sizeof(LFRFIDRawFileHeader), 1, reader->file) != 1 ||
+       header->magic != LFRFID_RAW_FILE_MAGIC ||
+       (header->version != LFRFID_RAW_FILE_VERSION_PAIRS &&
+        header->version != LFRFID_RAW_FILE_VERSION_BLOCKS) ||
+       header->max_buffer_size > UINT16_MAX) {
+        fclose(reader->file);
+        return false;
+    }
+
+    reader->buffer = malloc(header->max_buffer_size);
+    return true;
+}
+
+static void raw_reader_close(RawReader* reader) {
+    free(reader->buffer);
+    fclose(reader->file);
+}
+
+static bool raw_reader_next(RawReader* reader, uint32_t* pulse, uint32_t* duration) {
+    if(reader->header.version == LFRFID_RAW_FILE_VERSION_BLOCKS) {
+        while(!raw_block_decoder_next(&reader->decoder, pulse, duration)) {
+            RawBlockHeader header;
+            if(fread(&header, sizeof(RawBlockHeader), 1, reader->file) != 1) return false;
+            if(header.size > reader->header.max_buffer_size ||
+               fread(reader->buffer, 1, header.size, reader->file) != header.size ||
+               !raw_block_decoder_start(&reader->decoder, &header, reader->buffer)) {
+                fprintf(stderr, "malformed block at %ld\n", ftell(reader->file));
+                return false;
+            }
+            reader->blocks++;
+            reader->lost += header.lost;
+        }
+        return true;
+    }
+
+    if(reader->buffer_counter >= reader->buffer_size) {
+        if(fread(&reader->buffer_size, sizeof(uint32_t), 1, reader->file) != 1) return false;
+        if(reader->buffer_size > reader->header.max_buffer_size ||
+           fread(reader->buffer, 1, reader->buffer_size, reader->file) != reader->buffer_size) {
+            fprintf(stderr, "malformed buffer at %ld\n", ftell(reader->file));
+            return false;
+        }
+        reader->buffer_counter = 0;
+        reader->blocks++;
+    }
+
+    size_t size = 0;
+    if(!varint_pair_unpack(
+           &reader->buffer[reader->buffer_counter],
+           reader->buffer_size - reader->buffer_counter,
+           pulse,
+           duration,
+           &size)) {
+        fprintf(stderr, "truncated pair\n");
+        return false;
+    }
+    reader->buffer_counter += size;
+    return true;
+}
+
+static bool raw_writer_open(
+    RawWriter* writer,
+    const char* path,
+    uint32_t version,
+    uint8_t shift,
+    float frequency,
+    float duty_cycle) {
+    memset(writer, 0, sizeof(RawWriter));
+    writer->file = fopen(path, "wb");
+    if(!writer->file) return false;
+    writer->version = version;
+    writer->shift = shift;
+
+    LFRFIDRawFileHeader header = {
+        .magic = LFRFID_RAW_FILE_MAGIC,
+        .version = version,
+        .frequency = frequency,
+        .duty_cycle = duty_cycle,
+        .max_buffer_size = version == LFRFID_RAW_FILE_VERSION_BLOCKS ?
+                               RAW_BLOCK_PAYLOAD_MAX_SIZE :
+                               LFRFID_RAW_PAIRS_BUFFER_SIZE,
+    };
+    return fwrite(&header, sizeof(header), 1, writer->file) == 1;
+}
+
+static void raw_writer_flush(RawWriter* writer) {
+    if(writer->version == LFRFID_RAW_FILE_VERSION_BLOCKS) {
+        size_t size = raw_block_encoder_finish(&writer->encoder);
+        fwrite(writer->buffer, 1, size, writer->file);
+        writer->started = false;
+    } else if(writer->size) {
+        uint32_t size = writer->size;
+        fwrite(&size, sizeof(uint32_t), 1, writer->file);
+        fwrite(writer->buffer, 1, writer->size, writer->file);
+        writer->size = 0;
+    }
+}
+
+static void raw_writer_push(RawWriter* writer, uint32_t pulse, uint32_t duration) {
+    if(writer->version == LFRFID_RAW_FILE_VERSION_BLOCKS) {
+        if(writer->started && raw_block_encoder_push(&writer->encoder, pulse, duration)) return;
+        if(writer->started) raw_writer_flush(writer);
+        raw_block_encoder_start(
+            &writer->encoder, writer->buffer, sizeof(writer->buffer), writer->shift, 0);
+        writer->started = true;
+        furi_check(raw_block_encoder_push(&writer->encoder, pulse, duration));
+        return;
+    }
+
+    uint8_t pair[RAW_BLOCK_PAIR_MAX_SIZE];
+    VarintPair* varint_pair = varint_pair_alloc();
+    varint_pair_pack(varint_pair, true, pulse);
+    varint_pair_pack(varint_pair, false, duration);
+    size_t size = varint_pair_get_size(varint_pair);
+    memcpy(pair, varint_pair_get_data(varint_pair), size);
+    varint_pair_free(varint_pair);
+
+    if(writer->size + size > sizeof(writer->buffer)) raw_writer_flush(writer);
+    memcpy(&writer->buffer[writer->size], pair, size);
+    writer->size += size;
+}
+
+static bool raw_writer_close(RawWriter* writer) {
+    if(writer->version != LFRFID_RAW_FILE_VERSION_BLOCKS || writer->started) {
+        raw_writer_flush(writer);
+    }
+    bool success = !ferror(writer->file);
+    return fclose(writer->file) == 0 && success;
+}
+
+static void print_data(ProtocolDict* dict, ProtocolId protocol) {
+    size_t data_size = protocol_dict_get_data_size(dict, protocol);
+    uint8_t* data = malloc(data_size);
+    protocol_dict_get_data(dict, protocol, data, data_size);
+    for(size_t i = 0; i < data_size; i++) {
+        printf("%02X", data[i]);
+    }
+    free(data);
+}
+
+static int command_protocols(void) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        printf("%s\n", protocol_dict_get_name(dict, i));
+    }
+    protocol_dict_free(dict);
+    return 0;
+}
+
+static int command_synth(const char* name, const char* path, size_t pairs, uint32_t jitter) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    ProtocolId protocol = protocol_dict_get_protocol_by_name(dict, name);
+    if(protocol == PROTOCOL_NO) {
+        fprintf(stderr, "unknown protocol %s\n", name);
+        protocol_dict_free(dict);
+        return 1;
+    }
+
+    size_t data_size = protocol_dict_get_data_size(dict, protocol);
+    uint8_t* data = malloc(data_size);
+    for(size_t i = 0; i < data_size; i++) {
+        data[i] = 0x1D * (i + 1);
+    }
+    protocol_dict_set_data(dict, protocol, data, data_size);
+    free(data);
+
+    RawWriter* writer = malloc(sizeof(RawWriter));
+    if(!protocol_dict_encoder_start(dict, protocol) ||
+       !raw_writer_open(writer, path, LFRFID_RAW_FILE_VERSION_PAIRS, 0, 125000, 0.5f)) {
+        fprintf(stderr, "can't start %s\n", name);
+        free(writer);
+        protocol_dict_free(dict);
+        return 1;
+    }
+
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    for(size_t count = 0; count < pairs;) {
+        LevelDuration level_duration = protocol_dict_encoder_yield(dict, protocol);
+        if(!pulse_glue_push(
+               pulse_glue,
+               level_duration_get_level(level_duration),
+               level_duration_get_duration(level_duration) * LFRFID_RAW_TIMING_MULTIPLIER)) {
+            continue;
+        }
+
+        uint32_t duration, pulse;
+        pulse_glue_pop(pulse_glue, &duration, &pulse);
+        if(jitter) {
+            // edges move by up to jitter us, pulse stays inside the period
+            int32_t delta = (int32_t)(rand() % (2 * jitter + 1)) - (int32_t)jitter;
+            if((int32_t)pulse + delta > 0 && pulse + delta < duration) pulse += delta;
+        }
+        raw_writer_push(writer, pulse, duration);
+        count++;
+    }
+    pulse_glue_free(pulse_glue);
+
+    printf("%s ", protocol_dict_get_name(dict, protocol));
+    print_data(dict, protocol);
+    printf("\n");
+
+    bool success = raw_writer_close(writer);
+    free(writer);
+    protocol_dict_free(dict);
+    return success ? 0 : 1;
+}
+
+static int command_convert(const char* in, const char* out, uint32_t version, uint8_t shift) {
+    RawReader reader;
+    if(!raw_reader_open(&reader, in)) {
+        fprintf(stderr, "can't open %s\n", in);
+        return 1;
+    }
+
+    RawWriter* writer = malloc(sizeof(RawWriter));
+    bool success = raw_writer_open(
+        writer, out, version, shift, reader.header.frequency, reader.header.duty_cycle);
+    if(success) {
+        uint32_t pulse, duration;
+        while(raw_reader_next(&reader, &pulse, &duration)) {
+            raw_writer_push(writer, pulse, duration);
+        }
+        success = raw_writer_close(writer);
+    }
+
+    free(writer);
+    raw_reader_close(&reader);
+    return success ? 0 : 1;
+}
+
+static int command_decode(const char* in) {
+    RawReader reader;
+    if(!raw_reader_open(&reader, in)) {
+        fprintf(stderr, "can't open %s\n", in);
+        return 1;
+    }
+
+    // same feeding as lfrfid CLI raw analysis and read worker
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    protocol_dict_decoders_start(dict);
+
+    uint32_t pulse, duration;
+    for(size_t index = 0; raw_reader_next(&reader, &pulse, &duration); index++) {
+        ProtocolId protocol = protocol_dict_decoders_feed(dict, true, pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol = protocol_dict_decoders_feed(dict, false, duration - pulse);
+        }
+        if(protocol != PROTOCOL_NO) {
+            printf("%zu %s ", index, protocol_dict_get_name(dict, protocol));
+            print_data(dict, protocol);
+            printf("\n");
+        }
+    }
+
+    protocol_dict_free(dict);
+    raw_reader_close(&reader);
+    return 0;
+}
+
+static int command_info(const char* in) {
+    RawReader reader;
+    if(!raw_reader_open(&reader, in)) {
+        fprintf(stderr, "can't open %s\n", in);
+        return 1;
+    }
+
+    size_t pairs = 0;
+    uint32_t pulse, duration;
+    while(raw_reader_next(&reader, &pulse, &duration)) {
+        pairs++;
+    }
+
+    printf(
+        "%lu %zu %zu %zu %ld\n",
+        (unsigned long)reader.header.version,
+        pairs,
+        reader.blocks,
+        reader.lost,
+        ftell(reader.file));
+
+    raw_reader_close(&reader);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if(argc == 2 && !strcmp(argv[1], "protocols")) {
+        return command_protocols();
+    } else if(argc >= 5 && argc <= 7 && !strcmp(argv[1], "synth")) {
+        srand(argc == 7 ? strtoul(argv[6], NULL, 0) : 1);
+        uint32_t jitter = argc >= 6 ? strtoul(argv[5], NULL, 0) : 0;
+        return command_synth(argv[2], argv[3], strtoul(argv[4], NULL, 0), jitter);
+    } else if((argc == 5 || argc == 6) && !strcmp(argv[1], "convert")) {
+        return command_convert(
+            argv[2],
+            argv[3],
+            strtoul(argv[4], NULL, 0),
+            argc == 6 ? strtoul(argv[5], NULL, 0) : LFRFID_RAW_DEFAULT_SHIFT);
+    } else if(argc == 3 && !strcmp(argv[1], "decode")) {
+        return command_decode(argv[2]);
+    } else if(argc == 3 && !strcmp(argv[1], "info")) {
+        return command_info(argv[2]);
+    }
+
+    fprintf(stderr, "bad arguments, see %s\n", __FILE__);
+    return 2;
+}
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+# Host benchmark of picopass loclass key diversification and MAC
+#
+# Builds applications/external/picopass/lib/loclass and DES from lib/mbedtls
+# with the host compiler together with scripts/loclass_bench. Checks hash0,
+# diversified keys and reader MACs against the bit-serial reference
+# implementation on pseudo-random vectors, then reports cost per operation of
+# both implementations.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+LOCLASS_DIR = os.path.join(
+    ROOT_DIR, "applications", "external", "picopass", "lib", "loclass"
+)
+MBEDTLS_DIR = os.path.join(ROOT_DIR, "lib", "mbedtls")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "loclass_bench")
+
+MBEDTLS_SOURCES = ["library/des.c", "library/platform_util.c"]
+
+# Same as the loclass private library in picopass application.fam
+CFLAGS = ["-O3", "-w", '-DMBEDTLS_CONFIG_FILE="mbedtls_cfg.h"']
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument(
+            "--mbedtls", default=MBEDTLS_DIR, help="mbedtls source tree"
+        )
+        self.parser.add_argument(
+            "-n", "--vectors", type=int, default=10000, help="Vectors per operation"
+        )
+        self.parser.add_argument(
+            "-r", "--repeat", type=int, default=5, help="Timed runs, best is kept"
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _sources(self):
+        for filename in sorted(os.listdir(LOCLASS_DIR)):
+            if filename.endswith(".c"):
+                yield os.path.join(LOCLASS_DIR, filename)
+        for filename in sorted(os.listdir(BENCH_DIR)):
+            if filename.endswith(".c"):
+                yield os.path.join(BENCH_DIR, filename)
+        for source in MBEDTLS_SOURCES:
+            yield os.path.join(self.args.mbedtls, source)
+
+    def _build(self, build_dir):
+        objects = []
+        includes = [
+            "-I",
+            LOCLASS_DIR,
+            "-I",
+            BENCH_DIR,
+            "-I",
+            os.path.join(self.args.mbedtls, "include"),
+            "-I",
+            os.path.join(ROOT_DIR, "lib"),
+        ]
+        for index, source in enumerate(self._sources()):
+            obj = os.path.join(build_dir, f"{index}.o")
+            subprocess.check_call(
+                [self.args.cc, "-c", *CFLAGS, *includes, source, "-o", obj]
+            )
+            objects.append(obj)
+        binary = os.path.join(build_dir, "loclass_bench")
+        subprocess.check_call([self.args.cc, *objects, "-o", binary])
+        return binary
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        if not os.path.isfile(os.path.join(self.args.mbedtls, MBEDTLS_SOURCES[0])):
+            self.logger.error(
+                f"mbedtls sources not found in {self.args.mbedtls}, "
+                "run git submodule update --init lib/mbedtls"
+            )
+            return 1
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            process = subprocess.run(
+                [binary, str(self.args.vectors), str(self.args.repeat)],
+                stdout=subprocess.PIPE,
+                text=True,
+            )
+
+        result = 0
+        print(
+            f"{'Operation':<16} {'Vectors':>8} {'Mismatch':>9} "
+            f"{'Ref ns':>8} {'Lib ns':>8} {'Speedup':>8}"
+        )
+        verified = {}
+        for line in process.stdout.splitlines():
+            kind, name, *values = line.split()
+            if kind == "verify":
+                verified[name] = tuple(map(int, values))
+                if verified[name][1]:
+                    result = 1
+            elif kind == "cost":
+                reference, library = map(int, values)
+                vectors, mismatches = verified.get(name, (0, 0))
+                speedup = reference / library if library else 0
+                print(
+                    f"{name:<16} {vectors:>8} {mismatches:>9} "
+                    f"{reference:>8} {library:>8} {speedup:>7.2f}x"
+                )
+
+        if process.returncode:
+            self.logger.error("Library output differs from reference")
+            result = 1
+
+        return result
+
+
+if __name__ == "__main__":
+    Main()()
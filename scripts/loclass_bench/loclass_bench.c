@@ -0,0 +1,184 @@
+/*
+ * Host benchmark for picopass loclass, see scripts/loclass_bench.py
+ *
+ * Usage: loclass_bench <vectors> <rounds>
+ *
+ * Checks hash0, diversified keys (standard and elite) and reader MACs of the
+ * library against the bit-serial reference on pseudo-random inputs and prints
+ * "verify <operation> <vectors> <mismatches>" per operation. Then times every
+ * operation on both implementations and prints
+ * "cost <operation> <reference ns> <library ns>" per operation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "optimized_cipher.h"
+#include "optimized_ikeys.h"
+#include "loclass_reference.h"
+
+typedef struct {
+    uint8_t csn[8];
+    uint8_t key[8];
+    uint8_t cc_nr[12];
+} Vector;
+
+typedef enum {
+    OperationHash0,
+    OperationDivKey,
+    OperationDivKeyElite,
+    OperationReaderMac,
+    OperationNum,
+} Operation;
+
+static const char* const operation_names[OperationNum] = {
+    "hash0",
+    "div_key",
+    "div_key_elite",
+    "reader_mac",
+};
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void rng_fill(uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        data[i] = rng_next();
+    }
+}
+
+static uint64_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Timed outputs are folded into it, so timing loops are not elided
+static volatile uint8_t sink;
+
+static void run(Operation operation, bool reference, Vector* vector, uint8_t out[8]) {
+    uint64_t c;
+
+    switch(operation) {
+    case OperationHash0:
+        memcpy(&c, vector->csn, sizeof(c));
+        if(reference) {
+            loclass_ref_hash0(c, out);
+        } else {
+            loclass_hash0(c, out);
+        }
+        break;
+    case OperationDivKey:
+    case OperationDivKeyElite:
+        if(reference) {
+            loclass_ref_calc_div_key(
+                vector->csn, vector->key, out, operation == OperationDivKeyElite);
+        } else {
+            loclass_iclass_calc_div_key(
+                vector->csn, vector->key, out, operation == OperationDivKeyElite);
+        }
+        break;
+    case OperationReaderMac:
+        // Diversified keys are uniformly distributed, a random key is as good
+        memset(out, 0, 8);
+        if(reference) {
+            loclass_ref_reader_mac(vector->cc_nr, vector->key, out);
+        } else {
+            loclass_opt_doReaderMAC(vector->cc_nr, vector->key, out);
+        }
+        break;
+    default:
+        abort();
+    }
+}
+
+static size_t verify(Operation operation, Vector* vectors, size_t count) {
+    size_t mismatches = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        uint8_t expected[8];
+        uint8_t actual[8];
+        run(operation, true, &vectors[i], expected);
+        run(operation, false, &vectors[i], actual);
+        if(memcmp(expected, actual, sizeof(expected))) {
+            if(!mismatches) {
+                fprintf(stderr, "%s mismatch on vector %zu\n", operation_names[operation], i);
+            }
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+static uint64_t cost(
+    Operation operation,
+    bool reference,
+    Vector* vectors,
+    size_t count,
+    size_t rounds) {
+    uint64_t best = UINT64_MAX;
+
+    for(size_t round = 0; round < rounds; round++) {
+        uint64_t start = clock_ns();
+        for(size_t i = 0; i < count; i++) {
+            uint8_t out[8];
+            run(operation, reference, &vectors[i], out);
+            sink ^= out[0] ^ out[7];
+        }
+        uint64_t elapsed = clock_ns() - start;
+        if(elapsed < best) best = elapsed;
+    }
+
+    return best / count;
+}
+
+int main(int argc, char** argv) {
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s <vectors> <rounds>\n", argv[0]);
+        return 2;
+    }
+
+    size_t count = strtoul(argv[1], NULL, 0);
+    size_t rounds = strtoul(argv[2], NULL, 0);
+    if(!count || !rounds) return 2;
+
+    Vector* vectors = malloc(count * sizeof(Vector));
+    if(!vectors) return 1;
+
+    for(size_t i = 0; i < count; i++) {
+        rng_fill(vectors[i].csn, sizeof(vectors[i].csn));
+        rng_fill(vectors[i].key, sizeof(vectors[i].key));
+        rng_fill(vectors[i].cc_nr, 8);
+        // Reader nonce is always zero in picopass
+        memset(&vectors[i].cc_nr[8], 0, 4);
+    }
+
+    int result = 0;
+    for(Operation operation = 0; operation < OperationNum; operation++) {
+        size_t mismatches = verify(operation, vectors, count);
+        printf("verify %s %zu %zu\n", operation_names[operation], count, mismatches);
+        if(mismatches) result = 1;
+    }
+
+    for(Operation operation = 0; operation < OperationNum; operation++) {
+        uint64_t reference = cost(operation, true, vectors, count, rounds);
+        uint64_t library = cost(operation, false, vectors, count, rounds);
+        printf(
+            "cost %s %llu %llu\n",
+            operation_names[operation],
+            (unsigned long long)reference,
+            (unsigned long long)library);
+    }
+
+    free(vectors);
+    return result;
+}
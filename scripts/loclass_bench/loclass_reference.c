@@ -0,0 +1,379 @@
+/*
+ * Reference loclass implementation for scripts/loclass_bench.py
+ *
+ * Bit-serial hash0 and MAC as they were before the byte-wise rewrite in
+ * applications/external/picopass/lib/loclass. DES, hash1, hash2 and the key
+ * permutation are shared with the library.
+ */
+
+#include "loclass_reference.h"
+
+#include <string.h>
+#include <mbedtls/des.h>
+
+#include "optimized_cipher.h"
+#include "optimized_cipherutils.h"
+#include "optimized_elite.h"
+
+static const uint8_t loclass_pi[35] = {0x0F, 0x17, 0x1B, 0x1D, 0x1E, 0x27, 0x2B, 0x2D, 0x2E,
+                                       0x33, 0x35, 0x39, 0x36, 0x3A, 0x3C, 0x47, 0x4B, 0x4D,
+                                       0x4E, 0x53, 0x55, 0x56, 0x59, 0x5A, 0x5C, 0x63, 0x65,
+                                       0x66, 0x69, 0x6A, 0x6C, 0x71, 0x72, 0x74, 0x78};
+
+/**
+ * @brief The key diversification algorithm uses 6-bit bytes.
+ * This implementation uses 64 bit uint to pack seven of them into one
+ * variable. When they are there, they are placed as follows:
+ * XXXX XXXX N0 .... N7, occupying the last 48 bits.
+ *
+ * This function picks out one from such a collection
+ * @param all
+ * @param n bitnumber
+ * @return
+ */
+static uint8_t loclass_ref_getSixBitByte(uint64_t c, int n) {
+    return (c >> (42 - 6 * n)) & 0x3F;
+}
+
+/**
+ * @brief Puts back a six-bit 'byte' into a uint64_t.
+ * @param c buffer
+ * @param z the value to place there
+ * @param n bitnumber.
+ */
+static void loclass_ref_pushbackSixBitByte(uint64_t* c, uint8_t z, int n) {
+    //0x XXXX YYYY ZZZZ ZZZZ ZZZZ
+    //             ^z0         ^z7
+    //z0:  1111 1100 0000 0000
+
+    uint64_t masked = z & 0x3F;
+    uint64_t eraser = 0x3F;
+    masked <<= 42 - 6 * n;
+    eraser <<= 42 - 6 * n;
+
+    //masked <<= 6*n;
+    //eraser <<= 6*n;
+
+    eraser = ~eraser;
+    (*c) &= eraser;
+    (*c) |= masked;
+}
+/**
+ * @brief Swaps the z-values.
+ * If the input value has format XYZ0Z1...Z7, the output will have the format
+ * XYZ7Z6...Z0 instead
+ * @param c
+ * @return
+ */
+static uint64_t loclass_ref_swapZvalues(uint64_t c) {
+    uint64_t newz = 0;
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 0), 7);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 1), 6);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 2), 5);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 3), 4);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 4), 3);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 5), 2);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 6), 1);
+    loclass_ref_pushbackSixBitByte(&newz, loclass_ref_getSixBitByte(c, 7), 0);
+    newz |= (c & 0xFFFF000000000000);
+    return newz;
+}
+
+/**
+* @return 4 six-bit bytes chunked into a uint64_t,as 00..00a0a1a2a3
+*/
+static uint64_t loclass_ref_ck(int i, int j, uint64_t z) {
+    if(i == 1 && j == -1) {
+        // loclass_ref_ck(1, −1, z [0] . . . z [3] ) = z [0] . . . z [3]
+        return z;
+    } else if(j == -1) {
+        // loclass_ref_ck(i, −1, z [0] . . . z [3] ) = loclass_ref_ck(i − 1, i − 2, z [0] . . . z [3] )
+        return loclass_ref_ck(i - 1, i - 2, z);
+    }
+
+    if(loclass_ref_getSixBitByte(z, i) == loclass_ref_getSixBitByte(z, j)) {
+        //loclass_ref_ck(i, j − 1, z [0] . . . z [i] ← j . . . z [3] )
+        uint64_t newz = 0;
+        int c;
+        for(c = 0; c < 4; c++) {
+            uint8_t val = loclass_ref_getSixBitByte(z, c);
+            if(c == i)
+                loclass_ref_pushbackSixBitByte(&newz, j, c);
+            else
+                loclass_ref_pushbackSixBitByte(&newz, val, c);
+        }
+        return loclass_ref_ck(i, j - 1, newz);
+    } else {
+        return loclass_ref_ck(i, j - 1, z);
+    }
+}
+/**
+
+    Definition 8.
+    Let the function check : (F 62 ) 8 → (F 62 ) 8 be defined as
+    check(z [0] . . . z [7] ) = loclass_ref_ck(3, 2, z [0] . . . z [3] ) · loclass_ref_ck(3, 2, z [4] . . . z [7] )
+
+    where loclass_ref_ck : N × N × (F 62 ) 4 → (F 62 ) 4 is defined as
+
+        loclass_ref_ck(1, −1, z [0] . . . z [3] ) = z [0] . . . z [3]
+        loclass_ref_ck(i, −1, z [0] . . . z [3] ) = loclass_ref_ck(i − 1, i − 2, z [0] . . . z [3] )
+        loclass_ref_ck(i, j, z [0] . . . z [3] ) =
+        loclass_ref_ck(i, j − 1, z [0] . . . z [i] ← j . . . z [3] ),  if z [i] = z [j] ;
+        loclass_ref_ck(i, j − 1, z [0] . . . z [3] ), otherwise
+
+    otherwise.
+**/
+
+static uint64_t loclass_ref_check(uint64_t z) {
+    //These 64 bits are divided as c = x, y, z [0] , . . . , z [7]
+
+    // loclass_ref_ck(3, 2, z [0] . . . z [3] )
+    uint64_t ck1 = loclass_ref_ck(3, 2, z);
+
+    // loclass_ref_ck(3, 2, z [4] . . . z [7] )
+    uint64_t ck2 = loclass_ref_ck(3, 2, z << 24);
+
+    //The loclass_ref_ck function will place the values
+    // in the middle of z.
+    ck1 &= 0x00000000FFFFFF000000;
+    ck2 &= 0x00000000FFFFFF000000;
+
+    return ck1 | ck2 >> 24;
+}
+
+static void loclass_ref_permute(
+    LoclassBitstreamIn_t* p_in,
+    uint64_t z,
+    int l,
+    int r,
+    LoclassBitstreamOut_t* out) {
+    if(loclass_bitsLeft(p_in) == 0) return;
+
+    bool pn = loclass_tailBit(p_in);
+    if(pn) { // pn = 1
+        uint8_t zl = loclass_ref_getSixBitByte(z, l);
+
+        loclass_push6bits(out, zl + 1);
+        loclass_ref_permute(p_in, z, l + 1, r, out);
+    } else { // otherwise
+        uint8_t zr = loclass_ref_getSixBitByte(z, r);
+
+        loclass_push6bits(out, zr);
+        loclass_ref_permute(p_in, z, l, r + 1, out);
+    }
+}
+
+/**
+ * @brief
+ *Definition 11. Let the function loclass_ref_hash0 : F 82 × F 82 × (F 62 ) 8 → (F 82 ) 8 be defined as
+ *  loclass_ref_hash0(x, y, z [0] . . . z [7] ) = k [0] . . . k [7] where
+ * z'[i] = (z[i] mod (63-i)) + i      i =  0...3
+ * z'[i+4] = (z[i+4] mod (64-i)) + i  i =  0...3
+ * ẑ = check(z');
+ * @param c
+ * @param k this is where the diversified key is put (should be 8 bytes)
+ * @return
+ */
+void loclass_ref_hash0(uint64_t c, uint8_t k[8]) {
+    c = loclass_ref_swapZvalues(c);
+
+    //These 64 bits are divided as c = x, y, z [0] , . . . , z [7]
+    // x = 8 bits
+    // y = 8 bits
+    // z0-z7 6 bits each : 48 bits
+    uint8_t x = (c & 0xFF00000000000000) >> 56;
+    uint8_t y = (c & 0x00FF000000000000) >> 48;
+    uint64_t zP = 0;
+
+    for(int n = 0; n < 4; n++) {
+        uint8_t zn = loclass_ref_getSixBitByte(c, n);
+        uint8_t zn4 = loclass_ref_getSixBitByte(c, n + 4);
+        uint8_t _zn = (zn % (63 - n)) + n;
+        uint8_t _zn4 = (zn4 % (64 - n)) + n;
+        loclass_ref_pushbackSixBitByte(&zP, _zn, n);
+        loclass_ref_pushbackSixBitByte(&zP, _zn4, n + 4);
+    }
+
+    uint64_t zCaret = loclass_ref_check(zP);
+    uint8_t p = loclass_pi[x % 35];
+
+    if(x & 1) //Check if x7 is 1
+        p = ~p;
+
+    LoclassBitstreamIn_t p_in = {&p, 8, 0};
+    uint8_t outbuffer[] = {0, 0, 0, 0, 0, 0, 0, 0};
+    LoclassBitstreamOut_t out = {outbuffer, 0, 0};
+    loclass_ref_permute(&p_in, zCaret, 0, 4, &out); //returns 48 bits? or 6 8-bytes
+
+    //Out is now a buffer containing six-bit bytes, should be 48 bits
+    // if all went well
+    //Shift z-values down onto the lower segment
+
+    uint64_t zTilde = loclass_x_bytes_to_num(outbuffer, sizeof(outbuffer));
+
+    zTilde >>= 16;
+
+    for(int i = 0; i < 8; i++) {
+        // the key on index i is first a bit from y
+        // then six bits from z,
+        // then a bit from p
+
+        // Init with zeroes
+        k[i] = 0;
+        // First, place yi leftmost in k
+        //k[i] |= (y  << i) & 0x80 ;
+
+        // First, place y(7-i) leftmost in k
+        k[i] |= (y << (7 - i)) & 0x80;
+
+        uint8_t zTilde_i = loclass_ref_getSixBitByte(zTilde, i);
+        // zTildeI is now on the form 00XXXXXX
+        // with one leftshift, it'll be
+        // 0XXXXXX0
+        // So after leftshift, we can OR it into k
+        // However, when doing complement, we need to
+        // again MASK 0XXXXXX0 (0x7E)
+        zTilde_i <<= 1;
+
+        //Finally, add bit from p or p-mod
+        //Shift bit i into rightmost location (mask only after complement)
+        uint8_t p_i = p >> i & 0x1;
+
+        if(k[i]) { // yi = 1
+            k[i] |= ~zTilde_i & 0x7E;
+            k[i] |= p_i & 1;
+            k[i] += 1;
+
+        } else { // otherwise
+            k[i] |= zTilde_i & 0x7E;
+            k[i] |= (~p_i) & 1;
+        }
+    }
+}
+
+static const uint8_t loclass_ref_select_LUT[256] = {
+    00, 03, 02, 01, 02, 03, 00, 01, 04, 07, 07, 04, 06, 07, 05, 04, 01, 02, 03, 00, 02, 03, 00, 01,
+    05, 06, 06, 05, 06, 07, 05, 04, 06, 05, 04, 07, 04, 05, 06, 07, 06, 05, 05, 06, 04, 05, 07, 06,
+    07, 04, 05, 06, 04, 05, 06, 07, 07, 04, 04, 07, 04, 05, 07, 06, 06, 05, 04, 07, 04, 05, 06, 07,
+    02, 01, 01, 02, 00, 01, 03, 02, 03, 00, 01, 02, 00, 01, 02, 03, 07, 04, 04, 07, 04, 05, 07, 06,
+    00, 03, 02, 01, 02, 03, 00, 01, 00, 03, 03, 00, 02, 03, 01, 00, 05, 06, 07, 04, 06, 07, 04, 05,
+    05, 06, 06, 05, 06, 07, 05, 04, 02, 01, 00, 03, 00, 01, 02, 03, 06, 05, 05, 06, 04, 05, 07, 06,
+    03, 00, 01, 02, 00, 01, 02, 03, 07, 04, 04, 07, 04, 05, 07, 06, 02, 01, 00, 03, 00, 01, 02, 03,
+    02, 01, 01, 02, 00, 01, 03, 02, 03, 00, 01, 02, 00, 01, 02, 03, 03, 00, 00, 03, 00, 01, 03, 02,
+    04, 07, 06, 05, 06, 07, 04, 05, 00, 03, 03, 00, 02, 03, 01, 00, 01, 02, 03, 00, 02, 03, 00, 01,
+    05, 06, 06, 05, 06, 07, 05, 04, 04, 07, 06, 05, 06, 07, 04, 05, 04, 07, 07, 04, 06, 07, 05, 04,
+    01, 02, 03, 00, 02, 03, 00, 01, 01, 02, 02, 01, 02, 03, 01, 00};
+
+static inline void loclass_ref_successor(const uint8_t* k, LoclassState_t* s, uint8_t y) {
+    uint16_t Tt = s->t & 0xc533;
+    Tt = Tt ^ (Tt >> 1);
+    Tt = Tt ^ (Tt >> 4);
+    Tt = Tt ^ (Tt >> 10);
+    Tt = Tt ^ (Tt >> 8);
+
+    s->t = (s->t >> 1);
+    s->t |= (Tt ^ (s->r >> 7) ^ (s->r >> 3)) << 15;
+
+    uint8_t opt_B = s->b;
+    opt_B ^= s->b >> 6;
+    opt_B ^= s->b >> 5;
+    opt_B ^= s->b >> 4;
+
+    s->b = s->b >> 1;
+    s->b |= (opt_B ^ s->r) << 7;
+
+    uint8_t Tt1 = Tt & 0x01;
+    uint8_t opt_select = loclass_ref_select_LUT[s->r] ^ Tt1 ^ ((Tt1 ^ (y & 0x01)) << 1);
+
+    uint8_t r = s->r;
+    s->r = (k[opt_select] ^ s->b) + s->l;
+    s->l = s->r + r;
+}
+
+static inline void loclass_ref_suc(
+    const uint8_t* k,
+    LoclassState_t* s,
+    const uint8_t* in,
+    uint8_t length,
+    bool add32Zeroes) {
+    for(int i = 0; i < length; i++) {
+        uint8_t head = in[i];
+#pragma GCC unroll 8
+        for(int j = 0; j < 8; j++) {
+            loclass_ref_successor(k, s, head);
+            head >>= 1;
+        }
+    }
+    // For tag MAC, an additional 32 zeroes
+    if(add32Zeroes) {
+        for(int i = 0; i < 32; i++) {
+            loclass_ref_successor(k, s, 0);
+        }
+    }
+}
+
+static inline void loclass_ref_output(const uint8_t* k, LoclassState_t* s, uint8_t* buffer) {
+#pragma GCC unroll 4
+    for(uint8_t times = 0; times < 4; times++) {
+        uint8_t bout = 0;
+        bout |= (s->r & 0x4) >> 2;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) >> 1;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4);
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) << 1;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) << 2;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) << 3;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) << 4;
+        loclass_ref_successor(k, s, 0);
+        bout |= (s->r & 0x4) << 5;
+        loclass_ref_successor(k, s, 0);
+        buffer[times] = bout;
+    }
+}
+
+void loclass_ref_reader_mac(const uint8_t cc_nr[12], const uint8_t div_key[8], uint8_t mac[4]) {
+    LoclassState_t state = {
+        ((div_key[0] ^ 0x4c) + 0xEC) & 0xFF, // l
+        ((div_key[0] ^ 0x4c) + 0x21) & 0xFF, // r
+        0x4c, // b
+        0xE012 // t
+    };
+
+    loclass_ref_suc(div_key, &state, cc_nr, 12, false);
+    loclass_ref_output(div_key, &state, mac);
+}
+
+void loclass_ref_calc_div_key(
+    const uint8_t csn[8],
+    const uint8_t key[8],
+    uint8_t div_key[8],
+    bool elite) {
+    uint8_t key_sel_p[8];
+
+    if(elite) {
+        uint8_t keytable[128] = {0};
+        uint8_t key_index[8] = {0};
+        uint8_t key_sel[8] = {0};
+        loclass_hash2(key, keytable);
+        loclass_hash1(csn, key_index);
+        for(uint8_t i = 0; i < 8; i++) key_sel[i] = keytable[key_index[i]];
+        loclass_permutekey_rev(key_sel, key_sel_p);
+    } else {
+        memcpy(key_sel_p, key, sizeof(key_sel_p));
+    }
+
+    mbedtls_des_context ctx;
+    mbedtls_des_init(&ctx);
+    mbedtls_des_setkey_enc(&ctx, key_sel_p);
+
+    uint8_t crypted_csn[8] = {0};
+    mbedtls_des_crypt_ecb(&ctx, csn, crypted_csn);
+    mbedtls_des_free(&ctx);
+
+    loclass_ref_hash0(loclass_x_bytes_to_num(crypted_csn, sizeof(crypted_csn)), div_key);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void loclass_ref_hash0(uint64_t c, uint8_t k[8]);
+
+void loclass_ref_reader_mac(const uint8_t cc_nr[12], const uint8_t div_key[8], uint8_t mac[4]);
+
+void loclass_ref_calc_div_key(
+    const uint8_t csn[8],
+    const uint8_t key[8],
+    uint8_t div_key[8],
+    bool elite);
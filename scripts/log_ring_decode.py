@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+
+# Decoder for asynchronous log ring (see furi/core/log.c)
+#
+# Ring can be dumped with debugger, for example from gdb:
+#   dump binary memory ram.bin 0x20000000 0x20030000
+# Ring is located by its magic, tag and format pointers are resolved
+# against firmware ELF.
+
+import re
+import struct
+
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+
+RING_MAGIC = 0x474F4C46
+RING_HEADER = struct.Struct("<IIIII")
+RECORD_HEADER = struct.Struct("<HBBIII")
+
+STATE_RESERVED = 0
+STATE_COMMITTED = 1
+STATE_PADDING = 2
+
+FLAG_RAW = 1 << 0
+FLAG_TAG_INLINE = 1 << 1
+FLAG_FORMAT_INLINE = 1 << 2
+
+LEVEL_LETTERS = {2: "E", 3: "W", 4: "I", 5: "D", 6: "T"}
+
+SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|ll|[hljztL])?(?P<conv>[diouxXcfFeEgGaApns%])"
+)
+
+
+class ElfStrings:
+    def __init__(self, elf_path):
+        self.segments = []
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for segment in elf.iter_segments():
+                if segment["p_type"] == "PT_LOAD" and segment["p_filesz"]:
+                    self.segments.append((segment["p_vaddr"], segment.data()))
+
+    def get(self, address):
+        for base, data in self.segments:
+            if base <= address < base + len(data):
+                end = data.find(b"\0", address - base)
+                return data[address - base : end].decode("utf-8", "replace")
+        return f"<0x{address:08x}>"
+
+
+class RecordReader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def take(self, fmt):
+        value = struct.unpack_from(fmt, self.data, self.offset)[0]
+        self.offset += struct.calcsize(fmt)
+        return value
+
+    def string(self):
+        length = self.data[self.offset]
+        value = self.data[self.offset + 1 : self.offset + 1 + length]
+        self.offset += 1 + length
+        return value.decode("utf-8", "replace")
+
+
+def format_record(fmt, reader):
+    def substitute(match):
+        spec = match.groupdict()
+        if spec["conv"] == "%":
+            return "%"
+        width = spec["width"] or ""
+        precision = spec["precision"]
+        if width == "*":
+            width = str(reader.take("<i"))
+        if precision == "*":
+            precision = str(reader.take("<i"))
+        is_64bit = spec["length"] in ("ll", "j")
+        conv = spec["conv"]
+        py_spec = "%" + spec["flags"] + width
+        if precision is not None:
+            py_spec += "." + precision
+
+        if conv in "diouxXc":
+            value = reader.take("<q" if is_64bit else "<i")
+            if conv in "ouxX" and value < 0:
+                value += 1 << (64 if is_64bit else 32)
+            return (py_spec + ("d" if conv == "i" else conv)) % value
+        if conv in "fFeEgGaA":
+            value = reader.take("<d")
+            return (py_spec + ("f" if conv in "aA" else conv)) % value
+        if conv in "pn":
+            value = reader.take("<I")
+            return "" if conv == "n" else (py_spec + "s") % f"0x{value:x}"
+        return (py_spec + "s") % reader.string()
+
+    return SPEC_RE.sub(substitute, fmt)
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("elf", help="Firmware ELF")
+        self.parser.add_argument("dump", help="Binary memory dump containing log ring")
+        self.parser.set_defaults(func=self.decode)
+
+    def decode(self):
+        strings = ElfStrings(self.args.elf)
+        with open(self.args.dump, "rb") as f:
+            dump = f.read()
+
+        position = dump.find(struct.pack("<I", RING_MAGIC))
+        while position >= 0:
+            magic, size, head, tail, dropped = RING_HEADER.unpack_from(dump, position)
+            if size and (size & (size - 1)) == 0 and head - tail <= size:
+                break
+            position = dump.find(struct.pack("<I", RING_MAGIC), position + 4)
+        else:
+            self.logger.error("Log ring not found in dump")
+            return 1
+
+        data = dump[position + RING_HEADER.size : position + RING_HEADER.size + size]
+        self.logger.info(f"Ring at +0x{position:x}: head {head}, tail {tail}")
+        if dropped:
+            self.logger.warning(f"{dropped} records dropped")
+
+        # Only records not yet printed by drain thread are guaranteed to be intact
+        cursor = tail
+        while cursor < head:
+            offset = cursor & (size - 1)
+            rec_size, state = struct.unpack_from("<HB", data, offset)
+            if state == STATE_PADDING:
+                cursor += rec_size
+                continue
+            (
+                rec_size,
+                state,
+                level,
+                timestamp,
+                tag_ptr,
+                format_ptr,
+            ) = RECORD_HEADER.unpack_from(data, offset)
+            if rec_size == 0 or rec_size & 3:
+                self.logger.error(f"Corrupted record at {cursor}")
+                return 1
+            cursor += rec_size
+            if state != STATE_COMMITTED:
+                continue
+
+            flags = level >> 4
+            reader = RecordReader(data[offset + RECORD_HEADER.size : offset + rec_size])
+            tag = reader.string() if flags & FLAG_TAG_INLINE else strings.get(tag_ptr)
+            fmt = (
+                reader.string()
+                if flags & FLAG_FORMAT_INLINE
+                else strings.get(format_ptr)
+            )
+            text = format_record(fmt, reader)
+            if flags & FLAG_RAW:
+                print(text, end="")
+            else:
+                letter = LEVEL_LETTERS.get(level & 0x0F, " ")
+                print(f"{timestamp} [{letter}][{tag}] {text}")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+
+# Host benchmark of mJS garbage collector
+#
+# Builds lib/mjs with the host compiler together with scripts/mjs_bench/mjs_bench.c
+# and runs every benchmark script in a fresh interpreter instance. Reports
+# execution time, number of collections, total and longest GC pause and peak
+# heap usage. Run it on two commits to compare.
+#
+# With --roundtrip, checks instead that bytecode of every script survives
+# being stored and loaded back through the bytecode cache hooks, and that the
+# reloaded bytecode runs without parsing and gives the same result.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+MJS_DIR = os.path.join(ROOT_DIR, "lib", "mjs")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "mjs_bench")
+
+CFLAGS = [
+    "-O2",
+    "-Wall",
+    "-DCS_PLATFORM=CS_P_FLIPPER",
+    "-DCS_ENABLE_STDIO=1",
+    "-DMJS_MEMORY_STATS=1",
+    "-DMJS_GC_CLOCK()=mjs_bench_clock_us()",
+    "-include",
+    "mjs_bench_clock.h",
+]
+
+# Harness sources, the library itself only has -Wall
+HARNESS_CFLAGS = ["-Wextra", "-Werror"]
+
+LDFLAGS = ["-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free", "-lm"]
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.add_argument(
+            "-r", "--repeat", type=int, default=3, help="Runs per script, best is kept"
+        )
+        self.parser.add_argument(
+            "--roundtrip",
+            action="store_true",
+            help="Check bytecode cache round trip instead of benchmarking",
+        )
+        self.parser.add_argument(
+            "scripts",
+            nargs="*",
+            help="Scripts to run, defaults to scripts/mjs_bench/*.js",
+        )
+        self.parser.set_defaults(func=self.bench)
+
+    def _sources(self):
+        for dirpath, _, filenames in os.walk(MJS_DIR):
+            # Platform glue needs firmware storage
+            if "platforms" in dirpath:
+                continue
+            for filename in sorted(filenames):
+                if filename.endswith(".c"):
+                    yield os.path.join(dirpath, filename), []
+        yield os.path.join(BENCH_DIR, "mjs_bench.c"), HARNESS_CFLAGS
+
+    def _build(self, build_dir):
+        objects = []
+        includes = ["-I", os.path.join(BENCH_DIR, "furi_stub"), "-I", MJS_DIR]
+        for index, (source, cflags) in enumerate(self._sources()):
+            obj = os.path.join(build_dir, f"{index}.o")
+            subprocess.check_call(
+                [self.args.cc, "-c", *CFLAGS, *cflags, *includes, source, "-o", obj]
+            )
+            objects.append(obj)
+        binary = os.path.join(build_dir, "mjs_bench")
+        subprocess.check_call([self.args.cc, *objects, *LDFLAGS, "-o", binary])
+        return binary
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        scripts = self.args.scripts or sorted(
+            os.path.join(BENCH_DIR, name)
+            for name in os.listdir(BENCH_DIR)
+            if name.endswith(".js")
+        )
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            if self.args.roundtrip:
+                return self._roundtrip(binary, scripts)
+
+            print(
+                f"{'Script':<20} {'Result':>8} {'Time us':>9} {'GCs':>6} "
+                f"{'GC us':>9} {'Max us':>7} {'Heap':>7} {'Strings':>8}"
+            )
+            for script in scripts:
+                samples = []
+                for _ in range(self.args.repeat):
+                    try:
+                        output = subprocess.check_output([binary, script], text=True)
+                    except subprocess.CalledProcessError:
+                        self.logger.error(f"{script} failed")
+                        return 1
+                    samples.append(output.split()[1:])
+                result, *stats = min(samples, key=lambda sample: int(sample[1]))
+                name = os.path.splitext(os.path.basename(script))[0]
+                time, runs, gc_time, max_pause, heap, strings = map(int, stats)
+                print(
+                    f"{name:<20} {result:>8} {time:>9} {runs:>6} "
+                    f"{gc_time:>9} {max_pause:>7} {heap:>7} {strings:>8}"
+                )
+
+        return 0
+
+    def _roundtrip(self, binary, scripts):
+        print(f"{'Script':<20} {'Parsed':>8} {'Cached':>8}")
+        failed = 0
+        for script in scripts:
+            process = subprocess.run(
+                [binary, "--roundtrip", script], text=True, stdout=subprocess.PIPE
+            )
+            name = os.path.splitext(os.path.basename(script))[0]
+            if process.stdout:
+                parsed, cached = process.stdout.split()[1:]
+                print(f"{name:<20} {parsed:>8} {cached:>8}")
+            if process.returncode:
+                self.logger.error(f"{script} round trip failed")
+                failed += 1
+        return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    Main()()
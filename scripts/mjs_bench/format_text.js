@@ -0,0 +1,20 @@
+// Formats UI text lines in a loop, keeping a few of them alive
+function str(n) {
+  let s = "";
+  while (n > 0 || s === "") {
+    s = chr(48 + n % 10) + s;
+    n = (n - n % 10) / 10;
+  }
+  return s;
+}
+
+let lines = [];
+let total = 0;
+for (let i = 0; i < 2000; i++) {
+  let line = "Frequency: " + str(433920 + i) + " kHz, " + "modulation: AM650";
+  if (i % 100 === 0) {
+    lines.push(line);
+  }
+  total = total + line.length;
+}
+total + lines.length;
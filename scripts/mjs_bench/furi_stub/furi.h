@@ -0,0 +1,13 @@
+#pragma once
+
+/* Minimal furi replacement for host builds of lib/mjs */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define furi_assert(x) assert(x)
+#define furi_check(x) assert(x)
+
+#define UNUSED(x) (void)(x)
@@ -0,0 +1,4 @@
+#pragma once
+
+/* GC pause clock for host builds of lib/mjs, microseconds */
+unsigned long mjs_bench_clock_us(void);
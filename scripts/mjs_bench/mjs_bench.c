@@ -0,0 +1,223 @@
+/*
+ * Host benchmark for lib/mjs garbage collector, see scripts/mjs_bench.py
+ *
+ * Runs each script given on the command line in a fresh mJS instance and
+ * prints one line per script: name, result, execution time, GC runs, total
+ * and max GC pause, peak heap and peak owned strings buffer size.
+ *
+ * With --roundtrip, every script is compiled and its bytecode is taken out
+ * through the bytecode cache hooks, then loaded into a fresh instance and
+ * executed without parsing. Prints name and result of both runs, fails if
+ * they differ.
+ */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mjs_core.h"
+#include "mjs_exec_public.h"
+#include "mjs_primitive_public.h"
+#include "common/cs_file.h"
+
+static size_t heap_used;
+static size_t heap_peak;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static void heap_account(void* ptr, size_t prev_size) {
+    heap_used -= prev_size;
+    if(ptr) heap_used += malloc_usable_size(ptr);
+    if(heap_used > heap_peak) heap_peak = heap_used;
+}
+
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    heap_account(ptr, 0);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    heap_account(ptr, 0);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    size_t prev_size = ptr ? malloc_usable_size(ptr) : 0;
+    void* new_ptr = __real_realloc(ptr, size);
+    if(new_ptr || size == 0) {
+        heap_account(new_ptr, prev_size);
+    }
+    return new_ptr;
+}
+
+void __wrap_free(void* ptr) {
+    if(ptr) heap_account(NULL, malloc_usable_size(ptr));
+    __real_free(ptr);
+}
+
+unsigned long mjs_bench_clock_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000UL + ts.tv_nsec / 1000;
+}
+
+/* Replaces lib/mjs/common/platforms/platform_flipper.c, which needs storage */
+char* cs_read_file(const char* path, size_t* size_out) {
+    FILE* fp = fopen(path, "rb");
+    char* data = NULL;
+    long size;
+
+    if(fp == NULL) return NULL;
+    if(fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0) {
+        data = malloc(size + 1);
+        if(fread(data, 1, size, fp) != (size_t)size) {
+            free(data);
+            data = NULL;
+        } else {
+            data[size] = '\0';
+            if(size_out) *size_out = size;
+        }
+    }
+    fclose(fp);
+    return data;
+}
+
+/* Replaces persistent bytecode cache of platform_flipper.c with a single
+ * in-memory entry */
+static struct {
+    char* path;
+    char* src;
+    char* bcode;
+    size_t bcode_len;
+} bcode_cache;
+
+static void bcode_cache_reset(void) {
+    free(bcode_cache.path);
+    free(bcode_cache.src);
+    free(bcode_cache.bcode);
+    memset(&bcode_cache, 0, sizeof(bcode_cache));
+}
+
+char* cs_bcode_cache_load(const char* path, const char* src, size_t src_len, size_t* bcode_len) {
+    if(bcode_cache.bcode == NULL || strcmp(bcode_cache.path, path) != 0 ||
+       strlen(bcode_cache.src) != src_len || memcmp(bcode_cache.src, src, src_len) != 0) {
+        return NULL;
+    }
+    char* bcode = malloc(bcode_cache.bcode_len);
+    memcpy(bcode, bcode_cache.bcode, bcode_cache.bcode_len);
+    *bcode_len = bcode_cache.bcode_len;
+    return bcode;
+}
+
+void cs_bcode_cache_store(
+    const char* path,
+    const char* src,
+    size_t src_len,
+    const char* bcode,
+    size_t bcode_len) {
+    bcode_cache_reset();
+    bcode_cache.path = strdup(path);
+    bcode_cache.src = strndup(src, src_len);
+    bcode_cache.bcode = malloc(bcode_len);
+    memcpy(bcode_cache.bcode, bcode, bcode_len);
+    bcode_cache.bcode_len = bcode_len;
+}
+
+static int roundtrip_exec(const char* path, size_t* parse_cnt) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_set_generate_jsc(mjs, 1);
+    /* Leftover from an earlier failure must not leak into the run */
+    mjs_set_errorf(mjs, MJS_INTERNAL_ERROR, "stale error");
+
+    mjs_val_t result = MJS_UNDEFINED;
+    mjs_err_t err = mjs_exec_file(mjs, path, &result);
+    int value = -1;
+    if(err != MJS_OK) {
+        fprintf(stderr, "%s: %s\n", path, mjs_strerror(mjs, err));
+    } else if(mjs_is_number(result)) {
+        value = mjs_get_int(mjs, result);
+    }
+    *parse_cnt = mjs_get_parse_cnt(mjs);
+
+    mjs_destroy(mjs);
+    return err == MJS_OK ? value : -2;
+}
+
+static int roundtrip_script(const char* path) {
+    size_t compiled_parse_cnt, cached_parse_cnt;
+
+    bcode_cache_reset();
+    int compiled = roundtrip_exec(path, &compiled_parse_cnt);
+    if(bcode_cache.bcode == NULL) {
+        fprintf(stderr, "%s: bytecode was not stored\n", path);
+        return 1;
+    }
+    int cached = roundtrip_exec(path, &cached_parse_cnt);
+    bcode_cache_reset();
+
+    printf("%s %d %d\n", path, compiled, cached);
+    if(compiled_parse_cnt != 1 || cached_parse_cnt != 0) {
+        fprintf(stderr, "%s: cached run was parsed\n", path);
+        return 1;
+    }
+    return compiled < -1 || compiled != cached;
+}
+
+static int run_script(const char* path) {
+    char* src = cs_read_file(path, NULL);
+    if(src == NULL) {
+        fprintf(stderr, "%s: cannot read\n", path);
+        return 1;
+    }
+
+    size_t heap_base = heap_used;
+    heap_peak = heap_used;
+
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_val_t result = MJS_UNDEFINED;
+
+    unsigned long start = mjs_bench_clock_us();
+    mjs_err_t err = mjs_exec(mjs, src, &result);
+    unsigned long elapsed = mjs_bench_clock_us() - start;
+
+    if(err != MJS_OK) {
+        fprintf(stderr, "%s: %s\n", path, mjs_strerror(mjs, err));
+    } else {
+        const struct mjs_gc_stats* stats = &mjs->gc_stats;
+        printf(
+            "%s %d %lu %lu %lu %lu %zu %zu\n",
+            path,
+            mjs_is_number(result) ? mjs_get_int(mjs, result) : -1,
+            elapsed,
+            stats->runs,
+            stats->total_time,
+            stats->max_pause,
+            heap_peak - heap_base,
+            stats->strings_peak);
+    }
+
+    mjs_destroy(mjs);
+    free(src);
+    return err != MJS_OK;
+}
+
+int main(int argc, char** argv) {
+    int ret = 0;
+    int (*run)(const char*) = run_script;
+    int i = 1;
+    if(argc > 1 && strcmp(argv[1], "--roundtrip") == 0) {
+        run = roundtrip_script;
+        i++;
+    }
+    for(; i < argc; i++) {
+        ret |= run(argv[i]);
+    }
+    return ret;
+}
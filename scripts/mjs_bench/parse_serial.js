@@ -0,0 +1,20 @@
+// Splits serial input into key/value records
+let input = "";
+for (let i = 0; i < 40; i++) {
+  input = input + "temperature=" + chr(48 + i % 10) + ";humidity_level=" + chr(48 + i % 7) + ";";
+}
+
+let count = 0;
+for (let round = 0; round < 20; round++) {
+  let record = {};
+  let pos = 0;
+  while (pos < input.length) {
+    let eq = input.indexOf("=", pos);
+    let end = input.indexOf(";", eq);
+    let key = input.slice(pos, eq);
+    record[key] = input.slice(eq + 1, end);
+    pos = end + 1;
+    count = count + 1;
+  }
+}
+count;
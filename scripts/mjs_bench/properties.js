@@ -0,0 +1,16 @@
+// Reads and writes properties and variables with long names
+let settings = {
+  backlightLevel: 10,
+  vibrationEnabled: 1,
+  soundVolumeLevel: 5,
+  displayTimeout: 30,
+};
+let accumulator = 0;
+for (let iteration = 0; iteration < 5000; iteration++) {
+  settings.backlightLevel = settings.backlightLevel + 1;
+  accumulator = accumulator + settings.soundVolumeLevel + settings.displayTimeout;
+  if (settings.vibrationEnabled === 1) {
+    accumulator = accumulator + 1;
+  }
+}
+accumulator;
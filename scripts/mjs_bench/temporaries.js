@@ -0,0 +1,12 @@
+// Allocates short-lived objects while a larger set of objects stays alive
+let retained = [];
+for (let i = 0; i < 300; i++) {
+  retained.push({ index: i, label: "retained object" });
+}
+
+let sum = 0;
+for (let i = 0; i < 5000; i++) {
+  let tmp = { index: i, label: "temporary object" };
+  sum = sum + tmp.index % 7;
+}
+sum + retained.length;
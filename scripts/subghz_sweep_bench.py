@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+
+# Host benchmark of CC1101 frequency sweeps
+#
+# Builds lib/drivers/cc1101.c with the host compiler against the CC1101 model
+# in scripts/subghz_sweep_bench, which stands in for the SPI bus and cortex
+# timer. Compares calibrate-every-step sweeps with fixed delays against
+# calibration cached sweeps, checks every RSSI reading against the model and
+# reports virtual time, calibrations and SPI transactions per sweep.
+
+import os
+import shutil
+import subprocess
+import tempfile
+
+from flipper.app import App
+
+ROOT_DIR = os.path.normpath(os.path.join(os.path.dirname(__file__), ".."))
+DRIVERS_DIR = os.path.join(ROOT_DIR, "lib", "drivers")
+BENCH_DIR = os.path.join(ROOT_DIR, "scripts", "subghz_sweep_bench")
+STUB_DIR = os.path.join(BENCH_DIR, "furi_stub")
+
+# CC1101Status packs an enum bitfield into a byte, as arm-none-eabi does by default
+CFLAGS = ["-O2", "-Wall", "-Wextra", "-fshort-enums"]
+
+SOURCES = [
+    os.path.join(DRIVERS_DIR, "cc1101.c"),
+    os.path.join(BENCH_DIR, "cc1101_model.c"),
+    os.path.join(BENCH_DIR, "subghz_sweep_bench.c"),
+]
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--cc", default="cc", help="Host C compiler")
+        self.parser.set_defaults(func=self.bench)
+
+    def _build(self, build_dir):
+        includes = ["-I", STUB_DIR, "-I", DRIVERS_DIR]
+        binary = os.path.join(build_dir, "subghz_sweep_bench")
+        subprocess.check_call(
+            [self.args.cc, *CFLAGS, *includes, *SOURCES, "-o", binary]
+        )
+        return binary
+
+    def bench(self):
+        if not shutil.which(self.args.cc):
+            self.logger.error(f"Compiler {self.args.cc} not found")
+            return 1
+
+        with tempfile.TemporaryDirectory() as build_dir:
+            try:
+                binary = self._build(build_dir)
+            except subprocess.CalledProcessError:
+                self.logger.error("Build failed")
+                return 1
+
+            process = subprocess.run([binary], stdout=subprocess.PIPE, text=True)
+
+        result = 1 if process.returncode else 0
+        print(
+            f"{'Scenario':<12} {'Method':<10} {'Channels':>8} {'Time us':>8} "
+            f"{'us/ch':>6} {'SCAL':>5} {'SPI':>5} {'Mismatch':>8} {'Errors':>6}"
+        )
+        legacy = {}
+        for line in process.stdout.splitlines():
+            kind, scenario, method, *values = line.split()
+            if kind != "result":
+                continue
+            channels, time, scal, spi, mismatches, errors = map(int, values)
+            if mismatches or errors:
+                result = 1
+            print(
+                f"{scenario:<12} {method:<10} {channels:>8} {time:>8} "
+                f"{time // channels:>6} {scal:>5} {spi:>5} {mismatches:>8} {errors:>6}"
+            )
+            if method == "legacy":
+                legacy[scenario] = time
+            elif method == "sweep" and time:
+                speedup = legacy.get(scenario, 0) / time
+                self.logger.info(f"{scenario}: sweep {speedup:.1f}x faster")
+
+        if result:
+            self.logger.error("Sweep readings differ from the model")
+
+        return result
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,297 @@
+#include "cc1101_model.h"
+
+#include <string.h>
+
+#include <cc1101_regs.h>
+#include <furi_hal_cortex.h>
+#include <furi_hal_spi.h>
+
+/* Datasheet typical values: SPI at 8MHz with chip select overhead, calibration
+ * and PLL settling from table 34 */
+#define MODEL_SPI_TRANSACTION_NS 2000
+#define MODEL_SPI_BYTE_NS 1000
+#define MODEL_CALIBRATION_NS 718000
+#define MODEL_SETTLING_NS 85000
+
+#define MODEL_NOISE_FLOOR -100.0f
+#define MODEL_UNLOCKED -110.0f
+#define MODEL_MCSM0_FS_AUTOCAL_IDLE_TO_RXTX (0b01 << 4)
+
+#define MODEL_MAX_EMITTERS 8
+
+typedef struct {
+    uint64_t now;
+    uint8_t regs[CC1101_TEST0 + 1];
+
+    CC1101State target;
+    uint64_t calibration_until;
+    uint64_t settling_until;
+    bool calibration_pending;
+
+    uint8_t rssi;
+    uint64_t rssi_update_at;
+
+    CC1101ModelEmitter emitters[MODEL_MAX_EMITTERS];
+    size_t emitter_count;
+
+    CC1101ModelStats stats;
+} CC1101Model;
+
+static CC1101Model model;
+
+static uint32_t model_get_freq_word(void) {
+    return (model.regs[CC1101_FREQ2] << 16) | (model.regs[CC1101_FREQ1] << 8) |
+           model.regs[CC1101_FREQ0];
+}
+
+static uint32_t model_get_frequency(void) {
+    return (uint64_t)model_get_freq_word() * CC1101_QUARTZ / CC1101_FDIV;
+}
+
+/* Synthetic calibration result, unique for every few kHz of tuning */
+static void model_get_fscal(uint32_t freq_word, uint8_t fscal[3]) {
+    fscal[0] = 0xE0 | ((freq_word >> 16) & 0x0F);
+    fscal[1] = (freq_word >> 10) & 0x20;
+    fscal[2] = (freq_word >> 4) & 0x3F;
+}
+
+static bool model_is_locked(void) {
+    uint8_t fscal[3];
+    model_get_fscal(model_get_freq_word(), fscal);
+    return memcmp(fscal, &model.regs[CC1101_FSCAL3], sizeof(fscal)) == 0;
+}
+
+static uint32_t model_get_bandwidth(void) {
+    uint8_t mdmcfg4 = model.regs[CC1101_MDMCFG4];
+    return CC1101_QUARTZ / ((8 * (4 + ((mdmcfg4 >> 4) & 0b11))) << (mdmcfg4 >> 6));
+}
+
+/* AGC wait time plus averaging, without any margin */
+static uint64_t model_get_rssi_settle_ns(void) {
+    uint8_t agcctrl0 = model.regs[CC1101_AGCCTRL0];
+    uint32_t samples = 8 * (1 + ((agcctrl0 >> 4) & 0b11)) + (8 << (agcctrl0 & 0b11));
+    return (uint64_t)samples * 1000000000 / model_get_bandwidth();
+}
+
+static float model_get_power(uint32_t frequency) {
+    float power = MODEL_NOISE_FLOOR;
+    uint32_t half_bandwidth = model_get_bandwidth() / 2;
+    for(size_t i = 0; i < model.emitter_count; i++) {
+        uint32_t offset = frequency > model.emitters[i].frequency ?
+                              frequency - model.emitters[i].frequency :
+                              model.emitters[i].frequency - frequency;
+        if(offset > half_bandwidth) continue;
+        // Filter roll off, keeps the peak unique
+        float level = model.emitters[i].power - 6.0f * offset / half_bandwidth;
+        if(level > power) power = level;
+    }
+    return power;
+}
+
+static uint8_t model_power_to_rssi(float power) {
+    return (uint8_t)(int8_t)((power + 74.0f) * 2.0f);
+}
+
+static void model_update(void) {
+    if(model.calibration_pending && model.now >= model.calibration_until) {
+        model_get_fscal(model_get_freq_word(), &model.regs[CC1101_FSCAL3]);
+        model.calibration_pending = false;
+    }
+}
+
+static CC1101State model_get_state(void) {
+    model_update();
+    if(model.now < model.calibration_until) return CC1101StateCALIBRATE;
+    if(model.now < model.settling_until) return CC1101StateSETTLING;
+    return model.target;
+}
+
+static void model_strobe(uint8_t strobe) {
+    CC1101State state = model_get_state();
+
+    switch(strobe) {
+    case CC1101_STROBE_SRES:
+        cc1101_model_reset();
+        break;
+    case CC1101_STROBE_SIDLE:
+        // Aborts calibration and settling
+        model.target = CC1101StateIDLE;
+        model.calibration_until = 0;
+        model.settling_until = 0;
+        model.calibration_pending = false;
+        break;
+    case CC1101_STROBE_SCAL:
+        if(state != CC1101StateIDLE) {
+            model.stats.errors++;
+            break;
+        }
+        model.stats.scal++;
+        model.calibration_until = model.now + MODEL_CALIBRATION_NS;
+        model.settling_until = model.calibration_until;
+        model.calibration_pending = true;
+        break;
+    case CC1101_STROBE_SRX:
+        if(state != CC1101StateIDLE) {
+            if(state != CC1101StateRX) model.stats.errors++;
+            break;
+        }
+        if((model.regs[CC1101_MCSM0] & (0b11 << 4)) == MODEL_MCSM0_FS_AUTOCAL_IDLE_TO_RXTX) {
+            model.stats.autocal++;
+            model.calibration_until = model.now + MODEL_CALIBRATION_NS;
+            model.calibration_pending = true;
+        }
+        model.settling_until =
+            (model.calibration_pending ? model.calibration_until : model.now) + MODEL_SETTLING_NS;
+        model.target = CC1101StateRX;
+        model.rssi_update_at = model.settling_until + model_get_rssi_settle_ns();
+        break;
+    case CC1101_STROBE_SNOP:
+    case CC1101_STROBE_SFRX:
+    case CC1101_STROBE_SFTX:
+        break;
+    default:
+        model.stats.errors++;
+        break;
+    }
+}
+
+static uint8_t model_read_status_reg(uint8_t reg) {
+    switch(reg) {
+    case CC1101_STATUS_PARTNUM:
+        return 0x00;
+    case CC1101_STATUS_VERSION:
+        return 0x14;
+    case CC1101_STATUS_RSSI:
+        // Register keeps the previous estimate until the new one is ready
+        if(model_get_state() == CC1101StateRX && model.now >= model.rssi_update_at) {
+            model.rssi = model_power_to_rssi(
+                model_is_locked() ? model_get_power(model_get_frequency()) : MODEL_UNLOCKED);
+        }
+        return model.rssi;
+    case CC1101_STATUS_MARCSTATE:
+        return model_get_state() == CC1101StateRX ? 0x0D : 0x01;
+    default:
+        return 0;
+    }
+}
+
+static void model_write_reg(uint8_t reg, uint8_t data) {
+    if(reg > CC1101_TEST0) return;
+    // Synthesizer registers only take effect in IDLE
+    bool synthesizer = (reg >= CC1101_FREQ2 && reg <= CC1101_FREQ0) ||
+                       (reg >= CC1101_FSCAL3 && reg <= CC1101_FSCAL0);
+    if(synthesizer && model_get_state() != CC1101StateIDLE) model.stats.errors++;
+    model.regs[reg] = data;
+}
+
+static uint8_t model_status_byte(void) {
+    return model_get_state() << 4;
+}
+
+bool furi_hal_gpio_read(const GpioPin* gpio) {
+    (void)gpio;
+    return false;
+}
+
+bool furi_hal_spi_bus_trx(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout) {
+    (void)handle;
+    (void)timeout;
+
+    model.stats.spi++;
+    model.now += MODEL_SPI_TRANSACTION_NS + MODEL_SPI_BYTE_NS * size;
+
+    uint8_t header = tx_buffer ? tx_buffer[0] : 0;
+    uint8_t address = header & 0x3F;
+    bool read = header & CC1101_READ;
+    bool burst = header & CC1101_BURST;
+
+    uint8_t rx[64] = {0};
+    rx[0] = model_status_byte();
+
+    if(address >= CC1101_STROBE_SRES && address <= CC1101_STROBE_SNOP && !burst) {
+        model_strobe(address);
+    } else if(address >= CC1101_STROBE_SRES && address <= CC1101_STROBE_SNOP) {
+        if(size > 1) rx[1] = model_read_status_reg(address);
+    } else if(address < CC1101_PATABLE) {
+        for(size_t i = 1; i < size && i < sizeof(rx); i++) {
+            uint8_t reg = address + (burst ? i - 1 : 0);
+            if(read) {
+                rx[i] = reg <= CC1101_TEST0 ? model.regs[reg] : 0;
+            } else {
+                model_write_reg(reg, tx_buffer[i]);
+                rx[i] = model_status_byte();
+            }
+        }
+    }
+
+    if(rx_buffer) memcpy(rx_buffer, rx, size < sizeof(rx) ? size : sizeof(rx));
+    return true;
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    model.now += (uint64_t)microseconds * 1000;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    return (FuriHalCortexTimer){.start = model.now, .value = timeout_us};
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return model.now - cortex_timer.start >= (uint64_t)cortex_timer.value * 1000;
+}
+
+void cc1101_model_reset(void) {
+    uint64_t now = model.now;
+    CC1101ModelEmitter emitters[MODEL_MAX_EMITTERS];
+    size_t emitter_count = model.emitter_count;
+    memcpy(emitters, model.emitters, sizeof(emitters));
+
+    memset(&model, 0, sizeof(model));
+    model.now = now;
+    memcpy(model.emitters, emitters, sizeof(emitters));
+    model.emitter_count = emitter_count;
+
+    model.regs[CC1101_FREQ2] = 0x1E;
+    model.regs[CC1101_FREQ1] = 0xC4;
+    model.regs[CC1101_FREQ0] = 0xEC;
+    model.regs[CC1101_MDMCFG4] = 0x8C;
+    model.regs[CC1101_MCSM0] = 0x04;
+    model.regs[CC1101_AGCCTRL0] = 0x91;
+    model.regs[CC1101_FSCAL3] = 0xA9;
+    model.regs[CC1101_FSCAL2] = 0x0A;
+    model.regs[CC1101_FSCAL1] = 0x20;
+    model.regs[CC1101_FSCAL0] = 0x0D;
+    model.target = CC1101StateIDLE;
+    model.rssi = model_power_to_rssi(MODEL_UNLOCKED);
+}
+
+void cc1101_model_set_emitters(const CC1101ModelEmitter* emitters, size_t count) {
+    if(count > MODEL_MAX_EMITTERS) count = MODEL_MAX_EMITTERS;
+    memcpy(model.emitters, emitters, sizeof(CC1101ModelEmitter) * count);
+    model.emitter_count = count;
+}
+
+uint64_t cc1101_model_get_time_ns(void) {
+    return model.now;
+}
+
+const CC1101ModelStats* cc1101_model_get_stats(void) {
+    return &model.stats;
+}
+
+void cc1101_model_clear_stats(void) {
+    memset(&model.stats, 0, sizeof(model.stats));
+}
+
+uint8_t cc1101_model_get_reg(uint8_t reg) {
+    return reg <= CC1101_TEST0 ? model.regs[reg] : 0;
+}
+
+uint8_t cc1101_model_get_expected_rssi(uint32_t frequency) {
+    return model_power_to_rssi(model_get_power(frequency));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+ * Behavioral CC1101 model behind the SPI stub, see scripts/subghz_sweep_bench.py
+ *
+ * Decodes register accesses and strobes, runs the state machine on a virtual
+ * clock advanced by SPI transfers and delays. Calibration result is a function
+ * of FREQ, RSSI reflects emitters within the channel filter once the AGC had
+ * time to settle and only if FSCAL matches the tuned frequency.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t frequency;
+    float power; /* dBm */
+} CC1101ModelEmitter;
+
+typedef struct {
+    uint32_t spi; /* SPI transactions */
+    uint32_t scal; /* SCAL strobes */
+    uint32_t autocal; /* Calibrations on IDLE to RX transition */
+    uint32_t errors; /* Accesses in a state not allowing them */
+} CC1101ModelStats;
+
+/** Power on reset, clears stats, keeps clock and emitters */
+void cc1101_model_reset(void);
+
+void cc1101_model_set_emitters(const CC1101ModelEmitter* emitters, size_t count);
+
+uint64_t cc1101_model_get_time_ns(void);
+
+const CC1101ModelStats* cc1101_model_get_stats(void);
+
+void cc1101_model_clear_stats(void);
+
+uint8_t cc1101_model_get_reg(uint8_t reg);
+
+/** Raw RSSI a correctly tuned and settled chip reports for frequency */
+uint8_t cc1101_model_get_expected_rssi(uint32_t frequency);
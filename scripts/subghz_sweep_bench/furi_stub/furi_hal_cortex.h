@@ -0,0 +1,17 @@
+#pragma once
+
+/* Minimal cortex HAL replacement running on the CC1101 model clock */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint64_t start;
+    uint32_t value;
+} FuriHalCortexTimer;
+
+void furi_hal_cortex_delay_us(uint32_t microseconds);
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us);
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer);
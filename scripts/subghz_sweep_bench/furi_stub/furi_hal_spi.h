@@ -0,0 +1,23 @@
+#pragma once
+
+/* Minimal SPI HAL replacement, transfers go to the CC1101 model */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct GpioPin GpioPin;
+
+typedef struct {
+    const GpioPin* miso;
+} FuriHalSpiBusHandle;
+
+/** Chip is always ready, MISO reads low */
+bool furi_hal_gpio_read(const GpioPin* gpio);
+
+bool furi_hal_spi_bus_trx(
+    FuriHalSpiBusHandle* handle,
+    const uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout);
@@ -0,0 +1,171 @@
+/*
+ * Host benchmark of CC1101 frequency sweeps, see scripts/subghz_sweep_bench.py
+ *
+ * Usage: subghz_sweep_bench
+ *
+ * Runs frequency analyzer style coarse and fine sweeps against the CC1101
+ * model, once with calibration on every step and fixed delay as the analyzers
+ * used to do and once with cc1101_calibrate_channel and cc1101_sweep. Every
+ * reported RSSI is checked against the model. Prints
+ * "result <scenario> <method> <channels> <time us> <scal> <spi> <mismatches> <errors>"
+ * per run, calibration of the cached method is reported as a separate method.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cc1101.h>
+#include <furi_hal_cortex.h>
+
+#include "cc1101_model.h"
+
+#define LEGACY_DELAY_US 2000
+#define FINE_SPAN 300000
+#define FINE_STEP 20000
+#define FINE_COUNT (2 * FINE_SPAN / FINE_STEP)
+
+typedef struct {
+    const char* name;
+    uint8_t mdmcfg4;
+    uint8_t agcctrl0;
+    const uint32_t* frequencies;
+    size_t count;
+} Scenario;
+
+// Part of the default frequency analyzer list
+static const uint32_t coarse_frequencies[] = {
+    300000000, 302757000, 303875000, 304250000, 307000000, 307500000, 307800000,
+    309000000, 310000000, 312000000, 312100000, 313000000, 313850000, 314000000,
+    314350000, 314980000, 315000000, 318000000, 330000000, 345000000, 348000000,
+    387000000, 390000000, 418000000, 430000000, 431000000, 431500000, 433075000,
+    433220000, 433420000, 433657070, 433889000, 433920000, 434075000, 434176948,
+    434390000, 434420000, 434775000, 438900000, 440175000, 464000000, 779000000,
+    868350000, 868400000, 868800000, 868950000, 906400000, 915000000, 925000000,
+};
+
+static uint32_t fine_frequencies[FINE_COUNT];
+
+static const CC1101ModelEmitter emitters[] = {
+    {.frequency = 433920000, .power = -40.0f},
+    {.frequency = 868350000, .power = -60.0f},
+};
+
+static FuriHalSpiBusHandle handle;
+
+static void bench_setup(const Scenario* scenario, uint8_t mcsm0) {
+    cc1101_reset(&handle);
+    cc1101_write_reg(&handle, CC1101_MCSM0, mcsm0);
+    cc1101_write_reg(&handle, CC1101_MDMCFG4, scenario->mdmcfg4);
+    cc1101_write_reg(&handle, CC1101_AGCCTRL0, scenario->agcctrl0);
+    cc1101_model_clear_stats();
+}
+
+static void bench_report(
+    const Scenario* scenario,
+    const char* method,
+    size_t count,
+    uint64_t start,
+    uint32_t mismatches) {
+    const CC1101ModelStats* stats = cc1101_model_get_stats();
+    printf(
+        "result %s %s %zu %llu %u %u %u %u\n",
+        scenario->name,
+        method,
+        count,
+        (unsigned long long)((cc1101_model_get_time_ns() - start) / 1000),
+        stats->scal + stats->autocal,
+        stats->spi,
+        mismatches,
+        stats->errors);
+}
+
+static uint32_t bench_check(uint32_t frequency, uint8_t rssi) {
+    uint8_t expected = cc1101_model_get_expected_rssi(frequency);
+    if(rssi == expected) return 0;
+    fprintf(stderr, "%lu: rssi %u, expected %u\n", (unsigned long)frequency, rssi, expected);
+    return 1;
+}
+
+/* Former frequency analyzer step: calibrate, enter RX, sleep */
+static void bench_legacy(const Scenario* scenario) {
+    bench_setup(scenario, 0x04);
+    uint64_t start = cc1101_model_get_time_ns();
+    uint32_t mismatches = 0;
+
+    for(size_t i = 0; i < scenario->count; i++) {
+        cc1101_switch_to_idle(&handle);
+        uint32_t frequency = cc1101_set_frequency(&handle, scenario->frequencies[i]);
+        cc1101_calibrate(&handle);
+        if(!cc1101_wait_status_state(&handle, CC1101StateIDLE, 10000)) mismatches++;
+        cc1101_switch_to_rx(&handle);
+        furi_hal_cortex_delay_us(LEGACY_DELAY_US);
+        mismatches += bench_check(frequency, cc1101_get_rssi(&handle));
+    }
+    cc1101_switch_to_idle(&handle);
+
+    bench_report(scenario, "legacy", scenario->count, start, mismatches);
+}
+
+static void bench_cached(const Scenario* scenario) {
+    CC1101Channel* channels = malloc(sizeof(CC1101Channel) * scenario->count);
+    uint8_t* rssi = malloc(scenario->count);
+
+    // Presets enable calibration on IDLE to RX, sweep must suspend it
+    const uint8_t mcsm0 = 0x18;
+    bench_setup(scenario, mcsm0);
+    uint64_t start = cc1101_model_get_time_ns();
+    uint32_t mismatches = 0;
+    for(size_t i = 0; i < scenario->count; i++) {
+        if(!cc1101_calibrate_channel(&handle, scenario->frequencies[i], &channels[i])) {
+            mismatches++;
+        }
+    }
+    bench_report(scenario, "calibrate", scenario->count, start, mismatches);
+
+    cc1101_model_clear_stats();
+    start = cc1101_model_get_time_ns();
+    mismatches = cc1101_sweep(&handle, channels, scenario->count, rssi) ? 0 : 1;
+    for(size_t i = 0; i < scenario->count; i++) {
+        mismatches += bench_check(channels[i].frequency, rssi[i]);
+    }
+    // Calibration is cached, none may happen during sweep
+    const CC1101ModelStats* stats = cc1101_model_get_stats();
+    if(stats->scal || stats->autocal) mismatches++;
+    if(cc1101_model_get_reg(CC1101_MCSM0) != mcsm0) mismatches++;
+    bench_report(scenario, "sweep", scenario->count, start, mismatches);
+
+    free(rssi);
+    free(channels);
+}
+
+int main(void) {
+    for(size_t i = 0; i < FINE_COUNT; i++) {
+        fine_frequencies[i] = 433920000 - FINE_SPAN + i * FINE_STEP;
+    }
+
+    const Scenario scenarios[] = {
+        {
+            .name = "coarse_650k",
+            .mdmcfg4 = 0x17,
+            .agcctrl0 = 0x30,
+            .frequencies = coarse_frequencies,
+            .count = sizeof(coarse_frequencies) / sizeof(coarse_frequencies[0]),
+        },
+        {
+            .name = "fine_58k",
+            .mdmcfg4 = 0xF7,
+            .agcctrl0 = 0x30,
+            .frequencies = fine_frequencies,
+            .count = FINE_COUNT,
+        },
+    };
+
+    cc1101_model_set_emitters(emitters, sizeof(emitters) / sizeof(emitters[0]));
+
+    for(size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        bench_legacy(&scenarios[i]);
+        bench_cached(&scenarios[i]);
+    }
+
+    return 0;
+}
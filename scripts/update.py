@@ -23,6 +23,12 @@ class Main(App):
     RESOURCE_TAR_FORMAT = tarfile.USTAR_FORMAT
     RESOURCE_FILE_NAME = "resources.tar"
     RESOURCE_ENTRY_NAME_MAX_LENGTH = 100
+    RESOURCE_MANIFEST_NAME = "Manifest"
+    #  Optional heatshrink-compressed tar, see TarHeatshrinkHeader
+    RESOURCE_HS_FILE_NAME = "resources.ths"
+    RESOURCE_HS_MAGIC = b"HS"
+    RESOURCE_HS_WINDOW_LOG = 13
+    RESOURCE_HS_LOOKAHEAD_LOG = 6
 
     WHITELISTED_STACK_TYPES = set(
         map(
@@ -76,6 +82,13 @@ class Main(App):
         self.parser_generate.add_argument(
             "--stackversion", dest="stack_version", required=False, default=""
         )
+        self.parser_generate.add_argument(
+            "--compress-resources",
+            dest="compress_resources",
+            action="store_true",
+            default=False,
+            required=False,
+        )
 
         self.parser_generate.set_defaults(func=self.generate)
 
@@ -146,6 +159,13 @@ class Main(App):
                 self.args.resources, join(self.args.directory, resources_basename)
             ):
                 return 3
+            if self.args.compress_resources:
+                tar_path = join(self.args.directory, resources_basename)
+                resources_basename = self.RESOURCE_HS_FILE_NAME
+                self.compress_resources(
+                    tar_path, join(self.args.directory, resources_basename)
+                )
+                os.remove(tar_path)
 
         if not self.layout_check(dfu_size, radio_addr):
             self.logger.warn("Memory layout looks suspicious")
@@ -233,21 +253,56 @@ class Main(App):
         tarinfo.uname = tarinfo.gname = "furippa"
         return tarinfo
 
+    def _tar_resource_filter(self, tarinfo: tarfile.TarInfo):
+        if tarinfo.name == self.RESOURCE_MANIFEST_NAME:
+            return None
+        return self._tar_filter(tarinfo)
+
     def package_resources(self, srcdir: str, dst_name: str):
         try:
             with tarfile.open(
                 dst_name, self.RESOURCE_TAR_MODE, format=self.RESOURCE_TAR_FORMAT
             ) as tarball:
+                # Manifest goes first: device reads it before everything else,
+                # compressed bundles are then decoded in a single pass
+                manifest_path = os.path.join(srcdir, self.RESOURCE_MANIFEST_NAME)
+                if os.path.isfile(manifest_path):
+                    tarball.add(
+                        manifest_path,
+                        arcname=self.RESOURCE_MANIFEST_NAME,
+                        filter=self._tar_filter,
+                    )
                 tarball.add(
                     srcdir,
                     arcname="",
-                    filter=self._tar_filter,
+                    filter=self._tar_resource_filter,
                 )
             return True
         except ValueError as e:
             self.logger.error(f"Cannot package resources: {e}")
             return False
 
+    def compress_resources(self, src_name: str, dst_name: str):
+        import heatshrink2
+
+        with open(src_name, "rb") as src:
+            data = src.read()
+        with open(dst_name, "wb") as dst:
+            dst.write(self.RESOURCE_HS_MAGIC)
+            dst.write(
+                bytes((self.RESOURCE_HS_WINDOW_LOG, self.RESOURCE_HS_LOOKAHEAD_LOG))
+            )
+            dst.write(
+                heatshrink2.compress(
+                    data,
+                    window_sz2=self.RESOURCE_HS_WINDOW_LOG,
+                    lookahead_sz2=self.RESOURCE_HS_LOOKAHEAD_LOG,
+                )
+            )
+        self.logger.info(
+            f"Compressed resources: {len(data)} -> {os.path.getsize(dst_name)} bytes"
+        )
+
     @staticmethod
     def copro_version_as_int(coprometa, stacktype):
         major = coprometa.img_sig.version_major
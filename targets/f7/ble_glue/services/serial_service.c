@@ -11,6 +11,13 @@
 
 #define TAG "BtSerialSvc"
 
+// Default ATT MTU minus notification header
+#define BLE_SVC_SERIAL_NOTIFY_LEN_DEFAULT (20)
+// Time to wait for stack tx buffers to become available
+#define BLE_SVC_SERIAL_TX_TIMEOUT_MS (1000)
+// Credit notifications are sent once this part of the buffer was released
+#define BLE_SVC_SERIAL_CREDIT_UPDATE_DIV (4)
+
 typedef enum {
     SerialSvcGattCharacteristicRx = 0,
     SerialSvcGattCharacteristicTx,
@@ -36,7 +43,7 @@ static const BleGattCharacteristicParams ble_svc_serial_chars[SerialSvcGattChara
          .data.fixed.length = BLE_SVC_SERIAL_DATA_LEN_MAX,
          .uuid.Char_UUID_128 = BLE_SVC_SERIAL_TX_CHAR_UUID,
          .uuid_type = UUID_TYPE_128,
-         .char_properties = CHAR_PROP_READ | CHAR_PROP_INDICATE,
+         .char_properties = CHAR_PROP_READ | CHAR_PROP_INDICATE | CHAR_PROP_NOTIFY,
          .security_permissions = ATTR_PERMISSION_AUTHEN_READ,
          .gatt_evt_mask = GATT_DONT_NOTIFY_EVENTS,
          .is_variable = CHAR_VALUE_LEN_VARIABLE},
@@ -67,21 +74,94 @@ struct BleServiceSerial {
     FuriMutex* buff_size_mtx;
     uint32_t buff_size;
     uint16_t bytes_ready_to_receive;
+    // Credit mode: client subscribed to TX notifications instead of indications
+    volatile bool credit_mode;
+    uint32_t rx_bytes_received;
+    uint32_t rx_bytes_granted;
+    volatile uint16_t tx_notify_len;
+    FuriSemaphore* tx_pool_sem;
     SerialServiceEventCallback callback;
     void* context;
     GapSvcEventHandler* event_handler;
 };
 
+static void ble_svc_serial_update_flow_ctrl_char(BleServiceSerial* serial_svc, uint32_t value) {
+    uint32_t value_reversed = REVERSE_BYTES_U32(value);
+    ble_gatt_characteristic_update(
+        serial_svc->svc_handle,
+        &serial_svc->chars[SerialSvcGattCharacteristicFlowCtrl],
+        &value_reversed);
+}
+
+/* Let client send more data, must be called with buff_size_mtx held
+ *
+ * Legacy mode: flow control value is the number of bytes client may send,
+ * it replaces previous one. So it can only be updated once previous grant
+ * is used up, otherwise bytes in flight would overflow the buffer.
+ *
+ * Credit mode: flow control value is the total number of bytes client may
+ * send since credit mode was enabled (modulo 2^32). Updates never revoke
+ * bytes in flight, so credits are returned as soon as buffer space is freed.
+ */
+static void ble_svc_serial_grant(BleServiceSerial* serial_svc, uint32_t free_size) {
+    if(serial_svc->credit_mode) {
+        const uint32_t granted = serial_svc->rx_bytes_received + free_size;
+        const uint32_t increment = granted - serial_svc->rx_bytes_granted;
+        if((int32_t)increment <= 0) return;
+        if((increment < serial_svc->buff_size / BLE_SVC_SERIAL_CREDIT_UPDATE_DIV) &&
+           (free_size < serial_svc->buff_size)) {
+            return;
+        }
+        FURI_LOG_D(TAG, "Granted %lu bytes", increment);
+        serial_svc->rx_bytes_granted = granted;
+        ble_svc_serial_update_flow_ctrl_char(serial_svc, granted);
+    } else {
+        if(serial_svc->bytes_ready_to_receive != 0) return;
+        if(free_size < serial_svc->buff_size / 2) return;
+        FURI_LOG_D(TAG, "Buffer is free. Notifying client");
+        serial_svc->bytes_ready_to_receive = free_size;
+        ble_svc_serial_update_flow_ctrl_char(serial_svc, free_size);
+    }
+}
+
+static void ble_svc_serial_set_credit_mode(BleServiceSerial* serial_svc, bool credit_mode) {
+    furi_check(furi_mutex_acquire(serial_svc->buff_size_mtx, FuriWaitForever) == FuriStatusOk);
+    if(serial_svc->credit_mode != credit_mode) {
+        FURI_LOG_I(TAG, "Credit mode %s", credit_mode ? "on" : "off");
+        // Keep bytes client is allowed to send, counting from zero is the same in both modes
+        if(credit_mode) {
+            serial_svc->rx_bytes_granted = serial_svc->bytes_ready_to_receive;
+        } else {
+            serial_svc->bytes_ready_to_receive =
+                serial_svc->rx_bytes_granted - serial_svc->rx_bytes_received;
+        }
+        serial_svc->rx_bytes_received = 0;
+        serial_svc->credit_mode = credit_mode;
+        ble_svc_serial_update_flow_ctrl_char(serial_svc, serial_svc->bytes_ready_to_receive);
+    }
+    furi_check(furi_mutex_release(serial_svc->buff_size_mtx) == FuriStatusOk);
+}
+
 static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context) {
     BleServiceSerial* serial_svc = (BleServiceSerial*)context;
     BleEventAckStatus ret = BleEventNotAck;
     hci_event_pckt* event_pckt = (hci_event_pckt*)(((hci_uart_pckt*)event)->data);
     evt_blecore_aci* blecore_evt = (evt_blecore_aci*)event_pckt->data;
     aci_gatt_attribute_modified_event_rp0* attribute_modified;
-    if(event_pckt->evt == HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE) {
+    if(event_pckt->evt == HCI_DISCONNECTION_COMPLETE_EVT_CODE) {
+        // Connection parameters are negotiated again by next client
+        serial_svc->tx_notify_len = BLE_SVC_SERIAL_NOTIFY_LEN_DEFAULT;
+        ble_svc_serial_set_credit_mode(serial_svc, false);
+    } else if(event_pckt->evt == HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE) {
         if(blecore_evt->ecode == ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE) {
             attribute_modified = (aci_gatt_attribute_modified_event_rp0*)blecore_evt->data;
             if(attribute_modified->Attr_Handle ==
+               serial_svc->chars[SerialSvcGattCharacteristicTx].handle + 2) {
+                // Client characteristic configuration: bit 0 - notifications, bit 1 - indications
+                const bool notify = attribute_modified->Attr_Data[0] & 0x01;
+                ble_svc_serial_set_credit_mode(serial_svc, notify);
+                ret = BleEventAckFlowEnable;
+            } else if(attribute_modified->Attr_Handle ==
                serial_svc->chars[SerialSvcGattCharacteristicRx].handle + 2) {
                 // Descriptor handle
                 ret = BleEventAckFlowEnable;
@@ -94,15 +174,21 @@ static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context
                     furi_check(
                         furi_mutex_acquire(serial_svc->buff_size_mtx, FuriWaitForever) ==
                         FuriStatusOk);
-                    if(attribute_modified->Attr_Data_Length > serial_svc->bytes_ready_to_receive) {
-                        FURI_LOG_W(
+                    const uint16_t length = attribute_modified->Attr_Data_Length;
+                    const uint32_t credits = serial_svc->credit_mode ?
+                                                 serial_svc->rx_bytes_granted -
+                                                     serial_svc->rx_bytes_received :
+                                                 serial_svc->bytes_ready_to_receive;
+                    if(length > credits) {
+                        FURI_LOG_E(
                             TAG,
-                            "Received %d, while was ready to receive %d bytes. Can lead to buffer overflow!",
-                            attribute_modified->Attr_Data_Length,
-                            serial_svc->bytes_ready_to_receive);
+                            "Received %d, while was ready to receive %lu bytes. Client ignores flow control",
+                            length,
+                            credits);
                     }
-                    serial_svc->bytes_ready_to_receive -= MIN(
-                        serial_svc->bytes_ready_to_receive, attribute_modified->Attr_Data_Length);
+                    serial_svc->bytes_ready_to_receive -=
+                        MIN(serial_svc->bytes_ready_to_receive, length);
+                    serial_svc->rx_bytes_received += length;
                     SerialServiceEvent event = {
                         .event = SerialServiceEventTypeDataReceived,
                         .data = {
@@ -111,6 +197,7 @@ static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context
                         }};
                     uint32_t buff_free_size = serial_svc->callback(event, serial_svc->context);
                     FURI_LOG_D(TAG, "Available buff size: %ld", buff_free_size);
+                    ble_svc_serial_grant(serial_svc, buff_free_size);
                     furi_check(furi_mutex_release(serial_svc->buff_size_mtx) == FuriStatusOk);
                 }
                 ret = BleEventAckFlowEnable;
@@ -136,6 +223,15 @@ static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context
                 serial_svc->callback(event, serial_svc->context);
             }
             ret = BleEventAckFlowEnable;
+        } else if(blecore_evt->ecode == ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE) {
+            // Not acknowledged: other services may be waiting for it too
+            furi_semaphore_release(serial_svc->tx_pool_sem);
+        } else if(blecore_evt->ecode == ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE) {
+            aci_att_exchange_mtu_resp_event_rp0* mtu_resp =
+                (aci_att_exchange_mtu_resp_event_rp0*)blecore_evt->data;
+            // Notification header is 3 bytes, event is also handled by GAP
+            serial_svc->tx_notify_len =
+                MIN(mtu_resp->Server_RX_MTU - 3, BLE_SVC_SERIAL_CHAR_VALUE_LEN_MAX);
         }
     }
     return ret;
@@ -170,6 +266,8 @@ BleServiceSerial* ble_svc_serial_start(void) {
 
     ble_svc_serial_update_rpc_char(serial_svc, SerialServiceRpcStatusNotActive);
     serial_svc->buff_size_mtx = furi_mutex_alloc(FuriMutexTypeNormal);
+    serial_svc->tx_pool_sem = furi_semaphore_alloc(1, 0);
+    serial_svc->tx_notify_len = BLE_SVC_SERIAL_NOTIFY_LEN_DEFAULT;
 
     return serial_svc;
 }
@@ -180,16 +278,17 @@ void ble_svc_serial_set_callbacks(
     SerialServiceEventCallback callback,
     void* context) {
     furi_assert(serial_svc);
+    furi_check(furi_mutex_acquire(serial_svc->buff_size_mtx, FuriWaitForever) == FuriStatusOk);
     serial_svc->callback = callback;
     serial_svc->context = context;
     serial_svc->buff_size = buff_size;
     serial_svc->bytes_ready_to_receive = buff_size;
+    // Initial value has the same meaning in both modes
+    serial_svc->rx_bytes_received = 0;
+    serial_svc->rx_bytes_granted = buff_size;
 
-    uint32_t buff_size_reversed = REVERSE_BYTES_U32(serial_svc->buff_size);
-    ble_gatt_characteristic_update(
-        serial_svc->svc_handle,
-        &serial_svc->chars[SerialSvcGattCharacteristicFlowCtrl],
-        &buff_size_reversed);
+    ble_svc_serial_update_flow_ctrl_char(serial_svc, buff_size);
+    furi_check(furi_mutex_release(serial_svc->buff_size_mtx) == FuriStatusOk);
 }
 
 void ble_svc_serial_notify_buffer_is_empty(BleServiceSerial* serial_svc) {
@@ -197,15 +296,17 @@ void ble_svc_serial_notify_buffer_is_empty(BleServiceSerial* serial_svc) {
     furi_assert(serial_svc->buff_size_mtx);
 
     furi_check(furi_mutex_acquire(serial_svc->buff_size_mtx, FuriWaitForever) == FuriStatusOk);
-    if(serial_svc->bytes_ready_to_receive == 0) {
-        FURI_LOG_D(TAG, "Buffer is empty. Notifying client");
-        serial_svc->bytes_ready_to_receive = serial_svc->buff_size;
-
-        uint32_t buff_size_reversed = REVERSE_BYTES_U32(serial_svc->buff_size);
-        ble_gatt_characteristic_update(
-            serial_svc->svc_handle,
-            &serial_svc->chars[SerialSvcGattCharacteristicFlowCtrl],
-            &buff_size_reversed);
+    if(serial_svc->credit_mode) {
+        // Data may have been received after buffer was found empty, ask for actual size
+        if(serial_svc->callback) {
+            SerialServiceEvent event = {
+                .event = SerialServiceEventTypeBufferFreeSizeRequest,
+            };
+            ble_svc_serial_grant(serial_svc, serial_svc->callback(event, serial_svc->context));
+        }
+    } else {
+        // No data in flight once client used up previous grant, buffer is still empty
+        ble_svc_serial_grant(serial_svc, serial_svc->buff_size);
     }
     furi_check(furi_mutex_release(serial_svc->buff_size_mtx) == FuriStatusOk);
 }
@@ -220,14 +321,63 @@ void ble_svc_serial_stop(BleServiceSerial* serial_svc) {
     }
     ble_gatt_service_delete(serial_svc->svc_handle);
     furi_mutex_free(serial_svc->buff_size_mtx);
+    furi_semaphore_free(serial_svc->tx_pool_sem);
     free(serial_svc);
 }
 
+static bool ble_svc_serial_notify_tx(BleServiceSerial* serial_svc, uint8_t* data, uint16_t data_len) {
+    for(uint16_t offset = 0; offset < data_len;) {
+        const uint16_t value_len = MIN(serial_svc->tx_notify_len, data_len - offset);
+
+        tBleStatus result;
+        while(true) {
+            result = aci_gatt_update_char_value_ext(
+                0,
+                serial_svc->svc_handle,
+                serial_svc->chars[SerialSvcGattCharacteristicTx].handle,
+                0x01,
+                value_len,
+                0,
+                value_len,
+                data + offset);
+            if(result != BLE_STATUS_INSUFFICIENT_RESOURCES) break;
+
+            // All stack buffers are in flight, wait for one to be released
+            if(furi_semaphore_acquire(
+                   serial_svc->tx_pool_sem, furi_ms_to_ticks(BLE_SVC_SERIAL_TX_TIMEOUT_MS)) !=
+               FuriStatusOk) {
+                break;
+            }
+        }
+
+        if(result) {
+            FURI_LOG_E(TAG, "Failed notifying TX characteristic: %d", result);
+            return false;
+        }
+
+        offset += value_len;
+    }
+
+    // Notifications are not confirmed: sender may continue right away
+    if(serial_svc->callback) {
+        SerialServiceEvent event = {
+            .event = SerialServiceEventTypeDataSent,
+        };
+        serial_svc->callback(event, serial_svc->context);
+    }
+
+    return true;
+}
+
 bool ble_svc_serial_update_tx(BleServiceSerial* serial_svc, uint8_t* data, uint16_t data_len) {
     if(data_len > BLE_SVC_SERIAL_DATA_LEN_MAX) {
         return false;
     }
 
+    if(serial_svc->credit_mode) {
+        return ble_svc_serial_notify_tx(serial_svc, data, data_len);
+    }
+
     for(uint16_t remained = data_len; remained > 0;) {
         uint8_t value_len = MIN(BLE_SVC_SERIAL_CHAR_VALUE_LEN_MAX, remained);
         uint16_t value_offset = data_len - remained;
@@ -9,6 +9,15 @@ extern "C" {
 
 /* 
  * Serial service. Implements RPC over BLE, with flow control.
+ *
+ * Client subscribed to TX indications works in legacy mode: every TX packet
+ * is confirmed, flow control characteristic holds number of bytes client is
+ * allowed to send, each update replaces previous value.
+ *
+ * Client subscribed to TX notifications works in credit mode: TX packets are
+ * notified back to back up to negotiated MTU, flow control characteristic
+ * holds total number of bytes client is allowed to send since subscription
+ * (modulo 2^32). Client must keep count of sent bytes and never exceed it.
  */
 
 #define BLE_SVC_SERIAL_DATA_LEN_MAX (486)
@@ -18,6 +27,7 @@ typedef enum {
     SerialServiceEventTypeDataReceived,
     SerialServiceEventTypeDataSent,
     SerialServiceEventTypesBleResetRequest,
+    SerialServiceEventTypeBufferFreeSizeRequest, /**< Callback returns free buffer size */
 } SerialServiceEventType;
 
 typedef struct {
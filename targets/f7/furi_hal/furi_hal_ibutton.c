@@ -3,6 +3,7 @@
 #include <furi_hal_resources.h>
 #include <furi_hal_bus.h>
 
+#include <stm32wbxx_ll_dma.h>
 #include <stm32wbxx_ll_tim.h>
 
 #include <furi.h>
@@ -12,15 +13,42 @@
 #define FURI_HAL_IBUTTON_TIMER_BUS FuriHalBusTIM1
 #define FURI_HAL_IBUTTON_TIMER_IRQ FuriHalInterruptIdTim1UpTim16
 
+/* Host mode, TIM1_CH2N on the iButton pin drives the line low in each slot */
+#define FURI_HAL_IBUTTON_HOST_GPIO_AF GpioAltFn1TIM1
+#define FURI_HAL_IBUTTON_HOST_TICKS_PER_US (64U)
+#define FURI_HAL_IBUTTON_HOST_PERIOD_MAX_US (1023U)
+#define FURI_HAL_IBUTTON_HOST_SLOTS_MAX (64U)
+#define FURI_HAL_IBUTTON_HOST_TIMEOUT_MS (10U)
+
+/* Host mode DMA channels, shared with RFID, Infrared and SubGhz */
+#define FURI_HAL_IBUTTON_HOST_DMA DMA2
+#define FURI_HAL_IBUTTON_HOST_DMA_PULSE_CHANNEL LL_DMA_CHANNEL_1
+#define FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_CHANNEL LL_DMA_CHANNEL_2
+#define FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_IRQ FuriHalInterruptIdDma2Ch2
+#define FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF \
+    FURI_HAL_IBUTTON_HOST_DMA, FURI_HAL_IBUTTON_HOST_DMA_PULSE_CHANNEL
+#define FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF \
+    FURI_HAL_IBUTTON_HOST_DMA, FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_CHANNEL
+
 typedef enum {
     FuriHalIbuttonStateIdle,
     FuriHalIbuttonStateRunning,
+    FuriHalIbuttonStateHost,
 } FuriHalIbuttonState;
 
+typedef struct {
+    FuriSemaphore* done;
+    /* Low time of each slot in timer ticks, followed by two idle slots */
+    uint16_t pulse[FURI_HAL_IBUTTON_HOST_SLOTS_MAX + 2];
+    /* GPIO input register captured in each slot */
+    uint16_t sample[FURI_HAL_IBUTTON_HOST_SLOTS_MAX];
+} FuriHalIbuttonHost;
+
 typedef struct {
     FuriHalIbuttonState state;
     FuriHalIbuttonEmulateCallback callback;
     void* context;
+    FuriHalIbuttonHost* host;
 } FuriHalIbutton;
 
 FuriHalIbutton* furi_hal_ibutton = NULL;
@@ -89,6 +117,213 @@ void furi_hal_ibutton_emulate_stop() {
     }
 }
 
+static void furi_hal_ibutton_host_sample_dma_isr(void* context) {
+    UNUSED(context);
+#if FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_CHANNEL == LL_DMA_CHANNEL_2
+    if(LL_DMA_IsActiveFlag_TC2(FURI_HAL_IBUTTON_HOST_DMA)) {
+        LL_DMA_ClearFlag_TC2(FURI_HAL_IBUTTON_HOST_DMA);
+#else
+#error Update this code. Would you kindly?
+#endif
+        /* Last slot sampled, let it run to the end and stop there. Should the update
+         * already be over, the counter stops after one more idle slot. */
+        LL_TIM_SetOnePulseMode(FURI_HAL_IBUTTON_TIMER, LL_TIM_ONEPULSEMODE_SINGLE);
+        LL_TIM_ClearFlag_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        LL_TIM_EnableIT_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    }
+}
+
+static void furi_hal_ibutton_host_timer_isr(void* context) {
+    UNUSED(context);
+    if(LL_TIM_IsActiveFlag_UPDATE(FURI_HAL_IBUTTON_TIMER)) {
+        LL_TIM_ClearFlag_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        LL_TIM_DisableIT_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        furi_semaphore_release(furi_hal_ibutton->host->done);
+    }
+}
+
+void furi_hal_ibutton_host_start() {
+    furi_assert(furi_hal_ibutton);
+    furi_assert(furi_hal_ibutton->state == FuriHalIbuttonStateIdle);
+
+    furi_hal_ibutton->state = FuriHalIbuttonStateHost;
+    furi_hal_ibutton->host = malloc(sizeof(FuriHalIbuttonHost));
+    furi_hal_ibutton->host->done = furi_semaphore_alloc(1, 0);
+
+    furi_hal_bus_enable(FURI_HAL_IBUTTON_TIMER_BUS);
+
+    LL_TIM_SetPrescaler(FURI_HAL_IBUTTON_TIMER, 0);
+    LL_TIM_SetCounterMode(FURI_HAL_IBUTTON_TIMER, LL_TIM_COUNTERMODE_UP);
+    LL_TIM_EnableARRPreload(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_SetRepetitionCounter(FURI_HAL_IBUTTON_TIMER, 0);
+    LL_TIM_SetClockDivision(FURI_HAL_IBUTTON_TIMER, LL_TIM_CLOCKDIVISION_DIV1);
+    LL_TIM_SetClockSource(FURI_HAL_IBUTTON_TIMER, LL_TIM_CLOCKSOURCE_INTERNAL);
+
+    // Line is low while the counter is below CCR2, CCR2 of 0 keeps it released
+    LL_TIM_OC_SetCompareCH2(FURI_HAL_IBUTTON_TIMER, 0);
+    LL_TIM_OC_EnablePreload(FURI_HAL_IBUTTON_TIMER, LL_TIM_CHANNEL_CH2);
+    LL_TIM_OC_SetMode(FURI_HAL_IBUTTON_TIMER, LL_TIM_CHANNEL_CH2, LL_TIM_OCMODE_PWM1);
+    LL_TIM_OC_SetPolarity(FURI_HAL_IBUTTON_TIMER, LL_TIM_CHANNEL_CH2N, LL_TIM_OCPOLARITY_LOW);
+    LL_TIM_CC_EnableChannel(FURI_HAL_IBUTTON_TIMER, LL_TIM_CHANNEL_CH2N);
+
+    // CCR3 match samples the line through DMA
+    LL_TIM_OC_SetMode(FURI_HAL_IBUTTON_TIMER, LL_TIM_CHANNEL_CH3, LL_TIM_OCMODE_FROZEN);
+
+    LL_TIM_GenerateEvent_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_EnableAllOutputs(FURI_HAL_IBUTTON_TIMER);
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (FURI_HAL_IBUTTON_TIMER->CCR2);
+    dma_config.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    dma_config.Mode = LL_DMA_MODE_NORMAL;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_HALFWORD;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_HALFWORD;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_TIM1_UP;
+    dma_config.Priority = LL_DMA_PRIORITY_VERYHIGH;
+    LL_DMA_Init(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF, &dma_config);
+
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (gpio_ibutton.port->IDR);
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_TIM1_CH3;
+    LL_DMA_Init(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF, &dma_config);
+    LL_DMA_EnableIT_TC(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF);
+
+    furi_hal_interrupt_set_isr(
+        FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_IRQ, furi_hal_ibutton_host_sample_dma_isr, NULL);
+    furi_hal_interrupt_set_isr(FURI_HAL_IBUTTON_TIMER_IRQ, furi_hal_ibutton_host_timer_isr, NULL);
+
+    // Outputs are enabled and released, safe to connect the pin
+    furi_hal_gpio_write(&gpio_ibutton, true);
+    furi_hal_gpio_init_ex(
+        &gpio_ibutton,
+        GpioModeAltFunctionOpenDrain,
+        GpioPullNo,
+        GpioSpeedVeryHigh,
+        FURI_HAL_IBUTTON_HOST_GPIO_AF);
+}
+
+void furi_hal_ibutton_host_stop() {
+    furi_assert(furi_hal_ibutton);
+
+    if(furi_hal_ibutton->state == FuriHalIbuttonStateHost) {
+        furi_hal_ibutton_pin_reset();
+
+        LL_TIM_DisableCounter(FURI_HAL_IBUTTON_TIMER);
+        furi_hal_interrupt_set_isr(FURI_HAL_IBUTTON_TIMER_IRQ, NULL, NULL);
+        furi_hal_interrupt_set_isr(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_IRQ, NULL, NULL);
+        LL_DMA_DeInit(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF);
+        LL_DMA_DeInit(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF);
+        furi_hal_bus_disable(FURI_HAL_IBUTTON_TIMER_BUS);
+
+        furi_semaphore_free(furi_hal_ibutton->host->done);
+        free(furi_hal_ibutton->host);
+        furi_hal_ibutton->host = NULL;
+        furi_hal_ibutton->state = FuriHalIbuttonStateIdle;
+    }
+}
+
+static bool furi_hal_ibutton_host_run(const FuriHalIbuttonHostSlot* slot, size_t count) {
+    FuriHalIbuttonHost* host = furi_hal_ibutton->host;
+
+    LL_TIM_DisableCounter(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_DisableDMAReq_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_DisableDMAReq_CC3(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_SetOnePulseMode(FURI_HAL_IBUTTON_TIMER, LL_TIM_ONEPULSEMODE_REPETITIVE);
+
+    // First slot goes to the active registers, second one to the preload ones
+    LL_TIM_SetAutoReload(
+        FURI_HAL_IBUTTON_TIMER, slot->period * FURI_HAL_IBUTTON_HOST_TICKS_PER_US - 1);
+    LL_TIM_OC_SetCompareCH2(FURI_HAL_IBUTTON_TIMER, host->pulse[0]);
+    LL_TIM_OC_SetCompareCH3(
+        FURI_HAL_IBUTTON_TIMER, slot->sample * FURI_HAL_IBUTTON_HOST_TICKS_PER_US);
+    LL_TIM_SetCounter(FURI_HAL_IBUTTON_TIMER, 0);
+    LL_TIM_GenerateEvent_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_OC_SetCompareCH2(FURI_HAL_IBUTTON_TIMER, host->pulse[1]);
+    LL_TIM_ClearFlag_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_ClearFlag_CC3(FURI_HAL_IBUTTON_TIMER);
+
+    // Every update preloads the slot after the next one
+    LL_DMA_SetMemoryAddress(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF, (uint32_t)&host->pulse[2]);
+    LL_DMA_SetDataLength(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF, count);
+    LL_DMA_EnableChannel(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF);
+
+    LL_DMA_SetMemoryAddress(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF, (uint32_t)host->sample);
+    LL_DMA_SetDataLength(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF, count);
+    LL_DMA_EnableChannel(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF);
+
+    LL_TIM_EnableDMAReq_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_EnableDMAReq_CC3(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_EnableCounter(FURI_HAL_IBUTTON_TIMER);
+
+    const uint32_t timeout_ms = count * slot->period / 1000 + FURI_HAL_IBUTTON_HOST_TIMEOUT_MS;
+    const bool done =
+        furi_semaphore_acquire(host->done, furi_ms_to_ticks(timeout_ms)) == FuriStatusOk;
+
+    LL_TIM_DisableDMAReq_UPDATE(FURI_HAL_IBUTTON_TIMER);
+    LL_TIM_DisableDMAReq_CC3(FURI_HAL_IBUTTON_TIMER);
+    LL_DMA_DisableChannel(FURI_HAL_IBUTTON_HOST_DMA_PULSE_DEF);
+    LL_DMA_DisableChannel(FURI_HAL_IBUTTON_HOST_DMA_SAMPLE_DEF);
+
+    if(!done) {
+        // DMA is off, sample ISR can't enable update interrupt anymore
+        LL_TIM_DisableCounter(FURI_HAL_IBUTTON_TIMER);
+        LL_TIM_DisableIT_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        // Release the line: load CCR2 of 0 from preload register
+        LL_TIM_OC_SetCompareCH2(FURI_HAL_IBUTTON_TIMER, 0);
+        LL_TIM_GenerateEvent_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        LL_TIM_ClearFlag_UPDATE(FURI_HAL_IBUTTON_TIMER);
+        // Completion could be signalled after the timeout, don't let it leak to next run
+        furi_semaphore_acquire(host->done, 0);
+        FURI_LOG_W(TAG, "Host slots timeout");
+    }
+
+    return done;
+}
+
+bool furi_hal_ibutton_host_exchange(
+    const FuriHalIbuttonHostSlot* slot,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    furi_assert(furi_hal_ibutton);
+    furi_assert(furi_hal_ibutton->state == FuriHalIbuttonStateHost);
+    furi_check(slot->period <= FURI_HAL_IBUTTON_HOST_PERIOD_MAX_US);
+    furi_check(slot->low_1 < slot->period && slot->low_0 < slot->period);
+    furi_check(slot->sample < slot->period);
+
+    FuriHalIbuttonHost* host = furi_hal_ibutton->host;
+    const uint16_t low_1 = slot->low_1 * FURI_HAL_IBUTTON_HOST_TICKS_PER_US;
+    const uint16_t low_0 = slot->low_0 * FURI_HAL_IBUTTON_HOST_TICKS_PER_US;
+
+    for(size_t offset = 0; offset < bit_count; offset += FURI_HAL_IBUTTON_HOST_SLOTS_MAX) {
+        const size_t count = MIN(bit_count - offset, FURI_HAL_IBUTTON_HOST_SLOTS_MAX);
+
+        for(size_t i = 0; i < count; i++) {
+            const size_t bit = offset + i;
+            const bool value = tx ? (tx[bit / 8] & (1U << (bit % 8))) : true;
+            host->pulse[i] = value ? low_1 : low_0;
+        }
+        host->pulse[count] = 0;
+        host->pulse[count + 1] = 0;
+
+        if(!furi_hal_ibutton_host_run(slot, count)) return false;
+
+        if(!rx) continue;
+        for(size_t i = 0; i < count; i++) {
+            const size_t bit = offset + i;
+            const uint8_t mask = 1U << (bit % 8);
+            const bool value = tx ? (tx[bit / 8] & mask) : true;
+            if(mask == 0x01) rx[bit / 8] = 0;
+            // Write 0 slots read as 0, same as with the bit-banging host
+            if(value && (host->sample[i] & gpio_ibutton.pin)) rx[bit / 8] |= mask;
+        }
+    }
+
+    return true;
+}
+
 void furi_hal_ibutton_pin_configure() {
     furi_hal_gpio_write(&gpio_ibutton, true);
     furi_hal_gpio_init(&gpio_ibutton, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
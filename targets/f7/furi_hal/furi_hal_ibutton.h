@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -14,6 +15,14 @@ extern "C" {
 
 typedef void (*FuriHalIbuttonEmulateCallback)(void* context);
 
+/** 1-Wire time slot shape, all times in microseconds from the slot start */
+typedef struct {
+    uint16_t period; /**< Slot duration, less than 1024 */
+    uint16_t low_1; /**< Line low time of write 1 and read slots */
+    uint16_t low_0; /**< Line low time of write 0 slots */
+    uint16_t sample; /**< Line sampling time */
+} FuriHalIbuttonHostSlot;
+
 /** Initialize */
 void furi_hal_ibutton_init();
 
@@ -39,6 +48,36 @@ void furi_hal_ibutton_emulate_set_next(uint32_t period);
  */
 void furi_hal_ibutton_emulate_stop();
 
+/**
+ * Start 1-Wire host slot generator, takes over the emulation timer and the pin
+ */
+void furi_hal_ibutton_host_start();
+
+/**
+ * Stop 1-Wire host slot generator, sets the pin to analog mode
+ */
+void furi_hal_ibutton_host_stop();
+
+/**
+ * Generate 1-Wire time slots with the timer and DMA, the calling thread sleeps meanwhile
+ *
+ * Slots are generated LSB first. A 1 bit in tx makes a slot with low_1 low time, the sampled
+ * line level goes to the same bit of rx. A 0 bit makes a slot with low_0 low time, which reads
+ * as 0. A reset pulse is a single slot with the reset low time.
+ *
+ * @param slot slot shape
+ * @param tx slot types, NULL for low_1 slots only
+ * @param rx sampled levels, may be NULL
+ * @param bit_count number of slots
+ * @return true on success, false if the slots did not complete in time: the timer and DMA are
+ * stopped, the line is released and rx content is undefined
+ */
+bool furi_hal_ibutton_host_exchange(
+    const FuriHalIbuttonHostSlot* slot,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count);
+
 /**
  * Set the pin to normal mode (open collector), and sets it to float
  */
@@ -336,17 +336,10 @@ bool furi_hal_subghz_tx() {
 
 float furi_hal_subghz_get_rssi() {
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-    int32_t rssi_dec = cc1101_get_rssi(&furi_hal_spi_bus_handle_subghz);
+    uint8_t rssi = cc1101_get_rssi(&furi_hal_spi_bus_handle_subghz);
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 
-    float rssi = rssi_dec;
-    if(rssi_dec >= 128) {
-        rssi = ((rssi - 256.0f) / 2.0f) - 74.0f;
-    } else {
-        rssi = (rssi / 2.0f) - 74.0f;
-    }
-
-    return rssi;
+    return cc1101_rssi_to_dbm(rssi);
 }
 
 uint8_t furi_hal_subghz_get_lqi() {
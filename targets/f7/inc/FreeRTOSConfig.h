@@ -87,7 +87,7 @@ to exclude the API function. */
 #define INCLUDE_xTimerPendFunctionCall 1
 
 /* Furi-specific */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
 
 extern __attribute__((__noreturn__)) void furi_thread_catch();
 #define configTASK_RETURN_ADDRESS (furi_thread_catch + 2)